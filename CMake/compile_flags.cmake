@@ -22,4 +22,16 @@ endmacro()
 macro(mark_third_party target)
 	set_compile_flags(${target})
 	set_property(TARGET ${target} PROPERTY FOLDER "ThirdParty")
+endmacro()
+
+# Only for the engine's own targets, third party code is built with its own warnings. Initialiser lists are not kept in
+# declaration order and interface overrides often ignore parameters, so those two are left out.
+macro(set_warning_flags target)
+	if(ENABLE_WARNINGS_AS_ERRORS)
+		if(MSVC)
+			target_compile_options(${target} PRIVATE /W3 /WX)
+		else()
+			target_compile_options(${target} PRIVATE -Wall -Wextra -Werror -Wno-reorder -Wno-unused-parameter)
+		endif()
+	endif()
 endmacro()
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Base64.hpp"
 #include <iostream>
+#include <cstring>
 
 namespace Engine
 {
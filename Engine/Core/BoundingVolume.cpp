@@ -0,0 +1,117 @@
+#include "BoundingVolume.hpp"
+#include "VertexData.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace Engine
+{
+	float MaxDistanceSquared(const glm::vec3* positions, uint32_t count, const glm::vec3& center)
+	{
+		float distance = 0.0f;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 offset = positions[i] - center;
+			distance = std::max(distance, glm::dot(offset, offset));
+		}
+
+		return distance;
+	}
+
+	uint32_t FindFurthest(const glm::vec3* positions, uint32_t count, const glm::vec3& from)
+	{
+		uint32_t furthest = 0;
+		float furthestDistance = -1.0f;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 offset = positions[i] - from;
+			float distance = glm::dot(offset, offset);
+			if (distance > furthestDistance)
+			{
+				furthest = i;
+				furthestDistance = distance;
+			}
+		}
+
+		return furthest;
+	}
+
+	LocalBounds BoundingVolume::Calculate(const VertexData& positions)
+	{
+		LocalBounds bounds = { glm::vec4(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) };
+
+		uint32_t count = positions.GetCount();
+		const glm::vec3* positionData = positions.GetData<glm::vec3>();
+		if (count == 0)
+			return bounds;
+
+		// Branch free min/max over contiguous data, which the compiler vectorises.
+		glm::vec3 boxMin(std::numeric_limits<float>::max());
+		glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			boxMin = glm::min(boxMin, positionData[i]);
+			boxMax = glm::max(boxMax, positionData[i]);
+		}
+
+		bounds.BoxMin = boxMin;
+		bounds.BoxMax = boxMax;
+
+		// Ritter's approximation, seeded from two roughly opposite extreme points and grown to cover any outliers.
+		uint32_t a = FindFurthest(positionData, count, positionData[0]);
+		uint32_t b = FindFurthest(positionData, count, positionData[a]);
+		glm::vec3 center = (positionData[a] + positionData[b]) * 0.5f;
+		float radius = glm::length(positionData[b] - positionData[a]) * 0.5f;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 offset = positionData[i] - center;
+			float distanceSquared = glm::dot(offset, offset);
+			if (distanceSquared <= radius * radius)
+				continue;
+
+			float distance = std::sqrt(distanceSquared);
+			float newRadius = (radius + distance) * 0.5f;
+			center += offset * ((newRadius - radius) / distance);
+			radius = newRadius;
+		}
+
+		// Growing the sphere can leave points marginally outside due to rounding, so measure the final radius exactly.
+		radius = std::sqrt(MaxDistanceSquared(positionData, count, center));
+
+		glm::vec3 boxCenter = (boxMin + boxMax) * 0.5f;
+		float boxRadius = std::sqrt(MaxDistanceSquared(positionData, count, boxCenter));
+		if (boxRadius < radius)
+		{
+			center = boxCenter;
+			radius = boxRadius;
+		}
+
+		bounds.Sphere = glm::vec4(center, std::nextafter(radius, std::numeric_limits<float>::max()));
+		return bounds;
+	}
+
+	WorldBounds BoundingVolume::Transform(const LocalBounds& bounds, const glm::mat4& transform)
+	{
+		WorldBounds worldBounds = {};
+
+		glm::vec3 halfExtents = (bounds.BoxMax - bounds.BoxMin) * 0.5f;
+		worldBounds.BoxCenter = glm::vec3(transform * glm::vec4((bounds.BoxMin + bounds.BoxMax) * 0.5f, 1.0f));
+		for (int i = 0; i < 3; ++i)
+			worldBounds.BoxAxes[i] = glm::vec3(transform[i]) * halfExtents[i];
+
+		// A sphere only stays a sphere under uniform scale, so scale the radius by the largest axis.
+		float maxScale = std::max(glm::length(glm::vec3(transform[0])),
+			std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+		glm::vec3 sphereCenter = glm::vec3(transform * glm::vec4(glm::vec3(bounds.Sphere), 1.0f));
+		float sphereRadius = bounds.Sphere.w * maxScale;
+
+		// The sphere around the oriented box is tighter for elongated meshes under non-uniform scale.
+		float boxRadius = glm::length(worldBounds.BoxAxes[0] + worldBounds.BoxAxes[1] + worldBounds.BoxAxes[2]);
+		boxRadius = std::max(boxRadius, glm::length(worldBounds.BoxAxes[0] + worldBounds.BoxAxes[1] - worldBounds.BoxAxes[2]));
+		boxRadius = std::max(boxRadius, glm::length(worldBounds.BoxAxes[0] - worldBounds.BoxAxes[1] + worldBounds.BoxAxes[2]));
+		boxRadius = std::max(boxRadius, glm::length(-worldBounds.BoxAxes[0] + worldBounds.BoxAxes[1] + worldBounds.BoxAxes[2]));
+
+		worldBounds.Sphere = boxRadius < sphereRadius ? glm::vec4(worldBounds.BoxCenter, boxRadius) : glm::vec4(sphereCenter, sphereRadius);
+		return worldBounds;
+	}
+}
\ No newline at end of file
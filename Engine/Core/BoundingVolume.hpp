@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+#include <glm/glm.hpp>
+#include "Macros.hpp"
+
+namespace Engine
+{
+	class VertexData;
+
+	struct LocalBounds
+	{
+		glm::vec4 Sphere; // Object space centre and radius.
+		glm::vec3 BoxMin;
+		glm::vec3 BoxMax;
+	};
+
+	struct WorldBounds
+	{
+		glm::vec4 Sphere; // World space centre and radius.
+		glm::vec3 BoxCenter;
+		glm::vec3 BoxAxes[3]; // World space half extent vectors of the oriented box.
+	};
+
+	class BoundingVolume
+	{
+	public:
+		// Ritter's sphere, falling back to the box centred sphere when that is tighter, plus the axis aligned box.
+		EXPORT static LocalBounds Calculate(const VertexData& positions);
+
+		// Applies the full transform, so rotated and non-uniformly scaled instances keep tight bounds.
+		EXPORT static WorldBounds Transform(const LocalBounds& bounds, const glm::mat4& transform);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "CellStreamer.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace Engine
+{
+	float GetDistanceToBounds(const glm::vec3& position, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+	{
+		glm::vec3 closest = glm::clamp(position, boundsMin, boundsMax);
+		return glm::length(position - closest);
+	}
+
+	CellStreamer::CellStreamer(float loadDistance, float unloadDistance, uint64_t memoryBudget, uint32_t maxConcurrentLoads)
+		: m_cells()
+		, m_queue()
+		, m_loadDistance(loadDistance)
+		, m_unloadDistance(std::max(loadDistance, unloadDistance))
+		, m_memoryBudget(memoryBudget)
+		, m_maxConcurrentLoads(std::max(maxConcurrentLoads, 1u))
+		, m_loadingCount(0)
+		, m_loadingBytes(0)
+		, m_residentBytes(0)
+	{
+	}
+
+	void CellStreamer::SetDistances(float loadDistance, float unloadDistance)
+	{
+		m_loadDistance = loadDistance;
+		m_unloadDistance = std::max(loadDistance, unloadDistance);
+	}
+
+	void CellStreamer::SetMemoryBudget(uint64_t memoryBudget)
+	{
+		m_memoryBudget = memoryBudget;
+	}
+
+	void CellStreamer::SetMaxConcurrentLoads(uint32_t maxConcurrentLoads)
+	{
+		m_maxConcurrentLoads = std::max(maxConcurrentLoads, 1u);
+	}
+
+	uint32_t CellStreamer::AddCell(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint64_t byteSize)
+	{
+		m_cells.push_back({ boundsMin, boundsMax, byteSize, CellState::Unloaded, 0.0f });
+		return static_cast<uint32_t>(m_cells.size() - 1);
+	}
+
+	void CellStreamer::Clear()
+	{
+		m_cells.clear();
+		m_queue.clear();
+		m_loadingCount = 0;
+		m_loadingBytes = 0;
+		m_residentBytes = 0;
+	}
+
+	void CellStreamer::Unload(uint32_t cellIndex, std::vector<uint32_t>& unloadRequests)
+	{
+		StreamingCell& cell = m_cells[cellIndex];
+		m_residentBytes -= cell.ByteSize;
+		cell.State = CellState::Unloaded;
+		unloadRequests.push_back(cellIndex);
+	}
+
+	void CellStreamer::Update(const glm::vec3& position, std::vector<uint32_t>& loadRequests, std::vector<uint32_t>& unloadRequests)
+	{
+		for (uint32_t i = 0; i < m_cells.size(); ++i)
+		{
+			StreamingCell& cell = m_cells[i];
+			cell.Distance = GetDistanceToBounds(position, cell.BoundsMin, cell.BoundsMax);
+
+			if (cell.State == CellState::Resident && cell.Distance > m_unloadDistance)
+			{
+				Unload(i, unloadRequests);
+			}
+			else if (cell.State == CellState::Unloaded && cell.Distance <= m_loadDistance)
+			{
+				cell.State = CellState::Queued;
+				m_queue.push_back(i);
+			}
+		}
+
+		// Queued cells the viewer has moved away from are dropped, loads already in progress are left to complete.
+		std::erase_if(m_queue, [this](uint32_t cellIndex)
+			{
+				StreamingCell& cell = m_cells[cellIndex];
+				if (cell.Distance <= m_unloadDistance)
+					return false;
+
+				cell.State = CellState::Unloaded;
+				return true;
+			});
+
+		std::stable_sort(m_queue.begin(), m_queue.end(), [this](uint32_t a, uint32_t b) { return m_cells[a].Distance < m_cells[b].Distance; });
+
+		size_t issued = 0;
+		while (issued < m_queue.size() && m_loadingCount < m_maxConcurrentLoads)
+		{
+			uint32_t cellIndex = m_queue[issued];
+			StreamingCell& cell = m_cells[cellIndex];
+
+			// Over budget, make room by evicting resident cells outside the load distance that are further away than this one.
+			while (m_residentBytes + m_loadingBytes + cell.ByteSize > m_memoryBudget)
+			{
+				uint32_t evictIndex = static_cast<uint32_t>(m_cells.size());
+				for (uint32_t i = 0; i < m_cells.size(); ++i)
+				{
+					const StreamingCell& candidate = m_cells[i];
+					if (candidate.State != CellState::Resident || candidate.Distance <= m_loadDistance || candidate.Distance <= cell.Distance)
+						continue;
+
+					if (evictIndex == m_cells.size() || candidate.Distance > m_cells[evictIndex].Distance)
+						evictIndex = i;
+				}
+
+				if (evictIndex == m_cells.size())
+					break;
+
+				Unload(evictIndex, unloadRequests);
+			}
+
+			// The nearest cell does not fit, leave it and everything behind it queued until memory is released.
+			if (m_residentBytes + m_loadingBytes + cell.ByteSize > m_memoryBudget)
+				break;
+
+			cell.State = CellState::Loading;
+			++m_loadingCount;
+			m_loadingBytes += cell.ByteSize;
+			loadRequests.push_back(cellIndex);
+			++issued;
+		}
+
+		m_queue.erase(m_queue.begin(), m_queue.begin() + issued);
+	}
+
+	void CellStreamer::CompleteLoad(uint32_t cellIndex, bool success)
+	{
+		StreamingCell& cell = m_cells[cellIndex];
+		if (cell.State != CellState::Loading)
+		{
+			Logger::Error("Cell {} completed a load that was not requested.", cellIndex);
+			return;
+		}
+
+		--m_loadingCount;
+		m_loadingBytes -= cell.ByteSize;
+
+		if (success)
+		{
+			cell.State = CellState::Resident;
+			m_residentBytes += cell.ByteSize;
+		}
+		else
+		{
+			cell.State = CellState::Unloaded;
+		}
+	}
+
+	CellStreamingStats CellStreamer::GetStats() const
+	{
+		CellStreamingStats stats = {};
+		stats.QueueDepth = static_cast<uint32_t>(m_queue.size());
+		stats.LoadingCount = m_loadingCount;
+		stats.ResidentBytes = m_residentBytes;
+		for (const StreamingCell& cell : m_cells)
+		{
+			if (cell.State == CellState::Resident)
+				++stats.ResidentCount;
+		}
+
+		return stats;
+	}
+
+	std::vector<CellStreamingStep> CellStreamer::Simulate(CellStreamer& streamer, const std::vector<glm::vec3>& path, uint32_t loadLatency)
+	{
+		std::vector<CellStreamingStep> steps;
+		steps.reserve(path.size());
+
+		std::vector<std::pair<uint32_t, uint32_t>> inFlight;
+		uint64_t peakResidentBytes = 0;
+
+		for (size_t step = 0; step < path.size(); ++step)
+		{
+			for (auto it = inFlight.begin(); it != inFlight.end();)
+			{
+				if (it->second > 0 && --it->second > 0)
+				{
+					++it;
+					continue;
+				}
+
+				streamer.CompleteLoad(it->first, true);
+				it = inFlight.erase(it);
+			}
+
+			CellStreamingStep& streamingStep = steps.emplace_back();
+			std::vector<uint32_t>& loadRequests = streamingStep.LoadRequests;
+			std::vector<uint32_t>& unloadRequests = streamingStep.UnloadRequests;
+			streamer.Update(path[step], loadRequests, unloadRequests);
+
+			for (uint32_t cellIndex : loadRequests)
+				inFlight.emplace_back(cellIndex, loadLatency);
+
+			const CellStreamingStats& stats = streamingStep.Stats = streamer.GetStats();
+			peakResidentBytes = std::max(peakResidentBytes, stats.ResidentBytes);
+
+			Logger::Verbose("Streaming step {} - queue depth {}, loading {}, resident {} cells ({} bytes), {} loads and {} unloads issued.",
+				step, stats.QueueDepth, stats.LoadingCount, stats.ResidentCount, stats.ResidentBytes, loadRequests.size(), unloadRequests.size());
+		}
+
+		Logger::Verbose("Streaming simulation finished - {} steps, peak resident {} bytes of {} budget.",
+			path.size(), peakResidentBytes, streamer.GetMemoryBudget());
+
+		return steps;
+	}
+}
\ No newline at end of file
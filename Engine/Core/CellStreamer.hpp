@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Macros.hpp"
+#include <glm/glm.hpp>
+#include <stdint.h>
+#include <vector>
+
+namespace Engine
+{
+	enum class CellState
+	{
+		Unloaded,
+		Queued,
+		Loading,
+		Resident
+	};
+
+	struct StreamingCell
+	{
+		glm::vec3 BoundsMin;
+		glm::vec3 BoundsMax;
+		uint64_t ByteSize;
+		CellState State;
+		float Distance;
+	};
+
+	struct CellStreamingStats
+	{
+		uint32_t QueueDepth;
+		uint32_t LoadingCount;
+		uint32_t ResidentCount;
+		uint64_t ResidentBytes;
+	};
+
+	struct CellStreamingStep
+	{
+		CellStreamingStats Stats;
+		std::vector<uint32_t> LoadRequests;
+		std::vector<uint32_t> UnloadRequests;
+	};
+
+	// Decides which world partition cells should be resident for a viewer position.
+	// Cells load inside the load distance and only unload beyond the larger unload distance, so a viewer moving along
+	// a cell border does not thrash. Holds no resources itself, so the scheduling can be exercised entirely on the CPU.
+	class CellStreamer
+	{
+	public:
+		EXPORT CellStreamer(float loadDistance = 100.0f, float unloadDistance = 150.0f, uint64_t memoryBudget = 1ull << 30, uint32_t maxConcurrentLoads = 2);
+
+		EXPORT void SetDistances(float loadDistance, float unloadDistance);
+		EXPORT void SetMemoryBudget(uint64_t memoryBudget);
+		EXPORT void SetMaxConcurrentLoads(uint32_t maxConcurrentLoads);
+
+		EXPORT uint32_t AddCell(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint64_t byteSize);
+		EXPORT void Clear();
+
+		// Returns the cells that should start loading and the resident cells that should be released.
+		EXPORT void Update(const glm::vec3& position, std::vector<uint32_t>& loadRequests, std::vector<uint32_t>& unloadRequests);
+
+		// Called when a load requested by Update has finished, failed loads return the cell to the unloaded state.
+		EXPORT void CompleteLoad(uint32_t cellIndex, bool success);
+
+		EXPORT CellStreamingStats GetStats() const;
+
+		// Drives the streamer along a scripted path, completing each load the given number of updates after it was requested.
+		// Returns the stats and the requests issued at every step of the path.
+		EXPORT static std::vector<CellStreamingStep> Simulate(CellStreamer& streamer, const std::vector<glm::vec3>& path, uint32_t loadLatency);
+
+		inline const std::vector<StreamingCell>& GetCells() const { return m_cells; }
+		inline uint64_t GetMemoryBudget() const { return m_memoryBudget; }
+
+	private:
+		void Unload(uint32_t cellIndex, std::vector<uint32_t>& unloadRequests);
+
+		std::vector<StreamingCell> m_cells;
+		std::vector<uint32_t> m_queue;
+		float m_loadDistance;
+		float m_unloadDistance;
+		uint64_t m_memoryBudget;
+		uint32_t m_maxConcurrentLoads;
+		uint32_t m_loadingCount;
+		uint64_t m_loadingBytes;
+		uint64_t m_residentBytes;
+	};
+}
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include "Logger.hpp"
 #include <fstream>
 #include <chrono>
+#include <algorithm>
 #include <lz4.h>
+#include <meshoptimizer.h>
 
 namespace Engine
 {
@@ -19,15 +21,65 @@ namespace Engine
 	inline void CompressData(const char* source, size_t size, std::vector<char>& outputBuffer, int32_t& compressedSize)
 	{
 		const int32_t maxSize = LZ4_compressBound(static_cast<int32_t>(size));
-		if (outputBuffer.size() < maxSize)
+		if (outputBuffer.size() < static_cast<size_t>(maxSize))
 			outputBuffer.resize(maxSize);
 
 		compressedSize = LZ4_compress_default(source, outputBuffer.data(), static_cast<int32_t>(size), maxSize);
 	}
 
+	inline void EncodeData(const char* source, const ChunkMemoryEntry& entry, std::vector<char>& outputBuffer, int32_t& compressedSize)
+	{
+		switch (entry.Compression)
+		{
+		case ChunkCompression::VertexCodec:
+		case ChunkCompression::VertexCodecExp:
+		{
+			size_t vertexCount = entry.Size / entry.ElementSize;
+			const void* vertices = source;
+
+			std::vector<uint32_t> filteredData;
+			if (entry.Compression == ChunkCompression::VertexCodecExp)
+			{
+				filteredData.resize(entry.Size / sizeof(uint32_t));
+				meshopt_encodeFilterExp(filteredData.data(), vertexCount, entry.ElementSize, entry.FilterBits,
+					reinterpret_cast<const float*>(source), meshopt_EncodeExpSharedVector);
+				vertices = filteredData.data();
+			}
+
+			size_t maxSize = meshopt_encodeVertexBufferBound(vertexCount, entry.ElementSize);
+			if (outputBuffer.size() < maxSize)
+				outputBuffer.resize(maxSize);
+
+			compressedSize = static_cast<int32_t>(meshopt_encodeVertexBuffer(reinterpret_cast<unsigned char*>(outputBuffer.data()),
+				maxSize, vertices, vertexCount, entry.ElementSize));
+		}
+		break;
+
+		case ChunkCompression::IndexCodec:
+		{
+			const uint32_t* indices = reinterpret_cast<const uint32_t*>(source);
+			size_t indexCount = entry.Size / sizeof(uint32_t);
+			size_t vertexCount = indexCount == 0 ? 0 : static_cast<size_t>(*std::max_element(indices, indices + indexCount)) + 1;
+
+			size_t maxSize = meshopt_encodeIndexBufferBound(indexCount, vertexCount);
+			if (outputBuffer.size() < maxSize)
+				outputBuffer.resize(maxSize);
+
+			compressedSize = static_cast<int32_t>(meshopt_encodeIndexBuffer(reinterpret_cast<unsigned char*>(outputBuffer.data()),
+				maxSize, indices, indexCount));
+		}
+		break;
+
+		default:
+			CompressData(source, entry.Size, outputBuffer, compressedSize);
+			break;
+		}
+	}
+
 	bool ChunkData::WriteToFile(const std::filesystem::path& path, AsyncData* asyncData) const
 	{
 		auto writeStartTime = std::chrono::high_resolution_clock::now();
+		const char* memoryData = reinterpret_cast<const char*>(m_memory.data());
 
 		size_t resourceCount = m_genericDataMap.size() + m_imageData.size() + m_vertexDataMap.size();
 		if (resourceCount == 0)
@@ -44,23 +96,42 @@ namespace Engine
 		}
 
 		std::vector<char> compressionBuffer;
+		std::vector<char> comparisonBuffer;
 		int32_t compressedSize = 0;
+		int32_t comparisonSize = 0;
+
+		// Track how the mesh codecs compare against plain LZ4 on the same data.
+		uint64_t meshRawSize = 0;
+		uint64_t meshEncodedSize = 0;
+		uint64_t meshLZ4Size = 0;
+		auto trackMeshEncoding = [&](const ChunkMemoryEntry& entry)
+		{
+			if (entry.Compression == ChunkCompression::LZ4)
+				return;
+
+			CompressData(memoryData + entry.Offset, entry.Size, comparisonBuffer, comparisonSize);
+			meshRawSize += entry.Size;
+			meshEncodedSize += compressedSize;
+			meshLZ4Size += comparisonSize;
+		};
 
 		ChunkHeader header{};
 		header.ResourceCount = static_cast<uint32_t>(resourceCount);
 		stream.write(reinterpret_cast<const char*>(&header), sizeof(ChunkHeader));
-		const char* memoryData = reinterpret_cast<const char*>(m_memory.data());
 
 		float subTicks = 500.0f / static_cast<float>(m_genericDataMap.size()) / 3.0f;
 		for (const auto& data : m_genericDataMap)
 		{
-			CompressData(memoryData + data.second.Offset, data.second.Size, compressionBuffer, compressedSize);
+			EncodeData(memoryData + data.second.Offset, data.second, compressionBuffer, compressedSize);
+			trackMeshEncoding(data.second);
 
 			ChunkResourceHeader resourceHeader;
 			resourceHeader.Identifier = data.first;
 			resourceHeader.ResourceType = ChunkResourceType::Generic;
 			resourceHeader.ResourceSize = compressedSize;
 			resourceHeader.UncompressedSize = data.second.Size;
+			resourceHeader.Compression = data.second.Compression;
+			resourceHeader.ElementSize = data.second.ElementSize;
 			stream.write(reinterpret_cast<const char*>(&resourceHeader), sizeof(ChunkResourceHeader));
 			stream.write(compressionBuffer.data(), compressedSize);
 
@@ -71,12 +142,15 @@ namespace Engine
 		subTicks = 500.0f / static_cast<float>(m_vertexDataMap.size()) / 3.0f;
 		for (const auto& data : m_vertexDataMap)
 		{
-			CompressData(memoryData + data.second.Offset, data.second.Size, compressionBuffer, compressedSize);
+			EncodeData(memoryData + data.second.Offset, data.second, compressionBuffer, compressedSize);
+			trackMeshEncoding(data.second);
 
 			ChunkResourceHeader resourceHeader;
 			resourceHeader.ResourceType = ChunkResourceType::VertexBuffer;
 			resourceHeader.ResourceSize = compressedSize;
 			resourceHeader.UncompressedSize = data.second.Size;
+			resourceHeader.Compression = data.second.Compression;
+			resourceHeader.ElementSize = data.second.ElementSize;
 			stream.write(reinterpret_cast<const char*>(&resourceHeader), sizeof(ChunkResourceHeader));
 			VertexBufferHeader vertexHeader;
 			vertexHeader.Type = data.first;
@@ -96,6 +170,8 @@ namespace Engine
 			resourceHeader.ResourceType = ChunkResourceType::Image;
 			resourceHeader.ResourceSize = compressedSize;
 			resourceHeader.UncompressedSize = data.Entry.Size;
+			resourceHeader.Compression = ChunkCompression::LZ4;
+			resourceHeader.ElementSize = 0;
 			stream.write(reinterpret_cast<const char*>(&resourceHeader), sizeof(ChunkResourceHeader));
 			stream.write(reinterpret_cast<const char*>(&data.Header), sizeof(ImageHeader));
 			stream.write(compressionBuffer.data(), compressedSize);
@@ -112,18 +188,63 @@ namespace Engine
 		float saveDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(writeEndTime - writeStartTime).count();
 		Logger::Verbose("Chunk saved to disk in {} seconds.", saveDeltaTime);
 
+		if (meshRawSize > 0)
+		{
+			Logger::Verbose("Mesh data encoded from {} to {} bytes with meshopt codecs, LZ4 alone produces {} bytes.",
+				meshRawSize, meshEncodedSize, meshLZ4Size);
+		}
+
 		return success;
 	}
 
-	void ChunkData::Decompress(const ChunkMemoryEntry& entry, std::vector<uint8_t>& decompressBuffer) const
+	bool ChunkData::Decompress(const ChunkMemoryEntry& entry, std::vector<uint8_t>& decompressBuffer) const
 	{
 		// Consider doing decompression on the GPU instead - worth it?
 		if (decompressBuffer.size() < entry.UncompressedSize)
 			decompressBuffer.resize(entry.UncompressedSize);
 
-		LZ4_decompress_safe(reinterpret_cast<const char*>(m_memory.data() + entry.Offset),
-			reinterpret_cast<char*>(decompressBuffer.data()), static_cast<int32_t>(entry.Size),
-			static_cast<int32_t>(entry.UncompressedSize));
+		const uint8_t* source = m_memory.data() + entry.Offset;
+
+		switch (entry.Compression)
+		{
+		case ChunkCompression::VertexCodec:
+		case ChunkCompression::VertexCodecExp:
+		{
+			size_t vertexCount = entry.UncompressedSize / entry.ElementSize;
+			if (meshopt_decodeVertexBuffer(decompressBuffer.data(), vertexCount, entry.ElementSize, source, entry.Size) != 0)
+			{
+				Logger::Error("Failed to decode vertex data from chunk.");
+				return false;
+			}
+
+			if (entry.Compression == ChunkCompression::VertexCodecExp)
+				meshopt_decodeFilterExp(decompressBuffer.data(), vertexCount, entry.ElementSize);
+		}
+		break;
+
+		case ChunkCompression::IndexCodec:
+		{
+			size_t indexCount = entry.UncompressedSize / sizeof(uint32_t);
+			if (meshopt_decodeIndexBuffer(decompressBuffer.data(), indexCount, sizeof(uint32_t), source, entry.Size) != 0)
+			{
+				Logger::Error("Failed to decode index data from chunk.");
+				return false;
+			}
+		}
+		break;
+
+		default:
+			if (LZ4_decompress_safe(reinterpret_cast<const char*>(source),
+				reinterpret_cast<char*>(decompressBuffer.data()), static_cast<int32_t>(entry.Size),
+				static_cast<int32_t>(entry.UncompressedSize)) < 0)
+			{
+				Logger::Error("Failed to decompress data from chunk.");
+				return false;
+			}
+			break;
+		}
+
+		return true;
 	}
 
 	bool ChunkData::Parse(const std::filesystem::path& path, AsyncData* asyncData)
@@ -183,7 +304,8 @@ namespace Engine
 			{
 			case ChunkResourceType::Generic:
 			{
-				m_genericDataMap[resource->Identifier] = ChunkMemoryEntry(dataIndex, resource->ResourceSize, resource->UncompressedSize);
+				m_genericDataMap[resource->Identifier] = ChunkMemoryEntry(dataIndex, resource->ResourceSize, resource->UncompressedSize,
+					resource->Compression, resource->ElementSize);
 				dataIndex += resource->ResourceSize;
 			}
 			break;
@@ -193,7 +315,8 @@ namespace Engine
 				VertexBufferHeader* vertexData = reinterpret_cast<VertexBufferHeader*>(m_memory.data() + dataIndex);
 				dataIndex += sizeof(VertexBufferHeader);
 
-				m_vertexDataMap[vertexData->Type] = ChunkMemoryEntry(dataIndex, resource->ResourceSize, resource->UncompressedSize);
+				m_vertexDataMap[vertexData->Type] = ChunkMemoryEntry(dataIndex, resource->ResourceSize, resource->UncompressedSize,
+					resource->Compression, resource->ElementSize);
 				dataIndex += resource->ResourceSize;
 			}
 			break;
@@ -243,16 +366,24 @@ namespace Engine
 		return false;
 	}
 
-	void ChunkData::SetVertexData(VertexBufferType type, const std::span<uint8_t>& data)
+	void ChunkData::SetVertexData(VertexBufferType type, const std::span<uint8_t>& data, uint32_t elementSize, int32_t filterBits)
 	{
 		if (m_vertexDataMap.contains(type))
 		{
 			Logger::Warning("Replacing existing vertex type '{}' in ChunkData.", static_cast<uint32_t>(type));
 		}
 
+		ChunkCompression compression = filterBits > 0 ? ChunkCompression::VertexCodecExp : ChunkCompression::VertexCodec;
+		if (elementSize == 0 || elementSize % 4 != 0 || elementSize > 256)
+		{
+			Logger::Warning("Vertex type '{}' has an element size unsupported by the vertex codec, falling back to LZ4.", static_cast<uint32_t>(type));
+			compression = ChunkCompression::LZ4;
+		}
+
 		uint64_t offset = m_memory.size();
 		m_memory.insert(m_memory.end(), data.begin(), data.end());
-		m_vertexDataMap[type] = ChunkMemoryEntry(offset, data.size());
+		ChunkMemoryEntry& entry = m_vertexDataMap[type] = ChunkMemoryEntry(offset, data.size(), 0, compression, elementSize);
+		entry.FilterBits = filterBits;
 	}
 
 	bool ChunkData::GetGenericData(uint32_t identifier, ChunkMemoryEntry& data)
@@ -267,7 +398,7 @@ namespace Engine
 		return false;
 	}
 
-	void ChunkData::SetGenericData(uint32_t identifier, const std::span<uint8_t>& data)
+	void ChunkData::SetGenericData(uint32_t identifier, const std::span<uint8_t>& data, ChunkCompression compression)
 	{
 		if (m_genericDataMap.contains(identifier))
 		{
@@ -276,7 +407,8 @@ namespace Engine
 
 		uint64_t offset = m_memory.size();
 		m_memory.insert(m_memory.end(), data.begin(), data.end());
-		m_genericDataMap[identifier] = ChunkMemoryEntry(offset, data.size());
+		uint32_t elementSize = compression == ChunkCompression::IndexCodec ? sizeof(uint32_t) : 0;
+		m_genericDataMap[identifier] = ChunkMemoryEntry(offset, data.size(), 0, compression, elementSize);
 	}
 
 	bool ChunkData::GetImageData(std::vector<ImageData>** imageData)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ChunkTypeInfo.hpp"
+#include "Macros.hpp"
 #include <filesystem>
 #include <unordered_map>
 #include <vector>
@@ -15,18 +16,28 @@ namespace Engine
 		uint64_t Offset;
 		uint64_t Size;
 		uint64_t UncompressedSize;
+		ChunkCompression Compression;
+		uint32_t ElementSize;
+		int32_t FilterBits;
 
 		ChunkMemoryEntry()
 			: Offset(0)
 			, Size(0)
 			, UncompressedSize(0)
+			, Compression(ChunkCompression::LZ4)
+			, ElementSize(0)
+			, FilterBits(0)
 		{
 		}
 
-		ChunkMemoryEntry(uint64_t offset, size_t size, size_t uncompressedSize = 0)
+		ChunkMemoryEntry(uint64_t offset, size_t size, size_t uncompressedSize = 0,
+			ChunkCompression compression = ChunkCompression::LZ4, uint32_t elementSize = 0)
 			: Offset(offset)
 			, Size(size)
 			, UncompressedSize(uncompressedSize)
+			, Compression(compression)
+			, ElementSize(elementSize)
+			, FilterBits(0)
 		{
 		}
 	};
@@ -51,25 +62,29 @@ namespace Engine
 	class ChunkData
 	{
 	public:
-		ChunkData();
+		EXPORT ChunkData();
 
-		bool WriteToFile(const std::filesystem::path& path, AsyncData* asyncData) const;
-		bool Parse(const std::filesystem::path& path, AsyncData* asyncData);
+		EXPORT bool WriteToFile(const std::filesystem::path& path, AsyncData* asyncData) const;
+		EXPORT bool Parse(const std::filesystem::path& path, AsyncData* asyncData);
 
-		bool GetVertexData(VertexBufferType type, ChunkMemoryEntry& data);
-		void SetVertexData(VertexBufferType type, const std::span<uint8_t>& data);
+		EXPORT bool GetVertexData(VertexBufferType type, ChunkMemoryEntry& data);
 
-		bool GetGenericData(uint32_t identifier, ChunkMemoryEntry& data);
-		void SetGenericData(uint32_t identifier, const std::span<uint8_t>& data);
+		// Vertex data is stored with the meshopt vertex codec. A non-zero filter bit count applies the lossy
+		// exponent filter to the float components first, which improves the compression ratio substantially.
+		EXPORT void SetVertexData(VertexBufferType type, const std::span<uint8_t>& data, uint32_t elementSize, int32_t filterBits = 0);
+
+		EXPORT bool GetGenericData(uint32_t identifier, ChunkMemoryEntry& data);
+		EXPORT void SetGenericData(uint32_t identifier, const std::span<uint8_t>& data,
+			ChunkCompression compression = ChunkCompression::LZ4);
 
 		bool GetImageData(std::vector<ImageData>** imageData);
 		void AddImageData(const ImageHeader& image, const std::vector<std::vector<uint8_t>>& mipMaps);
 
 		bool LoadedFromDisk() const;
 
-		void Decompress(const ChunkMemoryEntry& entry, std::vector<uint8_t>& decompressBuffer) const;
+		EXPORT bool Decompress(const ChunkMemoryEntry& entry, std::vector<uint8_t>& decompressBuffer) const;
 
-		inline const std::span<const uint8_t>& GetSpan(const ChunkMemoryEntry& data) const
+		inline std::span<const uint8_t> GetSpan(const ChunkMemoryEntry& data) const
 		{
 			return std::span<const uint8_t>(m_memory.begin() + data.Offset, data.Size);
 		}
@@ -11,6 +11,14 @@ namespace Engine
 		Image
 	};
 
+	enum class ChunkCompression : uint16_t
+	{
+		LZ4,
+		VertexCodec, // meshopt vertex codec, element size must be a multiple of 4.
+		VertexCodecExp, // meshopt vertex codec applied to exponent filtered float data.
+		IndexCodec // meshopt index codec, data must be a 32-bit triangle list.
+	};
+
 	enum class VertexBufferType
 	{
 		Positions,
@@ -21,7 +29,7 @@ namespace Engine
 	};
 
 	const uint64_t HeaderMagic = 0x3285130105;
-	const uint16_t CurrentVersion = 1;
+	const uint16_t CurrentVersion = 7;
 
 	struct ChunkHeader
 	{
@@ -36,6 +44,8 @@ namespace Engine
 		uint16_t Identifier;
 		uint64_t ResourceSize;
 		uint64_t UncompressedSize;
+		ChunkCompression Compression;
+		uint32_t ElementSize;
 	};
 
 	struct VertexBufferHeader
@@ -1,5 +1,3 @@
-#pragma once
-
 #include "Colour.hpp"
 #include <algorithm>
 
@@ -0,0 +1,167 @@
+#include "FreeListAllocator.hpp"
+#include "Logger.hpp"
+
+namespace Engine
+{
+	FreeListAllocator::FreeListAllocator(uint64_t capacity)
+		: m_capacity(0)
+		, m_usedSize(0)
+		, m_freeBlocks()
+		, m_freeBlocksBySize()
+		, m_allocations()
+	{
+		Reset(capacity);
+	}
+
+	uint64_t FreeListAllocator::Allocate(uint64_t size)
+	{
+		if (size == 0)
+			return InvalidOffset;
+
+		auto sizeIt = m_freeBlocksBySize.lower_bound(size);
+		if (sizeIt == m_freeBlocksBySize.end())
+			return InvalidOffset;
+
+		uint64_t blockOffset = sizeIt->second;
+		uint64_t blockSize = sizeIt->first;
+		EraseFreeBlock(m_freeBlocks.find(blockOffset));
+
+		if (blockSize > size)
+			InsertFreeBlock(blockOffset + size, blockSize - size);
+
+		m_allocations[blockOffset] = size;
+		m_usedSize += size;
+		return blockOffset;
+	}
+
+	bool FreeListAllocator::Free(uint64_t offset)
+	{
+		const auto& allocation = m_allocations.find(offset);
+		if (allocation == m_allocations.end())
+		{
+			Logger::Error("Attempted to free an unknown allocation at offset {}.", offset);
+			return false;
+		}
+
+		uint64_t size = allocation->second;
+		m_allocations.erase(allocation);
+		m_usedSize -= size;
+
+		// Merge with the following block.
+		auto next = m_freeBlocks.find(offset + size);
+		if (next != m_freeBlocks.end())
+		{
+			size += next->second;
+			EraseFreeBlock(next);
+		}
+
+		// Merge with the preceding block.
+		auto previous = m_freeBlocks.lower_bound(offset);
+		if (previous != m_freeBlocks.begin())
+		{
+			--previous;
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				EraseFreeBlock(previous);
+			}
+		}
+
+		InsertFreeBlock(offset, size);
+		return true;
+	}
+
+	void FreeListAllocator::Grow(uint64_t capacity)
+	{
+		if (capacity <= m_capacity)
+			return;
+
+		uint64_t offset = m_capacity;
+		uint64_t size = capacity - m_capacity;
+
+		// Extend a free block ending at the old capacity instead of fragmenting the tail.
+		if (!m_freeBlocks.empty())
+		{
+			auto last = std::prev(m_freeBlocks.end());
+			if (last->first + last->second == m_capacity)
+			{
+				offset = last->first;
+				size += last->second;
+				EraseFreeBlock(last);
+			}
+		}
+
+		InsertFreeBlock(offset, size);
+		m_capacity = capacity;
+	}
+
+	void FreeListAllocator::Reset(uint64_t capacity)
+	{
+		m_freeBlocks.clear();
+		m_freeBlocksBySize.clear();
+		m_allocations.clear();
+		m_usedSize = 0;
+		m_capacity = capacity;
+
+		if (capacity > 0)
+			InsertFreeBlock(0, capacity);
+	}
+
+	uint64_t FreeListAllocator::GetLargestFreeBlock() const
+	{
+		return m_freeBlocksBySize.empty() ? 0 : std::prev(m_freeBlocksBySize.end())->first;
+	}
+
+	bool FreeListAllocator::Validate() const
+	{
+		std::map<uint64_t, uint64_t> ranges(m_freeBlocks.begin(), m_freeBlocks.end());
+		for (const auto& allocation : m_allocations)
+		{
+			if (!ranges.emplace(allocation.first, allocation.second).second)
+				return false;
+		}
+
+		if (m_freeBlocks.size() != m_freeBlocksBySize.size())
+			return false;
+
+		uint64_t expectedOffset = 0;
+		bool previousFree = false;
+		for (const auto& range : ranges)
+		{
+			if (range.first != expectedOffset)
+				return false;
+
+			// Adjacent free blocks should always have been merged.
+			bool free = m_freeBlocks.contains(range.first) && !m_allocations.contains(range.first);
+			if (free && previousFree)
+				return false;
+
+			previousFree = free;
+			expectedOffset += range.second;
+		}
+
+		return expectedOffset == m_capacity;
+	}
+
+	void FreeListAllocator::InsertFreeBlock(uint64_t offset, uint64_t size)
+	{
+		m_freeBlocks[offset] = size;
+		m_freeBlocksBySize.emplace(size, offset);
+	}
+
+	void FreeListAllocator::EraseFreeBlock(std::map<uint64_t, uint64_t>::iterator it)
+	{
+		auto range = m_freeBlocksBySize.equal_range(it->second);
+		for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt)
+		{
+			if (sizeIt->second == it->first)
+			{
+				m_freeBlocksBySize.erase(sizeIt);
+				break;
+			}
+		}
+
+		m_freeBlocks.erase(it);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Macros.hpp"
+#include <stdint.h>
+#include <stddef.h>
+#include <map>
+#include <unordered_map>
+
+namespace Engine
+{
+	// Best fit range allocator over an abstract address space, free neighbours are coalesced on release.
+	// Holds no memory itself, so it can sub-allocate GPU buffers and be exercised entirely on the CPU.
+	class FreeListAllocator
+	{
+	public:
+		static constexpr uint64_t InvalidOffset = ~0ull;
+
+		EXPORT FreeListAllocator(uint64_t capacity = 0);
+
+		EXPORT uint64_t Allocate(uint64_t size);
+		EXPORT bool Free(uint64_t offset);
+		EXPORT void Grow(uint64_t capacity);
+		EXPORT void Reset(uint64_t capacity);
+
+		EXPORT uint64_t GetLargestFreeBlock() const;
+
+		// Checks that free blocks and allocations exactly tile the capacity without overlapping.
+		EXPORT bool Validate() const;
+
+		inline uint64_t GetCapacity() const { return m_capacity; }
+		inline uint64_t GetUsedSize() const { return m_usedSize; }
+		inline uint64_t GetFreeSize() const { return m_capacity - m_usedSize; }
+		inline size_t GetAllocationCount() const { return m_allocations.size(); }
+		inline size_t GetFreeBlockCount() const { return m_freeBlocks.size(); }
+
+	private:
+		void InsertFreeBlock(uint64_t offset, uint64_t size);
+		void EraseFreeBlock(std::map<uint64_t, uint64_t>::iterator it);
+
+		uint64_t m_capacity;
+		uint64_t m_usedSize;
+		std::map<uint64_t, uint64_t> m_freeBlocks; // offset -> size
+		std::multimap<uint64_t, uint64_t> m_freeBlocksBySize; // size -> offset
+		std::unordered_map<uint64_t, uint64_t> m_allocations; // offset -> size
+	};
+}
\ No newline at end of file
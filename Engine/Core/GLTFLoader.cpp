@@ -3,6 +3,7 @@
 #include "AsyncData.hpp"
 #include "Rendering/Resources/GeometryBatch.hpp"
 #include "VertexData.hpp"
+#include "TangentCalculator.hpp"
 #include "Image.hpp"
 #include "Colour.hpp"
 #include <glm/gtx/quaternion.hpp>
@@ -10,6 +11,7 @@
 #include <chrono>
 #include <unordered_map>
 #include <stdint.h>
+#include <cassert>
 #include <execution>
 #include <glm/gtc/type_ptr.hpp>
 #include <fastgltf/core.hpp>
@@ -22,13 +24,13 @@ namespace Engine
 	struct ImportState
 	{
 		const fastgltf::Asset* asset;
-		GeometryBatch& geometryBatch;
+		const GLTFLoader::BatchSelector& batchSelector;
 		std::vector<std::shared_ptr<Image>> loadedImages;
 		std::unordered_map<size_t, VertexData> bufferMap;
 		std::unordered_map<size_t, std::vector<uint32_t>> indexBufferMap;
 
-		ImportState(const fastgltf::Asset* asset, GeometryBatch& geometryBatch)
-			: geometryBatch(geometryBatch)
+		ImportState(const fastgltf::Asset* asset, const GLTFLoader::BatchSelector& batchSelector)
+			: batchSelector(batchSelector)
 			, asset(asset)
 			, bufferMap()
 			, indexBufferMap()
@@ -43,7 +45,6 @@ namespace Engine
 		std::vector<T> data;
 		data.resize(accessor.count);
 
-		int32_t byteStride = fastgltf::getComponentBitSize(accessor.componentType);
 		const fastgltf::sources::Array* bufferData = std::get_if<fastgltf::sources::Array>(&buffer.data);
 
 		memcpy(data.data(), bufferData->bytes.data() + bufferView.byteOffset + accessor.byteOffset, accessor.count * sizeof(std::decay_t<T>));
@@ -70,6 +71,30 @@ namespace Engine
 		}
 	}
 
+	// Positions are mirrored on X when converted to left handed, match that so the bounds agree with the rendered mesh.
+	void GetWorldBounds(const VertexData& positions, const glm::mat4& transform, glm::vec3& boundsMin, glm::vec3& boundsMax)
+	{
+		glm::vec3 localMin(std::numeric_limits<float>::max());
+		glm::vec3 localMax(std::numeric_limits<float>::lowest());
+		const glm::vec3* vertices = positions.GetData<glm::vec3>();
+		for (uint32_t i = 0; i < positions.GetCount(); ++i)
+		{
+			glm::vec3 position(-vertices[i].x, vertices[i].y, vertices[i].z);
+			localMin = glm::min(localMin, position);
+			localMax = glm::max(localMax, position);
+		}
+
+		boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			glm::vec3 corner((i & 1) ? localMax.x : localMin.x, (i & 2) ? localMax.y : localMin.y, (i & 4) ? localMax.z : localMin.z);
+			glm::vec3 worldCorner = glm::vec3(transform * glm::vec4(corner, 1.0f));
+			boundsMin = glm::min(boundsMin, worldCorner);
+			boundsMax = glm::max(boundsMax, worldCorner);
+		}
+	}
+
 	template <typename T>
 	bool LoadBuffer(ImportState& importState, const fastgltf::Primitive& primitive, std::vector<VertexData>& vertexDataArrays, uint32_t vertexSlot, std::string attributeName)
 	{
@@ -134,6 +159,9 @@ namespace Engine
 			if (!LoadBuffer<glm::vec3>(importState, primitive, vertexDataArrays, 2, "NORMAL"))
 				continue;
 
+			// Tangents, generated below once the indices are known when the primitive does not provide them.
+			bool hasTangents = LoadBuffer<glm::vec4>(importState, primitive, vertexDataArrays, 3, "TANGENT");
+
 			std::vector<uint32_t> indices;
 
 			size_t indexAccessorIndex = primitive.indicesAccessor.value();
@@ -167,6 +195,13 @@ namespace Engine
 				importState.indexBufferMap[indexAccessorIndex] = indices;
 			}
 
+			if (!hasTangents)
+			{
+				std::unique_ptr<VertexData> tangents;
+				TangentCalculator::CalculateTangents(vertexDataArrays[0], vertexDataArrays[2], vertexDataArrays[1], indices, tangents);
+				vertexDataArrays.emplace_back(std::move(*tangents));
+			}
+
 			Colour colour = {};
 			std::shared_ptr<Image> diffuseImage;
 			std::shared_ptr<Image> normalImage;
@@ -244,7 +279,12 @@ namespace Engine
 				}
 			}
 
-			importState.geometryBatch.CreateMesh(vertexDataArrays, indices, transform, colour, diffuseImage, normalImage, metallicRoughnessImage, true);
+			glm::vec3 boundsMin;
+			glm::vec3 boundsMax;
+			GetWorldBounds(vertexDataArrays[0], transform, boundsMin, boundsMax);
+
+			GeometryBatch& geometryBatch = importState.batchSelector(boundsMin, boundsMax);
+			geometryBatch.CreateMesh(vertexDataArrays, indices, transform, colour, diffuseImage, normalImage, metallicRoughnessImage, true);
 		}
 
 		return true;
@@ -291,6 +331,11 @@ namespace Engine
 	}
 
 	bool GLTFLoader::LoadGLTF(const std::filesystem::path& filePath, GeometryBatch& geometryBatch, AsyncData* asyncData)
+	{
+		return LoadGLTF(filePath, [&geometryBatch](const glm::vec3&, const glm::vec3&) -> GeometryBatch& { return geometryBatch; }, asyncData);
+	}
+
+	bool GLTFLoader::LoadGLTF(const std::filesystem::path& filePath, const BatchSelector& batchSelector, AsyncData* asyncData)
 	{
 		if (!std::filesystem::exists(filePath))
 		{
@@ -360,7 +405,7 @@ namespace Engine
 
 		auto loadStartTime = std::chrono::high_resolution_clock::now();
 
-		ImportState importState(&asset, geometryBatch);
+		ImportState importState(&asset, batchSelector);
 
 		// Track if images should be treated as SRGB, normal maps, etc.
 		std::vector<ImageFlags> m_imageFlags;
@@ -458,6 +503,6 @@ namespace Engine
 		float loadDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(loadEndTime - loadStartTime).count();
 		Logger::Verbose("GLTF file loaded in {} seconds.", loadDeltaTime);
 
-		return true;
+		return result;
 	}
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <glm/glm.hpp>
 
 namespace Engine::Rendering
 {
@@ -14,6 +16,10 @@ namespace Engine
 	class GLTFLoader
 	{
 	public:
+		// Chooses the batch each mesh is created in from its world space bounds.
+		typedef std::function<Engine::Rendering::GeometryBatch&(const glm::vec3& boundsMin, const glm::vec3& boundsMax)> BatchSelector;
+
 		bool LoadGLTF(const std::filesystem::path& filePath, Engine::Rendering::GeometryBatch& geometryBatch, AsyncData* asyncData);
+		bool LoadGLTF(const std::filesystem::path& filePath, const BatchSelector& batchSelector, AsyncData* asyncData);
 	};
 }
\ No newline at end of file
@@ -1,15 +1,121 @@
 #include "Hash.hpp"
-#include <string>
+#include <bit>
+#include <cstring>
 
 namespace Engine
 {
+	// Constants and structure follow XXH64, which keeps hashes stable where std::hash is implementation defined.
+	constexpr uint64_t Prime1 = 11400714785074694791ULL;
+	constexpr uint64_t Prime2 = 14029467366897019727ULL;
+	constexpr uint64_t Prime3 = 1609587929392839161ULL;
+	constexpr uint64_t Prime4 = 9650029242287828579ULL;
+	constexpr uint64_t Prime5 = 2870177450012600261ULL;
+
+	inline uint64_t Read64(const uint8_t* data)
+	{
+		uint64_t value;
+		memcpy(&value, data, sizeof(uint64_t));
+		return value;
+	}
+
+	inline uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(uint32_t));
+		return value;
+	}
+
+	inline uint64_t Round(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * Prime2;
+		accumulator = std::rotl(accumulator, 31);
+		return accumulator * Prime1;
+	}
+
+	inline uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+	{
+		accumulator ^= Round(0, value);
+		return accumulator * Prime1 + Prime4;
+	}
+
+	inline uint64_t Avalanche(uint64_t hash)
+	{
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
 	uint64_t Hash::CalculateHash(const void* data, uint64_t length)
 	{
-		return std::hash<std::string_view>{}({ reinterpret_cast<const char*>(data), length });
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		const uint8_t* end = bytes + length;
+		uint64_t hash;
+
+		if (length >= 32)
+		{
+			// Independent lanes avoid a serial dependency chain so the loop can run at memory bandwidth.
+			uint64_t lane1 = Prime1 + Prime2;
+			uint64_t lane2 = Prime2;
+			uint64_t lane3 = 0;
+			uint64_t lane4 = 0 - Prime1;
+
+			const uint8_t* limit = end - 32;
+			do
+			{
+				lane1 = Round(lane1, Read64(bytes));
+				lane2 = Round(lane2, Read64(bytes + 8));
+				lane3 = Round(lane3, Read64(bytes + 16));
+				lane4 = Round(lane4, Read64(bytes + 24));
+				bytes += 32;
+			} while (bytes <= limit);
+
+			hash = std::rotl(lane1, 1) + std::rotl(lane2, 7) + std::rotl(lane3, 12) + std::rotl(lane4, 18);
+			hash = MergeRound(hash, lane1);
+			hash = MergeRound(hash, lane2);
+			hash = MergeRound(hash, lane3);
+			hash = MergeRound(hash, lane4);
+		}
+		else
+		{
+			hash = Prime5;
+		}
+
+		hash += length;
+
+		while (bytes + 8 <= end)
+		{
+			hash ^= Round(0, Read64(bytes));
+			hash = std::rotl(hash, 27) * Prime1 + Prime4;
+			bytes += 8;
+		}
+
+		if (bytes + 4 <= end)
+		{
+			hash ^= static_cast<uint64_t>(Read32(bytes)) * Prime1;
+			hash = std::rotl(hash, 23) * Prime2 + Prime3;
+			bytes += 4;
+		}
+
+		while (bytes < end)
+		{
+			hash ^= static_cast<uint64_t>(*bytes) * Prime5;
+			hash = std::rotl(hash, 11) * Prime1;
+			++bytes;
+		}
+
+		return Avalanche(hash);
 	}
 
 	uint64_t Hash::CalculateHash(const std::vector<uint8_t>& vector)
 	{
-		return std::hash<std::string_view>{}({ reinterpret_cast<const char*>(vector.data()), vector.size()});
+		return CalculateHash(vector.data(), vector.size());
+	}
+
+	uint64_t Hash::CombineHash(uint64_t seed, uint64_t value)
+	{
+		return Avalanche(MergeRound(seed, value));
 	}
 }
\ No newline at end of file
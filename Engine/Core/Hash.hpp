@@ -9,7 +9,9 @@ namespace Engine
 	class Hash
 	{
 	public:
+		// Stable across platforms and runs, processing 32 bytes per iteration over four independent lanes.
 		EXPORT static uint64_t CalculateHash(const void* data, uint64_t length);
 		EXPORT static uint64_t CalculateHash(const std::vector<uint8_t>& vector);
+		EXPORT static uint64_t CombineHash(uint64_t seed, uint64_t value);
 	};
 }
\ No newline at end of file
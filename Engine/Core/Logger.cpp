@@ -5,7 +5,7 @@
 #ifdef _MSC_VER
 #define DEBUG_BREAK __debugbreak()
 #else
-#define DEBUG_BREAK (void)
+#define DEBUG_BREAK ((void)0)
 #endif
 
 namespace Engine
@@ -1,9 +1,13 @@
 #pragma once
 
+#ifdef _WIN32
 #ifdef ENGINE_EXPORTS
 #define EXPORT __declspec(dllexport)
 #else
 #define EXPORT __declspec(dllimport)
 #endif
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
 
 #define COUNT_OF(x) ((sizeof(x)/sizeof(0[x])) / ((size_t)(!(sizeof(x) % sizeof(0[x])))))
\ No newline at end of file
@@ -1,66 +1,414 @@
 #include "MeshOptimiser.hpp"
 #include <meshoptimizer.h>
-#include "Logger.hpp"
+#include "MeshOptimiserArena.hpp"
 #include "VertexData.hpp"
+#include "Logger.hpp"
 #include <glm/glm.hpp>
 #include <chrono>
+#include <algorithm>
+#include <cstring>
 
 namespace Engine
 {
-	bool MeshOptimiser::Optimise(std::vector<uint32_t>& indices, std::vector<std::unique_ptr<VertexData>>& vertexArrays)
+	constexpr size_t MinLODIndexCount = 96;
+	constexpr float LODTargetError = 0.05f;
+	constexpr size_t MaxClusterVertices = 64;
+	constexpr size_t MaxClusterTriangles = 124;
+	constexpr float ClusterConeWeight = 0.25f;
+	constexpr float OverdrawThreshold = 1.05f;
+	constexpr uint32_t AnalysisCacheSize = 16;
+
+	constexpr uint32_t UnusedVertex = ~0u;
+
+	struct ThreadArenaScope
+	{
+		ThreadArenaScope(MeshOptimiserArena& arena)
+		{
+			MeshOptimiserArena::SetThreadArena(&arena);
+		}
+
+		~ThreadArenaScope()
+		{
+			MeshOptimiserArena::SetThreadArena(nullptr);
+		}
+	};
+
+	void AnalyseIndices(const std::vector<uint32_t>& indices, const VertexData& positions,
+		uint64_t& verticesTransformed, uint64_t& pixelsCovered, uint64_t& pixelsShaded)
+	{
+		meshopt_VertexCacheStatistics cacheStatistics = meshopt_analyzeVertexCache(indices.data(), indices.size(), positions.GetCount(),
+			AnalysisCacheSize, 0, 0);
+		meshopt_OverdrawStatistics overdrawStatistics = meshopt_analyzeOverdraw(indices.data(), indices.size(), positions.GetData<float>(),
+			positions.GetCount(), positions.GetElementSize());
+
+		verticesTransformed += cacheStatistics.vertices_transformed;
+		pixelsCovered += overdrawStatistics.pixels_covered;
+		pixelsShaded += overdrawStatistics.pixels_shaded;
+	}
+
+	// Optimises the index ranges in place. When remapping, vertexRemap receives a single remap from the original vertex order
+	// to the final one, so the vertex data only has to be moved once.
+	bool OptimiseIndices(uint32_t* indices, const size_t* rangeEnds, size_t rangeCount, const std::vector<std::unique_ptr<VertexData>>& vertexArrays,
+		bool remapVertices, MeshOptimiserArena& arena, uint32_t*& vertexRemap, size_t& vertexCount)
 	{
-		auto optimiseStartTime = std::chrono::high_resolution_clock::now();
+		const VertexData& positions = *vertexArrays[0];
+		size_t indexCount = rangeEnds[rangeCount - 1];
+		size_t originalVertexCount = positions.GetCount();
+		size_t positionStride = positions.GetElementSize();
+		const float* optimisePositions = positions.GetData<float>();
 
-		if (vertexArrays.empty())
+		vertexRemap = nullptr;
+		vertexCount = originalVertexCount;
+
+		if (remapVertices)
+		{
+			meshopt_Stream* streams = arena.Allocate<meshopt_Stream>(vertexArrays.size());
+			for (size_t i = 0; i < vertexArrays.size(); ++i)
+			{
+				const VertexData* vertexData = vertexArrays[i].get();
+				streams[i] = meshopt_Stream{ vertexData->GetData<uint8_t>(), vertexData->GetElementSize(), vertexData->GetElementSize() };
+			}
+
+			vertexRemap = arena.Allocate<uint32_t>(originalVertexCount);
+			vertexCount = meshopt_generateVertexRemapMulti(vertexRemap, indices, indexCount, originalVertexCount, streams, vertexArrays.size());
+			if (vertexCount == 0)
+				return false;
+
+			meshopt_remapIndexBuffer(indices, indices, indexCount, vertexRemap);
+
+			// Only positions are needed to order for overdraw, the remaining streams are moved once the final order is known.
+			float* uniquePositions = static_cast<float*>(arena.Allocate(vertexCount * positionStride));
+			meshopt_remapVertexBuffer(uniquePositions, optimisePositions, originalVertexCount, positionStride, vertexRemap);
+			optimisePositions = uniquePositions;
+		}
+
+		size_t rangeStart = 0;
+		for (size_t i = 0; i < rangeCount; ++i)
+		{
+			uint32_t* rangeIndices = indices + rangeStart;
+			size_t rangeIndexCount = rangeEnds[i] - rangeStart;
+			meshopt_optimizeVertexCache(rangeIndices, rangeIndices, rangeIndexCount, vertexCount);
+			meshopt_optimizeOverdraw(rangeIndices, rangeIndices, rangeIndexCount, optimisePositions, vertexCount, positionStride, OverdrawThreshold);
+			rangeStart = rangeEnds[i];
+		}
+
+		if (remapVertices)
+		{
+			uint32_t* fetchRemap = arena.Allocate<uint32_t>(vertexCount);
+			size_t fetchVertexCount = meshopt_optimizeVertexFetchRemap(fetchRemap, indices, indexCount, vertexCount);
+			meshopt_remapIndexBuffer(indices, indices, indexCount, fetchRemap);
+
+			for (size_t i = 0; i < originalVertexCount; ++i)
+			{
+				if (vertexRemap[i] != UnusedVertex)
+					vertexRemap[i] = fetchRemap[vertexRemap[i]];
+			}
+
+			vertexCount = fetchVertexCount;
+		}
+
+		return true;
+	}
+
+	void ScatterVertices(const VertexData& source, const uint32_t* vertexRemap, uint8_t* destination, size_t destinationStride, size_t destinationOffset)
+	{
+		const uint8_t* sourceData = source.GetData<uint8_t>();
+		size_t elementSize = source.GetElementSize();
+		uint32_t sourceCount = source.GetCount();
+		for (uint32_t i = 0; i < sourceCount; ++i)
+		{
+			if (vertexRemap[i] == UnusedVertex)
+				continue;
+
+			memcpy(destination + vertexRemap[i] * destinationStride + destinationOffset, sourceData + i * elementSize, elementSize);
+		}
+	}
+
+	bool MeshOptimiser::Optimise(const std::vector<std::vector<uint32_t>*>& indexArrays, std::vector<std::unique_ptr<VertexData>>& vertexArrays,
+		bool remapVertices, MeshOptimiserArena& arena, MeshOptimiserStatistics& statistics)
+	{
+		if (indexArrays.empty() || vertexArrays.empty() || vertexArrays.size() > MaxMeshOptimiserStreams)
 			return false;
 
-		size_t indexCount = indices.size();
-		size_t vertexCount = vertexArrays[0]->GetCount();
-		size_t originalVertexCount = vertexCount;
+		const VertexData& positions = *vertexArrays[0];
+		if (positions.GetCount() == 0)
+			return false;
 
-		if (indexCount == 0 || vertexCount == 0)
+		arena.Reset();
+		ThreadArenaScope arenaScope(arena);
+
+		size_t* rangeEnds = arena.Allocate<size_t>(indexArrays.size());
+		size_t indexCount = 0;
+		for (size_t i = 0; i < indexArrays.size(); ++i)
 		{
+			const std::vector<uint32_t>& indexArray = *indexArrays[i];
+			if (indexArray.empty())
+				return false;
+
+			statistics.TriangleCount += indexArray.size() / 3;
+			AnalyseIndices(indexArray, positions, statistics.VerticesTransformedBefore, statistics.PixelsCoveredBefore, statistics.PixelsShadedBefore);
+
+			indexCount += indexArray.size();
+			rangeEnds[i] = indexCount;
+		}
+
+		// Removing duplicates and reordering the vertex data is only valid when every index array using it is remapped together.
+		uint32_t* indices = arena.Allocate<uint32_t>(indexCount);
+		for (size_t i = 0; i < indexArrays.size(); ++i)
+		{
+			std::copy(indexArrays[i]->begin(), indexArrays[i]->end(), indices + (i == 0 ? 0 : rangeEnds[i - 1]));
+		}
+
+		uint32_t* vertexRemap;
+		size_t vertexCount;
+		if (!OptimiseIndices(indices, rangeEnds, indexArrays.size(), vertexArrays, remapVertices, arena, vertexRemap, vertexCount))
 			return false;
+
+		for (size_t i = 0; i < indexArrays.size(); ++i)
+		{
+			const uint32_t* rangeIndices = indices + (i == 0 ? 0 : rangeEnds[i - 1]);
+			std::copy(rangeIndices, rangeIndices + indexArrays[i]->size(), indexArrays[i]->begin());
+		}
+
+		if (remapVertices)
+		{
+			for (auto it = vertexArrays.begin(); it != vertexArrays.end(); ++it)
+			{
+				VertexData* vertexData = it->get();
+				uint8_t* remappedVertexData = arena.Allocate<uint8_t>(vertexCount * vertexData->GetElementSize());
+				ScatterVertices(*vertexData, vertexRemap, remappedVertexData, vertexData->GetElementSize(), 0);
+				vertexData->ReplaceData(remappedVertexData, static_cast<uint32_t>(vertexCount));
+			}
+		}
+
+		for (const std::vector<uint32_t>* indexArray : indexArrays)
+		{
+			AnalyseIndices(*indexArray, positions, statistics.VerticesTransformedAfter, statistics.PixelsCoveredAfter, statistics.PixelsShadedAfter);
 		}
 
-		std::vector<meshopt_Stream> streams;
-		for (auto it = vertexArrays.begin(); it != vertexArrays.end(); ++it)
+		return true;
+	}
+
+	bool MeshOptimiser::Optimise(const std::vector<uint32_t>& indices, const std::vector<std::unique_ptr<VertexData>>& vertexArrays,
+		bool interleave, MeshOptimiserArena& arena, MeshOptimiserOutput& output)
+	{
+		output = {};
+		if (indices.empty() || vertexArrays.empty() || vertexArrays.size() > MaxMeshOptimiserStreams || vertexArrays[0]->GetCount() == 0)
+			return false;
+
+		arena.Reset();
+		ThreadArenaScope arenaScope(arena);
+
+		uint32_t* outputIndices = arena.Allocate<uint32_t>(indices.size());
+		std::copy(indices.begin(), indices.end(), outputIndices);
+
+		size_t rangeEnd = indices.size();
+		uint32_t* vertexRemap;
+		size_t vertexCount;
+		if (!OptimiseIndices(outputIndices, &rangeEnd, 1, vertexArrays, true, arena, vertexRemap, vertexCount))
+			return false;
+
+		output.Indices = outputIndices;
+		output.IndexCount = indices.size();
+		output.VertexCount = vertexCount;
+
+		if (interleave)
 		{
-			const VertexData* vertexData = it->get();
-			streams.emplace_back(meshopt_Stream{ vertexData->GetData<uint8_t>(), vertexData->GetElementSize(), vertexData->GetElementSize() });
+			size_t stride = 0;
+			for (const std::unique_ptr<VertexData>& vertexData : vertexArrays)
+			{
+				stride += vertexData->GetElementSize();
+			}
+
+			uint8_t* vertices = arena.Allocate<uint8_t>(vertexCount * stride);
+			size_t offset = 0;
+			for (const std::unique_ptr<VertexData>& vertexData : vertexArrays)
+			{
+				ScatterVertices(*vertexData, vertexRemap, vertices, stride, offset);
+				offset += vertexData->GetElementSize();
+			}
+
+			output.Streams[0] = vertices;
+			output.Strides[0] = stride;
+			output.StreamCount = 1;
 		}
+		else
+		{
+			for (size_t i = 0; i < vertexArrays.size(); ++i)
+			{
+				size_t elementSize = vertexArrays[i]->GetElementSize();
+				output.Streams[i] = arena.Allocate<uint8_t>(vertexCount * elementSize);
+				output.Strides[i] = elementSize;
+				ScatterVertices(*vertexArrays[i], vertexRemap, output.Streams[i], elementSize, 0);
+			}
+
+			output.StreamCount = vertexArrays.size();
+		}
+
+		return true;
+	}
+
+	void MeshOptimiser::Benchmark(const std::vector<uint32_t>& indices, const std::vector<std::unique_ptr<VertexData>>& vertexArrays, uint32_t iterations)
+	{
+		struct BenchmarkResult
+		{
+			float Seconds = 0.0f;
+			uint64_t HeapAllocations = 0;
+		};
 
-		std::vector<uint32_t> remap(indexCount);
-		vertexCount = meshopt_generateVertexRemapMulti(remap.data(), indices.data(), indexCount, vertexCount, streams.data(), streams.size());
-		if (vertexCount == 0)
+		auto runBenchmark = [&](bool reuseArena, bool interleave)
+		{
+			BenchmarkResult result;
+			MeshOptimiserArena sharedArena;
+			MeshOptimiserOutput output;
+
+			auto startTime = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				if (reuseArena)
+				{
+					MeshOptimiser::Optimise(indices, vertexArrays, interleave, sharedArena, output);
+				}
+				else
+				{
+					// A fresh arena per call behaves like the previous implementation, which allocated all scratch storage each time.
+					MeshOptimiserArena arena;
+					MeshOptimiser::Optimise(indices, vertexArrays, interleave, arena, output);
+					result.HeapAllocations += arena.GetHeapAllocationCount();
+				}
+			}
+
+			auto endTime = std::chrono::high_resolution_clock::now();
+			result.Seconds = std::chrono::duration<float, std::chrono::seconds::period>(endTime - startTime).count();
+			result.HeapAllocations += sharedArena.GetHeapAllocationCount();
+			return result;
+		};
+
+		if (iterations == 0)
+			return;
+
+		BenchmarkResult coldResult = runBenchmark(false, false);
+		BenchmarkResult warmResult = runBenchmark(true, false);
+		BenchmarkResult interleavedResult = runBenchmark(true, true);
+
+		Logger::Verbose("Mesh optimiser benchmark over {} iterations of {} triangles.", iterations, indices.size() / 3);
+		Logger::Verbose("Fresh arena: {} seconds, {} heap allocations.", coldResult.Seconds, coldResult.HeapAllocations);
+		Logger::Verbose("Reused arena: {} seconds, {} heap allocations.", warmResult.Seconds, warmResult.HeapAllocations);
+		Logger::Verbose("Reused arena interleaved: {} seconds, {} heap allocations.", interleavedResult.Seconds, interleavedResult.HeapAllocations);
+	}
+
+	bool MeshOptimiser::GenerateLODs(const std::vector<uint32_t>& indices, const VertexData& positions, uint32_t maxLODCount, std::vector<MeshLOD>& lods)
+	{
+		lods.clear();
+
+		size_t vertexCount = positions.GetCount();
+		if (indices.empty() || vertexCount == 0)
 		{
 			return false;
 		}
 
-		std::vector<uint32_t> optimisedIndices(indexCount);
-		meshopt_remapIndexBuffer(optimisedIndices.data(), indices.data(), indexCount, remap.data());
+		const float* vertexPositions = positions.GetData<float>();
+		size_t vertexStride = positions.GetElementSize();
+
+		// Simplification error is relative to the mesh extents, scale it so it can be compared against world distances.
+		float errorScale = meshopt_simplifyScale(vertexPositions, vertexCount, vertexStride);
+
+		// Reserve up front as each level is simplified from the previous one.
+		lods.reserve(maxLODCount);
+
+		const std::vector<uint32_t>* sourceIndices = &indices;
+		float accumulatedError = 0.0f;
+		for (uint32_t level = 1; level < maxLODCount; ++level)
+		{
+			size_t sourceIndexCount = sourceIndices->size();
+			size_t targetIndexCount = sourceIndexCount / 6 * 3;
+			if (targetIndexCount < MinLODIndexCount)
+			{
+				break;
+			}
+
+			std::vector<uint32_t> lodIndices(sourceIndexCount);
+			float lodError = 0.0f;
+			size_t lodIndexCount = meshopt_simplify(lodIndices.data(), sourceIndices->data(), sourceIndexCount, vertexPositions,
+				vertexCount, vertexStride, targetIndexCount, LODTargetError, 0, &lodError);
+
+			// Topology preserving simplification stalls on attribute seams and open borders, fall back to sloppy simplification.
+			size_t stallIndexCount = sourceIndexCount * 3 / 4;
+			if (lodIndexCount > stallIndexCount)
+			{
+				lodIndexCount = meshopt_simplifySloppy(lodIndices.data(), sourceIndices->data(), sourceIndexCount, vertexPositions,
+					vertexCount, vertexStride, targetIndexCount, LODTargetError, &lodError);
+			}
+
+			if (lodIndexCount == 0 || lodIndexCount > stallIndexCount)
+			{
+				break;
+			}
+
+			lodIndices.resize(lodIndexCount);
+			meshopt_optimizeVertexCache(lodIndices.data(), lodIndices.data(), lodIndexCount, vertexCount);
+
+			// Each level is simplified from the previous one, so errors accumulate.
+			accumulatedError += lodError;
+
+			MeshLOD& lod = lods.emplace_back();
+			lod.Indices = std::move(lodIndices);
+			lod.Error = accumulatedError * errorScale;
+			sourceIndices = &lod.Indices;
+		}
+
+		return true;
+	}
 
-		std::vector<uint32_t> vertexRemap(vertexCount);
-		vertexCount = meshopt_optimizeVertexFetchRemap(vertexRemap.data(), indices.data(), indexCount, vertexCount);
+	bool MeshOptimiser::BuildClusters(const std::vector<uint32_t>& indices, const VertexData& positions,
+		std::vector<MeshCluster>& clusters, std::vector<uint32_t>& clusterIndices)
+	{
+		clusters.clear();
+		clusterIndices.clear();
 
-		for (auto it = vertexArrays.begin(); it != vertexArrays.end(); ++it)
+		size_t indexCount = indices.size();
+		size_t vertexCount = positions.GetCount();
+		if (indexCount == 0 || vertexCount == 0)
 		{
-			VertexData* vertexData = it->get();
-			std::vector<uint8_t> optimisedVertexData(static_cast<size_t>(vertexData->GetCount()) * vertexData->GetElementSize());
-			meshopt_remapVertexBuffer(optimisedVertexData.data(), vertexData->GetData<uint8_t>(), originalVertexCount, vertexData->GetElementSize(), vertexRemap.data());
-			vertexData->ReplaceData(optimisedVertexData, static_cast<uint32_t>(vertexCount));
+			return false;
 		}
 
-		meshopt_optimizeVertexCache(optimisedIndices.data(), optimisedIndices.data(), indexCount, vertexCount);
+		const float* vertexPositions = positions.GetData<float>();
+		size_t vertexStride = positions.GetElementSize();
 
-		meshopt_optimizeOverdraw(optimisedIndices.data(), optimisedIndices.data(), indexCount, vertexArrays[0]->GetData<float>(), vertexCount, sizeof(glm::vec3), 1.05f);
+		size_t maxMeshlets = meshopt_buildMeshletsBound(indexCount, MaxClusterVertices, MaxClusterTriangles);
+		std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+		std::vector<uint32_t> meshletVertices(maxMeshlets * MaxClusterVertices);
+		std::vector<uint8_t> meshletTriangles(maxMeshlets * MaxClusterTriangles * 3);
 
-		indices.clear();
-		indices.append_range(optimisedIndices);
+		size_t meshletCount = meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), indices.data(),
+			indexCount, vertexPositions, vertexCount, vertexStride, MaxClusterVertices, MaxClusterTriangles, ClusterConeWeight);
+
+		clusters.reserve(meshletCount);
+		clusterIndices.reserve(indexCount);
+		for (size_t i = 0; i < meshletCount; ++i)
+		{
+			const meshopt_Meshlet& meshlet = meshlets[i];
+			const uint32_t* localVertices = &meshletVertices[meshlet.vertex_offset];
+			const uint8_t* localTriangles = &meshletTriangles[meshlet.triangle_offset];
 
-		auto optimiseEndTime = std::chrono::high_resolution_clock::now();
-		float optimiseDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(optimiseEndTime - optimiseStartTime).count();
-		Logger::Verbose("Mesh optimising finished in {} seconds.", optimiseDeltaTime);
+			meshopt_Bounds bounds = meshopt_computeMeshletBounds(localVertices, localTriangles, meshlet.triangle_count,
+				vertexPositions, vertexCount, vertexStride);
+
+			MeshCluster& cluster = clusters.emplace_back();
+			cluster.FirstIndex = static_cast<uint32_t>(clusterIndices.size());
+			cluster.IndexCount = meshlet.triangle_count * 3;
+			cluster.Center = glm::vec3(bounds.center[0], bounds.center[1], bounds.center[2]);
+			cluster.Radius = bounds.radius;
+			cluster.ConeAxis = glm::vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+			cluster.ConeCutoff = bounds.cone_cutoff;
+
+			// Expand the meshlet's local triangle list back into regular indices so clusters can be drawn by the vertex pipeline.
+			for (uint32_t j = 0; j < cluster.IndexCount; ++j)
+			{
+				clusterIndices.push_back(localVertices[localTriangles[j]]);
+			}
+		}
 
 		return true;
 	}
@@ -3,14 +3,74 @@
 #include <stdint.h>
 #include <vector>
 #include <memory>
+#include <array>
+#include <glm/glm.hpp>
+#include "Macros.hpp"
 
 namespace Engine
 {
 	class VertexData;
+	class MeshOptimiserArena;
+
+	constexpr size_t MaxMeshOptimiserStreams = 16;
+
+	struct MeshLOD
+	{
+		std::vector<uint32_t> Indices;
+		float Error; // Object space deviation from the full detail mesh.
+	};
+
+	struct MeshCluster
+	{
+		uint32_t FirstIndex; // Relative to the start of the cluster index data.
+		uint32_t IndexCount;
+		glm::vec3 Center;
+		float Radius;
+		glm::vec3 ConeAxis;
+		float ConeCutoff;
+	};
+
+	struct MeshOptimiserStatistics
+	{
+		uint64_t TriangleCount = 0;
+		uint64_t VerticesTransformedBefore = 0;
+		uint64_t VerticesTransformedAfter = 0;
+		uint64_t PixelsCoveredBefore = 0;
+		uint64_t PixelsCoveredAfter = 0;
+		uint64_t PixelsShadedBefore = 0;
+		uint64_t PixelsShadedAfter = 0;
+	};
+
+	// Points into the arena passed to MeshOptimiser::Optimise and is only valid until that arena is reset.
+	struct MeshOptimiserOutput
+	{
+		uint32_t* Indices;
+		size_t IndexCount;
+		size_t VertexCount;
+		std::array<uint8_t*, MaxMeshOptimiserStreams> Streams;
+		std::array<size_t, MaxMeshOptimiserStreams> Strides;
+		size_t StreamCount;
+	};
 
 	class MeshOptimiser
 	{
 	public:
-		static bool Optimise(std::vector<uint32_t>& indices, std::vector<std::unique_ptr<VertexData>>& vertexArrays);
+		// Optimises each index array for the vertex cache and overdraw. When remapVertices is set the vertex data is also
+		// deduplicated and reordered for fetch locality, which requires indexArrays to hold every index array referencing it.
+		// All scratch storage comes from the arena, so reusing one arena across calls avoids per-call heap allocation.
+		EXPORT static bool Optimise(const std::vector<std::vector<uint32_t>*>& indexArrays, std::vector<std::unique_ptr<VertexData>>& vertexArrays,
+			bool remapVertices, MeshOptimiserArena& arena, MeshOptimiserStatistics& statistics);
+
+		// Optimises into arena storage without modifying the inputs. With interleave set the vertex streams are written as a
+		// single stream whose stride is the sum of the input element sizes, in input order.
+		EXPORT static bool Optimise(const std::vector<uint32_t>& indices, const std::vector<std::unique_ptr<VertexData>>& vertexArrays,
+			bool interleave, MeshOptimiserArena& arena, MeshOptimiserOutput& output);
+
+		static bool GenerateLODs(const std::vector<uint32_t>& indices, const VertexData& positions, uint32_t maxLODCount, std::vector<MeshLOD>& lods);
+		EXPORT static bool BuildClusters(const std::vector<uint32_t>& indices, const VertexData& positions,
+			std::vector<MeshCluster>& clusters, std::vector<uint32_t>& clusterIndices);
+
+		// Reports time and heap allocations for fresh versus reused arenas, and for interleaved output.
+		EXPORT static void Benchmark(const std::vector<uint32_t>& indices, const std::vector<std::unique_ptr<VertexData>>& vertexArrays, uint32_t iterations);
 	};
 }
\ No newline at end of file
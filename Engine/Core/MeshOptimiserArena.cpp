@@ -0,0 +1,126 @@
+#include "MeshOptimiserArena.hpp"
+#include <meshoptimizer.h>
+#include <atomic>
+#include <mutex>
+
+namespace Engine
+{
+	constexpr size_t ArenaAlignment = 16;
+	constexpr size_t MaxOverflowBlocks = 64;
+
+	thread_local MeshOptimiserArena* t_threadArena = nullptr;
+	std::atomic<uint64_t> g_unboundHeapAllocationCount = 0;
+	std::once_flag g_allocatorInstalled;
+
+	void* MESHOPTIMIZER_ALLOC_CALLCONV ArenaAllocate(size_t size)
+	{
+		if (t_threadArena != nullptr)
+			return t_threadArena->Allocate(size);
+
+		++g_unboundHeapAllocationCount;
+		return ::operator new(size);
+	}
+
+	void MESHOPTIMIZER_ALLOC_CALLCONV ArenaDeallocate(void* pointer)
+	{
+		// Arena memory is released in bulk on Reset.
+		if (t_threadArena != nullptr && t_threadArena->Owns(pointer))
+			return;
+
+		::operator delete(pointer);
+	}
+
+	inline size_t AlignSize(size_t size)
+	{
+		return (size + ArenaAlignment - 1) & ~(ArenaAlignment - 1);
+	}
+
+	MeshOptimiserArena::MeshOptimiserArena(size_t initialCapacity)
+		: m_block()
+		, m_capacity(AlignSize(initialCapacity))
+		, m_offset(0)
+		, m_cycleUsage(0)
+		, m_heapAllocationCount(0)
+		, m_overflowBlocks()
+		, m_overflowSizes()
+	{
+		std::call_once(g_allocatorInstalled, []() { meshopt_setAllocator(ArenaAllocate, ArenaDeallocate); });
+
+		m_overflowBlocks.reserve(MaxOverflowBlocks);
+		m_overflowSizes.reserve(MaxOverflowBlocks);
+
+		if (m_capacity > 0)
+		{
+			m_block = std::make_unique_for_overwrite<uint8_t[]>(m_capacity);
+			++m_heapAllocationCount;
+		}
+	}
+
+	MeshOptimiserArena::~MeshOptimiserArena()
+	{
+		if (t_threadArena == this)
+			t_threadArena = nullptr;
+	}
+
+	void* MeshOptimiserArena::Allocate(size_t size)
+	{
+		size = AlignSize(size == 0 ? 1 : size);
+		m_cycleUsage += size;
+
+		if (m_offset + size <= m_capacity)
+		{
+			void* pointer = m_block.get() + m_offset;
+			m_offset += size;
+			return pointer;
+		}
+
+		// Serve the request from a dedicated block, Reset folds these into the main block for the next cycle.
+		m_overflowBlocks.emplace_back(std::make_unique_for_overwrite<uint8_t[]>(size));
+		m_overflowSizes.push_back(size);
+		++m_heapAllocationCount;
+		return m_overflowBlocks.back().get();
+	}
+
+	void MeshOptimiserArena::Reset()
+	{
+		if (m_cycleUsage > m_capacity)
+		{
+			m_block = std::make_unique_for_overwrite<uint8_t[]>(m_cycleUsage);
+			m_capacity = m_cycleUsage;
+			++m_heapAllocationCount;
+		}
+
+		m_overflowBlocks.clear();
+		m_overflowSizes.clear();
+		m_offset = 0;
+		m_cycleUsage = 0;
+	}
+
+	bool MeshOptimiserArena::Owns(const void* pointer) const
+	{
+		std::less_equal<const void*> lessEqual;
+		std::less<const void*> less;
+
+		if (m_block && lessEqual(m_block.get(), pointer) && less(pointer, m_block.get() + m_capacity))
+			return true;
+
+		for (size_t i = 0; i < m_overflowBlocks.size(); ++i)
+		{
+			const uint8_t* block = m_overflowBlocks[i].get();
+			if (lessEqual(block, pointer) && less(pointer, block + m_overflowSizes[i]))
+				return true;
+		}
+
+		return false;
+	}
+
+	void MeshOptimiserArena::SetThreadArena(MeshOptimiserArena* arena)
+	{
+		t_threadArena = arena;
+	}
+
+	uint64_t MeshOptimiserArena::GetUnboundHeapAllocationCount()
+	{
+		return g_unboundHeapAllocationCount;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include "Macros.hpp"
+
+namespace Engine
+{
+	// Bump allocator for mesh optimisation scratch and output data. Allocations stay valid until Reset, which also grows the
+	// main block to the peak usage of the previous cycle so repeated calls on similar meshes stop touching the heap.
+	class MeshOptimiserArena
+	{
+	public:
+		EXPORT MeshOptimiserArena(size_t initialCapacity = 0);
+		EXPORT ~MeshOptimiserArena();
+
+		EXPORT void* Allocate(size_t size);
+		EXPORT void Reset();
+		EXPORT bool Owns(const void* pointer) const;
+
+		template <typename T>
+		inline T* Allocate(size_t count) { return static_cast<T*>(Allocate(count * sizeof(T))); }
+
+		inline size_t GetCapacity() const { return m_capacity; }
+		inline uint64_t GetHeapAllocationCount() const { return m_heapAllocationCount; }
+
+		// Routes meshoptimizer's internal allocations on the calling thread to the given arena, nullptr restores the heap.
+		EXPORT static void SetThreadArena(MeshOptimiserArena* arena);
+
+		// Number of meshoptimizer allocations made on the heap because no arena was bound to the calling thread.
+		EXPORT static uint64_t GetUnboundHeapAllocationCount();
+
+	private:
+		std::unique_ptr<uint8_t[]> m_block;
+		size_t m_capacity;
+		size_t m_offset;
+		size_t m_cycleUsage;
+		uint64_t m_heapAllocationCount;
+		std::vector<std::unique_ptr<uint8_t[]>> m_overflowBlocks;
+		std::vector<size_t> m_overflowSizes;
+	};
+}
@@ -4,7 +4,10 @@
 #include "Utilities.hpp"
 #include "AsyncData.hpp"
 #include <filesystem>
-#include "GltfLoader.hpp"
+#include <fstream>
+#include <format>
+#include <map>
+#include "GLTFLoader.hpp"
 #include "Rendering/Renderer.hpp"
 #include "Rendering/Resources/GeometryBatch.hpp"
 
@@ -12,8 +15,38 @@ using namespace Engine::Rendering;
 
 namespace Engine
 {
+	constexpr uint32_t CellManifestMagic = 0x4C4C4543;
+	constexpr uint32_t CellManifestVersion = 2;
+
+	struct CellManifestHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		float CellSize;
+		uint32_t CellCount;
+	};
+
+	struct CellManifestEntry
+	{
+		glm::ivec2 Coordinate;
+		glm::vec3 BoundsMin;
+		glm::vec3 BoundsMax;
+		uint64_t ByteSize;
+	};
+
+	std::filesystem::path GetCellChunkPath(const std::filesystem::path& path, const glm::ivec2& coordinate)
+	{
+		std::filesystem::path cellPath(path);
+		cellPath.replace_filename(std::format("{}_{}_{}.chunk", path.stem().string(), coordinate.x, coordinate.y));
+		return cellPath;
+	}
+
 	SceneManager::SceneManager()
 		: m_creating(false)
+		, m_partitionReady(false)
+		, m_renderer(nullptr)
+		, m_cellStreamer()
+		, m_partitionCells()
 	{
 	}
 
@@ -135,4 +168,247 @@ namespace Engine
 		asyncData.InitProgress("Loading Scene", cache ? 1500.0f : 1000.0f);
 		asyncData.SetFuture(std::move(std::async(std::launch::async, [filePath, &geometryBatch, cache, &asyncData, this] { LoadSceneImp(filePath, geometryBatch, cache, asyncData); })));
 	}
+
+	bool SceneManager::ImportPartitionedScene(const std::filesystem::path& path, float cellSize, AsyncData& asyncData)
+	{
+		std::string pathExtension(path.extension().string());
+		if (!Utilities::EqualsIgnoreCase(pathExtension, ".glb") && !Utilities::EqualsIgnoreCase(pathExtension, ".gltf"))
+		{
+			Logger::Error("Scene file type not handled.");
+			return false;
+		}
+
+		Image::CompressInit();
+
+		// Import batches are not registered with the renderer, they are only baked to produce each cell's chunk.
+		std::vector<std::unique_ptr<GeometryBatch>> cellBatches;
+		std::map<std::pair<int32_t, int32_t>, size_t> cellLookup;
+		GLTFLoader::BatchSelector batchSelector = [this, cellSize, &cellBatches, &cellLookup](const glm::vec3& boundsMin, const glm::vec3& boundsMax) -> GeometryBatch&
+			{
+				glm::vec3 centre = (boundsMin + boundsMax) * 0.5f;
+				glm::ivec2 coordinate(static_cast<int32_t>(std::floor(centre.x / cellSize)), static_cast<int32_t>(std::floor(centre.z / cellSize)));
+
+				auto [it, inserted] = cellLookup.try_emplace(std::make_pair(coordinate.x, coordinate.y), m_partitionCells.size());
+				if (inserted)
+				{
+					cellBatches.emplace_back(std::make_unique<GeometryBatch>(*m_renderer));
+					m_partitionCells.push_back({ coordinate, boundsMin, boundsMax, 0, "", nullptr, nullptr });
+				}
+
+				PartitionCell& cell = m_partitionCells[it->second];
+				cell.BoundsMin = glm::min(cell.BoundsMin, boundsMin);
+				cell.BoundsMax = glm::max(cell.BoundsMax, boundsMax);
+				return *cellBatches[it->second];
+			};
+
+		asyncData.InitSubProgress("Loading GLTF Data", 400.0f);
+		GLTFLoader gltfLoader;
+		if (!gltfLoader.LoadGLTF(path, batchSelector, &asyncData) || asyncData.State == AsyncState::Cancelled)
+			return false;
+
+		bool success = true;
+		for (size_t i = 0; i < cellBatches.size() && success; ++i)
+		{
+			PartitionCell& cell = m_partitionCells[i];
+			std::filesystem::path chunkPath = GetCellChunkPath(path, cell.Coordinate);
+
+			asyncData.InitSubProgress(std::format("Building Cell {} of {}", i + 1, cellBatches.size()), 200.0f);
+			ChunkData chunkData{};
+			uint64_t deviceSize = 0;
+			success = cellBatches[i]->Bake(chunkData, asyncData, deviceSize) && chunkData.WriteToFile(chunkPath, &asyncData);
+			if (success)
+			{
+				// The streaming budget is spent on device memory, which the compressed chunk on disk says little about.
+				cell.ChunkPath = chunkPath.string();
+				cell.ByteSize = deviceSize;
+			}
+			else
+			{
+				Logger::Error("Failed to build scene cell ({}, {}).", cell.Coordinate.x, cell.Coordinate.y);
+			}
+		}
+
+		if (!success)
+			return false;
+
+		std::filesystem::path manifestPath(path);
+		manifestPath.replace_extension("cells");
+		std::ofstream stream(manifestPath, std::ios::binary);
+		if (!stream.is_open())
+		{
+			Logger::Error("Could not open output path '{}'.", manifestPath.string());
+			return false;
+		}
+
+		CellManifestHeader header = { CellManifestMagic, CellManifestVersion, cellSize, static_cast<uint32_t>(m_partitionCells.size()) };
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(CellManifestHeader));
+		for (const PartitionCell& cell : m_partitionCells)
+		{
+			CellManifestEntry entry = { cell.Coordinate, cell.BoundsMin, cell.BoundsMax, cell.ByteSize };
+			stream.write(reinterpret_cast<const char*>(&entry), sizeof(CellManifestEntry));
+		}
+
+		Logger::Verbose("Scene partitioned into {} cells of size {}.", m_partitionCells.size(), cellSize);
+		return true;
+	}
+
+	void SceneManager::LoadPartitionedSceneImp(const std::string& filePath, float cellSize, AsyncData& asyncData)
+	{
+		std::filesystem::path path(filePath);
+		std::filesystem::path manifestPath(path);
+		manifestPath.replace_extension("cells");
+
+		bool loaded = false;
+		if (std::filesystem::exists(manifestPath) && (!std::filesystem::exists(path)
+			|| std::filesystem::last_write_time(path) <= std::filesystem::last_write_time(manifestPath)))
+		{
+			std::ifstream stream(manifestPath, std::ios::binary);
+			CellManifestHeader header = {};
+			stream.read(reinterpret_cast<char*>(&header), sizeof(CellManifestHeader));
+			if (!stream || header.Magic != CellManifestMagic || header.Version != CellManifestVersion || header.CellSize != cellSize)
+			{
+				Logger::Info("Scene cell manifest out of date, rebuilding.");
+			}
+			else
+			{
+				loaded = true;
+				for (uint32_t i = 0; i < header.CellCount && loaded; ++i)
+				{
+					CellManifestEntry entry = {};
+					stream.read(reinterpret_cast<char*>(&entry), sizeof(CellManifestEntry));
+					std::filesystem::path chunkPath = GetCellChunkPath(path, entry.Coordinate);
+					loaded = stream && std::filesystem::exists(chunkPath);
+					m_partitionCells.push_back({ entry.Coordinate, entry.BoundsMin, entry.BoundsMax, entry.ByteSize, chunkPath.string(), nullptr, nullptr });
+				}
+
+				if (!loaded)
+				{
+					Logger::Info("Scene cell manifest is incomplete, rebuilding.");
+					m_partitionCells.clear();
+				}
+			}
+		}
+
+		if (!loaded)
+		{
+			if (!std::filesystem::exists(path))
+			{
+				Logger::Error("Scene file does not exist.");
+				asyncData.State = AsyncState::Failed;
+				m_creating = false;
+				return;
+			}
+
+			if (!ImportPartitionedScene(path, cellSize, asyncData))
+			{
+				m_partitionCells.clear();
+				if (asyncData.State != AsyncState::Cancelled)
+					asyncData.State = AsyncState::Failed;
+				m_creating = false;
+				return;
+			}
+		}
+
+		m_partitionReady = true;
+		m_creating = false;
+		asyncData.State = AsyncState::Completed;
+	}
+
+	void SceneManager::LoadPartitionedScene(const std::string& filePath, Renderer* renderer, float cellSize, AsyncData& asyncData)
+	{
+		if (m_creating)
+		{
+			Logger::Error("Cannot load more than one scene simultaneously.");
+			asyncData.State = AsyncState::Failed;
+			return;
+		}
+
+		if (!m_partitionCells.empty() || cellSize <= 0.0f)
+		{
+			Logger::Error("A partitioned scene is already loaded or the cell size is invalid.");
+			asyncData.State = AsyncState::Failed;
+			return;
+		}
+
+		m_renderer = renderer;
+		m_creating = true;
+		m_partitionReady = false;
+		asyncData.State = AsyncState::InProgress;
+		asyncData.InitProgress("Partitioning Scene", 1000.0f);
+		asyncData.SetFuture(std::move(std::async(std::launch::async, [filePath, cellSize, &asyncData, this] { LoadPartitionedSceneImp(filePath, cellSize, asyncData); })));
+	}
+
+	void SceneManager::LoadCell(PartitionCell& cell)
+	{
+		GeometryBatch& geometryBatch = m_renderer->CreateGeometryBatch();
+		cell.GeometryBatch = &geometryBatch;
+		cell.Load = std::make_unique<AsyncData>(AsyncState::InProgress);
+
+		AsyncData& asyncData = *cell.Load;
+		std::string chunkPath = cell.ChunkPath;
+		asyncData.InitProgress("Loading Cell", 1500.0f);
+		asyncData.SetFuture(std::move(std::async(std::launch::async, [chunkPath, &geometryBatch, &asyncData]
+			{
+				ChunkData chunkData{};
+				asyncData.InitSubProgress("Loading Cache", 1000.0f);
+				if (!chunkData.Parse(chunkPath, &asyncData))
+				{
+					asyncData.State = AsyncState::Failed;
+					return;
+				}
+
+				asyncData.InitSubProgress("Uploading Cache Data", 500.0f);
+				asyncData.State = geometryBatch.Build(&chunkData, asyncData) ? AsyncState::Completed : AsyncState::Failed;
+			})));
+	}
+
+	void SceneManager::UpdateStreaming(const glm::vec3& position)
+	{
+		if (!m_partitionReady)
+			return;
+
+		// Cells are handed to the streamer on the calling thread once partitioning has finished.
+		if (m_cellStreamer.GetCells().size() != m_partitionCells.size())
+		{
+			m_cellStreamer.Clear();
+			for (const PartitionCell& cell : m_partitionCells)
+				m_cellStreamer.AddCell(cell.BoundsMin, cell.BoundsMax, cell.ByteSize);
+		}
+
+		// A load completes once its upload has been processed and the batch is built.
+		for (uint32_t i = 0; i < m_partitionCells.size(); ++i)
+		{
+			PartitionCell& cell = m_partitionCells[i];
+			if (cell.Load == nullptr)
+				continue;
+
+			AsyncState state = cell.Load->State;
+			if (state == AsyncState::InProgress || (state == AsyncState::Completed && (!cell.GeometryBatch->IsBuilt() || cell.GeometryBatch->HasPendingUploads())))
+				continue;
+
+			cell.Load.reset();
+			if (state != AsyncState::Completed)
+			{
+				Logger::Error("Failed to load scene cell ({}, {}).", cell.Coordinate.x, cell.Coordinate.y);
+				m_renderer->DestroyGeometryBatch(*cell.GeometryBatch);
+				cell.GeometryBatch = nullptr;
+			}
+
+			m_cellStreamer.CompleteLoad(i, state == AsyncState::Completed);
+		}
+
+		std::vector<uint32_t> loadRequests;
+		std::vector<uint32_t> unloadRequests;
+		m_cellStreamer.Update(position, loadRequests, unloadRequests);
+
+		for (uint32_t cellIndex : unloadRequests)
+		{
+			PartitionCell& cell = m_partitionCells[cellIndex];
+			m_renderer->DestroyGeometryBatch(*cell.GeometryBatch);
+			cell.GeometryBatch = nullptr;
+		}
+
+		for (uint32_t cellIndex : loadRequests)
+			LoadCell(m_partitionCells[cellIndex]);
+	}
 }
\ No newline at end of file
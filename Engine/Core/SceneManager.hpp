@@ -12,7 +12,9 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <filesystem>
 #include <atomic>
+#include "CellStreamer.hpp"
 
 namespace Engine::Rendering
 {
@@ -32,8 +34,34 @@ namespace Engine
 
 		EXPORT void LoadScene(const std::string& filePath, Engine::Rendering::Renderer* renderer, bool cache, AsyncData& asyncData);
 
+		// Splits the scene into a grid of cells on the XZ plane, each cached in its own chunk. Cells are then
+		// streamed in and out around the position passed to UpdateStreaming, which must be called once per frame.
+		EXPORT void LoadPartitionedScene(const std::string& filePath, Engine::Rendering::Renderer* renderer, float cellSize, AsyncData& asyncData);
+		EXPORT void UpdateStreaming(const glm::vec3& position);
+
+		inline CellStreamer& GetCellStreamer() { return m_cellStreamer; }
+
 	private:
+		struct PartitionCell
+		{
+			glm::ivec2 Coordinate;
+			glm::vec3 BoundsMin;
+			glm::vec3 BoundsMax;
+			uint64_t ByteSize;
+			std::string ChunkPath;
+			Engine::Rendering::GeometryBatch* GeometryBatch;
+			std::unique_ptr<AsyncData> Load;
+		};
+
 		void LoadSceneImp(const std::string& filePath, Engine::Rendering::GeometryBatch& geometryBatch, bool cache, AsyncData& asyncData);
+		void LoadPartitionedSceneImp(const std::string& filePath, float cellSize, AsyncData& asyncData);
+		bool ImportPartitionedScene(const std::filesystem::path& path, float cellSize, AsyncData& asyncData);
+		void LoadCell(PartitionCell& cell);
+
 		std::atomic<bool> m_creating;
+		std::atomic<bool> m_partitionReady;
+		Engine::Rendering::Renderer* m_renderer;
+		CellStreamer m_cellStreamer;
+		std::vector<PartitionCell> m_partitionCells;
 	};
 }
\ No newline at end of file
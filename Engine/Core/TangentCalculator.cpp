@@ -1,73 +1,159 @@
 #include "TangentCalculator.hpp"
 #include "VertexData.hpp"
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cmath>
 
 namespace Engine
 {
+	constexpr float DegenerateAreaEpsilon = 1e-20f;
+	constexpr float DegenerateUVEpsilon = 1e-12f;
+
+	struct FaceTangent
+	{
+		glm::vec3 Tangent;
+		glm::vec3 Bitangent;
+		bool Valid;
+	};
+
+	inline glm::vec3 ProjectToTangentPlane(const glm::vec3& normal, const glm::vec3& vector)
+	{
+		return vector - normal * glm::dot(normal, vector);
+	}
+
+	inline glm::vec3 SafeNormalise(const glm::vec3& vector, bool& valid)
+	{
+		float length = glm::length(vector);
+		valid = length > 0.0f && std::isfinite(length);
+		return valid ? vector / length : glm::vec3(0.0f);
+	}
+
+	inline glm::vec3 ArbitraryTangent(const glm::vec3& normal)
+	{
+		// Pick the axis least aligned with the normal to keep the cross product well conditioned.
+		glm::vec3 axis = glm::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		bool valid;
+		glm::vec3 tangent = SafeNormalise(glm::cross(axis, normal), valid);
+		return valid ? tangent : glm::vec3(1.0f, 0.0f, 0.0f);
+	}
+
 	void TangentCalculator::CalculateTangents(const VertexData& positionBuffer, const VertexData& normalBuffer, const VertexData& uvBuffer,
-		const std::vector<uint32_t>& indices, std::unique_ptr<VertexData>& tangentsResult, std::unique_ptr<VertexData>& bitangentsResult)
+		const std::vector<uint32_t>& indices, std::unique_ptr<VertexData>& tangentsResult)
 	{
 		uint32_t vertexCount = positionBuffer.GetCount();
-		std::vector<glm::vec3> tangents(vertexCount);
-		std::vector<glm::vec3> bitangents(vertexCount);
+		size_t triangleCount = indices.size() / 3;
 
 		const glm::vec3* positions = positionBuffer.GetData<glm::vec3>();
 		const glm::vec3* normals = normalBuffer.GetData<glm::vec3>();
 		const glm::vec2* uvs = uvBuffer.GetData<glm::vec2>();
 
-		uint32_t vertexIndex = 0;
-		size_t indexCount = indices.size();
-		for (uint32_t i = 0; i < indexCount; i += 3)
-		{
-			uint32_t i1 = indices[i];
-			uint32_t i2 = indices[i + 1];
-			uint32_t i3 = indices[i + 2];
-
-			const glm::vec3& v0 = positions[i1];
-			const glm::vec3& v1 = positions[i2];
-			const glm::vec3& v2 = positions[i3];
-
-			const glm::vec2& uv0 = uvs[i1];
-			const glm::vec2& uv1 = uvs[i2];
-			const glm::vec2& uv2 = uvs[i3];
-
-			glm::vec3 deltaPos1 = v1 - v0;
-			glm::vec3 deltaPos2 = v2 - v0;
-
-			glm::vec2 deltaUV1 = uv1 - uv0;
-			glm::vec2 deltaUV2 = uv2 - uv0;
-
-			float r = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x);
-			glm::vec3 tangent = (deltaPos1 * deltaUV2.y - deltaPos2 * deltaUV1.y) * r;
-			glm::vec3 bitangent = (deltaPos2 * deltaUV1.x - deltaPos1 * deltaUV2.x) * r;
-
-			tangents[i1] += tangent;
-			tangents[i2] += tangent;
-			tangents[i3] += tangent;
-
-			// Same thing for binormals
-			bitangents[i1] += bitangent;
-			bitangents[i2] += bitangent;
-			bitangents[i3] += bitangent;
-		}
-
-		for (uint32_t i = 0; i < vertexCount; i += 1)
-		{
-			const glm::vec3& n = normals[i];
-			glm::vec3& t = tangents[i];
-			glm::vec3& b = bitangents[i];
-
-			// Gram-Schmidt orthogonalize
-			t = glm::normalize(t - n * glm::dot(n, t));
-
-			// Calculate handedness
-			if (glm::dot(glm::cross(n, t), b) < 0.0f)
+		// Face tangents are independent, so compute them in parallel without any shared writes.
+		std::vector<FaceTangent> faceTangents(triangleCount);
+		std::vector<size_t> triangleIndices(triangleCount);
+		std::iota(triangleIndices.begin(), triangleIndices.end(), 0);
+		std::for_each(
+			std::execution::par,
+			triangleIndices.begin(),
+			triangleIndices.end(),
+			[&](size_t triangle)
+			{
+				FaceTangent& face = faceTangents[triangle];
+				face.Valid = false;
+
+				uint32_t i0 = indices[triangle * 3];
+				uint32_t i1 = indices[triangle * 3 + 1];
+				uint32_t i2 = indices[triangle * 3 + 2];
+
+				glm::vec3 deltaPos1 = positions[i1] - positions[i0];
+				glm::vec3 deltaPos2 = positions[i2] - positions[i0];
+				glm::vec2 deltaUV1 = uvs[i1] - uvs[i0];
+				glm::vec2 deltaUV2 = uvs[i2] - uvs[i0];
+
+				glm::vec3 areaVector = glm::cross(deltaPos1, deltaPos2);
+				float signedUVArea = deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x;
+				if (glm::dot(areaVector, areaVector) <= DegenerateAreaEpsilon || glm::abs(signedUVArea) <= DegenerateUVEpsilon)
+					return;
+
+				// Like MikkTSpace, keep the direction only and flip by the UV winding rather than dividing by the determinant.
+				float orientation = signedUVArea > 0.0f ? 1.0f : -1.0f;
+				bool tangentValid;
+				bool bitangentValid;
+				face.Tangent = SafeNormalise((deltaPos1 * deltaUV2.y - deltaPos2 * deltaUV1.y) * orientation, tangentValid);
+				face.Bitangent = SafeNormalise((deltaPos2 * deltaUV1.x - deltaPos1 * deltaUV2.x) * orientation, bitangentValid);
+				face.Valid = tangentValid && bitangentValid;
+			});
+
+		// Build a vertex to corner adjacency so each vertex can gather its contributions without atomics.
+		std::vector<uint32_t> cornerOffsets(static_cast<size_t>(vertexCount) + 1, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			++cornerOffsets[indices[i] + 1];
+
+		std::inclusive_scan(cornerOffsets.begin(), cornerOffsets.end(), cornerOffsets.begin());
+
+		std::vector<uint32_t> corners(triangleCount * 3);
+		std::vector<uint32_t> cornerCursors(cornerOffsets.begin(), cornerOffsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+			corners[cornerCursors[indices[i]]++] = static_cast<uint32_t>(i);
+
+		std::vector<glm::vec4> tangents(vertexCount);
+		std::vector<uint32_t> vertexIndices(vertexCount);
+		std::iota(vertexIndices.begin(), vertexIndices.end(), 0);
+		std::for_each(
+			std::execution::par,
+			vertexIndices.begin(),
+			vertexIndices.end(),
+			[&](uint32_t vertex)
 			{
-				t = t * -1.0f;
-			}
-		}
+				bool normalValid;
+				glm::vec3 normal = SafeNormalise(normals[vertex], normalValid);
+				if (!normalValid)
+					normal = glm::vec3(0.0f, 0.0f, 1.0f);
+
+				glm::vec3 tangentSum(0.0f);
+				glm::vec3 bitangentSum(0.0f);
+				for (uint32_t c = cornerOffsets[vertex]; c < cornerOffsets[vertex + 1]; ++c)
+				{
+					uint32_t corner = corners[c];
+					size_t triangle = corner / 3;
+					const FaceTangent& face = faceTangents[triangle];
+					if (!face.Valid)
+						continue;
+
+					// Weight each face by the corner angle projected into the vertex tangent plane, as MikkTSpace does.
+					size_t base = triangle * 3;
+					const glm::vec3& position = positions[indices[corner]];
+					bool edge1Valid;
+					bool edge2Valid;
+					glm::vec3 edge1 = SafeNormalise(ProjectToTangentPlane(normal, positions[indices[base + (corner + 1) % 3]] - position), edge1Valid);
+					glm::vec3 edge2 = SafeNormalise(ProjectToTangentPlane(normal, positions[indices[base + (corner + 2) % 3]] - position), edge2Valid);
+					if (!edge1Valid || !edge2Valid)
+						continue;
+
+					float angle = glm::acos(glm::clamp(glm::dot(edge1, edge2), -1.0f, 1.0f));
+
+					bool projectedValid;
+					glm::vec3 projectedTangent = SafeNormalise(ProjectToTangentPlane(normal, face.Tangent), projectedValid);
+					if (!projectedValid)
+						continue;
+
+					tangentSum += projectedTangent * angle;
+					bitangentSum += face.Bitangent * angle;
+				}
+
+				bool tangentValid;
+				glm::vec3 tangent = SafeNormalise(ProjectToTangentPlane(normal, tangentSum), tangentValid);
+				if (!tangentValid)
+				{
+					tangents[vertex] = glm::vec4(ArbitraryTangent(normal), 1.0f);
+					return;
+				}
+
+				float sign = glm::dot(glm::cross(normal, tangent), bitangentSum) < 0.0f ? -1.0f : 1.0f;
+				tangents[vertex] = glm::vec4(tangent, sign);
+			});
 
 		tangentsResult = std::make_unique<VertexData>(tangents);
-		bitangentsResult = std::make_unique<VertexData>(bitangents);
 	}
 }
\ No newline at end of file
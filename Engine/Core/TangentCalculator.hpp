@@ -11,7 +11,9 @@ namespace Engine
 	class TangentCalculator
 	{
 	public:
+		// Generates MikkTSpace style per-vertex tangents as vec4, where w holds the bitangent sign such that
+		// bitangent = cross(normal, tangent.xyz) * tangent.w. Degenerate triangles do not contribute.
 		EXPORT static void CalculateTangents(const VertexData& positions, const VertexData& normals, const VertexData& uvs,
-			const std::vector<uint32_t>& indices, std::unique_ptr<VertexData>& tangentsResult, std::unique_ptr<VertexData>& bitangentsResult);
+			const std::vector<uint32_t>& indices, std::unique_ptr<VertexData>& tangentsResult);
 	};
 }
\ No newline at end of file
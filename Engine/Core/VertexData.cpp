@@ -16,4 +16,12 @@ namespace Engine
 		m_elementCount = newCount;
 		m_hash = Hash::CalculateHash(m_data);
 	}
+
+	void VertexData::ReplaceData(const uint8_t* data, uint32_t newCount)
+	{
+		// Assigning in place reuses the existing capacity, which is enough whenever the element count shrinks.
+		m_data.assign(data, data + static_cast<size_t>(newCount) * m_elementSize);
+		m_elementCount = newCount;
+		m_hash = Hash::CalculateHash(m_data);
+	}
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Hash.hpp"
+#include <stddef.h>
+#include <string.h>
 #include <vector>
 
 namespace Engine
@@ -31,6 +33,7 @@ namespace Engine
 		}
 
 		void ReplaceData(const std::vector<uint8_t>& data, uint32_t newCount);
+		void ReplaceData(const uint8_t* data, uint32_t newCount);
 
 		template <typename T>
 		constexpr inline const T* GetData() const { return reinterpret_cast<const T*>(m_data.data()); }
@@ -0,0 +1,153 @@
+#include "VertexQuantiser.hpp"
+#include "VertexData.hpp"
+#include <glm/packing.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace Engine
+{
+	void VertexQuantiser::QuantisePositions(const VertexData& positions, std::vector<QuantisedPosition>& output, glm::vec3& offset, glm::vec3& scale)
+	{
+		const glm::vec3* positionData = positions.GetData<glm::vec3>();
+		uint32_t count = positions.GetCount();
+
+		glm::vec3 min(std::numeric_limits<float>::max());
+		glm::vec3 max(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			min = glm::min(min, positionData[i]);
+			max = glm::max(max, positionData[i]);
+		}
+
+		if (count == 0)
+		{
+			min = max = glm::vec3(0.0f);
+		}
+
+		offset = min;
+		scale = max - min;
+
+		// Flat axes collapse to the offset, avoid dividing by zero for them.
+		glm::vec3 inverseScale = glm::vec3(
+			scale.x > 0.0f ? 1.0f / scale.x : 0.0f,
+			scale.y > 0.0f ? 1.0f / scale.y : 0.0f,
+			scale.z > 0.0f ? 1.0f / scale.z : 0.0f);
+
+		output.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 normalised = (positionData[i] - offset) * inverseScale;
+			output[i].XY = glm::packUnorm2x16(glm::vec2(normalised.x, normalised.y));
+			output[i].Z = glm::packUnorm2x16(glm::vec2(normalised.z, 0.0f));
+		}
+	}
+
+	void VertexQuantiser::QuantiseNormals(const VertexData& normals, std::vector<uint32_t>& output)
+	{
+		const glm::vec3* normalData = normals.GetData<glm::vec3>();
+		uint32_t count = normals.GetCount();
+
+		output.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			output[i] = EncodeOctahedral(normalData[i]);
+		}
+	}
+
+	void VertexQuantiser::QuantiseTextureCoordinates(const VertexData& uvs, std::vector<uint32_t>& output)
+	{
+		const glm::vec2* uvData = uvs.GetData<glm::vec2>();
+		uint32_t count = uvs.GetCount();
+
+		output.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			output[i] = glm::packHalf2x16(uvData[i]);
+		}
+	}
+
+	void VertexQuantiser::QuantiseTangents(const VertexData& tangents, std::vector<uint32_t>& output)
+	{
+		const glm::vec4* tangentData = tangents.GetData<glm::vec4>();
+		uint32_t count = tangents.GetCount();
+
+		output.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const glm::vec4& tangent = tangentData[i];
+			output[i] = glm::packSnorm4x8(glm::vec4(glm::vec3(tangent), tangent.w < 0.0f ? -1.0f : 1.0f));
+		}
+	}
+
+	glm::vec3 VertexQuantiser::DecodePosition(const QuantisedPosition& position, const glm::vec3& offset, const glm::vec3& scale)
+	{
+		glm::vec2 xy = glm::unpackUnorm2x16(position.XY);
+		float z = glm::unpackUnorm2x16(position.Z).x;
+		return offset + glm::vec3(xy, z) * scale;
+	}
+
+	uint32_t VertexQuantiser::EncodeOctahedral(const glm::vec3& normal)
+	{
+		float length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+		if (length <= 0.0f)
+		{
+			return glm::packSnorm2x16(glm::vec2(0.0f));
+		}
+
+		glm::vec2 projected = glm::vec2(normal.x, normal.y) / length;
+		if (normal.z < 0.0f)
+		{
+			// Fold the lower hemisphere over the diagonals.
+			glm::vec2 folded = (1.0f - glm::abs(glm::vec2(projected.y, projected.x)));
+			projected = glm::vec2(
+				projected.x >= 0.0f ? folded.x : -folded.x,
+				projected.y >= 0.0f ? folded.y : -folded.y);
+		}
+
+		return glm::packSnorm2x16(projected);
+	}
+
+	glm::vec3 VertexQuantiser::DecodeOctahedral(uint32_t encoded)
+	{
+		glm::vec2 projected = glm::unpackSnorm2x16(encoded);
+		glm::vec3 normal = glm::vec3(projected, 1.0f - glm::abs(projected.x) - glm::abs(projected.y));
+		float fold = glm::max(-normal.z, 0.0f);
+		normal.x += normal.x >= 0.0f ? -fold : fold;
+		normal.y += normal.y >= 0.0f ? -fold : fold;
+
+		float length = glm::length(normal);
+		return length > 0.0f ? normal / length : normal;
+	}
+
+	void VertexQuantiser::MeasureError(const VertexData& positions, const VertexData& normals, const VertexData& uvs,
+		const std::vector<QuantisedPosition>& quantisedPositions, const glm::vec3& offset, const glm::vec3& scale,
+		const std::vector<uint32_t>& quantisedNormals, const std::vector<uint32_t>& quantisedUVs, VertexQuantisationError& error)
+	{
+		const glm::vec3* positionData = positions.GetData<glm::vec3>();
+		for (size_t i = 0; i < quantisedPositions.size(); ++i)
+		{
+			glm::vec3 decoded = DecodePosition(quantisedPositions[i], offset, scale);
+			error.MaxPositionError = std::max(error.MaxPositionError, glm::length(decoded - positionData[i]));
+		}
+
+		const glm::vec3* normalData = normals.GetData<glm::vec3>();
+		for (size_t i = 0; i < quantisedNormals.size(); ++i)
+		{
+			float sourceLength = glm::length(normalData[i]);
+			if (sourceLength <= 0.0f)
+				continue;
+
+			glm::vec3 decoded = DecodeOctahedral(quantisedNormals[i]);
+			float cosAngle = glm::clamp(glm::dot(decoded, normalData[i] / sourceLength), -1.0f, 1.0f);
+			error.MaxNormalAngle = std::max(error.MaxNormalAngle, glm::degrees(glm::acos(cosAngle)));
+		}
+
+		const glm::vec2* uvData = uvs.GetData<glm::vec2>();
+		for (size_t i = 0; i < quantisedUVs.size(); ++i)
+		{
+			glm::vec2 decoded = glm::unpackHalf2x16(quantisedUVs[i]);
+			glm::vec2 delta = glm::abs(decoded - uvData[i]);
+			error.MaxUVError = std::max(error.MaxUVError, std::max(delta.x, delta.y));
+		}
+	}
+}
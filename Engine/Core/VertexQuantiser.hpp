@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Macros.hpp"
+
+namespace Engine
+{
+	class VertexData;
+
+	// 16-bit unorm components relative to the mesh bounds, the last component is padding.
+	struct QuantisedPosition
+	{
+		uint32_t XY;
+		uint32_t Z;
+	};
+
+	struct VertexQuantisationError
+	{
+		float MaxPositionError; // Object space distance.
+		float MaxNormalAngle; // Degrees.
+		float MaxUVError;
+
+		VertexQuantisationError()
+			: MaxPositionError(0.0f)
+			, MaxNormalAngle(0.0f)
+			, MaxUVError(0.0f)
+		{
+		}
+	};
+
+	class VertexQuantiser
+	{
+	public:
+		EXPORT static void QuantisePositions(const VertexData& positions, std::vector<QuantisedPosition>& output, glm::vec3& offset, glm::vec3& scale);
+		EXPORT static void QuantiseNormals(const VertexData& normals, std::vector<uint32_t>& output);
+		EXPORT static void QuantiseTextureCoordinates(const VertexData& uvs, std::vector<uint32_t>& output);
+		// 8-bit snorm direction with the bitangent sign in the last component.
+		EXPORT static void QuantiseTangents(const VertexData& tangents, std::vector<uint32_t>& output);
+
+		EXPORT static glm::vec3 DecodePosition(const QuantisedPosition& position, const glm::vec3& offset, const glm::vec3& scale);
+		EXPORT static uint32_t EncodeOctahedral(const glm::vec3& normal);
+		EXPORT static glm::vec3 DecodeOctahedral(uint32_t encoded);
+
+		// Decodes the quantised streams on the CPU and accumulates the worst case error against the source data.
+		EXPORT static void MeasureError(const VertexData& positions, const VertexData& normals, const VertexData& uvs,
+			const std::vector<QuantisedPosition>& quantisedPositions, const glm::vec3& offset, const glm::vec3& scale,
+			const std::vector<uint32_t>& quantisedNormals, const std::vector<uint32_t>& quantisedUVs, VertexQuantisationError& error);
+	};
+}
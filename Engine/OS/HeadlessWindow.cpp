@@ -0,0 +1,25 @@
+#include "HeadlessWindow.hpp"
+
+namespace Engine::OS
+{
+	HeadlessWindow::HeadlessWindow(const std::string& title, const glm::uvec2& size)
+		: Window(title, size, false)
+	{
+	}
+
+	std::unique_ptr<HeadlessWindow> HeadlessWindow::Create(const std::string& title, const glm::uvec2& size)
+	{
+		if (size.x == 0 || size.y == 0)
+		{
+			Logger::Error("Headless window '{}' cannot be created with a zero size.", title);
+			return nullptr;
+		}
+
+		return std::make_unique<HeadlessWindow>(title, size);
+	}
+
+	void HeadlessWindow::Resize(const glm::uvec2& size)
+	{
+		OnResize(size);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Window.hpp"
+
+namespace Engine::OS
+{
+	// A window with no native surface, resizes are applied immediately. Used by backends that never present to the screen.
+	class HeadlessWindow : public Window
+	{
+	public:
+		EXPORT static std::unique_ptr<HeadlessWindow> Create(const std::string& title, const glm::uvec2& size);
+		HeadlessWindow(const std::string& title, const glm::uvec2& size);
+
+		EXPORT virtual void Resize(const glm::uvec2& size) override;
+	};
+}
\ No newline at end of file
@@ -28,7 +28,8 @@ namespace Engine::OS
 #ifdef _WIN32
 		return Win32Window::Create(title, size, fullscreen);
 #else
-#error "Not implemented."
+		Logger::Error("Native windows are not supported on this platform, use a HeadlessWindow instead.");
+		return nullptr;
 #endif
 	}
 
@@ -6,6 +6,8 @@
 #include "Core/Logger.hpp"
 #include "InputState.hpp"
 #include <functional>
+#include <atomic>
+#include <vector>
 
 namespace Engine::OS
 {
@@ -28,10 +30,10 @@ namespace Engine::OS
 		template <typename TReturn>
 		static inline void RegisterCallback(std::vector<std::function<TReturn(void)>>& collection, std::function<TReturn(void)> callback)
 		{
-			const auto& target = callback.target<TReturn(void)>();
+			const auto& target = callback.template target<TReturn(void)>();
 			for (auto it = collection.cbegin(); it != collection.cend(); ++it)
 			{
-				if (it->target<TReturn(void)>() == target)
+				if (it->template target<TReturn(void)>() == target)
 				{
 					Engine::Logger::Error("Callback already registered.");
 					return;
@@ -44,10 +46,10 @@ namespace Engine::OS
 		template <typename TReturn>
 		static inline void UnregisterCallback(std::vector<std::function<TReturn(void)>>& collection, std::function<TReturn(void)> callback)
 		{
-			const auto& target = callback.target<TReturn(void)>();
+			const auto& target = callback.template target<TReturn(void)>();
 			for (auto it = collection.cbegin(); it != collection.cend(); ++it)
 			{
-				if (it->target<TReturn(void)>() == target)
+				if (it->template target<TReturn(void)>() == target)
 				{
 					collection.erase(it);
 					return;
@@ -60,10 +62,10 @@ namespace Engine::OS
 		template <typename TReturn, class TArg>
 		static inline void RegisterCallback(std::vector<std::function<TReturn(TArg)>>& collection, std::function<TReturn(TArg)> callback)
 		{
-			const auto& target = callback.target<TReturn(TArg)>();
+			const auto& target = callback.template target<TReturn(TArg)>();
 			for (auto it = collection.cbegin(); it != collection.cend(); ++it)
 			{
-				if (it->target<TReturn(TArg)>() == target)
+				if (it->template target<TReturn(TArg)>() == target)
 				{
 					Engine::Logger::Error("Callback already registered.");
 					return;
@@ -76,10 +78,10 @@ namespace Engine::OS
 		template <typename TReturn, typename TArg>
 		static inline void UnregisterCallback(std::vector<std::function<TReturn(TArg)>>& collection, std::function<TReturn(TArg)> callback)
 		{
-			const auto& target = callback.target<TReturn(TArg)>();
+			const auto& target = callback.template target<TReturn(TArg)>();
 			for (auto it = collection.cbegin(); it != collection.cend(); ++it)
 			{
-				if (it->target<TReturn(TArg)>() == target)
+				if (it->template target<TReturn(TArg)>() == target)
 				{
 					collection.erase(it);
 					return;
@@ -127,7 +129,7 @@ namespace Engine::OS
 		void OnResize(const glm::uvec2& size);
 		void OnDPIChanged(uint32_t dpi);
 
-		InputState InputState;
+		Engine::OS::InputState InputState;
 
 	protected:
 		Window(const std::string& name, const glm::uvec2& size, bool fullscreen);
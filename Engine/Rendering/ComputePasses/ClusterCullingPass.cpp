@@ -0,0 +1,211 @@
+#include "ClusterCullingPass.hpp"
+#include "FrustumCullingPass.hpp"
+#include "../Resources/IBuffer.hpp"
+#include "../IResourceFactory.hpp"
+#include "../IDevice.hpp"
+#include "../Resources/ICommandBuffer.hpp"
+#include "../Resources/IMemoryBarriers.hpp"
+#include "../Resources/GeometryBatch.hpp"
+#include "../Renderer.hpp"
+#include <algorithm>
+
+namespace Engine::Rendering
+{
+	// Workgroups step through the culled draws, so the dispatch stays within the guaranteed workgroup count limit.
+	constexpr uint32_t MaxDrawWorkgroupCount = 65535;
+
+	ClusterCullingPass::ClusterCullingPass(const FrustumCullingPass& frustumCullingPass, const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches)
+		: IComputePass("ClusterCulling", "ClusterCulling")
+		, m_frustumCullingPass(frustumCullingPass)
+		, m_geometryBatches(geometryBatches)
+		, m_built(false)
+		, m_regions()
+		, m_inputRegions()
+		, m_mode(CullingMode::FrustumAndOcclusion)
+		, m_drawCullData()
+		, m_occlusionImage(nullptr)
+		, m_memoryBarriers()
+		, m_indirectBuffer(nullptr)
+	{
+		// Ordered after frustum culling, the meshes it kept are split into clusters that replace its output for the passes that follow.
+		m_bufferInputInfos =
+		{
+			{ "IndirectDraw", RenderPassBufferInfo(AccessFlags::Read, MaterialStageFlags::ComputeShader, MaterialAccessFlags::ShaderRead) }
+		};
+
+		m_bufferOutputInfos =
+		{
+			{ "IndirectDraw", RenderPassBufferInfo(AccessFlags::Write, MaterialStageFlags::Transfer, MaterialAccessFlags::TransferWrite, nullptr) }
+		};
+	}
+
+	void ClusterCullingPass::SetCullingMode(CullingMode mode)
+	{
+		m_mode = mode;
+	}
+
+	bool ClusterCullingPass::Build(const Renderer& renderer,
+		const std::unordered_map<std::string, IRenderImage*>& imageInputs,
+		const std::unordered_map<std::string, IRenderImage*>& imageOutputs,
+		const std::unordered_map<std::string, IBuffer*>& bufferInputs,
+		const std::unordered_map<std::string, IBuffer*>& bufferOutputs)
+	{
+		m_built = false;
+
+		if (m_mode != CullingMode::FrustumAndOcclusion)
+		{
+			return ClusterPassBuild(renderer, &renderer.GetBlankImage());
+		}
+
+		return true;
+	}
+
+	void ClusterCullingPass::ClearResources()
+	{
+		m_indirectBuffer.reset();
+		m_inputRegions.clear();
+		auto& bufferInfo = m_bufferOutputInfos.at("IndirectDraw");
+		bufferInfo.Buffer = nullptr;
+		IComputePass::ClearResources();
+	}
+
+	bool ClusterCullingPass::ClusterPassBuild(const Renderer& renderer, IRenderImage* occlusionImage)
+	{
+		// Depth reduction forwards the occlusion image regardless of whether cluster culling is in use.
+		if (!GetEnabled() || m_indirectBuffer == nullptr)
+			return true;
+
+		// If no batch has been built or they are all empty, mark the pass as done so drawing is skipped for this pass.
+		if (m_regions.empty())
+			return true;
+
+		// Frustum culling lays out a region per batch as well, match them by batch as their capacities differ.
+		const IBuffer* inputIndirectBuffer = m_frustumCullingPass.GetIndirectBuffer();
+		const std::vector<IndirectDrawRegion>& frustumRegions = m_frustumCullingPass.GetIndirectDrawRegions();
+		if (inputIndirectBuffer == nullptr)
+		{
+			Logger::Error("Cluster culling requires the frustum culling output.");
+			return false;
+		}
+
+		m_inputRegions.clear();
+		for (const IndirectDrawRegion& region : m_regions)
+		{
+			auto inputRegion = std::find_if(frustumRegions.begin(), frustumRegions.end(),
+				[&region](const IndirectDrawRegion& frustumRegion) { return frustumRegion.Batch == region.Batch; });
+			if (inputRegion == frustumRegions.end())
+			{
+				Logger::Error("Frustum culling has no draws for a batch with clusters.");
+				return false;
+			}
+
+			m_inputRegions.push_back(*inputRegion);
+		}
+
+		m_occlusionImage = occlusionImage;
+		m_memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
+
+		const Camera& camera = renderer.GetCameraReadOnly();
+
+		m_drawCullData.znear = camera.GetNearFar().x;
+		m_drawCullData.zfar = camera.GetNearFar().y;
+		m_drawCullData.pyramidWidth = static_cast<float>(m_occlusionImage->GetDimensions().x);
+		m_drawCullData.pyramidHeight = static_cast<float>(m_occlusionImage->GetDimensions().y);
+
+		const std::vector<std::unique_ptr<IBuffer>>& frameInfoBuffers = renderer.GetFrameInfoBuffers();
+
+		m_material->SetInstanceCount(static_cast<uint32_t>(m_regions.size()));
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			const IndirectDrawRegion& region = m_regions[i];
+			const IndirectDrawRegion& inputRegion = m_inputRegions[i];
+			const GeometryBatch& geometryBatch = *region.Batch;
+
+			m_material->SetBindingInstance(static_cast<uint32_t>(i));
+			if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
+				!m_material->BindStorageBuffer(1, geometryBatch.GetClusterBuffer()) ||
+				!m_material->BindStorageBufferRange(2, *inputIndirectBuffer, inputRegion.Offset, inputRegion.Size) ||
+				!m_material->BindStorageBufferRange(3, *m_indirectBuffer, region.Offset, region.Size) ||
+				!m_material->BindCombinedImageSampler(4, renderer.GetReductionSampler(), m_occlusionImage->GetView(), ImageLayout::ShaderReadOnly) ||
+				!m_material->BindStorageBuffer(5, geometryBatch.GetLODBuffer()))
+				return false;
+		}
+
+		m_built = true;
+		return true;
+	}
+
+	bool ClusterCullingPass::BuildResources(const Renderer& renderer)
+	{
+		ClearResources();
+
+		uint64_t size = IndirectDrawLayout::Build(m_geometryBatches, &GeometryBatch::GetClusterDrawCapacity, sizeof(uint32_t), 1, m_regions);
+		if (!CreateIndirectBuffer(renderer, size))
+		{
+			return false;
+		}
+
+		auto& bufferInfo = m_bufferOutputInfos.at("IndirectDraw");
+		bufferInfo.Buffer = m_indirectBuffer.get();
+
+		return true;
+	}
+
+
+	bool ClusterCullingPass::CreateIndirectBuffer(const Renderer& renderer, uint64_t size)
+	{
+		const IDevice& device = renderer.GetDevice();
+		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
+
+		m_indirectBuffer = resourceFactory.CreateBuffer();
+
+		// Every cluster can produce at most one draw, meshes drawn at a simplified LOD or without clusters emit one draw each.
+		if (!m_indirectBuffer->Initialise("clusterIndirectBuffer", device, size,
+			BufferUsageFlags::IndirectBuffer | BufferUsageFlags::StorageBuffer | BufferUsageFlags::TransferDst, MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive))
+		{
+			Logger::Error("Failed to initialise cluster indirect buffer.");
+			return false;
+		}
+
+		return true;
+	}
+
+	void ClusterCullingPass::Dispatch(const Renderer& renderer, const ICommandBuffer& commandBuffer,
+		uint32_t frameIndex)
+	{
+		if (!m_built || m_mode == CullingMode::Paused)
+			return;
+
+		bool enableOcclusion = m_mode == CullingMode::FrustumAndOcclusion && m_occlusionImage->GetLayout() != ImageLayout::Undefined;
+
+		if (m_occlusionImage->GetLayout() != ImageLayout::ShaderReadOnly)
+		{
+			m_occlusionImage->AppendImageLayoutTransitionExt(commandBuffer,
+				MaterialStageFlags::ComputeShader, ImageLayout::ShaderReadOnly,
+				MaterialAccessFlags::ShaderRead, *m_memoryBarriers);
+			commandBuffer.MemoryBarrier(*m_memoryBarriers);
+			m_memoryBarriers->Clear();
+		}
+
+		const Camera& camera = renderer.GetCameraReadOnly();
+		const glm::mat4& projection = camera.GetProjection();
+		m_drawCullData.frustum = camera.GetProjectionFrustum();
+		m_drawCullData.P00 = projection[0][0];
+		m_drawCullData.P11 = projection[1][1];
+		m_drawCullData.enableOcclusion = enableOcclusion ? 1 : 0;
+		m_drawCullData.cullingMode = static_cast<uint32_t>(m_mode);
+
+		for (const IndirectDrawRegion& region : m_regions)
+			commandBuffer.FillBuffer(*m_indirectBuffer, region.Offset, sizeof(uint32_t), 0);
+
+		// A workgroup per draw kept by frustum culling, the draw count is only known on the GPU so the spare groups exit early.
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			uint32_t workgroupCount = std::min(m_inputRegions[i].MaxDrawCount, MaxDrawWorkgroupCount);
+
+			m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex, static_cast<uint32_t>(i));
+			commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(DrawCullData), reinterpret_cast<const uint32_t*>(&m_drawCullData));
+			commandBuffer.Dispatch(workgroupCount, 1, 1);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "IComputePass.hpp"
+#include "../Resources/IMemoryBarriers.hpp"
+#include "../CullingMode.hpp"
+#include "../IndirectDrawLayout.hpp"
+
+namespace Engine::Rendering
+{
+	class IResourceFactory;
+	class GeometryBatch;
+	class FrustumCullingPass;
+
+	class ClusterCullingPass : public IComputePass
+	{
+	public:
+		ClusterCullingPass(const FrustumCullingPass& frustumCullingPass, const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches);
+
+		virtual bool Build(const Renderer& renderer,
+			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
+			const std::unordered_map<std::string, IRenderImage*>& imageOutputs,
+			const std::unordered_map<std::string, IBuffer*>& bufferInputs,
+			const std::unordered_map<std::string, IBuffer*>& bufferOutputs) override;
+
+		bool ClusterPassBuild(const Renderer& renderer, IRenderImage* occlusionImage);
+
+		virtual void Dispatch(const Renderer& renderer, const ICommandBuffer& commandBuffer,
+			uint32_t frameIndex) override;
+
+		virtual bool BuildResources(const Renderer& renderer) override;
+		virtual void ClearResources() override;
+
+		void SetCullingMode(CullingMode mode);
+
+		inline const IBuffer* GetIndirectBuffer() const { return m_indirectBuffer.get(); }
+		inline const std::vector<IndirectDrawRegion>& GetIndirectDrawRegions() const { return m_regions; }
+
+	private:
+		// Packed to match the shader's 48 byte push constant block, LODs are already chosen by frustum culling.
+		struct DrawCullData
+		{
+			float P00, P11, znear, zfar; // symmetric projection parameters
+			glm::vec4 frustum; // data for left/right/top/bottom frustum planes
+			float pyramidWidth, pyramidHeight; // depth pyramid size in texels
+			uint32_t enableOcclusion;
+			uint32_t cullingMode;
+		};
+		static_assert(sizeof(DrawCullData) == 48);
+
+		bool CreateIndirectBuffer(const Renderer& renderer, uint64_t size);
+
+		const FrustumCullingPass& m_frustumCullingPass;
+		const std::vector<std::unique_ptr<GeometryBatch>>& m_geometryBatches;
+		CullingMode m_mode;
+		bool m_built;
+		IRenderImage* m_occlusionImage;
+		std::unique_ptr<IMemoryBarriers> m_memoryBarriers;
+		std::vector<IndirectDrawRegion> m_regions;
+		std::vector<IndirectDrawRegion> m_inputRegions;
+		DrawCullData m_drawCullData;
+		std::unique_ptr<IBuffer> m_indirectBuffer;
+	};
+}
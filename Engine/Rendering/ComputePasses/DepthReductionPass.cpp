@@ -1,5 +1,6 @@
 #include "DepthReductionPass.hpp"
 #include "FrustumCullingPass.hpp"
+#include "ClusterCullingPass.hpp"
 #include "../Resources/IBuffer.hpp"
 #include "../Resources/IImageSampler.hpp"
 #include "../IResourceFactory.hpp"
@@ -10,14 +11,16 @@
 
 namespace Engine::Rendering
 {
-	DepthReductionPass::DepthReductionPass(FrustumCullingPass& frustumCullingPass)
+	DepthReductionPass::DepthReductionPass(FrustumCullingPass& frustumCullingPass, ClusterCullingPass& clusterCullingPass)
 		: IComputePass("DepthReduction", "DepthReduction")
 		, m_occlusionImage(nullptr)
 		, m_depthPyramidWidth(0)
 		, m_depthPyramidHeight(0)
 		, m_depthPyramidLevels(0)
 		, m_occlusionMipViews()
+		, m_memoryBarriers()
 		, m_frustumCullingPass(frustumCullingPass)
+		, m_clusterCullingPass(clusterCullingPass)
 		, m_depthImage(nullptr)
 	{
 		m_imageInputInfos =
@@ -97,12 +100,20 @@ namespace Engine::Rendering
 			return false;
 		}
 
+		m_memoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+
 		if (!m_frustumCullingPass.FrustumPassBuild(renderer, m_occlusionImage.get()))
 		{
 			Logger::Error("Failed to perform separate frustum pass build.");
 			return false;
 		}
 
+		if (!m_clusterCullingPass.ClusterPassBuild(renderer, m_occlusionImage.get()))
+		{
+			Logger::Error("Failed to perform separate cluster pass build.");
+			return false;
+		}
+
 		m_occlusionMipViews.resize(m_depthPyramidLevels);
 		for (uint32_t i = 0; i < m_depthPyramidLevels; ++i)
 		{
@@ -156,22 +167,20 @@ namespace Engine::Rendering
 	void DepthReductionPass::Dispatch(const Renderer& renderer, const ICommandBuffer& commandBuffer,
 		uint32_t frameIndex)
 	{
-		const IDevice& device = renderer.GetDevice();
-
-		std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
+		IMemoryBarriers& memoryBarriers = *m_memoryBarriers;
 
 		if (m_occlusionImage->GetLayout() == ImageLayout::Undefined)
 		{
 			m_occlusionImage->AppendImageLayoutTransitionExt(commandBuffer,
-				MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, *memoryBarriers);
-			commandBuffer.MemoryBarrier(*memoryBarriers);
-			memoryBarriers->Clear();
+				MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, memoryBarriers);
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
 
 			commandBuffer.ClearColourImage(*m_occlusionImage, Engine::Colour());
 		}
 
 		m_occlusionImage->AppendImageLayoutTransitionExt(commandBuffer,
-			MaterialStageFlags::ComputeShader, ImageLayout::General, MaterialAccessFlags::ShaderRead, *memoryBarriers);
+			MaterialStageFlags::ComputeShader, ImageLayout::General, MaterialAccessFlags::ShaderRead, memoryBarriers);
 
 		m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex);
 
@@ -183,7 +192,9 @@ namespace Engine::Rendering
 			DimensionsAndIndex dimensionsAndIndex = { glm::vec2(levelWidth, levelHeight), i };
 			commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(dimensionsAndIndex), reinterpret_cast<uint32_t*>(&dimensionsAndIndex));
 			commandBuffer.Dispatch(getGroupCount(levelWidth, 32), getGroupCount(levelHeight, 32), 1);
-			commandBuffer.MemoryBarrier(*memoryBarriers);
+			commandBuffer.MemoryBarrier(memoryBarriers);
 		}
+
+		memoryBarriers.Clear();
 	}
 }
\ No newline at end of file
@@ -1,16 +1,18 @@
 #pragma once
 
 #include "IComputePass.hpp"
+#include "../Resources/IMemoryBarriers.hpp"
 
 namespace Engine::Rendering
 {
 	class IResourceFactory;
 	class FrustumCullingPass;
+	class ClusterCullingPass;
 
 	class DepthReductionPass : public IComputePass
 	{
 	public:
-		DepthReductionPass(FrustumCullingPass& frustumCullingPass);
+		DepthReductionPass(FrustumCullingPass& frustumCullingPass, ClusterCullingPass& clusterCullingPass);
 
 		virtual bool Build(const Renderer& renderer,
 			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
@@ -34,8 +36,10 @@ namespace Engine::Rendering
 
 		std::unique_ptr<IRenderImage> m_occlusionImage;
 		std::vector<std::unique_ptr<IImageView>> m_occlusionMipViews;
+		std::unique_ptr<IMemoryBarriers> m_memoryBarriers;
 		IRenderImage* m_depthImage;
 		FrustumCullingPass& m_frustumCullingPass;
+		ClusterCullingPass& m_clusterCullingPass;
 		uint32_t m_depthPyramidLevels;
 		uint32_t m_depthPyramidWidth;
 		uint32_t m_depthPyramidHeight;
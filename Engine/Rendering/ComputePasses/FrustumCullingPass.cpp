@@ -7,17 +7,22 @@
 #include "../Resources/IMemoryBarriers.hpp"
 #include "../Resources/GeometryBatch.hpp"
 #include "../Renderer.hpp"
+#include "../MeshLODSelector.hpp"
 
 namespace Engine::Rendering
 {
-	FrustumCullingPass::FrustumCullingPass(const GeometryBatch& sceneGeometryBatch)
+	constexpr float LODThresholdPixels = 1.0f;
+
+	FrustumCullingPass::FrustumCullingPass(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches)
 		: IComputePass("FrustumCulling", "FrustumCulling")
-		, m_sceneGeometryBatch(sceneGeometryBatch)
+		, m_geometryBatches(geometryBatches)
 		, m_built(false)
-		, m_dispatchSize(0)
+		, m_regions()
 		, m_mode(CullingMode::FrustumAndOcclusion)
+		, m_boxCulling(true)
 		, m_drawCullData()
 		, m_occlusionImage(nullptr)
+		, m_memoryBarriers()
 		, m_indirectBuffer(nullptr)
 	{
 		m_bufferOutputInfos =
@@ -28,12 +33,12 @@ namespace Engine::Rendering
 
 	void FrustumCullingPass::SetCullingMode(CullingMode mode)
 	{
-		if (m_mode == mode)
-			return;
-
 		m_mode = mode;
-		int32_t modeInt = static_cast<int32_t>(mode);
-		m_material->SetSpecialisationConstant("cullingMode", modeInt);
+	}
+
+	void FrustumCullingPass::SetBoxCulling(bool enable)
+	{
+		m_boxCulling = enable;
 	}
 
 	bool FrustumCullingPass::Build(const Renderer& renderer,
@@ -62,32 +67,37 @@ namespace Engine::Rendering
 
 	bool FrustumCullingPass::FrustumPassBuild(const Renderer& renderer, IRenderImage* occlusionImage)
 	{
-		// If scene manager has not been built or is empty, mark the pass as done so drawing is skipped for this pass.
-		if (!m_sceneGeometryBatch.IsBuilt() || m_sceneGeometryBatch.GetVertexBuffers().empty())
+		// If no batch has been built or they are all empty, mark the pass as done so drawing is skipped for this pass.
+		if (m_regions.empty())
 			return true;
 
-		const IBuffer& boundsBuffer = m_sceneGeometryBatch.GetBoundsBuffer();
-		const IBuffer& indirectDrawBuffer = m_sceneGeometryBatch.GetIndirectDrawBuffer();
 		m_occlusionImage = occlusionImage;
+		m_memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
 
 		const Camera& camera = renderer.GetCameraReadOnly();
 
-		uint32_t meshCount = m_sceneGeometryBatch.GetMeshCapacity();
 		m_drawCullData.znear = camera.GetNearFar().x;
 		m_drawCullData.zfar = camera.GetNearFar().y;
 		m_drawCullData.pyramidWidth = static_cast<float>(m_occlusionImage->GetDimensions().x);
 		m_drawCullData.pyramidHeight = static_cast<float>(m_occlusionImage->GetDimensions().y);
 
-		m_dispatchSize = (meshCount / 64) + 1;
-
 		const std::vector<std::unique_ptr<IBuffer>>& frameInfoBuffers = renderer.GetFrameInfoBuffers();
 
-		if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
-			!m_material->BindStorageBuffer(1, boundsBuffer) ||
-			!m_material->BindStorageBuffer(2, indirectDrawBuffer) ||
-			!m_material->BindStorageBuffer(3, m_indirectBuffer) ||
-			!m_material->BindCombinedImageSampler(4, renderer.GetReductionSampler(), m_occlusionImage->GetView(), ImageLayout::ShaderReadOnly))
-			return false;
+		m_material->SetInstanceCount(static_cast<uint32_t>(m_regions.size()));
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			const IndirectDrawRegion& region = m_regions[i];
+			const GeometryBatch& geometryBatch = *region.Batch;
+
+			m_material->SetBindingInstance(static_cast<uint32_t>(i));
+			if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
+				!m_material->BindStorageBuffer(1, geometryBatch.GetBoundsBuffer()) ||
+				!m_material->BindStorageBuffer(2, geometryBatch.GetIndirectDrawBuffer()) ||
+				!m_material->BindStorageBufferRange(3, *m_indirectBuffer, region.Offset, region.Size) ||
+				!m_material->BindCombinedImageSampler(4, renderer.GetReductionSampler(), m_occlusionImage->GetView(), ImageLayout::ShaderReadOnly) ||
+				!m_material->BindStorageBuffer(5, geometryBatch.GetLODBuffer()))
+				return false;
+		}
 
 		m_built = true;
 		return true;
@@ -97,7 +107,8 @@ namespace Engine::Rendering
 	{
 		ClearResources();
 
-		if (!CreateIndirectBuffer(renderer, m_sceneGeometryBatch.GetMeshCapacity()))
+		uint64_t size = IndirectDrawLayout::Build(m_geometryBatches, &GeometryBatch::GetMeshCapacity, sizeof(uint32_t), 1, m_regions);
+		if (!CreateIndirectBuffer(renderer, size))
 		{
 			return false;
 		}
@@ -109,14 +120,14 @@ namespace Engine::Rendering
 	}
 
 
-	bool FrustumCullingPass::CreateIndirectBuffer(const Renderer& renderer, uint32_t meshCount)
+	bool FrustumCullingPass::CreateIndirectBuffer(const Renderer& renderer, uint64_t size)
 	{
 		const IDevice& device = renderer.GetDevice();
 		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
 
 		m_indirectBuffer = resourceFactory.CreateBuffer();
 
-		if (!m_indirectBuffer->Initialise("indirectBuffer", device, sizeof(uint32_t) + meshCount * sizeof(IndexedIndirectCommand),
+		if (!m_indirectBuffer->Initialise("indirectBuffer", device, size,
 			BufferUsageFlags::IndirectBuffer | BufferUsageFlags::StorageBuffer | BufferUsageFlags::TransferDst, MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive))
 		{
 			Logger::Error("Failed to initialise indirect buffer.");
@@ -132,31 +143,36 @@ namespace Engine::Rendering
 		if (!m_built || m_mode == CullingMode::Paused)
 			return;
 
-		const IDevice& device = renderer.GetDevice();
-
 		bool enableOcclusion = m_mode == CullingMode::FrustumAndOcclusion && m_occlusionImage->GetLayout() != ImageLayout::Undefined;
 
 		if (m_occlusionImage->GetLayout() != ImageLayout::ShaderReadOnly)
 		{
-			std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
 			m_occlusionImage->AppendImageLayoutTransitionExt(commandBuffer,
 				MaterialStageFlags::ComputeShader, ImageLayout::ShaderReadOnly,
-				MaterialAccessFlags::ShaderRead, *memoryBarriers);
-			commandBuffer.MemoryBarrier(*memoryBarriers);
+				MaterialAccessFlags::ShaderRead, *m_memoryBarriers);
+			commandBuffer.MemoryBarrier(*m_memoryBarriers);
+			m_memoryBarriers->Clear();
 		}
 
-		m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex);
-
 		const Camera& camera = renderer.GetCameraReadOnly();
 		const glm::mat4& projection = camera.GetProjection();
 		m_drawCullData.frustum = camera.GetProjectionFrustum();
 		m_drawCullData.P00 = projection[0][0];
 		m_drawCullData.P11 = projection[1][1];
 		m_drawCullData.enableOcclusion = enableOcclusion ? 1 : 0;
+		m_drawCullData.cullingMode = static_cast<uint32_t>(m_mode);
+		m_drawCullData.boxCulling = m_boxCulling ? 1 : 0;
+		m_drawCullData.lodScale = MeshLODSelector::CalculateLODScale(projection[1][1],
+			static_cast<float>(renderer.GetRenderGraph().GetRenderExtent().y), LODThresholdPixels);
 
-		commandBuffer.FillBuffer(*m_indirectBuffer, 0, sizeof(uint32_t), 0);
+		for (const IndirectDrawRegion& region : m_regions)
+			commandBuffer.FillBuffer(*m_indirectBuffer, region.Offset, sizeof(uint32_t), 0);
 
-		commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(DrawCullData), reinterpret_cast<const uint32_t*>(&m_drawCullData));
-		commandBuffer.Dispatch(m_dispatchSize, 1, 1);
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex, static_cast<uint32_t>(i));
+			commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(DrawCullData), reinterpret_cast<const uint32_t*>(&m_drawCullData));
+			commandBuffer.Dispatch((m_regions[i].MaxDrawCount / 64) + 1, 1, 1);
+		}
 	}
 }
\ No newline at end of file
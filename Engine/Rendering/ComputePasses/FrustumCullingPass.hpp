@@ -1,7 +1,9 @@
 #pragma once
 
 #include "IComputePass.hpp"
+#include "../Resources/IMemoryBarriers.hpp"
 #include "../CullingMode.hpp"
+#include "../IndirectDrawLayout.hpp"
 
 namespace Engine::Rendering
 {
@@ -11,7 +13,7 @@ namespace Engine::Rendering
 	class FrustumCullingPass : public IComputePass
 	{
 	public:
-		FrustumCullingPass(const GeometryBatch& sceneGeometryBatch);
+		FrustumCullingPass(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches);
 
 		virtual bool Build(const Renderer& renderer,
 			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
@@ -28,23 +30,35 @@ namespace Engine::Rendering
 		virtual void ClearResources() override;
 
 		void SetCullingMode(CullingMode mode);
+		void SetBoxCulling(bool enable);
+
+		inline const IBuffer* GetIndirectBuffer() const { return m_indirectBuffer.get(); }
+		inline const std::vector<IndirectDrawRegion>& GetIndirectDrawRegions() const { return m_regions; }
 
 	private:
-		struct alignas(16) DrawCullData
+		// Packed to match the shader's 56 byte push constant block. The modes are pushed rather than specialised so that
+		// switching them does not recreate the pipeline.
+		struct DrawCullData
 		{
 			float P00, P11, znear, zfar; // symmetric projection parameters
 			glm::vec4 frustum; // data for left/right/top/bottom frustum planes
 			float pyramidWidth, pyramidHeight; // depth pyramid size in texels
 			uint32_t enableOcclusion;
+			float lodScale; // projection scale over the LOD error threshold in pixels
+			uint32_t cullingMode;
+			uint32_t boxCulling;
 		};
+		static_assert(sizeof(DrawCullData) == 56);
 
-		bool CreateIndirectBuffer(const Renderer& renderer, uint32_t meshCount);
+		bool CreateIndirectBuffer(const Renderer& renderer, uint64_t size);
 
-		const GeometryBatch& m_sceneGeometryBatch;
+		const std::vector<std::unique_ptr<GeometryBatch>>& m_geometryBatches;
 		CullingMode m_mode;
+		bool m_boxCulling;
 		bool m_built;
 		IRenderImage* m_occlusionImage;
-		uint32_t m_dispatchSize;
+		std::unique_ptr<IMemoryBarriers> m_memoryBarriers;
+		std::vector<IndirectDrawRegion> m_regions;
 		DrawCullData m_drawCullData;
 		std::unique_ptr<IBuffer> m_indirectBuffer;
 		std::unique_ptr<IBuffer> m_shadowIndirectBuffer;
@@ -6,15 +6,21 @@
 #include "../Resources/ICommandBuffer.hpp"
 #include "../Resources/GeometryBatch.hpp"
 #include "../Renderer.hpp"
+#include "../MeshLODSelector.hpp"
 
 namespace Engine::Rendering
 {
-	ShadowCullingPass::ShadowCullingPass(const GeometryBatch& sceneGeometryBatch, const ShadowMap& shadowMap)
+	// Shadow cascades are lower resolution than the view, so tolerate a larger error before switching LODs.
+	constexpr float ShadowLODThresholdPixels = 4.0f;
+
+	ShadowCullingPass::ShadowCullingPass(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches, const ShadowMap& shadowMap)
 		: IComputePass("ShadowCulling", "ShadowCulling")
-		, m_sceneGeometryBatch(sceneGeometryBatch)
+		, m_geometryBatches(geometryBatches)
 		, m_built(false)
-		, m_dispatchSize(0)
+		, m_regions()
+		, m_drawCullData()
 		, m_mode(CullingMode::FrustumAndOcclusion)
+		, m_boxCulling(true)
 		, m_shadowIndirectBuffer(nullptr)
 	{
 		m_bufferOutputInfos =
@@ -25,12 +31,12 @@ namespace Engine::Rendering
 
 	void ShadowCullingPass::SetCullingMode(CullingMode mode)
 	{
-		if (m_mode == mode)
-			return;
-
 		m_mode = mode;
-		int32_t modeInt = static_cast<int32_t>(mode);
-		m_material->SetSpecialisationConstant("cullingMode", modeInt);
+	}
+
+	void ShadowCullingPass::SetBoxCulling(bool enable)
+	{
+		m_boxCulling = enable;
 	}
 
 	bool ShadowCullingPass::Build(const Renderer& renderer,
@@ -41,26 +47,28 @@ namespace Engine::Rendering
 	{
 		m_built = false;
 
-		// If scene manager has not been built or is empty, mark the pass as done so drawing is skipped for this pass.
-		if (!m_sceneGeometryBatch.IsBuilt() || m_sceneGeometryBatch.GetVertexBuffers().empty())
+		// If no batch has been built or they are all empty, mark the pass as done so drawing is skipped for this pass.
+		if (m_regions.empty())
 			return true;
 
-		const IBuffer& boundsBuffer = m_sceneGeometryBatch.GetBoundsBuffer();
-		const IBuffer& indirectDrawBuffer = m_sceneGeometryBatch.GetIndirectDrawBuffer();
-
-		uint32_t meshCount = m_sceneGeometryBatch.GetMeshCapacity();
-
-		m_dispatchSize = (meshCount / 64) + 1;
-
 		const std::vector<std::unique_ptr<IBuffer>>& frameInfoBuffers = renderer.GetFrameInfoBuffers();
 		const std::vector<std::unique_ptr<IBuffer>>& lightBuffers = renderer.GetLightBuffers();
 
-		if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
-			!m_material->BindUniformBuffers(1, lightBuffers) ||
-			!m_material->BindStorageBuffer(2, boundsBuffer) ||
-			!m_material->BindStorageBuffer(3, indirectDrawBuffer) ||
-			!m_material->BindStorageBuffer(4, m_shadowIndirectBuffer))
-			return false;
+		m_material->SetInstanceCount(static_cast<uint32_t>(m_regions.size()));
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			const IndirectDrawRegion& region = m_regions[i];
+			const GeometryBatch& geometryBatch = *region.Batch;
+
+			m_material->SetBindingInstance(static_cast<uint32_t>(i));
+			if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
+				!m_material->BindUniformBuffers(1, lightBuffers) ||
+				!m_material->BindStorageBuffer(2, geometryBatch.GetBoundsBuffer()) ||
+				!m_material->BindStorageBuffer(3, geometryBatch.GetIndirectDrawBuffer()) ||
+				!m_material->BindStorageBufferRange(4, *m_shadowIndirectBuffer, region.Offset, region.Size) ||
+				!m_material->BindStorageBuffer(5, geometryBatch.GetLODBuffer()))
+				return false;
+		}
 
 		m_built = true;
 		return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
@@ -78,7 +86,10 @@ namespace Engine::Rendering
 	{
 		ClearResources();
 
-		if (!CreateIndirectBuffer(renderer, m_sceneGeometryBatch.GetMeshCapacity()))
+		// Each batch region holds the draw count of every cascade followed by the commands of each cascade.
+		uint32_t cascadeCount = renderer.GetShadowMap().GetCascadeCount();
+		uint64_t size = IndirectDrawLayout::Build(m_geometryBatches, &GeometryBatch::GetMeshCapacity, sizeof(uint32_t) * 4, cascadeCount, m_regions);
+		if (!CreateIndirectBuffer(renderer, size))
 		{
 			return false;
 		}
@@ -89,16 +100,14 @@ namespace Engine::Rendering
 		return true;
 	}
 
-	bool ShadowCullingPass::CreateIndirectBuffer(const Renderer& renderer, uint32_t meshCount)
+	bool ShadowCullingPass::CreateIndirectBuffer(const Renderer& renderer, uint64_t size)
 	{
 		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
 		const IDevice& device = renderer.GetDevice();
 
-		uint32_t cascadeCount = renderer.GetShadowMap().GetCascadeCount();
 		m_shadowIndirectBuffer = resourceFactory.CreateBuffer();
 
-		// Create one single buffer with the capacity to hold each cascade.
-		if (!m_shadowIndirectBuffer->Initialise("shadowIndirectBuffer", device, cascadeCount * (sizeof(uint32_t) + meshCount * sizeof(IndexedIndirectCommand)),
+		if (!m_shadowIndirectBuffer->Initialise("shadowIndirectBuffer", device, size,
 			BufferUsageFlags::IndirectBuffer | BufferUsageFlags::StorageBuffer | BufferUsageFlags::TransferDst, MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive))
 		{
 			Logger::Error("Failed to initialise indirect buffer.");
@@ -120,15 +129,21 @@ namespace Engine::Rendering
 			return;
 
 		const Camera& camera = renderer.GetCameraReadOnly();
-		const glm::vec4& frustum = camera.GetProjectionFrustum();
+		for (const IndirectDrawRegion& region : m_regions)
+			commandBuffer.FillBuffer(*m_shadowIndirectBuffer, region.Offset, sizeof(uint32_t) * 4, 0);
 
-		const IDevice& device = renderer.GetDevice();
+		m_drawCullData.frustum = camera.GetProjectionFrustum();
+		m_drawCullData.znear = camera.GetNearFar().x;
+		m_drawCullData.cullingMode = static_cast<uint32_t>(m_mode);
+		m_drawCullData.boxCulling = m_boxCulling ? 1 : 0;
+		m_drawCullData.lodScale = MeshLODSelector::CalculateLODScale(camera.GetProjection()[1][1],
+			static_cast<float>(renderer.GetSwapChain().GetExtent().y), ShadowLODThresholdPixels);
 
-		m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex);
-
-		commandBuffer.FillBuffer(*m_shadowIndirectBuffer, 0, sizeof(uint32_t) * 4, 0);
-
-		commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(glm::vec4), reinterpret_cast<const uint32_t*>(&frustum));
-		commandBuffer.Dispatch(m_dispatchSize, 1, 1);
+		for (size_t i = 0; i < m_regions.size(); ++i)
+		{
+			m_material->BindMaterial(commandBuffer, BindPoint::Compute, frameIndex, static_cast<uint32_t>(i));
+			commandBuffer.PushConstants(m_material, ShaderStageFlags::Compute, 0, sizeof(DrawCullData), reinterpret_cast<const uint32_t*>(&m_drawCullData));
+			commandBuffer.Dispatch((m_regions[i].MaxDrawCount / 64) + 1, 1, 1);
+		}
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "IComputePass.hpp"
 #include "../CullingMode.hpp"
+#include "../IndirectDrawLayout.hpp"
 
 namespace Engine::Rendering
 {
@@ -12,7 +13,7 @@ namespace Engine::Rendering
 	class ShadowCullingPass : public IComputePass
 	{
 	public:
-		ShadowCullingPass(const GeometryBatch& sceneGeometryBatch, const ShadowMap& shadowMap);
+		ShadowCullingPass(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches, const ShadowMap& shadowMap);
 
 		virtual bool Build(const Renderer& renderer,
 			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
@@ -27,14 +28,30 @@ namespace Engine::Rendering
 		virtual void ClearResources() override;
 
 		void SetCullingMode(CullingMode mode);
+		void SetBoxCulling(bool enable);
 
-	private:
-		bool CreateIndirectBuffer(const Renderer& renderer, uint32_t meshCount);
+		inline const std::vector<IndirectDrawRegion>& GetIndirectDrawRegions() const { return m_regions; }
 
-		const GeometryBatch& m_sceneGeometryBatch;
+	private:
+		// Packed to match the shader's 32 byte push constant block, padding would push past the reflected range.
+		struct DrawCullData
+		{
+			glm::vec4 frustum; // data for left/right/top/bottom frustum planes
+			float znear;
+			float lodScale; // projection scale over the LOD error threshold in pixels
+			uint32_t cullingMode;
+			uint32_t boxCulling;
+		};
+		static_assert(sizeof(DrawCullData) == 32);
+
+		bool CreateIndirectBuffer(const Renderer& renderer, uint64_t size);
+
+		const std::vector<std::unique_ptr<GeometryBatch>>& m_geometryBatches;
 		CullingMode m_mode;
+		bool m_boxCulling;
 		bool m_built;
-		uint32_t m_dispatchSize;
+		std::vector<IndirectDrawRegion> m_regions;
+		DrawCullData m_drawCullData;
 		std::unique_ptr<IBuffer> m_shadowIndirectBuffer;
 	};
 }
\ No newline at end of file
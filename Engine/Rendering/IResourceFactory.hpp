@@ -11,6 +11,7 @@ namespace Engine::Rendering
 	class ICommandPool;
 	class ISemaphore;
 	class IMemoryBarriers;
+	class IMemoryHeap;
 
 	class IResourceFactory
 	{
@@ -23,5 +24,6 @@ namespace Engine::Rendering
 		virtual std::unique_ptr<ICommandPool> CreateCommandPool() const = 0;
 		virtual std::unique_ptr<ISemaphore> CreateGraphicsSemaphore() const = 0;
 		virtual std::unique_ptr<IMemoryBarriers> CreateMemoryBarriers() const = 0;
+		virtual std::unique_ptr<IMemoryHeap> CreateMemoryHeap() const = 0;
 	};
 }
\ No newline at end of file
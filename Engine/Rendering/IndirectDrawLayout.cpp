@@ -0,0 +1,37 @@
+#include "IndirectDrawLayout.hpp"
+#include "Resources/GeometryBatch.hpp"
+#include "Resources/IndexedIndirectCommand.hpp"
+
+namespace Engine::Rendering
+{
+	// Largest storage buffer offset alignment permitted by Vulkan, so regions can be bound on any device.
+	constexpr uint64_t RegionAlignment = 256;
+
+	uint64_t IndirectDrawLayout::Build(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches, DrawCapacityGetter drawCapacity,
+		uint64_t headerSize, uint32_t drawSetCount, std::vector<IndirectDrawRegion>& regions)
+	{
+		regions.clear();
+
+		uint64_t offset = 0;
+		for (const std::unique_ptr<GeometryBatch>& geometryBatch : geometryBatches)
+		{
+			if (!geometryBatch->IsBuilt() || geometryBatch->GetVertexBuffers().empty())
+				continue;
+
+			uint32_t maxDrawCount = (*geometryBatch.*drawCapacity)();
+			if (maxDrawCount == 0)
+				continue;
+
+			IndirectDrawRegion& region = regions.emplace_back();
+			region.Batch = geometryBatch.get();
+			region.Offset = offset;
+			region.Size = headerSize + static_cast<uint64_t>(drawSetCount) * maxDrawCount * sizeof(IndexedIndirectCommand);
+			region.MaxDrawCount = maxDrawCount;
+
+			offset = (offset + region.Size + RegionAlignment - 1) / RegionAlignment * RegionAlignment;
+		}
+
+		// The graph still expects a buffer when nothing is drawable, keep room for the counts.
+		return regions.empty() ? headerSize : offset;
+	}
+}
\ No newline at end of file
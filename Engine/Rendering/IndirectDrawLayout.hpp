@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace Engine::Rendering
+{
+	class GeometryBatch;
+
+	struct IndirectDrawRegion
+	{
+		const GeometryBatch* Batch;
+		uint64_t Offset;
+		uint64_t Size;
+		uint32_t MaxDrawCount;
+	};
+
+	// Culling passes write the draws of every geometry batch into one indirect buffer, so the render graph tracks a single resource.
+	// Each batch owns an aligned region of draw counts followed by its commands, bound to the culling shaders as a buffer range.
+	class IndirectDrawLayout
+	{
+	public:
+		typedef uint32_t(GeometryBatch::* DrawCapacityGetter)() const;
+
+		// Returns the buffer size required for the regions of every drawable batch.
+		static uint64_t Build(const std::vector<std::unique_ptr<GeometryBatch>>& geometryBatches, DrawCapacityGetter drawCapacity,
+			uint64_t headerSize, uint32_t drawSetCount, std::vector<IndirectDrawRegion>& regions);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "MeshLODSelector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine::Rendering
+{
+	float MeshLODSelector::CalculateLODScale(float projectionScale, float viewHeight, float thresholdPixels)
+	{
+		// Maps a world space error at unit distance to a fraction of the pixel threshold.
+		return std::abs(projectionScale) * 0.5f * viewHeight / std::max(thresholdPixels, std::numeric_limits<float>::epsilon());
+	}
+
+	uint32_t MeshLODSelector::SelectLOD(const RenderMeshLODInfo& lodInfo, float distance, float radius, float nearPlane, float lodScale)
+	{
+		// Measure from the nearest point of the bounding sphere so that large meshes do not drop detail up close.
+		float projectionScale = lodScale / std::max(distance - radius, nearPlane);
+
+		uint32_t lodCount = std::min(lodInfo.lodCount, MaxMeshLODCount);
+		uint32_t lod = 0;
+		for (uint32_t i = 1; i < lodCount; ++i)
+		{
+			if (lodInfo.lods[i].error * projectionScale >= 1.0f)
+				break;
+
+			lod = i;
+		}
+
+		return lod;
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Core/Macros.hpp"
+#include "Resources/RenderMeshLODInfo.hpp"
+
+namespace Engine::Rendering
+{
+	// CPU mirror of the LOD selection performed by the culling compute shaders.
+	class MeshLODSelector
+	{
+	public:
+		EXPORT static float CalculateLODScale(float projectionScale, float viewHeight, float thresholdPixels);
+		EXPORT static uint32_t SelectLOD(const RenderMeshLODInfo& lodInfo, float distance, float radius, float nearPlane, float lodScale);
+	};
+}
@@ -0,0 +1,119 @@
+#include "Buffer.hpp"
+#include "CommandBuffer.hpp"
+#include "NullMemoryBarriers.hpp"
+#include "../Resources/IRenderImage.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Engine::Rendering::Null
+{
+	Buffer::Buffer()
+		: m_name()
+		, m_data()
+	{
+	}
+
+	bool Buffer::Initialise(std::string_view name, const IDevice& device, uint64_t size, BufferUsageFlags bufferUsage,
+		MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode)
+	{
+		if (size == 0)
+		{
+			Logger::Error("Buffer '{}' cannot be created with a size of zero.", name);
+			return false;
+		}
+
+		m_name = name;
+		m_size = size;
+		m_data.assign(size, 0);
+
+		// Only persistently mapped allocations expose their memory, so code that forgets to request it fails here too.
+		if ((createFlags & AllocationCreateFlags::Mapped) == AllocationCreateFlags::Mapped)
+			m_mappedDataPtr = m_data.data();
+
+		return true;
+	}
+
+	bool Buffer::UpdateContents(const void* data, size_t offset, size_t size)
+	{
+		if (offset + size > m_size)
+		{
+			Logger::Error("Update of {} bytes at offset {} exceeds the size of buffer '{}'.", size, offset, m_name);
+			return false;
+		}
+
+		memcpy(m_data.data() + offset, data, size);
+		return true;
+	}
+
+	uint64_t Buffer::GetDeviceAddress(const IDevice& device)
+	{
+		return reinterpret_cast<uint64_t>(m_data.data());
+	}
+
+	void Buffer::Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size,
+		size_t sourceOffset, size_t destinationOffset) const
+	{
+		const Buffer& nullDestination = static_cast<const Buffer&>(destination);
+		if (sourceOffset + size > m_size || destinationOffset + size > nullDestination.m_size)
+		{
+			Logger::Error("Copy of {} bytes from buffer '{}' to buffer '{}' is out of range.", size, m_name, nullDestination.m_name);
+			return;
+		}
+
+		static_cast<const CommandBuffer&>(commandBuffer).Record(CommandType::CopyBuffer, &destination,
+			reinterpret_cast<uint64_t>(this), sourceOffset, destinationOffset, size);
+
+		memmove(nullDestination.m_data.data() + destinationOffset, m_data.data() + sourceOffset, size);
+	}
+
+	void Buffer::CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination,
+		size_t sourceOffset, uint32_t firstRow, uint32_t rowCount) const
+	{
+		if (mipLevel >= destination.GetMipLevels())
+		{
+			Logger::Error("Copy from buffer '{}' targets mip level {} of an image with {} levels.", m_name, mipLevel, destination.GetMipLevels());
+			return;
+		}
+
+		if (destination.GetLayout() != ImageLayout::TransferDst)
+		{
+			Logger::Error("Copy from buffer '{}' targets an image that is not in the transfer destination layout.", m_name);
+			return;
+		}
+
+		static_cast<const CommandBuffer&>(commandBuffer).Record(CommandType::CopyBufferToImage, &destination,
+			reinterpret_cast<uint64_t>(this), sourceOffset, mipLevel, (static_cast<uint64_t>(firstRow) << 32) | rowCount);
+	}
+
+	void Buffer::Fill(size_t offset, size_t size, uint32_t data) const
+	{
+		if (offset >= m_size)
+			return;
+
+		size = std::min(size, static_cast<size_t>(m_size - offset)) & ~static_cast<size_t>(3);
+		for (size_t i = 0; i < size; i += sizeof(uint32_t))
+			memcpy(m_data.data() + offset + i, &data, sizeof(uint32_t));
+	}
+
+	bool Buffer::AppendBufferMemoryBarrier(const ICommandBuffer& commandBuffer,
+		MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+		MaterialStageFlags dstStageFlags, MaterialAccessFlags dstAccessFlags,
+		IMemoryBarriers& memoryBarriers, uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily)
+	{
+		if (srcQueueFamily != dstQueueFamily)
+		{
+			uint32_t commandBufferQueueIndex = commandBuffer.GetQueueFamilyIndex();
+			if (commandBufferQueueIndex != srcQueueFamily && commandBufferQueueIndex != dstQueueFamily)
+			{
+				Logger::Error("Command buffer queue family index matches neither requested source or destination index.");
+				return false;
+			}
+		}
+
+		NullMemoryBarriers& nullMemoryBarriers = static_cast<NullMemoryBarriers&>(memoryBarriers);
+		nullMemoryBarriers.AddBufferBarrier({ this, srcStageFlags, srcAccessFlags, dstStageFlags, dstAccessFlags, srcQueueFamily, dstQueueFamily });
+
+		return true;
+	}
+}
\ No newline at end of file
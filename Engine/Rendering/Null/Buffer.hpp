@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../Resources/IBuffer.hpp"
+#include <vector>
+
+namespace Engine::Rendering::Null
+{
+	// Backed by host memory. Copies and fills recorded against it are applied when they are recorded, so buffer contents
+	// can be inspected straight after the command that writes them.
+	class Buffer : public IBuffer
+	{
+	public:
+		Buffer();
+		virtual bool Initialise(std::string_view name, const IDevice& device, uint64_t size, BufferUsageFlags bufferUsage,
+			MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode) override;
+		virtual bool UpdateContents(const void* data, size_t offset, size_t size) override;
+		virtual uint64_t GetDeviceAddress(const IDevice& device) override;
+		virtual void Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size,
+			size_t sourceOffset = 0, size_t destinationOffset = 0) const override;
+		virtual void CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination,
+			size_t sourceOffset = 0, uint32_t firstRow = 0, uint32_t rowCount = 0) const override;
+
+		virtual bool AppendBufferMemoryBarrier(const ICommandBuffer& commandBuffer,
+			MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+			MaterialStageFlags dstStageFlags, MaterialAccessFlags dstAccessFlags,
+			IMemoryBarriers& memoryBarriers, uint32_t srcQueueFamily = 0,
+			uint32_t dstQueueFamily = 0) override;
+
+		void Fill(size_t offset, size_t size, uint32_t data) const;
+
+		inline const std::string& GetName() const { return m_name; }
+		inline const uint8_t* GetData() const { return m_data.data(); }
+
+	private:
+		std::string m_name;
+		mutable std::vector<uint8_t> m_data;
+	};
+}
\ No newline at end of file
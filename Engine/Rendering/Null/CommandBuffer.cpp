@@ -0,0 +1,128 @@
+#include "CommandBuffer.hpp"
+#include "Buffer.hpp"
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering::Null
+{
+	CommandBuffer::CommandBuffer(uint32_t queueFamilyIndex)
+		: m_commands()
+		, m_bufferBarriers()
+		, m_imageBarriers()
+		, m_recording(false)
+	{
+		m_queueFamilyIndex = queueFamilyIndex;
+	}
+
+	bool CommandBuffer::Begin() const
+	{
+		// Beginning a command buffer implicitly resets it, as it does for pools created with the reset flag.
+		Reset();
+		m_recording = true;
+		return true;
+	}
+
+	void CommandBuffer::Record(CommandType type, const void* resource, uint64_t argument0, uint64_t argument1,
+		uint64_t argument2, uint64_t argument3) const
+	{
+		if (!m_recording)
+		{
+			Logger::Error("Command {} recorded outside of Begin and End.", static_cast<uint32_t>(type));
+			return;
+		}
+
+		m_commands.emplace_back(type, resource, std::array<uint64_t, 4>{ argument0, argument1, argument2, argument3 });
+	}
+
+	void CommandBuffer::BeginRendering(const std::vector<AttachmentInfo>& attachments,
+		const std::optional<AttachmentInfo>& depthAttachment, const glm::uvec2& size, uint32_t layerCount) const
+	{
+		// The depth image and its load op are kept so tests can check how layered passes clear their attachment.
+		Record(CommandType::BeginRendering, depthAttachment.has_value() ? depthAttachment->renderImage : nullptr, attachments.size(),
+			depthAttachment.has_value() ? static_cast<uint64_t>(depthAttachment->loadOp) : 0, (static_cast<uint64_t>(size.x) << 32) | size.y, layerCount);
+	}
+
+	void CommandBuffer::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) const
+	{
+		Record(CommandType::Draw, nullptr, vertexCount, instanceCount, firstVertex, firstInstance);
+	}
+
+	void CommandBuffer::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const
+	{
+		Record(CommandType::Dispatch, nullptr, groupCountX, groupCountY, groupCountZ);
+	}
+
+	void CommandBuffer::BlitImage(const IRenderImage& srcImage, const IRenderImage& dstImage, const std::vector<ImageBlit>& regions, Filter filter) const
+	{
+		Record(CommandType::BlitImage, &dstImage, reinterpret_cast<uint64_t>(&srcImage), regions.size(), static_cast<uint64_t>(filter));
+	}
+
+	void CommandBuffer::PushConstants(const Material* material, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const uint32_t* value) const
+	{
+		Record(CommandType::PushConstants, material, static_cast<uint64_t>(stageFlags), offset, size);
+	}
+
+	void CommandBuffer::BindVertexBuffers(uint32_t firstBinding, const std::vector<IBuffer*>& buffers, const std::vector<size_t>& offsets) const
+	{
+		if (buffers.size() != offsets.size())
+		{
+			Logger::Error("Vertex buffer and offset counts do not match.");
+			return;
+		}
+
+		Record(CommandType::BindVertexBuffers, buffers.empty() ? nullptr : buffers.front(), firstBinding, buffers.size());
+	}
+
+	void CommandBuffer::BindIndexBuffer(const IBuffer& buffer, size_t offset, IndexType indexType) const
+	{
+		Record(CommandType::BindIndexBuffer, &buffer, offset, static_cast<uint64_t>(indexType));
+	}
+
+	void CommandBuffer::DrawIndexedIndirect(const IBuffer& buffer, size_t offset, uint32_t drawCount, uint32_t stride) const
+	{
+		Record(CommandType::DrawIndexedIndirect, &buffer, offset, drawCount, stride);
+	}
+
+	void CommandBuffer::DrawIndexedIndirectCount(const IBuffer& buffer, size_t offset, const IBuffer& countBuffer, size_t countOffset, uint32_t maxDrawCount, uint32_t stride) const
+	{
+		Record(CommandType::DrawIndexedIndirectCount, &buffer, offset, reinterpret_cast<uint64_t>(&countBuffer), maxDrawCount, stride);
+	}
+
+	void CommandBuffer::MemoryBarrier(MaterialStageFlags srcStage, MaterialAccessFlags srcMask, MaterialStageFlags dstStage, MaterialAccessFlags dstMask) const
+	{
+		Record(CommandType::PipelineBarrier, nullptr, 1, 0, 0);
+	}
+
+	void CommandBuffer::MemoryBarrier(const IMemoryBarriers& memoryBarriersContainer) const
+	{
+		const NullMemoryBarriers& memoryBarriers = static_cast<const NullMemoryBarriers&>(memoryBarriersContainer);
+		if (memoryBarriers.Empty())
+			return;
+
+		const std::vector<BufferBarrier>& bufferBarriers = memoryBarriers.GetBufferBarriers();
+		const std::vector<ImageBarrier>& imageBarriers = memoryBarriers.GetImageBarriers();
+
+		Record(CommandType::PipelineBarrier, nullptr, 0, bufferBarriers.size(), imageBarriers.size());
+		if (m_recording)
+		{
+			m_bufferBarriers.insert(m_bufferBarriers.end(), bufferBarriers.begin(), bufferBarriers.end());
+			m_imageBarriers.insert(m_imageBarriers.end(), imageBarriers.begin(), imageBarriers.end());
+		}
+	}
+
+	void CommandBuffer::ClearColourImage(const IRenderImage& image, const Colour& colour) const
+	{
+		Record(CommandType::ClearColourImage, &image);
+	}
+
+	void CommandBuffer::ClearDepthStencilImage(const IRenderImage& image, float depth, uint32_t stencil) const
+	{
+		Record(CommandType::ClearDepthStencilImage, &image, 0, stencil);
+	}
+
+	void CommandBuffer::FillBuffer(const IBuffer& buffer, size_t offset, size_t size, uint32_t data) const
+	{
+		Record(CommandType::FillBuffer, &buffer, offset, size, data);
+		if (m_recording)
+			static_cast<const Buffer&>(buffer).Fill(offset, size, data);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../Resources/ICommandBuffer.hpp"
+#include "RecordedCommand.hpp"
+#include "NullMemoryBarriers.hpp"
+#include <vector>
+
+namespace Engine::Rendering::Null
+{
+	// Records commands into an in-memory stream instead of submitting them, so the work a frame generates can be
+	// inspected and measured without a GPU. Barrier commands store their barriers in the buffer and image barrier lists
+	// in recording order, the command's arguments hold how many of each it added.
+	class CommandBuffer : public ICommandBuffer
+	{
+	public:
+		CommandBuffer(uint32_t queueFamilyIndex);
+
+		inline virtual void Reset() const override
+		{
+			m_commands.clear();
+			m_bufferBarriers.clear();
+			m_imageBarriers.clear();
+			m_recording = false;
+		}
+
+		virtual bool Begin() const override;
+
+		inline virtual void End() const override
+		{
+			m_recording = false;
+		}
+
+		virtual void BeginRendering(const std::vector<AttachmentInfo>& attachments,
+			const std::optional<AttachmentInfo>& depthAttachment, const glm::uvec2& size,
+			uint32_t layerCount) const override;
+
+		inline virtual void EndRendering() const override
+		{
+			Record(CommandType::EndRendering, nullptr);
+		}
+
+		virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) const override;
+
+		virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const override;
+
+		virtual void BlitImage(const IRenderImage& srcImage, const IRenderImage& dstImage, const std::vector<ImageBlit>& regions, Filter filter) const override;
+
+		virtual void PushConstants(const Material* material, ShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const uint32_t* value) const override;
+
+		virtual void BindVertexBuffers(uint32_t firstBinding, const std::vector<IBuffer*>& buffers, const std::vector<size_t>& offsets) const override;
+
+		virtual void BindIndexBuffer(const IBuffer& buffer, size_t offset, IndexType indexType) const override;
+
+		virtual void DrawIndexedIndirect(const IBuffer& buffer, size_t offset, uint32_t drawCount, uint32_t stride) const override;
+
+		virtual void DrawIndexedIndirectCount(const IBuffer& buffer, size_t offset, const IBuffer& countBuffer, size_t countOffset, uint32_t maxDrawCount, uint32_t stride) const override;
+
+		virtual void MemoryBarrier(MaterialStageFlags srcStage, MaterialAccessFlags srcMask, MaterialStageFlags dstStage, MaterialAccessFlags dstMask) const override;
+
+		virtual void MemoryBarrier(const IMemoryBarriers& memoryBarriersContainer) const override;
+
+		virtual void ClearColourImage(const IRenderImage& image, const Colour& colour) const override;
+
+		virtual void ClearDepthStencilImage(const IRenderImage& image, float depth, uint32_t stencil) const override;
+
+		virtual void FillBuffer(const IBuffer& buffer, size_t offset, size_t size, uint32_t data) const override;
+
+		void Record(CommandType type, const void* resource, uint64_t argument0 = 0, uint64_t argument1 = 0,
+			uint64_t argument2 = 0, uint64_t argument3 = 0) const;
+
+		inline const std::vector<RecordedCommand>& GetCommands() const { return m_commands; }
+		inline const std::vector<BufferBarrier>& GetBufferBarriers() const { return m_bufferBarriers; }
+		inline const std::vector<ImageBarrier>& GetImageBarriers() const { return m_imageBarriers; }
+
+	private:
+		mutable std::vector<RecordedCommand> m_commands;
+		mutable std::vector<BufferBarrier> m_bufferBarriers;
+		mutable std::vector<ImageBarrier> m_imageBarriers;
+		mutable bool m_recording;
+	};
+}
\ No newline at end of file
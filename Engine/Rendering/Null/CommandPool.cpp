@@ -0,0 +1,37 @@
+#include "CommandPool.hpp"
+#include "CommandBuffer.hpp"
+
+namespace Engine::Rendering::Null
+{
+	CommandPool::CommandPool()
+	{
+		m_queueFamilyIndex = 0;
+	}
+
+	bool CommandPool::Initialise(std::string_view name, const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t queueFamilyIndex, CommandPoolFlags flags)
+	{
+		m_queueFamilyIndex = queueFamilyIndex;
+		return true;
+	}
+
+	std::vector<std::unique_ptr<ICommandBuffer>> CommandPool::CreateCommandBuffers(std::string_view name, const IDevice& device, uint32_t count) const
+	{
+		std::vector<std::unique_ptr<ICommandBuffer>> results;
+		for (uint32_t i = 0; i < count; ++i)
+			results.emplace_back(std::make_unique<CommandBuffer>(m_queueFamilyIndex));
+
+		return results;
+	}
+
+	std::unique_ptr<ICommandBuffer> CommandPool::BeginResourceCommandBuffer(const IDevice& device) const
+	{
+		std::unique_ptr<CommandBuffer> commandBuffer = std::make_unique<CommandBuffer>(m_queueFamilyIndex);
+		commandBuffer->Begin();
+		return commandBuffer;
+	}
+
+	void CommandPool::Reset(const IDevice& device) const
+	{
+		// Command buffers clear their stream when recording begins again, which is all a pool reset needs to do here.
+	}
+}
\ No newline at end of file
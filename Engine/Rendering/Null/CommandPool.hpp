@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Resources/ICommandPool.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class CommandPool : public ICommandPool
+	{
+	public:
+		CommandPool();
+
+		virtual bool Initialise(std::string_view name, const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t queueFamilyIndex, CommandPoolFlags flags) override;
+
+		virtual std::vector<std::unique_ptr<ICommandBuffer>> CreateCommandBuffers(std::string_view name, const IDevice& device, uint32_t count) const override;
+		virtual std::unique_ptr<ICommandBuffer> BeginResourceCommandBuffer(const IDevice& device) const override;
+		virtual void Reset(const IDevice& device) const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../IDevice.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class Device : public IDevice
+	{
+	public:
+		Device() = default;
+	};
+}
\ No newline at end of file
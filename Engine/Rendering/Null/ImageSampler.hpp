@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Resources/IImageSampler.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class ImageSampler : public IImageSampler
+	{
+	public:
+		ImageSampler() = default;
+
+		inline virtual bool Initialise(const IDevice& device, Filter magFilter, Filter minFilter, SamplerMipmapMode mipMapMode,
+			SamplerAddressMode addressMode, float maxAnisotropy, SamplerCreationFlags flags) override
+		{
+			return true;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "ImageView.hpp"
+#include "Core/Logger.hpp"
+#include "../Resources/IRenderImage.hpp"
+
+namespace Engine::Rendering::Null
+{
+	ImageView::ImageView()
+		: m_image(nullptr)
+		, m_baseMipLevel(0)
+	{
+	}
+
+	bool ImageView::Initialise(std::string_view name, const IDevice& device, const IRenderImage& image, uint32_t baseMipLevel, uint32_t mipLevels,
+		uint32_t layerCount, Format format, ImageAspectFlags aspectFlags)
+	{
+		if (baseMipLevel + mipLevels > image.GetMipLevels() || layerCount > image.GetLayerCount())
+		{
+			Logger::Error("Image view '{}' exceeds the subresources of its image.", name);
+			return false;
+		}
+
+		m_image = &image;
+		m_baseMipLevel = baseMipLevel;
+		m_mipLevels = mipLevels;
+		m_layerCount = layerCount;
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Resources/IImageView.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class ImageView : public IImageView
+	{
+	public:
+		ImageView();
+		virtual bool Initialise(std::string_view name, const IDevice& device, const IRenderImage& image, uint32_t baseMipLevel,
+			uint32_t mipLevels, uint32_t layerCount, Format format, ImageAspectFlags aspectFlags) override;
+
+		inline const IRenderImage* GetImage() const { return m_image; }
+		inline uint32_t GetBaseMipLevel() const { return m_baseMipLevel; }
+
+	private:
+		const IRenderImage* m_image;
+		uint32_t m_baseMipLevel;
+	};
+}
\ No newline at end of file
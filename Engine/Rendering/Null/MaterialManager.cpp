@@ -0,0 +1,39 @@
+#include "MaterialManager.hpp"
+#include "NullMaterial.hpp"
+#include <filesystem>
+
+namespace Engine::Rendering::Null
+{
+	bool MaterialManager::BuildMaterials(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t concurrentFrames, Format swapchainFormat, Format depthFormat)
+	{
+		for (const auto& materialPath : std::filesystem::recursive_directory_iterator("Materials"))
+		{
+			if (materialPath.is_regular_file())
+			{
+				const auto& path = materialPath.path();
+				if (path.extension() == ".material")
+				{
+					// Nothing is compiled for the null backend, so the shaders do not need to have been built.
+					std::unique_ptr<NullMaterial> material = std::make_unique<NullMaterial>();
+					if (!material->Parse(path, false))
+						continue;
+
+					m_materials.emplace(material->GetName(), std::move(material));
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool MaterialManager::Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t concurrentFrames, Format swapchainFormat, Format depthFormat)
+	{
+		return BuildMaterials(physicalDevice, device, concurrentFrames, swapchainFormat, depthFormat);
+	}
+
+	bool MaterialManager::Update(const IPhysicalDevice& physicalDevice, const IDevice& device,
+		Format swapchainFormat, Format depthFormat) const
+	{
+		return true;
+	}
+}
\ No newline at end of file
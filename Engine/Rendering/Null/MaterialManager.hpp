@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../IMaterialManager.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class MaterialManager : public IMaterialManager
+	{
+	public:
+		MaterialManager() = default;
+		bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t concurrentFrames,
+			Format swapchainFormat, Format depthFormat) override;
+		bool Update(const IPhysicalDevice& physicalDevice, const IDevice& device, Format swapchainFormat,
+			Format depthFormat) const override;
+
+	private:
+		virtual bool BuildMaterials(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t concurrentFrames,
+			Format swapchainFormat, Format depthFormat) override;
+	};
+}
\ No newline at end of file
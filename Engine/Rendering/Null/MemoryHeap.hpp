@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../Resources/IMemoryHeap.hpp"
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering::Null
+{
+	// Nothing is backed by the heap, it only records the size so placements can be validated and reported.
+	class MemoryHeap : public IMemoryHeap
+	{
+	public:
+		MemoryHeap() = default;
+
+		inline virtual bool Initialise(std::string_view name, const IDevice& device, const MemoryRequirements& requirements) override
+		{
+			if (requirements.Size == 0)
+			{
+				Logger::Error("Memory heap '{}' cannot be created with a size of zero.", name);
+				return false;
+			}
+
+			m_size = requirements.Size;
+			return true;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "NullMaterial.hpp"
+#include "CommandBuffer.hpp"
+#include "../Resources/IBuffer.hpp"
+
+namespace Engine::Rendering::Null
+{
+	NullMaterial::NullMaterial()
+		: Material()
+		, m_specialisationConstants()
+	{
+	}
+
+	bool NullMaterial::SetSpecialisationConstant(std::string name, int32_t value)
+	{
+		m_specialisationConstants[name] = value;
+		return true;
+	}
+
+	bool NullMaterial::BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex, uint32_t instance) const
+	{
+		if (instance >= m_instanceCount)
+		{
+			Logger::Error("Binding instance {} of material '{}' which only has {} instances.", instance, GetName(), m_instanceCount);
+			return false;
+		}
+
+		static_cast<const CommandBuffer&>(commandBuffer).Record(CommandType::BindMaterial, this,
+			static_cast<uint64_t>(bindPoint), frameIndex, instance);
+
+		return true;
+	}
+
+	bool NullMaterial::ValidateBindingInstance() const
+	{
+		if (m_bindingInstance >= m_instanceCount)
+		{
+			Logger::Error("Binding instance {} of material '{}' which only has {} instances.", m_bindingInstance, GetName(), m_instanceCount);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool NullMaterial::BindImageViewsImp(uint32_t binding, const std::vector<const IImageView*>& imageViews)
+	{
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers)
+	{
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindCombinedImageSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers,
+		const std::vector<const IImageView*>& imageViews, const std::vector<ImageLayout>& imageLayouts)
+	{
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindStorageBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& storageBuffers)
+	{
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindStorageBufferRangeImp(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size)
+	{
+		if (offset + size > storageBuffer.Size())
+		{
+			Logger::Error("Range bound to binding {} of material '{}' exceeds the buffer size.", binding, GetName());
+			return false;
+		}
+
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindStorageImagesImp(uint32_t binding, const std::vector<const IImageView*>& imageViews)
+	{
+		return ValidateBindingInstance();
+	}
+
+	bool NullMaterial::BindUniformBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& uniformBuffers)
+	{
+		return ValidateBindingInstance();
+	}
+}
\ No newline at end of file
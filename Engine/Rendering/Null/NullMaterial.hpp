@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../Resources/Material.hpp"
+#include <unordered_map>
+
+namespace Engine::Rendering::Null
+{
+	// Parsed from the same material files as the Vulkan backend, but without shader reflection every binding and
+	// specialisation constant is accepted. Binding a material is recorded so passes can be told apart in the stream.
+	class NullMaterial : public Material
+	{
+	public:
+		NullMaterial();
+
+		virtual bool SetSpecialisationConstant(std::string name, int32_t value) override;
+		virtual bool BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex, uint32_t instance = 0) const override;
+
+		inline const std::unordered_map<std::string, int32_t>& GetSpecialisationConstants() const { return m_specialisationConstants; }
+
+	protected:
+		virtual bool BindImageViewsImp(uint32_t binding, const std::vector<const IImageView*>& imageViews) override;
+		virtual bool BindSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers) override;
+		virtual bool BindCombinedImageSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers,
+			const std::vector<const IImageView*>& imageViews, const std::vector<ImageLayout>& imageLayouts) override;
+		virtual bool BindStorageBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& storageBuffers) override;
+		virtual bool BindStorageBufferRangeImp(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size) override;
+		virtual bool BindStorageImagesImp(uint32_t binding, const std::vector<const IImageView*>& imageViews) override;
+		virtual bool BindUniformBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& uniformBuffers) override;
+
+	private:
+		bool ValidateBindingInstance() const;
+
+		std::unordered_map<std::string, int32_t> m_specialisationConstants;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../Resources/IMemoryBarriers.hpp"
+#include "../Types.hpp"
+#include <vector>
+
+namespace Engine::Rendering
+{
+	class IBuffer;
+	class IRenderImage;
+}
+
+namespace Engine::Rendering::Null
+{
+	struct BufferBarrier
+	{
+		const IBuffer* Buffer;
+		MaterialStageFlags SrcStage;
+		MaterialAccessFlags SrcAccess;
+		MaterialStageFlags DstStage;
+		MaterialAccessFlags DstAccess;
+		uint32_t SrcQueueFamily;
+		uint32_t DstQueueFamily;
+	};
+
+	struct ImageBarrier
+	{
+		const IRenderImage* Image;
+		ImageLayout OldLayout;
+		ImageLayout NewLayout;
+		uint32_t BaseMipLevel;
+		uint32_t MipLevelCount;
+		uint32_t SrcQueueFamily;
+		uint32_t DstQueueFamily;
+	};
+
+	class NullMemoryBarriers : public IMemoryBarriers
+	{
+	public:
+		NullMemoryBarriers()
+			: m_bufferBarriers()
+			, m_imageBarriers()
+		{
+		}
+
+		inline const std::vector<BufferBarrier>& GetBufferBarriers() const { return m_bufferBarriers; }
+		inline const std::vector<ImageBarrier>& GetImageBarriers() const { return m_imageBarriers; }
+
+		inline void AddBufferBarrier(const BufferBarrier& barrier) { m_bufferBarriers.emplace_back(barrier); }
+		inline void AddImageBarrier(const ImageBarrier& barrier) { m_imageBarriers.emplace_back(barrier); }
+
+		inline virtual bool Empty() const override
+		{
+			return m_bufferBarriers.empty() && m_imageBarriers.empty();
+		}
+
+		inline virtual void Clear() override
+		{
+			m_bufferBarriers.clear();
+			m_imageBarriers.clear();
+		}
+
+	private:
+		std::vector<BufferBarrier> m_bufferBarriers;
+		std::vector<ImageBarrier> m_imageBarriers;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../NvidiaReflex.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class NullNvidiaReflex : public NvidiaReflex
+	{
+	public:
+		NullNvidiaReflex() = default;
+
+		inline virtual bool SetMode(NvidiaReflexMode mode) override
+		{
+			return mode == NvidiaReflexMode::Off;
+		}
+
+		inline virtual bool Sleep() const override
+		{
+			return true;
+		}
+
+		inline virtual void SetMarker(NvidiaReflexMarker marker) const override
+		{
+		}
+	};
+}
\ No newline at end of file
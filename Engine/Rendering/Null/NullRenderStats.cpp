@@ -0,0 +1,72 @@
+#include "NullRenderStats.hpp"
+#include <algorithm>
+
+namespace Engine::Rendering::Null
+{
+	NullRenderStats::NullRenderStats()
+		: RenderStats()
+		, m_recordedStats()
+		, m_passStats()
+		, m_totalStats(nullptr)
+		, m_passStarts()
+	{
+	}
+
+	bool NullRenderStats::Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, const std::vector<std::string_view>& passNames,
+		const std::vector<bool>& computePasses, const std::vector<IRenderResource*>& renderResources)
+	{
+		InitialiseResourceMemoryUsage(renderResources);
+
+		m_recordedStats.assign(passNames.size(), {});
+		m_passStarts.assign(passNames.size(), {});
+		m_passStats.clear();
+		m_statsData.clear();
+
+		m_passStats.reserve(passNames.size());
+		for (std::string_view passName : passNames)
+			m_passStats.emplace_back(&m_statsData[std::string(passName)]);
+		m_totalStats = &m_statsData["Total"];
+
+		return true;
+	}
+
+	void NullRenderStats::Begin(const ICommandBuffer& commandBuffer, uint32_t passIndex)
+	{
+		// Passes may be recorded on several threads at once, so each keeps its start time in its own slot.
+		m_passStarts[passIndex] = std::chrono::high_resolution_clock::now();
+	}
+
+	void NullRenderStats::End(const ICommandBuffer& commandBuffer, uint32_t passIndex)
+	{
+		auto passEnd = std::chrono::high_resolution_clock::now();
+		auto passStart = m_passStarts[passIndex];
+
+		FrameStats& data = m_recordedStats[passIndex];
+		data = {};
+		data.RenderBegin = std::chrono::duration_cast<std::chrono::nanoseconds>(passStart.time_since_epoch()).count();
+		data.RenderEnd = std::chrono::duration_cast<std::chrono::nanoseconds>(passEnd.time_since_epoch()).count();
+		data.RenderTime = std::chrono::duration<float, std::chrono::milliseconds::period>(passEnd - passStart).count();
+	}
+
+	void NullRenderStats::FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device)
+	{
+		m_memoryStats.SharedUsage = UpdateResourceMemoryUsage();
+
+		// Add a 'Total' entry spanning the first pass recorded to the last.
+		FrameStats total = {};
+		total.RenderBegin = ~0ULL;
+		for (size_t i = 0; i < m_recordedStats.size(); ++i)
+		{
+			*m_passStats[i] = m_recordedStats[i];
+			total.RenderBegin = std::min(total.RenderBegin, m_recordedStats[i].RenderBegin);
+			total.RenderEnd = std::max(total.RenderEnd, m_recordedStats[i].RenderEnd);
+			m_recordedStats[i] = {};
+		}
+
+		if (total.RenderEnd < total.RenderBegin)
+			total.RenderBegin = total.RenderEnd;
+
+		total.RenderTime = float(total.RenderEnd - total.RenderBegin) / 1000000.0f;
+		*m_totalStats = total;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../RenderStats.hpp"
+#include <chrono>
+
+namespace Engine::Rendering::Null
+{
+	// Without GPU timestamps or pipeline statistics, pass times measure how long each pass took to record on the CPU.
+	class NullRenderStats : public RenderStats
+	{
+	public:
+		NullRenderStats();
+		virtual bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, const std::vector<std::string_view>& passNames,
+			const std::vector<bool>& computePasses, const std::vector<IRenderResource*>& renderResources) override;
+		virtual void Begin(const ICommandBuffer& commandBuffer, uint32_t passIndex) override;
+		virtual void End(const ICommandBuffer& commandBuffer, uint32_t passIndex) override;
+		virtual void FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device) override;
+
+	private:
+		std::vector<FrameStats> m_recordedStats;
+		std::vector<FrameStats*> m_passStats;
+		FrameStats* m_totalStats;
+		std::vector<std::chrono::high_resolution_clock::time_point> m_passStarts;
+	};
+}
\ No newline at end of file
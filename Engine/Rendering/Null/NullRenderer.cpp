@@ -0,0 +1,319 @@
+#include "NullRenderer.hpp"
+#include "OS/Window.hpp"
+#include "Core/Logger.hpp"
+#include "../Resources/GeometryBatch.hpp"
+#include "../RenderGraph.hpp"
+#include "../PostProcessing.hpp"
+#include "../Resources/IBuffer.hpp"
+#include "UI/Null/NullUIManager.hpp"
+#include "PhysicalDevice.hpp"
+#include "Device.hpp"
+#include "SwapChain.hpp"
+#include "CommandPool.hpp"
+#include "CommandBuffer.hpp"
+#include "Semaphore.hpp"
+#include "MaterialManager.hpp"
+#include "ResourceFactory.hpp"
+#include "NullRenderStats.hpp"
+#include "NullNvidiaReflex.hpp"
+#include <array>
+
+#define DEFAULT_MAX_CONCURRENT_FRAMES 2
+#define SWAPCHAIN_IMAGE_COUNT 3
+
+using namespace Engine::OS;
+using namespace Engine::UI::Null;
+
+namespace Engine::Rendering::Null
+{
+	NullRenderer::NullRenderer(Window& window, bool debug)
+		: Renderer(window, debug)
+		, m_presentImageIndex(0)
+		, m_resourceCommandPool()
+		, m_pendingResources()
+		, m_submittedCommandBuffers()
+		, m_frameStats()
+		, m_frameStart()
+		, m_resourceSubmitMutex()
+	{
+		m_maxConcurrentFrames = DEFAULT_MAX_CONCURRENT_FRAMES;
+	}
+
+	void NullRenderer::DestroyResources()
+	{
+		m_pendingResources.clear();
+		m_submittedCommandBuffers.clear();
+
+		Renderer::DestroyResources();
+
+		m_resourceCommandPool.reset();
+		m_swapChain.reset();
+		m_device.reset();
+		m_physicalDevice.reset();
+	}
+
+	NullRenderer::~NullRenderer()
+	{
+		if (!m_device.get())
+		{
+			return;
+		}
+
+		Logger::Verbose("Shutting down null renderer...");
+
+		DestroyResources();
+	}
+
+	bool NullRenderer::Initialise()
+	{
+		Logger::Verbose("Initialising null renderer...");
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		m_lastWindowSize = m_window.GetSize();
+
+		m_physicalDevice = std::make_unique<PhysicalDevice>();
+		m_device = std::make_unique<Device>();
+		m_swapChain = std::make_unique<SwapChain>();
+		m_resourceCommandPool = std::make_unique<CommandPool>();
+		m_geometryBatches.clear();
+		m_geometryBatches.emplace_back(std::make_unique<GeometryBatch>(*this));
+		m_renderStats = std::make_unique<NullRenderStats>();
+		m_materialManager = std::make_unique<MaterialManager>();
+		m_resourceFactory = std::make_unique<ResourceFactory>();
+		m_nvidiaReflex = std::make_unique<NullNvidiaReflex>();
+		m_uiManager = std::make_unique<NullUIManager>(m_window, *this);
+
+		uint32_t graphicsFamily = m_physicalDevice->GetQueueFamilyIndices().GraphicsFamily.value();
+		if (!m_postProcessing->Rebuild(m_lastWindowSize)
+			|| !static_cast<SwapChain*>(m_swapChain.get())->Initialise(*m_device, m_lastWindowSize, SWAPCHAIN_IMAGE_COUNT)
+			|| !m_resourceCommandPool->Initialise("ResourceCommandPool", *m_physicalDevice, *m_device, graphicsFamily, CommandPoolFlags::Transient))
+		{
+			return false;
+		}
+
+		// Every queue family is the same, so compute passes always record into the graphics submission.
+		m_asyncComputeSupported = false;
+
+		if (!Renderer::Initialise())
+		{
+			return false;
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(endTime - startTime).count();
+		Logger::Verbose("Renderer setup finished in {} seconds.", deltaTime);
+
+		return true;
+	}
+
+	bool NullRenderer::SubmitResourceCommand(std::function<bool(const IDevice& device, const IPhysicalDevice& physicalDevice, const ICommandBuffer&,
+		const ICommandBuffer&, std::vector<std::unique_ptr<IBuffer>>&)> command, std::optional<std::function<void()>> postAction, bool transfer)
+	{
+		// Scene and cell loads record resource commands from their own threads.
+		std::lock_guard<std::mutex> lock(m_resourceSubmitMutex);
+
+		// There is no transfer queue, so the release and acquire halves always share one command buffer.
+		ResourceCommandData resourceData = {};
+		resourceData.commandBuffer = std::move(m_resourceCommandPool->BeginResourceCommandBuffer(*m_device));
+		if (!command(*m_device, *m_physicalDevice, *resourceData.commandBuffer, *resourceData.commandBuffer, resourceData.buffers))
+		{
+			return false;
+		}
+
+		resourceData.commandBuffer->End();
+		resourceData.postAction = postAction;
+
+		m_pendingResources.emplace_back(std::move(resourceData));
+
+		return true;
+	}
+
+	bool NullRenderer::RecreateSwapChain(const glm::uvec2& size)
+	{
+		m_lastWindowSize = size;
+
+		if (!static_cast<SwapChain*>(m_swapChain.get())->Initialise(*m_device, size, SWAPCHAIN_IMAGE_COUNT))
+		{
+			return false;
+		}
+
+		if (!m_postProcessing->Rebuild(GetRenderExtent()))
+		{
+			return false;
+		}
+
+		m_renderGraph->MarkDirty();
+
+		return true;
+	}
+
+	IRenderImage& NullRenderer::GetPresentImage() const
+	{
+		return m_swapChain->GetSwapChainImage(m_presentImageIndex);
+	}
+
+	uint32_t NullRenderer::GetSwapChainImageCount() const
+	{
+		return static_cast<const SwapChain*>(m_swapChain.get())->GetImageCount();
+	}
+
+	bool NullRenderer::ResolveSemaphores(const std::vector<SubmitInfo>& renderSubmitInfos, const std::vector<SubmitInfo>& computeSubmitInfos)
+	{
+		// Each queue runs its submissions in order, a submission starts once the values it waits for are signalled. Work
+		// completes immediately, so a wait that is still unresolved once neither queue can move would hang a GPU.
+		std::array<const std::vector<SubmitInfo>*, 2> queues = { &computeSubmitInfos, &renderSubmitInfos };
+		std::array<size_t, 2> nextSubmits{};
+		bool progressed = true;
+		while (progressed)
+		{
+			progressed = false;
+			for (size_t queue = 0; queue < queues.size(); ++queue)
+			{
+				const std::vector<SubmitInfo>& submitInfos = *queues[queue];
+				for (; nextSubmits[queue] < submitInfos.size(); ++nextSubmits[queue])
+				{
+					const SubmitInfo& submitInfo = submitInfos[nextSubmits[queue]];
+					bool ready = true;
+					for (size_t i = 0; i < submitInfo.WaitSemaphores.size(); ++i)
+						ready &= static_cast<const Semaphore*>(submitInfo.WaitSemaphores[i])->SignalledValue >= submitInfo.WaitValues[i];
+
+					if (!ready)
+						break;
+
+					for (size_t i = 0; i < submitInfo.SignalSemaphores.size(); ++i)
+					{
+						uint64_t& value = static_cast<const Semaphore*>(submitInfo.SignalSemaphores[i])->SignalledValue;
+						if (submitInfo.SignalValues[i] <= value)
+						{
+							Logger::Error("Semaphore signalled with value {} after already reaching {}.", submitInfo.SignalValues[i], value);
+							return false;
+						}
+
+						value = submitInfo.SignalValues[i];
+					}
+
+					progressed = true;
+				}
+			}
+		}
+
+		if (nextSubmits[0] != computeSubmitInfos.size() || nextSubmits[1] != renderSubmitInfos.size())
+		{
+			Logger::Error("Frame submissions wait on semaphore values that are never signalled.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool NullRenderer::Present(const std::vector<SubmitInfo>& renderSubmitInfos, const std::vector<SubmitInfo>& computeSubmitInfos)
+	{
+		m_submittedCommandBuffers.clear();
+		m_frameStats = {};
+
+		if (!ResolveSemaphores(renderSubmitInfos, computeSubmitInfos))
+			return false;
+
+		for (const std::vector<SubmitInfo>* submitInfos : { &computeSubmitInfos, &renderSubmitInfos })
+		{
+			for (const SubmitInfo& submitInfo : *submitInfos)
+			{
+				for (const ICommandBuffer* commandBuffer : submitInfo.CommandBuffers)
+				{
+					const CommandBuffer* nullCommandBuffer = static_cast<const CommandBuffer*>(commandBuffer);
+					m_submittedCommandBuffers.emplace_back(nullCommandBuffer);
+
+					for (const RecordedCommand& command : nullCommandBuffer->GetCommands())
+					{
+						if (command.Type == CommandType::Draw || command.Type == CommandType::DrawIndexedIndirect
+							|| command.Type == CommandType::DrawIndexedIndirectCount)
+							++m_frameStats.DrawCount;
+						else if (command.Type == CommandType::Dispatch)
+							++m_frameStats.DispatchCount;
+						else if (command.Type == CommandType::PipelineBarrier)
+							++m_frameStats.PipelineBarrierCount;
+					}
+
+					m_frameStats.CommandCount += static_cast<uint32_t>(nullCommandBuffer->GetCommands().size());
+					m_frameStats.BufferBarrierCount += static_cast<uint32_t>(nullCommandBuffer->GetBufferBarriers().size());
+					m_frameStats.ImageBarrierCount += static_cast<uint32_t>(nullCommandBuffer->GetImageBarriers().size());
+				}
+			}
+		}
+
+		m_frameStats.CommandBufferCount = static_cast<uint32_t>(m_submittedCommandBuffers.size());
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_frameStats.RecordTime = std::chrono::duration<float, std::chrono::milliseconds::period>(endTime - m_frameStart).count();
+
+		if (m_debug)
+		{
+			Logger::Verbose("Frame recorded {} commands ({} draws, {} dispatches) in {} command buffers with {} pipeline barriers "
+				"({} buffer, {} image) in {}ms.", m_frameStats.CommandCount, m_frameStats.DrawCount, m_frameStats.DispatchCount,
+				m_frameStats.CommandBufferCount, m_frameStats.PipelineBarrierCount, m_frameStats.BufferBarrierCount,
+				m_frameStats.ImageBarrierCount, m_frameStats.RecordTime);
+		}
+
+		m_currentFrame = (m_currentFrame + 1) % m_maxConcurrentFrames;
+		return true;
+	}
+
+	bool NullRenderer::Render()
+	{
+		// Resource commands have already been applied when recorded, so their post actions can run straight away.
+		std::vector<ResourceCommandData> completedResources;
+		{
+			std::lock_guard<std::mutex> lock(m_resourceSubmitMutex);
+			completedResources = std::move(m_pendingResources);
+			m_pendingResources.clear();
+		}
+
+		for (const auto& resource : completedResources)
+		{
+			if (resource.postAction.has_value())
+			{
+				resource.postAction.value()();
+			}
+		}
+
+		// Skip rendering in minimised state.
+		const glm::uvec2& windowSize = m_window.GetSize();
+		if (windowSize.x == 0 || windowSize.y == 0)
+			return true;
+
+		// There is no image to acquire again after a resize, so the frame goes ahead with the graph rebuilt below.
+		if (windowSize != m_lastWindowSize && !RecreateSwapChain(windowSize))
+		{
+			Logger::Error("Failed to recreate swapchain.");
+			return false;
+		}
+
+		if (m_renderGraph->CheckDirty())
+		{
+			if (!m_renderGraph->Build(*this, m_asyncComputePendingState))
+			{
+				Logger::Error("Failed to build render graph.");
+				return false;
+			}
+
+			m_asyncComputeEnabled = m_asyncComputePendingState;
+
+			if (!m_materialManager->Update(*m_physicalDevice, *m_device, m_swapChain->GetFormat(), m_depthFormat))
+			{
+				Logger::Error("Failed to update material manager.");
+				return false;
+			}
+		}
+
+		m_presentImageIndex = (m_presentImageIndex + 1) % static_cast<SwapChain*>(m_swapChain.get())->GetImageCount();
+		m_frameStart = std::chrono::high_resolution_clock::now();
+
+		if (!Renderer::Render())
+		{
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
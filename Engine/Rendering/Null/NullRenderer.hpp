@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../Renderer.hpp"
+#include <chrono>
+#include <mutex>
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class CommandBuffer;
+	class CommandPool;
+
+	struct RecordedFrameStats
+	{
+		uint32_t CommandBufferCount;
+		uint32_t CommandCount;
+		uint32_t DrawCount;
+		uint32_t DispatchCount;
+		uint32_t PipelineBarrierCount;
+		uint32_t BufferBarrierCount;
+		uint32_t ImageBarrierCount;
+		float RecordTime;
+	};
+
+	// Runs the full render graph without a GPU or native window. Command buffers record into memory and are kept
+	// after submission until the next frame, so the work and barriers each frame produces can be inspected.
+	// Buffer copies and fills are applied as they are recorded, images have no contents.
+	class NullRenderer : public Renderer
+	{
+	public:
+		NullRenderer(Engine::OS::Window& window, bool debug);
+		virtual ~NullRenderer() override;
+
+		virtual bool Initialise() override;
+		virtual bool Render() override;
+
+		inline virtual void SetMultiSampleCount(uint32_t multiSampleCount) override
+		{
+			Engine::Logger::Warning("Multisampling not supported in null backend.");
+		}
+
+		virtual bool SubmitResourceCommand(std::function<bool(const IDevice& device, const IPhysicalDevice& physicalDevice,
+			const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, std::vector<std::unique_ptr<IBuffer>>&)> command,
+			std::optional<std::function<void()>> postAction = std::nullopt, bool transfer = false) override;
+
+		virtual IRenderImage& GetPresentImage() const override;
+		virtual bool Present(const std::vector<SubmitInfo>& renderSubmitInfos, const std::vector<SubmitInfo>& computeSubmitInfos) override;
+
+		// Compute command buffers come first, followed by the render command buffers in submission order.
+		inline const std::vector<const CommandBuffer*>& GetSubmittedCommandBuffers() const { return m_submittedCommandBuffers; }
+		inline const RecordedFrameStats& GetFrameStats() const { return m_frameStats; }
+		EXPORT uint32_t GetSwapChainImageCount() const;
+
+	protected:
+		virtual void DestroyResources() override;
+
+	private:
+		bool RecreateSwapChain(const glm::uvec2& size);
+
+		bool ResolveSemaphores(const std::vector<SubmitInfo>& renderSubmitInfos, const std::vector<SubmitInfo>& computeSubmitInfos);
+
+		struct ResourceCommandData
+		{
+			std::vector<std::unique_ptr<IBuffer>> buffers;
+			std::unique_ptr<ICommandBuffer> commandBuffer;
+			std::optional<std::function<void()>> postAction;
+		};
+
+		uint32_t m_presentImageIndex;
+		std::unique_ptr<CommandPool> m_resourceCommandPool;
+		std::vector<ResourceCommandData> m_pendingResources;
+		std::vector<const CommandBuffer*> m_submittedCommandBuffers;
+		RecordedFrameStats m_frameStats;
+		std::chrono::high_resolution_clock::time_point m_frameStart;
+		std::mutex m_resourceSubmitMutex;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "PhysicalDevice.hpp"
+
+namespace Engine::Rendering::Null
+{
+	PhysicalDevice::PhysicalDevice()
+		: m_queueFamilyIndices()
+	{
+		m_queueFamilyIndices.GraphicsFamily = 0;
+		m_queueFamilyIndices.PresentFamily = 0;
+		m_queueFamilyIndices.ComputeFamily = 0;
+		m_queueFamilyIndices.TransferFamily = 0;
+	}
+
+	Format PhysicalDevice::FindDepthFormat()
+	{
+		if (m_depthFormat == Format::Undefined)
+			m_depthFormat = Format::D24UnormS8Uint;
+
+		return m_depthFormat;
+	}
+}
\ No newline at end of file
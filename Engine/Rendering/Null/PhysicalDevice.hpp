@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../QueueFamilyIndices.hpp"
+#include "../IPhysicalDevice.hpp"
+
+namespace Engine::Rendering::Null
+{
+	// A single queue family handles every kind of work, so async compute and the transfer queue are never used.
+	class PhysicalDevice : public IPhysicalDevice
+	{
+	public:
+		PhysicalDevice();
+		virtual Format FindDepthFormat() override;
+		inline virtual bool FormatSupported(Format format) const override { return true; }
+		inline virtual float GetMaxAnisotropy() const override { return 16.0f; }
+		inline virtual bool SupportsBCTextureCompression() const override { return true; }
+		inline virtual const QueueFamilyIndices& GetQueueFamilyIndices() const override { return m_queueFamilyIndices; }
+
+	private:
+		QueueFamilyIndices m_queueFamilyIndices;
+	};
+}
\ No newline at end of file
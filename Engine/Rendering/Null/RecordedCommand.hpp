@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+
+namespace Engine::Rendering::Null
+{
+	enum class CommandType
+	{
+		BeginRendering,
+		EndRendering,
+		BindMaterial,
+		PushConstants,
+		BindVertexBuffers,
+		BindIndexBuffer,
+		Draw,
+		DrawIndexedIndirect,
+		DrawIndexedIndirectCount,
+		Dispatch,
+		PipelineBarrier,
+		BlitImage,
+		CopyBuffer,
+		CopyBufferToImage,
+		ClearColourImage,
+		ClearDepthStencilImage,
+		FillBuffer
+	};
+
+	// A single recorded command. Resource is the buffer, image or material the command operates on, the meaning of
+	// the arguments depends on the type, e.g. group counts for dispatches and memory, buffer and image barrier counts for barriers.
+	struct RecordedCommand
+	{
+		CommandType Type;
+		const void* Resource;
+		std::array<uint64_t, 4> Arguments;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "RenderImage.hpp"
+#include "CommandBuffer.hpp"
+#include "ImageView.hpp"
+#include "NullMemoryBarriers.hpp"
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering::Null
+{
+	RenderImage::RenderImage()
+		: IRenderImage()
+		, m_name()
+		, m_releaseLayout(ImageLayout::Undefined)
+	{
+	}
+
+	static inline bool LayoutSupported(ImageUsageFlags flags, ImageLayout layout)
+	{
+		switch (layout)
+		{
+		case ImageLayout::ColorAttachment:
+			return (flags & ImageUsageFlags::ColorAttachment) == ImageUsageFlags::ColorAttachment;
+		case ImageLayout::DepthStencilAttachment:
+			return (flags & ImageUsageFlags::DepthStencilAttachment) == ImageUsageFlags::DepthStencilAttachment;
+		case ImageLayout::ShaderReadOnly:
+			return (flags & ImageUsageFlags::Sampled) == ImageUsageFlags::Sampled;
+		case ImageLayout::TransferSrc:
+			return (flags & ImageUsageFlags::TransferSrc) == ImageUsageFlags::TransferSrc;
+		case ImageLayout::TransferDst:
+			return (flags & ImageUsageFlags::TransferDst) == ImageUsageFlags::TransferDst;
+		case ImageLayout::General:
+			return (flags & ImageUsageFlags::Storage) == ImageUsageFlags::Storage;
+		case ImageLayout::PresentSrc:
+			return (flags & ImageUsageFlags::ColorAttachment) == ImageUsageFlags::ColorAttachment;
+		case ImageLayout::Undefined:
+			return true;
+		default: // Unexpected layout, return false.
+			return false;
+		}
+	}
+
+	bool RenderImage::Initialise(std::string_view name, const IDevice& device, ImageType imageType, Format format, const glm::uvec3& dimensions,
+		uint32_t mipLevels, uint32_t layerCount, ImageTiling tiling, ImageUsageFlags imageUsage, ImageAspectFlags aspectFlags,
+		MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode)
+	{
+		if (dimensions.x == 0 || dimensions.y == 0 || dimensions.z == 0 || mipLevels == 0 || layerCount == 0)
+		{
+			Logger::Error("Failed to create RenderImage '{}'.", name);
+			return false;
+		}
+
+		m_name = name;
+		m_format = format;
+		m_dimensions = dimensions;
+		m_mipLevels = mipLevels;
+		m_layerCount = layerCount;
+		m_usageFlags = imageUsage;
+		m_layout = ImageLayout::Undefined;
+		m_releaseLayout = ImageLayout::Undefined;
+
+		if (!InitialiseView(name, device, aspectFlags))
+		{
+			Logger::Error("Failed to create image view for image '{}'.", name);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RenderImage::InitialiseView(std::string_view name, const IDevice& device, ImageAspectFlags aspectFlags)
+	{
+		m_imageView = std::make_unique<ImageView>();
+		if (!m_imageView->Initialise(name, device, *this, 0, m_mipLevels, m_layerCount, m_format, aspectFlags))
+		{
+			Logger::Error("Failed to create image view.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RenderImage::InitialiseUnbound(std::string_view name, const IDevice& device, ImageType imageType, Format format,
+		const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount, ImageTiling tiling, ImageUsageFlags imageUsage,
+		SharingMode sharingMode)
+	{
+		if (dimensions.x == 0 || dimensions.y == 0 || dimensions.z == 0 || mipLevels == 0 || layerCount == 0)
+		{
+			Logger::Error("Failed to create RenderImage '{}'.", name);
+			return false;
+		}
+
+		m_name = name;
+		m_format = format;
+		m_dimensions = dimensions;
+		m_mipLevels = mipLevels;
+		m_layerCount = layerCount;
+		m_usageFlags = imageUsage;
+		m_layout = ImageLayout::Undefined;
+		m_releaseLayout = ImageLayout::Undefined;
+
+		return true;
+	}
+
+	static inline uint64_t GetTexelSize(Format format)
+	{
+		switch (format)
+		{
+		case Format::R8Unorm:
+		case Format::Bc5UnormBlock: // Block compressed formats store 16 bytes per 4x4 block.
+		case Format::Bc7SrgbBlock:
+		case Format::Bc7UnormBlock:
+			return 1;
+		case Format::R8G8Unorm:
+			return 2;
+		case Format::R8G8B8Unorm:
+			return 3;
+		case Format::R16G16B16Sfloat:
+			return 6;
+		case Format::R16G16B16A16Sfloat:
+		case Format::R32G32Sfloat:
+		case Format::R32G32Uint:
+		case Format::D32SfloatS8Uint:
+			return 8;
+		case Format::R32G32B32Sfloat:
+			return 12;
+		case Format::R32G32B32A32Sfloat:
+			return 16;
+		default:
+			return 4;
+		}
+	}
+
+	MemoryRequirements RenderImage::GetMemoryRequirements(const IDevice& device) const
+	{
+		const uint64_t alignment = 65536;
+
+		uint64_t size = 0;
+		glm::uvec3 mipDimensions = m_dimensions;
+		for (uint32_t i = 0; i < m_mipLevels; ++i)
+		{
+			size += static_cast<uint64_t>(mipDimensions.x) * mipDimensions.y * mipDimensions.z;
+			mipDimensions = glm::max(mipDimensions / 2u, glm::uvec3(1));
+		}
+
+		size *= GetTexelSize(m_format) * m_layerCount;
+		size = (size + alignment - 1) & ~(alignment - 1);
+
+		return { size, alignment, 1 };
+	}
+
+	bool RenderImage::BindMemory(std::string_view name, const IDevice& device, const IMemoryHeap& memoryHeap,
+		uint64_t offset, ImageAspectFlags aspectFlags)
+	{
+		MemoryRequirements requirements = GetMemoryRequirements(device);
+		if (offset % requirements.Alignment != 0 || offset + requirements.Size > memoryHeap.GetSize())
+		{
+			Logger::Error("Image '{}' placed at offset {} does not fit a memory heap of {} bytes.", name, offset, memoryHeap.GetSize());
+			return false;
+		}
+
+		if (!InitialiseView(name, device, aspectFlags))
+		{
+			Logger::Error("Failed to create image view for image '{}'.", name);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RenderImage::CreateView(std::string_view name, const IDevice& device, uint32_t baseMipLevel, ImageAspectFlags aspectFlags, std::unique_ptr<IImageView>& imageView) const
+	{
+		if (m_layerCount != 1)
+		{
+			Logger::Error("Creating image views with more than one layer currently not supported.");
+			return false;
+		}
+
+		imageView = std::make_unique<ImageView>();
+		if (!imageView->Initialise(name, device, *this, baseMipLevel, 1, 1, m_format, aspectFlags))
+		{
+			Logger::Error("Failed to create image view.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RenderImage::UpdateContents(const void* data, size_t offset, uint64_t size)
+	{
+		return true;
+	}
+
+	bool RenderImage::AppendTransition(const ICommandBuffer& commandBuffer, ImageLayout newLayout, IMemoryBarriers& memoryBarriers,
+		uint32_t baseMipLevel, uint32_t mipLevelCount, uint32_t srcQueueFamily, uint32_t dstQueueFamily)
+	{
+		if (!LayoutSupported(m_usageFlags, newLayout))
+		{
+			Logger::Error("Image was not created with usage flags that support the requested layout.");
+			return false;
+		}
+
+		if (newLayout == ImageLayout::Undefined)
+		{
+			Logger::Error("New image layout cannot be undefined.");
+			return false;
+		}
+
+		bool isQueueRelease = false;
+		if (srcQueueFamily != dstQueueFamily)
+		{
+			uint32_t commandBufferQueueIndex = commandBuffer.GetQueueFamilyIndex();
+			if (commandBufferQueueIndex != srcQueueFamily && commandBufferQueueIndex != dstQueueFamily)
+			{
+				Logger::Error("Command buffer queue family index matches neither requested source or destination index.");
+				return false;
+			}
+
+			isQueueRelease = commandBufferQueueIndex == srcQueueFamily;
+		}
+
+		// An acquire that completes a matching release repeats its transition exactly so the contents are kept.
+		ImageLayout oldLayout = m_layout;
+		if (srcQueueFamily != dstQueueFamily && srcQueueFamily != commandBuffer.GetQueueFamilyIndex() && newLayout != m_releaseLayout) // acquire
+			oldLayout = ImageLayout::Undefined;
+
+		NullMemoryBarriers& nullMemoryBarriers = static_cast<NullMemoryBarriers&>(memoryBarriers);
+		nullMemoryBarriers.AddImageBarrier({ this, oldLayout, newLayout, baseMipLevel, mipLevelCount == 0 ? m_mipLevels : mipLevelCount,
+			srcQueueFamily, dstQueueFamily });
+
+		if (isQueueRelease)
+			m_releaseLayout = newLayout;
+		else
+			m_layout = newLayout;
+
+		return true;
+	}
+
+	bool RenderImage::AppendImageLayoutTransition(const ICommandBuffer& commandBuffer,
+		ImageLayout newLayout, IMemoryBarriers& memoryBarriers, uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily, bool compute)
+	{
+		// Skip barrier if it's redundant.
+		if (m_layout == newLayout && srcQueueFamily == dstQueueFamily)
+			return false;
+
+		return AppendTransition(commandBuffer, newLayout, memoryBarriers, 0, m_mipLevels, srcQueueFamily, dstQueueFamily);
+	}
+
+	bool RenderImage::AppendImageLayoutTransitionExt(const ICommandBuffer& commandBuffer,
+		MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+		IMemoryBarriers& memoryBarriers, uint32_t baseMipLevel, uint32_t mipLevelCount,
+		uint32_t srcQueueFamily, uint32_t dstQueueFamily, bool compute)
+	{
+		return AppendTransition(commandBuffer, newLayout, memoryBarriers, baseMipLevel, mipLevelCount, srcQueueFamily, dstQueueFamily);
+	}
+
+	bool RenderImage::AppendAliasingBarrier(const ICommandBuffer& commandBuffer,
+		MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+		MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+		IMemoryBarriers& memoryBarriers)
+	{
+		if (!LayoutSupported(m_usageFlags, newLayout))
+		{
+			Logger::Error("Image was not created with usage flags that support the requested layout.");
+			return false;
+		}
+
+		NullMemoryBarriers& nullMemoryBarriers = static_cast<NullMemoryBarriers&>(memoryBarriers);
+		nullMemoryBarriers.AddImageBarrier({ this, ImageLayout::Undefined, newLayout, 0, m_mipLevels, 0, 0 });
+
+		m_layout = newLayout;
+		m_releaseLayout = ImageLayout::Undefined;
+
+		return true;
+	}
+
+	void RenderImage::GenerateMipmaps(const ICommandBuffer& commandBuffer)
+	{
+		NullMemoryBarriers memoryBarriers{};
+		if (m_mipLevels == 1)
+		{
+			AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, memoryBarriers, 0, 0, false);
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			return;
+		}
+
+		if (m_layerCount != 1)
+		{
+			Logger::Error("Generating mip maps for texture arrays is currently not supported.");
+			return;
+		}
+
+		// Mirrors the barriers and blits the Vulkan backend records, each level is read once the previous one is written.
+		const CommandBuffer& nullCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer);
+		for (uint32_t i = 1; i < m_mipLevels; ++i)
+		{
+			memoryBarriers.AddImageBarrier({ this, ImageLayout::TransferDst, ImageLayout::TransferSrc, i - 1, 1, 0, 0 });
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
+
+			nullCommandBuffer.Record(CommandType::BlitImage, this, reinterpret_cast<uint64_t>(this), 1, static_cast<uint64_t>(Filter::Linear));
+
+			memoryBarriers.AddImageBarrier({ this, ImageLayout::TransferSrc, ImageLayout::ShaderReadOnly, i - 1, 1, 0, 0 });
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
+		}
+
+		memoryBarriers.AddImageBarrier({ this, ImageLayout::TransferDst, ImageLayout::ShaderReadOnly, m_mipLevels - 1, 1, 0, 0 });
+		commandBuffer.MemoryBarrier(memoryBarriers);
+	}
+}
\ No newline at end of file
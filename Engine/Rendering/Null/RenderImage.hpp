@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../Resources/IRenderImage.hpp"
+#include <string>
+
+namespace Engine::Rendering::Null
+{
+	// Tracks the state a real image would have, layouts, queue ownership and subresources, without holding any texels.
+	class RenderImage : public IRenderImage
+	{
+	public:
+		RenderImage();
+		RenderImage(const RenderImage&) = delete;
+
+		virtual bool Initialise(std::string_view name, const IDevice& device, ImageType imageType,
+			Format format, const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount,
+			ImageTiling tiling, ImageUsageFlags imageUsage, ImageAspectFlags aspectFlags,
+			MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode) override;
+
+		virtual bool InitialiseView(std::string_view name, const IDevice& device, ImageAspectFlags aspectFlags) override;
+
+		virtual bool InitialiseUnbound(std::string_view name, const IDevice& device, ImageType imageType,
+			Format format, const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount,
+			ImageTiling tiling, ImageUsageFlags imageUsage, SharingMode sharingMode) override;
+
+		// Sizes are the tightly packed texel data aligned to 64KiB, roughly what discrete GPUs require for render targets.
+		virtual MemoryRequirements GetMemoryRequirements(const IDevice& device) const override;
+
+		virtual bool BindMemory(std::string_view name, const IDevice& device, const IMemoryHeap& memoryHeap,
+			uint64_t offset, ImageAspectFlags aspectFlags) override;
+
+		virtual bool UpdateContents(const void* data, size_t offset, uint64_t size) override;
+
+		virtual bool AppendImageLayoutTransition(const ICommandBuffer& commandBuffer,
+			ImageLayout newLayout, IMemoryBarriers& memoryBarriers, uint32_t srcQueueFamily,
+			uint32_t dstQueueFamily, bool compute) override;
+
+		virtual bool AppendImageLayoutTransitionExt(const ICommandBuffer& commandBuffer,
+			MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+			IMemoryBarriers& memoryBarriers, uint32_t baseMipLevel, uint32_t mipLevelCount,
+			uint32_t srcQueueFamily, uint32_t dstQueueFamily, bool compute) override;
+
+		virtual bool AppendAliasingBarrier(const ICommandBuffer& commandBuffer,
+			MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+			MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+			IMemoryBarriers& memoryBarriers) override;
+
+		virtual void GenerateMipmaps(const ICommandBuffer& commandBuffer) override;
+
+		virtual bool CreateView(std::string_view name, const IDevice& device, uint32_t baseMipLevel,
+			ImageAspectFlags aspectFlags, std::unique_ptr<IImageView>& imageView) const override;
+
+		inline const std::string& GetName() const { return m_name; }
+
+	private:
+		bool AppendTransition(const ICommandBuffer& commandBuffer, ImageLayout newLayout, IMemoryBarriers& memoryBarriers,
+			uint32_t baseMipLevel, uint32_t mipLevelCount, uint32_t srcQueueFamily, uint32_t dstQueueFamily);
+
+		std::string m_name;
+		ImageLayout m_releaseLayout;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "ResourceFactory.hpp"
+#include "Buffer.hpp"
+#include "ImageSampler.hpp"
+#include "RenderImage.hpp"
+#include "CommandPool.hpp"
+#include "Semaphore.hpp"
+#include "NullMemoryBarriers.hpp"
+#include "MemoryHeap.hpp"
+
+namespace Engine::Rendering::Null
+{
+	std::unique_ptr<IBuffer> ResourceFactory::CreateBuffer() const
+	{
+		return std::make_unique<Buffer>();
+	}
+
+	std::unique_ptr<IRenderImage> ResourceFactory::CreateRenderImage() const
+	{
+		return std::make_unique<RenderImage>();
+	}
+
+	std::unique_ptr<IImageSampler> ResourceFactory::CreateImageSampler() const
+	{
+		return std::make_unique<ImageSampler>();
+	}
+
+	std::unique_ptr<ICommandPool> ResourceFactory::CreateCommandPool() const
+	{
+		return std::make_unique<CommandPool>();
+	}
+
+	std::unique_ptr<ISemaphore> ResourceFactory::CreateGraphicsSemaphore() const
+	{
+		return std::make_unique<Semaphore>();
+	}
+
+	std::unique_ptr<IMemoryBarriers> ResourceFactory::CreateMemoryBarriers() const
+	{
+		return std::make_unique<NullMemoryBarriers>();
+	}
+
+	std::unique_ptr<IMemoryHeap> ResourceFactory::CreateMemoryHeap() const
+	{
+		return std::make_unique<MemoryHeap>();
+	}
+}
\ No newline at end of file
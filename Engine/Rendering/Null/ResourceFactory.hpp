@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../IResourceFactory.hpp"
+
+namespace Engine::Rendering::Null
+{
+	class ResourceFactory : public IResourceFactory
+	{
+	public:
+		ResourceFactory() = default;
+		virtual std::unique_ptr<IBuffer> CreateBuffer() const override;
+		virtual std::unique_ptr<IRenderImage> CreateRenderImage() const override;
+		virtual std::unique_ptr<IImageSampler> CreateImageSampler() const override;
+		virtual std::unique_ptr<ICommandPool> CreateCommandPool() const override;
+		virtual std::unique_ptr<ISemaphore> CreateGraphicsSemaphore() const override;
+		virtual std::unique_ptr<IMemoryBarriers> CreateMemoryBarriers() const override;
+		virtual std::unique_ptr<IMemoryHeap> CreateMemoryHeap() const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../Resources/ISemaphore.hpp"
+#include <string_view>
+
+namespace Engine::Rendering::Null
+{
+	// Work completes as soon as it is submitted, so the value last signalled is all there is to a semaphore. It is
+	// advanced when submissions are presented, which checks every wait can be satisfied.
+	class Semaphore : public ISemaphore
+	{
+	public:
+		Semaphore()
+			: SignalledValue(0)
+		{
+		}
+
+		inline virtual bool Initialise(std::string_view name, const IDevice& device, bool binary) override
+		{
+			return true;
+		}
+
+		mutable uint64_t SignalledValue;
+	};
+}
\ No newline at end of file
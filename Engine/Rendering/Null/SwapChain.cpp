@@ -0,0 +1,37 @@
+#include "SwapChain.hpp"
+#include "RenderImage.hpp"
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering::Null
+{
+	SwapChain::SwapChain()
+		: ISwapChain()
+	{
+		// There is no display to query, so HDR output is never available.
+		m_hdrSupport = false;
+	}
+
+	bool SwapChain::Initialise(const IDevice& device, const glm::uvec2& size, uint32_t imageCount)
+	{
+		m_swapChainImageFormat = Format::B8G8R8A8Unorm;
+		m_swapChainExtent = size;
+		m_swapChainImages.clear();
+		m_swapChainImages.reserve(imageCount);
+
+		for (uint32_t i = 0; i < imageCount; ++i)
+		{
+			std::unique_ptr<RenderImage> renderImage = std::make_unique<RenderImage>();
+			if (!renderImage->Initialise("SwapchainImage", device, ImageType::e2D, m_swapChainImageFormat, glm::uvec3(size, 1),
+				1, 1, ImageTiling::Optimal, ImageUsageFlags::ColorAttachment | ImageUsageFlags::TransferDst, ImageAspectFlags::Color,
+				MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive))
+			{
+				Logger::Error("Failed to create swap chain.");
+				return false;
+			}
+
+			m_swapChainImages.push_back(std::move(renderImage));
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../ISwapChain.hpp"
+
+namespace Engine::Rendering
+{
+	class IDevice;
+}
+
+namespace Engine::Rendering::Null
+{
+	class SwapChain : public ISwapChain
+	{
+	public:
+		SwapChain();
+
+		bool Initialise(const IDevice& device, const glm::uvec2& size, uint32_t imageCount);
+
+		inline uint32_t GetImageCount() const { return static_cast<uint32_t>(m_swapChainImages.size()); }
+	};
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "RenderPasses/PostProcessing/SMAABlendPass.hpp"
 #include "RenderPasses/PostProcessing/TAAPass.hpp"
 #include "RenderPasses/PostProcessing/TonemapperPass.hpp"
+#include "RenderPasses/PostProcessing/UpscalePass.hpp"
+#include "Resources/IBuffer.hpp"
 
 namespace Engine::Rendering
 {
@@ -15,6 +17,7 @@ namespace Engine::Rendering
 		, m_smaaBlendPass(nullptr)
 		, m_taaPass(nullptr)
 		, m_tonemapperPass(nullptr)
+		, m_upscalePass(nullptr)
 		, m_taaFrameIndex(0)
 		, m_taaJitterOffsets()
 	{
@@ -28,6 +31,7 @@ namespace Engine::Rendering
 		m_smaaBlendPass = std::make_unique<SMAABlendPass>();
 		m_taaPass = std::make_unique<TAAPass>();
 		m_tonemapperPass = std::make_unique<TonemapperPass>();
+		m_upscalePass = std::make_unique<UpscalePass>();
 		return true;
 	}
 
@@ -20,7 +20,7 @@ namespace Engine::Rendering
 		inline std::vector<IRenderPass*> GetRenderPasses() const
 		{
 			return { m_tonemapperPass.get(), m_fxaaPass.get(), m_smaaEdgesPass.get(),
-				m_smaaWeightsPass.get(), m_smaaBlendPass.get(), m_taaPass.get() };
+				m_smaaWeightsPass.get(), m_smaaBlendPass.get(), m_taaPass.get(), m_upscalePass.get() };
 		}
 
 		inline const glm::vec2& GetTAAJitter()
@@ -38,5 +38,6 @@ namespace Engine::Rendering
 		std::unique_ptr<IRenderPass> m_smaaBlendPass;
 		std::unique_ptr<IRenderPass> m_taaPass;
 		std::unique_ptr<IRenderPass> m_tonemapperPass;
+		std::unique_ptr<IRenderPass> m_upscalePass;
 	};
 }
\ No newline at end of file
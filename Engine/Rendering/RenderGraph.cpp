@@ -1,6 +1,8 @@
 #include "RenderGraph.hpp"
 #include "Renderer.hpp"
 #include "Core/Logger.hpp"
+#include "Core/Hash.hpp"
+#include "OS/Files.hpp"
 #include "IMaterialManager.hpp"
 #include "QueueFamilyIndices.hpp"
 #include "Resources/ICommandBuffer.hpp"
@@ -11,6 +13,14 @@
 #include "IResourceFactory.hpp"
 #include "IPhysicalDevice.hpp"
 #include <ranges>
+#include <map>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <atomic>
+
+using namespace Engine::OS;
 
 namespace Engine::Rendering
 {
@@ -21,20 +31,56 @@ namespace Engine::Rendering
 		, m_renderPasses()
 		, m_renderNodeLookup()
 		, m_dirty(true)
+		, m_pendingChange(RenderGraphChange::All)
+		, m_buildChange(RenderGraphChange::All)
+		, m_nodeBuildCount(0)
+		, m_buildCount(0)
 		, m_asyncCompute(false)
+		, m_parallelRecording(true)
 		, m_finalNode(nullptr)
+		, m_renderExtent()
 		, m_renderCommandBuffers()
 		, m_computeCommandBuffers()
 		, m_renderCommandPools()
 		, m_computeCommandPools()
-		, m_imageInfoBarrierState()
-		, m_bufferInfoBarrierState()
+		, m_passRecordings()
+		, m_imageBarrierStateLookup()
+		, m_bufferBarrierStateLookup()
+		, m_imageBarrierStates()
+		, m_bufferBarrierStates()
 		, m_renderToComputeSemaphore(nullptr)
 		, m_computeToRenderSemaphore(nullptr)
+		, m_renderSignalCount(0)
+		, m_computeSignalCount(0)
+		, m_previousFrameSignalled(false)
 		, m_renderTextures()
+		, m_transientImages()
+		, m_transientImageLookup()
+		, m_transientMemoryStats()
+		, m_memoryHeapRequirements()
+		, m_memoryHeaps()
+		, m_nodeBindings()
+		, m_freshResources()
+		, m_previousTransientImages()
+		, m_previousMemoryHeapRequirements()
+		, m_previousMemoryHeaps()
+		, m_previousRenderTextures()
 		, m_renderStats(renderStats)
 		, m_blitCommandBuffers()
 		, m_perStageOwnershipReleaseResources()
+		, m_executionPlan()
+		, m_recordedRenderPasses()
+		, m_scheduleStats()
+		, m_layoutCache()
+		, m_serialisedLayout()
+		, m_layoutCacheHit(false)
+		, m_renderSubmitInfos()
+		, m_computeSubmitInfos()
+		, m_stageMemoryBarriers(nullptr)
+		, m_renderToComputeMemoryBarriers(nullptr)
+		, m_computeToRenderMemoryBarriers(nullptr)
+		, m_blitRegions()
+		, m_finalImage(nullptr)
 	{
 	}
 
@@ -43,6 +89,7 @@ namespace Engine::Rendering
 		m_blitCommandBuffers.clear();
 		m_renderCommandBuffers.clear();
 		m_computeCommandBuffers.clear();
+		m_passRecordings.clear();
 		m_renderCommandPools.clear();
 		m_computeCommandPools.clear();
 	}
@@ -57,6 +104,7 @@ namespace Engine::Rendering
 		m_renderCommandBuffers.clear();
 		m_computeCommandBuffers.clear();
 		m_blitCommandBuffers.clear();
+		m_passRecordings.clear();
 		m_renderCommandPools.clear();
 		m_computeCommandPools.clear();
 
@@ -100,6 +148,11 @@ namespace Engine::Rendering
 			}
 		}
 
+		// Barriers are gathered into the same containers every frame rather than allocating new ones per stage.
+		m_stageMemoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+		m_renderToComputeMemoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+		m_computeToRenderMemoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+
 		m_asyncCompute = asyncCompute;
 
 		return true;
@@ -192,8 +245,11 @@ namespace Engine::Rendering
 			return;
 		}
 
+		if (pass->second->GetEnabled() == enabled)
+			return;
+
 		pass->second->SetEnabled(enabled);
-		m_dirty = true;
+		MarkDirty(RenderGraphChange::Passes);
 	}
 
 	bool RenderGraph::GetPassEnabled(const std::string& passName) const
@@ -208,6 +264,36 @@ namespace Engine::Rendering
 		return pass->second->GetEnabled();
 	}
 
+	void RenderGraph::SetPassBypassed(const std::string& passName, bool bypassed)
+	{
+		auto pass = m_renderNodeLookup.find(passName);
+		if (pass == m_renderNodeLookup.end())
+		{
+			Logger::Error("Pass '{}' not found in render graph.", passName);
+			return;
+		}
+
+		if (bypassed && !pass->second->GetEnabled())
+		{
+			Logger::Error("Pass '{}' is disabled and not part of the render graph, it cannot be bypassed.", passName);
+			return;
+		}
+
+		pass->second->SetBypassed(bypassed);
+	}
+
+	bool RenderGraph::GetPassBypassed(const std::string& passName) const
+	{
+		auto pass = m_renderNodeLookup.find(passName);
+		if (pass == m_renderNodeLookup.end())
+		{
+			Logger::Error("Pass '{}' not found in render graph.", passName);
+			return false;
+		}
+
+		return pass->second->GetBypassed();
+	}
+
 	bool RenderGraph::AddResource(IRenderResource* renderResource)
 	{
 		if (m_renderNodeLookup.contains(renderResource->GetName()))
@@ -216,7 +302,7 @@ namespace Engine::Rendering
 			return false;
 		}
 
-		for (const auto bufferOutput : renderResource->GetBufferOutputInfos())
+		for (const auto& bufferOutput : renderResource->GetBufferOutputInfos())
 		{
 			if (m_bufferResourceNodeLookup.contains(bufferOutput.first))
 			{
@@ -243,9 +329,31 @@ namespace Engine::Rendering
 		return true;
 	}
 
-	inline bool RenderGraph::TryGetOrAddImage(std::string_view name, const Renderer& renderer, std::unordered_map<Format, std::vector<ImageInfo>>& formatRenderTextureLookup,
-		std::vector<std::unique_ptr<IRenderImage>>& renderTextures, std::unordered_map<IRenderImage*, uint32_t>& imageInfoLookup,
-		Format format, AccessFlags accessFlags, const glm::uvec3& dimensions, IRenderImage** result) const
+	bool RenderGraph::InitialiseTransientImage(std::string_view name, const Renderer& renderer, Format format, const glm::uvec3& dimensions,
+		IRenderImage& image, ImageAspectFlags& aspectFlags) const
+	{
+		Format depthFormat = renderer.GetPhysicalDevice().GetDepthFormat();
+
+		ImageUsageFlags usageFlags;
+		if (format == depthFormat)
+		{
+			aspectFlags = ImageAspectFlags::Depth;
+			usageFlags = ImageUsageFlags::DepthStencilAttachment | ImageUsageFlags::Sampled | ImageUsageFlags::TransferDst;
+		}
+		else
+		{
+			aspectFlags = ImageAspectFlags::Color;
+			usageFlags = ImageUsageFlags::ColorAttachment | ImageUsageFlags::Sampled | ImageUsageFlags::TransferSrc | ImageUsageFlags::TransferDst;
+		}
+
+		// Memory is bound once the lifetimes of all graph images are known.
+		return image.InitialiseUnbound(name, renderer.GetDevice(), ImageType::e2D, format, dimensions, 1, 1, ImageTiling::Optimal,
+			usageFlags, SharingMode::Exclusive);
+	}
+
+	inline bool RenderGraph::AddTransientImage(std::string_view name, const Renderer& renderer, std::unordered_map<Format, std::vector<ImageInfo>>& formatRenderTextureLookup,
+		std::unordered_map<IRenderImage*, uint32_t>& imageInfoLookup, Format format, AccessFlags accessFlags, const glm::uvec3& dimensions,
+		IRenderImage** result)
 	{
 		if (format == Format::PlaceholderDepth || format == Format::PlaceholderSwapchain)
 		{
@@ -253,170 +361,243 @@ namespace Engine::Rendering
 			return false;
 		}
 
-		const IPhysicalDevice& physicalDevice = renderer.GetPhysicalDevice();
-		Format depthFormat = physicalDevice.GetDepthFormat();
-
-		std::vector<ImageInfo>& availableImages = formatRenderTextureLookup[format];
+		*result = nullptr;
 
-		for (auto& info : availableImages)
+		// Take over the image of the same name from the previous build if it is still the same, along with its memory.
+		for (TransientImage& previous : m_previousTransientImages)
 		{
-			// Ensure requested dimensions match.
-			if (info.Image.GetDimensions() != dimensions)
+			if (previous.Image == nullptr || previous.Name != name || previous.Image->GetFormat() != format || previous.Image->GetDimensions() != dimensions)
 				continue;
 
-			// Multiple reads are allowed.
-			if (accessFlags == AccessFlags::Read && info.Access != AccessFlags::Write)
-			{
-				info.Access = AccessFlags::Read;
-				*result = &info.Image;
-				return true;
-			}
+			auto owner = std::find_if(m_previousRenderTextures.begin(), m_previousRenderTextures.end(),
+				[&previous](const std::unique_ptr<IRenderImage>& image) { return image.get() == previous.Image; });
+			if (owner == m_previousRenderTextures.end())
+				continue;
 
-			// Allow write if no existing reads or writes exist.
-			if (accessFlags == AccessFlags::Write && info.Access == AccessFlags::None)
-			{
-				info.Access = AccessFlags::Write;
-				*result = &info.Image;
-				return true;
-			}
+			m_renderTextures.emplace_back(std::move(*owner));
+			m_previousRenderTextures.erase(owner);
 
-			// Passthrough (e.g. directly received from a render resource.)
-			if (accessFlags == AccessFlags::None)
-			{
-				*result = &info.Image;
-				return true;
-			}
+			TransientImage& transientImage = m_transientImages.emplace_back(TransientImage(name, previous.Image, previous.AspectFlags));
+			transientImage.HeapIndex = previous.HeapIndex;
+			transientImage.Offset = previous.Offset;
+			transientImage.Retained = true;
+
+			*result = previous.Image;
+			previous.Image = nullptr;
+			break;
 		}
 
-		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
-		const IDevice& device = renderer.GetDevice();
-		const ISwapChain& swapchain = renderer.GetSwapChain();
+		if (*result == nullptr)
+		{
+			std::unique_ptr<IRenderImage>& image = m_renderTextures.emplace_back(std::move(renderer.GetResourceFactory().CreateRenderImage()));
 
-		std::unique_ptr<IRenderImage>& image = renderTextures.emplace_back(std::move(resourceFactory.CreateRenderImage()));
+			ImageAspectFlags aspectFlags;
+			if (!InitialiseTransientImage(name, renderer, format, dimensions, *image, aspectFlags))
+				return false;
 
-		ImageAspectFlags aspectFlags;
-		ImageUsageFlags usageFlags;
-		if (format == depthFormat)
-		{
-			aspectFlags = ImageAspectFlags::Depth;
-			usageFlags = ImageUsageFlags::DepthStencilAttachment | ImageUsageFlags::Sampled | ImageUsageFlags::TransferDst;
-		}
-		else
-		{
-			aspectFlags = ImageAspectFlags::Color;
-			usageFlags = ImageUsageFlags::ColorAttachment | ImageUsageFlags::Sampled | ImageUsageFlags::TransferSrc | ImageUsageFlags::TransferDst;
+			m_transientImages.emplace_back(TransientImage(name, image.get(), aspectFlags));
+			m_freshResources.insert(image.get());
+			*result = image.get();
 		}
 
-		if (!image->Initialise(name, device, ImageType::e2D, format, dimensions, 1, 1, ImageTiling::Optimal,
-			usageFlags, aspectFlags, MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive))
-		{
-			*result = nullptr;
+		std::vector<ImageInfo>& availableImages = formatRenderTextureLookup[format];
+		imageInfoLookup.emplace(*result, static_cast<uint32_t>(availableImages.size()));
+		ImageInfo& newInfo = availableImages.emplace_back(ImageInfo(**result));
+		newInfo.Access = accessFlags;
+
+		m_transientImageLookup.emplace(*result, static_cast<uint32_t>(m_transientImages.size() - 1));
+
+		return true;
+	}
+
+	bool RenderGraph::ReplaceTransientImage(const Renderer& renderer, TransientImage& transientImage)
+	{
+		IRenderImage* previousImage = transientImage.Image;
+
+		std::unique_ptr<IRenderImage> image = std::move(renderer.GetResourceFactory().CreateRenderImage());
+		if (!InitialiseTransientImage(transientImage.Name, renderer, previousImage->GetFormat(), previousImage->GetDimensions(),
+			*image, transientImage.AspectFlags))
 			return false;
+
+		for (auto& stage : m_renderGraph)
+		{
+			for (auto& node : stage)
+			{
+				for (auto* images : { &node.InputImages, &node.OutputImages })
+				{
+					for (auto& pair : *images)
+					{
+						if (pair.second == previousImage)
+							pair.second = image.get();
+					}
+				}
+			}
 		}
 
-		imageInfoLookup.emplace(image.get(), static_cast<uint32_t>(availableImages.size()));
-		ImageInfo& newInfo = availableImages.emplace_back(ImageInfo(*image));
-		newInfo.Access = accessFlags;
+		uint32_t transientImageIndex = m_transientImageLookup.at(previousImage);
+		m_transientImageLookup.erase(previousImage);
+		m_transientImageLookup.emplace(image.get(), transientImageIndex);
+		m_freshResources.insert(image.get());
 
-		*result = image.get();
+		// The replaced image stays alive until the build completes, nodes still hold it until they are built again.
+		auto owner = std::find_if(m_renderTextures.begin(), m_renderTextures.end(),
+			[previousImage](const std::unique_ptr<IRenderImage>& renderTexture) { return renderTexture.get() == previousImage; });
+		m_previousRenderTextures.emplace_back(std::move(*owner));
+		*owner = std::move(image);
+
+		transientImage.Image = owner->get();
+		transientImage.Requirements = transientImage.Image->GetMemoryRequirements(renderer.GetDevice());
+		transientImage.Retained = false;
 
 		return true;
 	}
 
-	bool RenderGraph::DetermineRequiredResources(std::vector<IRenderNode*>& renderNodeStack,
-		std::unordered_map<std::string, RenderGraphNode*>& availableImageSources,
-		std::unordered_map<std::string, RenderGraphNode*>& availableBufferSources)
+	bool RenderGraph::NodeRequiresBuild(const RenderGraphNode& node) const
 	{
-		while (!renderNodeStack.empty())
+		// Compute passes are always built again, the culling passes are bound by the depth reduction pass when it is
+		// enabled and by themselves otherwise, so toggling either side changes what the other has to bind.
+		if (m_buildChange > RenderGraphChange::RenderExtent || node.Type == RenderNodeType::Compute)
+			return true;
+
+		const auto& search = m_nodeBindings.find(node.Node);
+		if (search == m_nodeBindings.end())
+			return true;
+
+		const NodeBindings& bindings = search->second;
+		if (bindings.InputImages != node.InputImages || bindings.OutputImages != node.OutputImages
+			|| bindings.InputBuffers != node.InputBuffers || bindings.OutputBuffers != node.OutputBuffers)
+			return true;
+
+		for (const auto* images : { &node.InputImages, &node.OutputImages })
 		{
-			std::vector<RenderGraphNode>& stage = m_renderGraph.emplace_back(std::vector<RenderGraphNode>());
+			for (const auto& pair : *images)
+			{
+				if (m_freshResources.contains(pair.second))
+					return true;
+			}
+		}
+
+		for (const auto* buffers : { &node.InputBuffers, &node.OutputBuffers })
+		{
+			for (const auto& pair : *buffers)
+			{
+				if (m_freshResources.contains(pair.second))
+					return true;
+			}
+		}
 
-			// Per-stage available resources.
-			std::unordered_map<std::string, RenderGraphNode*> stageAvailableBufferSources(availableBufferSources);
-			std::unordered_map<std::string, RenderGraphNode*> stageAvailableImageSources(availableImageSources);
+		return false;
+	}
+
+	bool RenderGraph::DetermineRequiredResources(const std::vector<IRenderNode*>& renderNodeStack)
+	{
+		// Nodes are addressed by their position in the stack until they are placed in their final stage, as the graph
+		// nodes reference their sources directly.
+		struct ScheduledNode
+		{
+			IRenderNode* Node;
+			uint32_t EarliestStage;
+			uint32_t LatestStage;
+			uint32_t Stage;
+			std::vector<std::pair<std::string, uint32_t>> ImageSources;
+			std::vector<std::pair<std::string, uint32_t>> BufferSources;
+		};
+
+		// A node has to be in a stage at least Gap stages after the one it depends on. Readers of a resource version
+		// that another node overwrites in place only have to come before it, which can be in the same stage.
+		struct Dependency
+		{
+			uint32_t From;
+			uint32_t To;
+			uint32_t Gap;
+		};
+
+		std::vector<ScheduledNode> nodes;
+		nodes.reserve(renderNodeStack.size());
+		for (IRenderNode* renderNode : renderNodeStack)
+			nodes.push_back({ renderNode, 0, 0, 0, {}, {} });
+
+		// Resolve which node each input comes from. Nodes are taken in the order they were added, each in the first
+		// stage where all its inputs are available. Resources a node reads and writes become unavailable to nodes after
+		// it in the same stage, so later readers see the new contents.
+		std::unordered_map<std::string, uint32_t> availableImageSources;
+		std::unordered_map<std::string, uint32_t> availableBufferSources;
+		std::vector<uint32_t> pending(nodes.size());
+		for (uint32_t i = 0; i < pending.size(); ++i)
+			pending[i] = i;
+
+		uint32_t stageCount = 0;
+		while (!pending.empty())
+		{
+			std::unordered_map<std::string, uint32_t> stageAvailableImageSources(availableImageSources);
+			std::unordered_map<std::string, uint32_t> stageAvailableBufferSources(availableBufferSources);
+			std::vector<uint32_t> stageNodes;
 
-			// Attempt to satisfy all requirements for each remaining render pass. If all requirements are met for a pass, remove it from the stack.
-			for (auto it = renderNodeStack.begin(); it != renderNodeStack.end();)
+			for (auto it = pending.begin(); it != pending.end();)
 			{
-				IRenderNode* renderNode = *it;
-				RenderGraphNode node = RenderGraphNode(renderNode);
-				bool satisfied = true;
+				ScheduledNode& node = nodes[*it];
 
-				for (const auto& bufferInput : node.Node->GetBufferInputInfos())
-				{
-					const auto& search = stageAvailableBufferSources.find(bufferInput.first);
-					if (search != stageAvailableBufferSources.end())
+				auto resolve = [](const auto& inputInfos, const std::unordered_map<std::string, uint32_t>& available,
+					std::vector<std::pair<std::string, uint32_t>>& sources)
 					{
-						// Make resource unavailable for the rest of this stage if it's being written to (exists in output.)
-						node.InputBufferSources.emplace(bufferInput.first, *search->second);
-						for (const auto& bufferOutput : node.Node->GetBufferOutputInfos())
+						for (const auto& input : inputInfos)
 						{
-							if (bufferOutput.first == search->first)
-							{
-								stageAvailableBufferSources.erase(bufferOutput.first);
-								break;
-							}
+							const auto& search = available.find(input.first);
+							if (search == available.end())
+								return false;
+
+							sources.emplace_back(input.first, search->second);
 						}
-					}
-					else
-					{
-						satisfied = false;
-						break;
-					}
-				}
 
-				if (satisfied)
+						return true;
+					};
+
+				node.ImageSources.clear();
+				node.BufferSources.clear();
+				bool satisfied = resolve(node.Node->GetBufferInputInfos(), stageAvailableBufferSources, node.BufferSources)
+					&& resolve(node.Node->GetImageInputInfos(), stageAvailableImageSources, node.ImageSources);
+
+				if (!satisfied)
 				{
-					for (const auto& imageInputInfo : node.Node->GetImageInputInfos())
-					{
-						const auto& search = stageAvailableImageSources.find(imageInputInfo.first);
-						if (search != stageAvailableImageSources.end())
-						{
-							// Make resource unavailable for the rest of this stage if it's being written to (exists in output.)
-							node.InputImageSources.insert_or_assign(imageInputInfo.first, *search->second);
-							for (const auto& imageOutput : node.Node->GetImageOutputInfos())
-							{
-								if (imageOutput.first == search->first)
-								{
-									stageAvailableImageSources.erase(imageOutput.first);
-									break;
-								}
-							}
-						}
-						else
-						{
-							satisfied = false;
-							break;
-						}
-					}
+					++it;
+					continue;
 				}
 
-				if (satisfied)
+				// Make resources unavailable for the rest of this stage if they are being written to.
+				for (const auto& source : node.BufferSources)
 				{
-					stage.emplace_back(std::move(node));
-					it = renderNodeStack.erase(it);
+					if (node.Node->GetBufferOutputInfos().contains(source.first))
+						stageAvailableBufferSources.erase(source.first);
 				}
-				else
+
+				for (const auto& source : node.ImageSources)
 				{
-					++it;
+					if (node.Node->GetImageOutputInfos().contains(source.first))
+						stageAvailableImageSources.erase(source.first);
 				}
+
+				node.EarliestStage = stageCount;
+				stageNodes.push_back(*it);
+				it = pending.erase(it);
 			}
 
-			if (stage.empty())
+			if (stageNodes.empty())
 			{
 				Logger::Error("Could not resolve requirements for remaining render passes while building render graph.");
 				return false;
 			}
 
 			// Make resources from current stage available for the next one.
-			for (RenderGraphNode& node : stage)
+			for (uint32_t nodeIndex : stageNodes)
 			{
-				for (const auto& bufferOutput : node.Node->GetBufferOutputInfos())
-					availableBufferSources.insert_or_assign(bufferOutput.first, &node);
+				for (const auto& bufferOutput : nodes[nodeIndex].Node->GetBufferOutputInfos())
+					availableBufferSources.insert_or_assign(bufferOutput.first, nodeIndex);
 
-				for (const auto& imageOutput : node.Node->GetImageOutputInfos())
-					availableImageSources.insert_or_assign(imageOutput.first, &node);
+				for (const auto& imageOutput : nodes[nodeIndex].Node->GetImageOutputInfos())
+					availableImageSources.insert_or_assign(imageOutput.first, nodeIndex);
 			}
+
+			++stageCount;
 		}
 
 		if (!availableImageSources.contains("Output"))
@@ -425,6 +606,252 @@ namespace Engine::Rendering
 			return false;
 		}
 
+		std::vector<Dependency> dependencies;
+		for (uint32_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+		{
+			const ScheduledNode& node = nodes[nodeIndex];
+			for (const auto* sources : { &node.ImageSources, &node.BufferSources })
+			{
+				bool isImage = sources == &node.ImageSources;
+				for (const auto& source : *sources)
+				{
+					dependencies.push_back({ source.second, nodeIndex, 1 });
+
+					bool overwrites = isImage ? node.Node->GetImageOutputInfos().contains(source.first)
+						: node.Node->GetBufferOutputInfos().contains(source.first);
+					if (!overwrites)
+						continue;
+
+					for (uint32_t readerIndex = 0; readerIndex < nodes.size(); ++readerIndex)
+					{
+						const ScheduledNode& reader = nodes[readerIndex];
+						const auto& readerSources = isImage ? reader.ImageSources : reader.BufferSources;
+						if (readerIndex != nodeIndex && std::find(readerSources.begin(), readerSources.end(), source) != readerSources.end())
+							dependencies.push_back({ readerIndex, nodeIndex, 0 });
+					}
+				}
+			}
+		}
+
+		// The latest stage each node can move to without making the frame any longer.
+		for (ScheduledNode& node : nodes)
+			node.LatestStage = stageCount - 1;
+
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (const Dependency& dependency : dependencies)
+			{
+				uint32_t latestStage = nodes[dependency.To].LatestStage - dependency.Gap;
+				if (latestStage < nodes[dependency.From].LatestStage)
+				{
+					nodes[dependency.From].LatestStage = latestStage;
+					changed = true;
+				}
+			}
+		}
+
+		// Nodes are placed in order of their earliest stage, then the order they were added, which every dependency follows.
+		std::vector<uint32_t> placementOrder(nodes.size());
+		for (uint32_t i = 0; i < placementOrder.size(); ++i)
+			placementOrder[i] = i;
+
+		std::stable_sort(placementOrder.begin(), placementOrder.end(), [&nodes](uint32_t a, uint32_t b)
+			{
+				return nodes[a].EarliestStage < nodes[b].EarliestStage;
+			});
+
+		// Render passes are on the critical path of the graphics queue and go in their earliest stage. On a separate
+		// compute queue, compute passes with room to move join a stage that already has compute work, so they share its
+		// submission and the semaphores around it instead of adding their own.
+		std::vector<uint32_t> stageComputeCounts(stageCount, 0);
+		for (uint32_t nodeIndex : placementOrder)
+		{
+			ScheduledNode& node = nodes[nodeIndex];
+
+			uint32_t earliestStage = node.EarliestStage;
+			for (const Dependency& dependency : dependencies)
+			{
+				if (dependency.To == nodeIndex)
+					earliestStage = std::max(earliestStage, nodes[dependency.From].Stage + dependency.Gap);
+			}
+
+			node.Stage = earliestStage;
+			if (m_asyncCompute && node.Node->GetNodeType() == RenderNodeType::Compute)
+			{
+				for (uint32_t stageIndex = earliestStage; stageIndex <= node.LatestStage; ++stageIndex)
+				{
+					if (stageComputeCounts[stageIndex] > 0)
+					{
+						node.Stage = stageIndex;
+						break;
+					}
+				}
+
+				++stageComputeCounts[node.Stage];
+			}
+		}
+
+		// Stages emptied by moving nodes are dropped.
+		std::vector<uint32_t> stageNodeCounts(stageCount, 0);
+		for (const ScheduledNode& node : nodes)
+			++stageNodeCounts[node.Stage];
+
+		std::vector<uint32_t> stageRemap(stageCount, 0);
+		uint32_t usedStageCount = 0;
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			stageRemap[stageIndex] = usedStageCount;
+			if (stageNodeCounts[stageIndex] > 0)
+				++usedStageCount;
+		}
+
+		// Storage for every stage is reserved up front, nodes reference their sources by address.
+		m_renderGraph.resize(usedStageCount);
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			if (stageNodeCounts[stageIndex] > 0)
+				m_renderGraph[stageRemap[stageIndex]].reserve(stageNodeCounts[stageIndex]);
+		}
+
+		std::vector<RenderGraphNode*> graphNodes(nodes.size(), nullptr);
+		for (uint32_t nodeIndex : placementOrder)
+		{
+			std::vector<RenderGraphNode>& stage = m_renderGraph[stageRemap[nodes[nodeIndex].Stage]];
+			graphNodes[nodeIndex] = &stage.emplace_back(RenderGraphNode(nodes[nodeIndex].Node));
+		}
+
+		for (uint32_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+		{
+			RenderGraphNode& graphNode = *graphNodes[nodeIndex];
+			for (const auto& source : nodes[nodeIndex].ImageSources)
+				graphNode.InputImageSources.emplace(source.first, *graphNodes[source.second]);
+
+			for (const auto& source : nodes[nodeIndex].BufferSources)
+				graphNode.InputBufferSources.emplace(source.first, *graphNodes[source.second]);
+		}
+
+		return true;
+	}
+
+	bool RenderGraph::RestoreSchedule(const RenderGraphLayout& layout)
+	{
+		// Storage for every stage is reserved up front, nodes reference their sources by address.
+		std::unordered_map<std::string_view, RenderGraphNode*> graphNodes;
+		m_renderGraph.resize(layout.Stages.size());
+		for (uint32_t stageIndex = 0; stageIndex < layout.Stages.size(); ++stageIndex)
+		{
+			const RenderGraphLayoutStage& stage = layout.Stages[stageIndex];
+			m_renderGraph[stageIndex].reserve(stage.Nodes.size());
+			for (const RenderGraphLayoutNode& layoutNode : stage.Nodes)
+			{
+				const auto& search = m_renderNodeLookup.find(layoutNode.Name);
+				if (search == m_renderNodeLookup.end())
+				{
+					Logger::Error("Cached render graph layout references unknown node '{}'.", layoutNode.Name);
+					return false;
+				}
+
+				graphNodes.emplace(layoutNode.Name, &m_renderGraph[stageIndex].emplace_back(RenderGraphNode(search->second)));
+			}
+		}
+
+		for (uint32_t stageIndex = 0; stageIndex < layout.Stages.size(); ++stageIndex)
+		{
+			const RenderGraphLayoutStage& stage = layout.Stages[stageIndex];
+			for (uint32_t nodeIndex = 0; nodeIndex < stage.Nodes.size(); ++nodeIndex)
+			{
+				const RenderGraphLayoutNode& layoutNode = stage.Nodes[nodeIndex];
+				RenderGraphNode& graphNode = m_renderGraph[stageIndex][nodeIndex];
+				for (const auto& source : layoutNode.ImageSources)
+					graphNode.InputImageSources.emplace(source.first, *graphNodes.at(source.second));
+
+				for (const auto& source : layoutNode.BufferSources)
+					graphNode.InputBufferSources.emplace(source.first, *graphNodes.at(source.second));
+			}
+		}
+
+		return true;
+	}
+
+	RenderGraphLayout RenderGraph::CreateLayout(uint64_t keyHash) const
+	{
+		RenderGraphLayout layout;
+		layout.KeyHash = keyHash;
+
+		std::vector<std::string_view> imageStateNames(m_imageBarrierStates.size());
+		for (const auto& pair : m_imageBarrierStateLookup)
+			imageStateNames[pair.second] = pair.first;
+
+		std::vector<std::string_view> bufferStateNames(m_bufferBarrierStates.size());
+		for (const auto& pair : m_bufferBarrierStateLookup)
+			bufferStateNames[pair.second] = pair.first;
+
+		auto sortedSources = [](const std::unordered_map<std::string, RenderGraphNode&>& sources)
+			{
+				std::vector<std::pair<std::string, std::string>> sorted;
+				for (const auto& source : sources)
+					sorted.emplace_back(source.first, source.second.Node->GetName());
+
+				std::sort(sorted.begin(), sorted.end());
+				return sorted;
+			};
+
+		layout.Stages.resize(m_renderGraph.size());
+		for (uint32_t stageIndex = 0; stageIndex < m_renderGraph.size(); ++stageIndex)
+		{
+			RenderGraphLayoutStage& layoutStage = layout.Stages[stageIndex];
+			for (const RenderGraphNode& node : m_renderGraph[stageIndex])
+				layoutStage.Nodes.push_back({ node.Node->GetName(), node.Type, sortedSources(node.InputImageSources), sortedSources(node.InputBufferSources) });
+
+			const CompiledStage& stage = m_executionPlan[stageIndex];
+			for (const CompiledBarrierBatch* batch : { &stage.RenderBarriers, &stage.ComputeBarriers })
+			{
+				bool isCompute = batch == &stage.ComputeBarriers;
+				for (const CompiledImageTransition& transition : batch->ImageTransitions)
+				{
+					layoutStage.Barriers.push_back({ std::string(imageStateNames[transition.StateIndex]), isCompute, false,
+						transition.Info->Layout, transition.StageFlags, transition.MatAccessFlags });
+				}
+
+				for (const CompiledBufferTransition& transition : batch->BufferTransitions)
+				{
+					layoutStage.Barriers.push_back({ std::string(bufferStateNames[transition.StateIndex]), isCompute, true,
+						ImageLayout::Undefined, transition.StageFlags, transition.MatAccessFlags });
+				}
+			}
+
+			layoutStage.RenderSignal = stage.RenderSignal;
+			layoutStage.ComputeSignal = stage.ComputeSignal;
+			layoutStage.RenderWaitSignal = stage.RenderWaitSignal;
+			layoutStage.ComputeWaitSignal = stage.ComputeWaitSignal;
+			layoutStage.RenderWaitsOnPreviousFrame = stage.RenderWaitsOnPreviousFrame;
+			layoutStage.ComputeWaitsOnPreviousFrame = stage.ComputeWaitsOnPreviousFrame;
+		}
+
+		for (const TransientImage& transientImage : m_transientImages)
+		{
+			layout.Images.push_back({ transientImage.Name, transientImage.Image->GetFormat(), transientImage.Image->GetDimensions(),
+				transientImage.FirstStage, transientImage.LastStage, transientImage.HeapIndex, transientImage.Offset,
+				transientImage.Requirements.Size, transientImage.Aliased });
+		}
+
+		std::stable_sort(layout.Images.begin(), layout.Images.end(), [](const RenderGraphLayoutImage& a, const RenderGraphLayoutImage& b)
+			{
+				return a.FirstStage != b.FirstStage ? a.FirstStage < b.FirstStage : a.Name < b.Name;
+			});
+
+		return layout;
+	}
+
+	bool RenderGraph::DumpLayout(const std::string& filePath) const
+	{
+		if (!Files::TryWriteTextFile(filePath, std::vector<char>(m_serialisedLayout.begin(), m_serialisedLayout.end())))
+		{
+			Logger::Error("Failed to write render graph layout to '{}'.", filePath);
+			return false;
+		}
+
 		return true;
 	}
 
@@ -446,11 +873,21 @@ namespace Engine::Rendering
 
 			for (auto& node : stage)
 			{
-				// Build resources before passes.
-				if (!node.Node->BuildResources(renderer))
+				// Build resources before passes. Nodes kept from the previous graph keep theirs when only passes or the
+				// render extent changed, as no node resource is sized by the extent.
+				if (m_buildChange > RenderGraphChange::RenderExtent || !m_nodeBindings.contains(node.Node))
 				{
-					Logger::Error("Failed to build resources for render node '{}' while building render graph.", node.Node->GetName());
-					return false;
+					if (!node.Node->BuildResources(renderer))
+					{
+						Logger::Error("Failed to build resources for render node '{}' while building render graph.", node.Node->GetName());
+						return false;
+					}
+
+					// New resources may reuse the address of ones just freed, so anything bound to them has to be built again.
+					for (const auto& output : node.Node->GetImageOutputInfos())
+						m_freshResources.insert(output.second.Image);
+					for (const auto& output : node.Node->GetBufferOutputInfos())
+						m_freshResources.insert(output.second.Buffer);
 				}
 
 				for (const auto& output : node.Node->GetBufferOutputInfos())
@@ -492,7 +929,7 @@ namespace Engine::Rendering
 							const RenderPassImageInfo& inputInfo = info.second;
 							glm::uvec3 requestedExtents = inputInfo.Dimensions == glm::uvec3() ? defaultExtents : inputInfo.Dimensions;
 							IRenderImage* image = nullptr;
-							if (!TryGetOrAddImage(info.first, renderer, formatRenderTextureLookup, m_renderTextures, imageInfoLookup,
+							if (!AddTransientImage(info.first, renderer, formatRenderTextureLookup, imageInfoLookup,
 								inputInfo.Format, inputInfo.Access, requestedExtents, &image))
 								return false;
 
@@ -524,7 +961,7 @@ namespace Engine::Rendering
 							}
 						}
 
-						if (image == nullptr && !TryGetOrAddImage(info.first, renderer, formatRenderTextureLookup, m_renderTextures, imageInfoLookup,
+						if (image == nullptr && !AddTransientImage(info.first, renderer, formatRenderTextureLookup, imageInfoLookup,
 							outputInfo.Format, AccessFlags::Write, requestedExtents, &image))
 							return false;
 
@@ -553,18 +990,282 @@ namespace Engine::Rendering
 		return true;
 	}
 
-	bool RenderGraph::BuildPasses(const Renderer& renderer, const IDevice& device)
+	bool RenderGraph::AllocateTransientImages(const Renderer& renderer)
 	{
-		uint32_t concurrentFrameCount = renderer.GetConcurrentFrameCount();
+		const IDevice& device = renderer.GetDevice();
+		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
+		uint32_t stageCount = static_cast<uint32_t>(m_renderGraph.size());
 
-		// Build the actual passes.
+		// Determine the first and last stage each image is used in.
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			for (const auto& node : m_renderGraph[stageIndex])
+			{
+				for (const auto* images : { &node.InputImages, &node.OutputImages })
+				{
+					for (const auto& pair : *images)
+					{
+						const auto& search = m_transientImageLookup.find(pair.second);
+						if (search == m_transientImageLookup.end())
+							continue;
+
+						TransientImage& transientImage = m_transientImages[search->second];
+						transientImage.FirstStage = std::min(transientImage.FirstStage, stageIndex);
+						transientImage.LastStage = std::max(transientImage.LastStage, stageIndex);
+					}
+				}
+			}
+		}
+
+		// The final output is still read by the blit to the swapchain after the last stage.
+		const auto& finalImage = m_transientImageLookup.find(m_finalNode->OutputImages.at("Output"));
+		if (finalImage != m_transientImageLookup.end())
+			m_transientImages[finalImage->second].LastStage = stageCount;
+
+		for (auto& transientImage : m_transientImages)
+		{
+			// Stages on the compute queue run alongside the graphics stages around them, so their order says nothing
+			// about when an image is no longer in use. Give every image the whole frame to keep them apart.
+			if (m_asyncCompute || transientImage.FirstStage > transientImage.LastStage)
+			{
+				transientImage.FirstStage = 0;
+				transientImage.LastStage = stageCount;
+			}
+
+			transientImage.Requirements = transientImage.Image->GetMemoryRequirements(device);
+		}
+
+		// Place the largest images first, each at the lowest offset not used by an image alive at the same time.
+		std::vector<uint32_t> placementOrder(m_transientImages.size());
+		for (uint32_t i = 0; i < placementOrder.size(); ++i)
+			placementOrder[i] = i;
+
+		std::stable_sort(placementOrder.begin(), placementOrder.end(), [this](uint32_t a, uint32_t b)
+			{
+				return m_transientImages[a].Requirements.Size > m_transientImages[b].Requirements.Size;
+			});
+
+		// Heaps from the previous build keep their memory, so images can only be added where they fit in it.
+		struct HeapPlacement
+		{
+			MemoryRequirements Requirements;
+			uint32_t PreviousIndex;
+			std::vector<uint32_t> Images;
+		};
+
+		std::vector<HeapPlacement> heaps;
+		for (uint32_t heapIndex = 0; heapIndex < m_previousMemoryHeapRequirements.size(); ++heapIndex)
+			heaps.push_back({ m_previousMemoryHeapRequirements[heapIndex], heapIndex, {} });
+
+		auto livesAlongside = [](const TransientImage& a, const TransientImage& b)
+			{
+				return a.FirstStage <= b.LastStage && b.FirstStage <= a.LastStage;
+			};
+
+		// Images kept from the previous build stay where they are, unless they are now alive at the same time as an
+		// image already placed in the same memory.
+		for (uint32_t imageIndex : placementOrder)
+		{
+			TransientImage& transientImage = m_transientImages[imageIndex];
+			if (!transientImage.Retained)
+				continue;
+
+			HeapPlacement& heap = heaps[transientImage.HeapIndex];
+			bool conflicts = std::any_of(heap.Images.begin(), heap.Images.end(), [&](uint32_t placedIndex)
+				{
+					const TransientImage& placed = m_transientImages[placedIndex];
+					return livesAlongside(placed, transientImage) && placed.Offset < transientImage.Offset + transientImage.Requirements.Size
+						&& transientImage.Offset < placed.Offset + placed.Requirements.Size;
+				});
+
+			if (conflicts)
+			{
+				if (!ReplaceTransientImage(renderer, transientImage))
+				{
+					Logger::Error("Failed to replace transient image '{}' while building render graph.", transientImage.Name);
+					return false;
+				}
+
+				continue;
+			}
+
+			heap.Images.push_back(imageIndex);
+		}
+
+		// Place the remaining images at the lowest offset not used by an image alive at the same time.
+		for (uint32_t imageIndex : placementOrder)
+		{
+			TransientImage& transientImage = m_transientImages[imageIndex];
+			if (transientImage.Retained)
+				continue;
+
+			const MemoryRequirements& requirements = transientImage.Requirements;
+
+			uint32_t heapIndex = 0;
+			uint64_t offset = 0;
+			for (; heapIndex < heaps.size(); ++heapIndex)
+			{
+				const HeapPlacement& heap = heaps[heapIndex];
+				if ((heap.Requirements.MemoryTypeBits & requirements.MemoryTypeBits) == 0)
+					continue;
+
+				bool allocated = heap.PreviousIndex != ~0U;
+				if (allocated && ((heap.Requirements.MemoryTypeBits & requirements.MemoryTypeBits) != heap.Requirements.MemoryTypeBits
+					|| requirements.Alignment > heap.Requirements.Alignment))
+					continue;
+
+				std::vector<const TransientImage*> overlapping;
+				for (uint32_t placedIndex : heap.Images)
+				{
+					const TransientImage& placed = m_transientImages[placedIndex];
+					if (livesAlongside(placed, transientImage))
+						overlapping.push_back(&placed);
+				}
+
+				std::sort(overlapping.begin(), overlapping.end(), [](const TransientImage* a, const TransientImage* b)
+					{
+						return a->Offset < b->Offset;
+					});
+
+				offset = 0;
+				for (const TransientImage* placed : overlapping)
+				{
+					if (offset + requirements.Size <= placed->Offset)
+						break;
+
+					uint64_t placedEnd = placed->Offset + placed->Requirements.Size;
+					offset = std::max(offset, (placedEnd + requirements.Alignment - 1) / requirements.Alignment * requirements.Alignment);
+				}
+
+				if (!allocated || offset + requirements.Size <= heap.Requirements.Size)
+					break;
+			}
+
+			if (heapIndex == heaps.size())
+			{
+				heaps.push_back({ { 0, 1, requirements.MemoryTypeBits }, ~0U, {} });
+				offset = 0;
+			}
+
+			transientImage.HeapIndex = heapIndex;
+			transientImage.Offset = offset;
+
+			HeapPlacement& heap = heaps[heapIndex];
+			if (heap.PreviousIndex == ~0U)
+			{
+				heap.Requirements.Size = std::max(heap.Requirements.Size, offset + requirements.Size);
+				heap.Requirements.Alignment = std::max(heap.Requirements.Alignment, requirements.Alignment);
+				heap.Requirements.MemoryTypeBits &= requirements.MemoryTypeBits;
+			}
+
+			heap.Images.push_back(imageIndex);
+		}
+
+		m_transientMemoryStats = {};
+		m_transientMemoryStats.ImageCount = static_cast<uint32_t>(m_transientImages.size());
+
+		// Keep the previous heaps that still hold an image and allocate the new ones.
+		std::vector<uint32_t> heapRemap(heaps.size(), ~0U);
+		std::vector<std::vector<uint32_t>> heapImages;
+		for (uint32_t heapIndex = 0; heapIndex < heaps.size(); ++heapIndex)
+		{
+			HeapPlacement& heap = heaps[heapIndex];
+			if (heap.Images.empty())
+				continue;
+
+			heapRemap[heapIndex] = static_cast<uint32_t>(m_memoryHeaps.size());
+			if (heap.PreviousIndex != ~0U)
+			{
+				m_memoryHeaps.emplace_back(std::move(m_previousMemoryHeaps[heap.PreviousIndex]));
+			}
+			else
+			{
+				std::unique_ptr<IMemoryHeap>& memoryHeap = m_memoryHeaps.emplace_back(std::move(resourceFactory.CreateMemoryHeap()));
+				if (!memoryHeap->Initialise(std::format("TransientMemoryHeap {}", m_memoryHeaps.size() - 1), device, heap.Requirements))
+					return false;
+			}
+
+			m_memoryHeapRequirements.push_back(heap.Requirements);
+			heapImages.emplace_back(std::move(heap.Images));
+			m_transientMemoryStats.AliasedSize += heap.Requirements.Size;
+		}
+
+		m_transientMemoryStats.HeapCount = static_cast<uint32_t>(m_memoryHeaps.size());
+
+		for (auto& transientImage : m_transientImages)
+		{
+			transientImage.HeapIndex = heapRemap[transientImage.HeapIndex];
+
+			// Images sharing memory with another have to discard its contents before their first use each frame.
+			for (uint32_t placedIndex : heapImages[transientImage.HeapIndex])
+			{
+				const TransientImage& placed = m_transientImages[placedIndex];
+				if (&placed != &transientImage && placed.Offset < transientImage.Offset + transientImage.Requirements.Size
+					&& transientImage.Offset < placed.Offset + placed.Requirements.Size)
+				{
+					transientImage.Aliased = true;
+					break;
+				}
+			}
+
+			m_transientMemoryStats.UnaliasedSize += transientImage.Requirements.Size;
+
+			if (transientImage.Retained)
+			{
+				++m_transientMemoryStats.RetainedImageCount;
+				continue;
+			}
+
+			if (!transientImage.Image->BindMemory(transientImage.Name, device, *m_memoryHeaps[transientImage.HeapIndex],
+				transientImage.Offset, transientImage.AspectFlags))
+			{
+				Logger::Error("Failed to place image '{}' in transient memory while building render graph.", transientImage.Name);
+				return false;
+			}
+		}
+
+		for (uint32_t stageIndex = 0; stageIndex <= stageCount; ++stageIndex)
+		{
+			uint64_t stageSize = 0;
+			for (const auto& transientImage : m_transientImages)
+			{
+				if (transientImage.FirstStage <= stageIndex && stageIndex <= transientImage.LastStage)
+					stageSize += transientImage.Requirements.Size;
+			}
+
+			m_transientMemoryStats.PeakSize = std::max(m_transientMemoryStats.PeakSize, stageSize);
+		}
+
+		const float bytesToMiB = 1.0f / (1024.0f * 1024.0f);
+		Logger::Verbose("Render graph placed {} transient images in {} memory heaps: {:.2f} MiB, {:.2f} MiB without aliasing, {:.2f} MiB peak in use.",
+			m_transientMemoryStats.ImageCount, m_transientMemoryStats.HeapCount, m_transientMemoryStats.AliasedSize * bytesToMiB,
+			m_transientMemoryStats.UnaliasedSize * bytesToMiB, m_transientMemoryStats.PeakSize * bytesToMiB);
+
+		m_renderStats.SetTransientMemoryUsage(m_transientMemoryStats.AliasedSize, m_transientMemoryStats.UnaliasedSize,
+			m_transientMemoryStats.PeakSize);
+
+		return true;
+	}
+
+	bool RenderGraph::BuildPasses(const Renderer& renderer, const IDevice& device)
+	{
+		uint32_t concurrentFrameCount = renderer.GetConcurrentFrameCount();
+
+		// Build the actual passes, skipping those whose connections did not change.
 		uint32_t stageIndex = 0;
+		std::unordered_map<const IRenderNode*, NodeBindings> nodeBindings;
+		m_nodeBuildCount = 0;
 		m_perStageOwnershipReleaseResources.resize(m_renderGraph.size());
 		for (const auto& stage : m_renderGraph)
 		{
 			for (const auto& node : stage)
 			{
-				if (node.Type == RenderNodeType::Pass)
+				bool requiresBuild = NodeRequiresBuild(node);
+				nodeBindings.emplace(node.Node, NodeBindings{ node.InputImages, node.OutputImages, node.InputBuffers, node.OutputBuffers });
+				if (requiresBuild)
+					++m_nodeBuildCount;
+
+				if (requiresBuild && node.Type == RenderNodeType::Pass)
 				{
 					IRenderPass* pass = static_cast<IRenderPass*>(node.Node);
 					if (!pass->Build(renderer, node.InputImages, node.OutputImages, node.InputBuffers, node.OutputBuffers))
@@ -573,7 +1274,7 @@ namespace Engine::Rendering
 						return false;
 					}
 				}
-				else if (node.Type == RenderNodeType::Compute)
+				else if (requiresBuild && node.Type == RenderNodeType::Compute)
 				{
 					IComputePass* pass = static_cast<IComputePass*>(node.Node);
 					if (!pass->Build(renderer, node.InputImages, node.OutputImages, node.InputBuffers, node.OutputBuffers))
@@ -590,149 +1291,719 @@ namespace Engine::Rendering
 				blankImageInfo.LastUsagePassStageIndex = stageIndex;
 				blankBufferInfo.LastUsagePassStageIndex = stageIndex;
 
+				// Each resource gets a barrier state slot, recording where ownership has to move between queues.
+				auto trackUsage = [&](const std::string& name, auto& stateLookup, auto& states, const auto& blankInfo, bool isBuffer)
+				{
+					const auto& search = stateLookup.find(name);
+					if (search == stateLookup.end())
+					{
+						stateLookup.emplace(name, static_cast<uint32_t>(states.size()));
+						states.emplace_back(blankInfo);
+						return;
+					}
+
+					uint32_t stateIndex = search->second;
+					auto& existing = states[stateIndex];
+					if (existing.LastUsagePassType == RenderNodeType::Resource)
+						existing.LastUsagePassType = node.Type;
+					else if (existing.LastUsagePassType != node.Type)
+					{
+						m_perStageOwnershipReleaseResources[existing.LastUsagePassStageIndex].push_back({ stateIndex, isBuffer, node.Type == RenderNodeType::Compute });
+						existing.LastUsagePassType = node.Type;
+					}
+					existing.LastUsagePassStageIndex = stageIndex;
+				};
+
 				for (const auto& pair : node.Node->GetImageInputInfos())
-					if (!m_imageInfoBarrierState.contains(pair.first))
-						m_imageInfoBarrierState.emplace(pair.first, blankImageInfo);
-					else
+					trackUsage(pair.first, m_imageBarrierStateLookup, m_imageBarrierStates, blankImageInfo, false);
+
+				for (const auto& pair : node.Node->GetImageOutputInfos())
+					trackUsage(pair.first, m_imageBarrierStateLookup, m_imageBarrierStates, blankImageInfo, false);
+
+				for (const auto& pair : node.Node->GetBufferInputInfos())
+					trackUsage(pair.first, m_bufferBarrierStateLookup, m_bufferBarrierStates, blankBufferInfo, true);
+
+				for (const auto& pair : node.Node->GetBufferOutputInfos())
+					trackUsage(pair.first, m_bufferBarrierStateLookup, m_bufferBarrierStates, blankBufferInfo, true);
+			}
+
+			// Command buffers of stages that already existed are reused.
+			if (stageIndex < m_renderCommandBuffers.size())
+			{
+				++stageIndex;
+				continue;
+			}
+
+			std::vector<std::unique_ptr<ICommandBuffer>> renderCommandBuffers;
+			std::vector<std::unique_ptr<ICommandBuffer>> computeCommandBuffers;
+			for (uint32_t i = 0; i < concurrentFrameCount; ++i)
+			{
+				auto commandBuffers = m_renderCommandPools[i]->CreateCommandBuffers(std::format("Stage {} Render Command Buffer {}", stageIndex, i), device, 1);
+				if (commandBuffers.empty())
+					return false;
+				renderCommandBuffers.emplace_back(std::move(commandBuffers[0]));
+
+				if (m_asyncCompute)
+				{
+					commandBuffers = m_computeCommandPools[i]->CreateCommandBuffers(std::format("Stage {} Compute Command Buffer {}", stageIndex, i), device, 1);
+					if (commandBuffers.empty())
+						return false;
+					computeCommandBuffers.emplace_back(std::move(commandBuffers[0]));
+				}
+			}
+
+			m_renderCommandBuffers.emplace_back(std::move(renderCommandBuffers));
+			if (m_asyncCompute)
+				m_computeCommandBuffers.emplace_back(std::move(computeCommandBuffers));
+
+			++stageIndex;
+		}
+
+		m_renderCommandBuffers.resize(m_renderGraph.size());
+		if (m_asyncCompute)
+			m_computeCommandBuffers.resize(m_renderGraph.size());
+
+		// Render passes keep their command pools and buffers for as long as they stay in the graph.
+		std::unordered_map<const IRenderNode*, PassRecording> passRecordings;
+		for (const auto& stage : m_renderGraph)
+		{
+			for (const auto& node : stage)
+			{
+				if (node.Type != RenderNodeType::Pass)
+					continue;
+
+				const auto& search = m_passRecordings.find(node.Node);
+				if (search != m_passRecordings.end())
+				{
+					passRecordings.emplace(node.Node, std::move(search->second));
+					continue;
+				}
+
+				if (!CreatePassRecording(renderer, device, *node.Node, passRecordings[node.Node]))
+				{
+					Logger::Error("Failed to create command buffers for render pass '{}' while building render graph.", node.Node->GetName());
+					return false;
+				}
+			}
+		}
+
+		m_passRecordings = std::move(passRecordings);
+		m_nodeBindings = std::move(nodeBindings);
+
+		return true;
+	}
+
+	bool RenderGraph::CreatePassRecording(const Renderer& renderer, const IDevice& device, const IRenderNode& node, PassRecording& recording) const
+	{
+		const IPhysicalDevice& physicalDevice = renderer.GetPhysicalDevice();
+		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
+		uint32_t graphicsFamilyIndex = physicalDevice.GetQueueFamilyIndices().GraphicsFamily.value();
+
+		for (uint32_t i = 0; i < renderer.GetConcurrentFrameCount(); ++i)
+		{
+			std::unique_ptr<ICommandPool>& commandPool = recording.CommandPools.emplace_back(std::move(resourceFactory.CreateCommandPool()));
+			if (!commandPool->Initialise(std::format("{} Command Pool {}", node.GetName(), i), physicalDevice, device, graphicsFamilyIndex, CommandPoolFlags::None))
+				return false;
+
+			auto commandBuffers = commandPool->CreateCommandBuffers(std::format("{} Draw Command Buffer {}", node.GetName(), i), device, 1);
+			if (commandBuffers.empty())
+				return false;
+			recording.DrawCommandBuffers.emplace_back(std::move(commandBuffers[0]));
+
+			// Work following the draw is recorded on the calling thread, so it comes from the frame's shared pool.
+			commandBuffers = m_renderCommandPools[i]->CreateCommandBuffers(std::format("{} Following Command Buffer {}", node.GetName(), i), device, 1);
+			if (commandBuffers.empty())
+				return false;
+			recording.FollowingCommandBuffers.emplace_back(std::move(commandBuffers[0]));
+		}
+
+		return true;
+	}
+
+	bool RenderGraph::FindFinalNode()
+	{
+		// Find the last usage of the 'Output' image and mark it as the final render pass.
+		m_finalNode = nullptr;
+		for (auto it = m_renderGraph.rbegin(); it != m_renderGraph.rend(); ++it)
+		{
+			for (const auto& node : *it)
+			{
+				if (node.Type == RenderNodeType::Pass)
+				{
+					for (const auto& imageOutput : node.Node->GetImageOutputInfos())
 					{
-						RenderPassImageInfo& existing = m_imageInfoBarrierState.at(pair.first);
-						if (existing.LastUsagePassType == RenderNodeType::Resource)
-							existing.LastUsagePassType = node.Type;
-						else if (existing.LastUsagePassType != node.Type)
+						if (imageOutput.first == "Output")
 						{
-							m_perStageOwnershipReleaseResources[existing.LastUsagePassStageIndex].push_back(std::make_pair(pair.first, node.Type == RenderNodeType::Compute));
-							existing.LastUsagePassType = node.Type;
+							m_finalNode = &node;
+							break;
 						}
-						existing.LastUsagePassStageIndex = stageIndex;
 					}
+				}
+			}
 
-				for (const auto& pair : node.Node->GetImageOutputInfos())
-					if (!m_imageInfoBarrierState.contains(pair.first))
-						m_imageInfoBarrierState.emplace(pair.first, blankImageInfo);
-					else
+			if (m_finalNode != nullptr)
+				break;
+		}
+
+		if (m_finalNode == nullptr)
+		{
+			Logger::Error("Render graph could not resolve final 'Output' image usage.");
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32_t RenderGraph::CompileBarrierBatch(const std::vector<RenderGraphNode>& nodes, bool isCompute, uint32_t stageIndex,
+		CompiledBarrierBatch& batch) const
+	{
+		// Resources are visited in name order so the same graph always produces the same barriers.
+		auto sortedByName = [](const auto& infos)
+			{
+				std::vector<const std::remove_cvref_t<decltype(*infos.begin())>*> sorted;
+				for (const auto& pair : infos)
+					sorted.push_back(&pair);
+
+				std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+				return sorted;
+			};
+
+		uint32_t mergedCount = 0;
+		for (const auto& node : nodes)
+		{
+			if (node.Type == RenderNodeType::Resource)
+				continue;
+
+			if (!m_asyncCompute || (node.Type == RenderNodeType::Compute && isCompute) || (node.Type == RenderNodeType::Pass && !isCompute))
+			{
+				for (bool isOutput : { false, true })
+				{
+					for (const auto* pair : sortedByName(isOutput ? node.Node->GetImageOutputInfos() : node.Node->GetImageInputInfos()))
 					{
-						RenderPassImageInfo& existing = m_imageInfoBarrierState.at(pair.first);
-						if (existing.LastUsagePassType == RenderNodeType::Resource)
-							existing.LastUsagePassType = node.Type;
-						else if (existing.LastUsagePassType != node.Type)
+						const RenderPassImageInfo& info = pair->second;
+						if (info.Access == AccessFlags::None)
+							continue;
+
+						auto existing = std::find_if(batch.ImageTransitions.begin(), batch.ImageTransitions.end(), [&info](const CompiledImageTransition& transition)
+							{
+								return info.Image != nullptr && transition.Info->Image == info.Image && transition.Info->Layout == info.Layout;
+							});
+
+						if (existing != batch.ImageTransitions.end())
 						{
-							m_perStageOwnershipReleaseResources[existing.LastUsagePassStageIndex].push_back(std::make_pair(pair.first, node.Type == RenderNodeType::Compute));
-							existing.LastUsagePassType = node.Type;
+							existing->StageFlags |= info.StageFlags;
+							existing->MatAccessFlags |= info.MatAccessFlags;
+							existing->IsOutput &= isOutput;
+							++mergedCount;
+							continue;
 						}
-						existing.LastUsagePassStageIndex = stageIndex;
+
+						batch.ImageTransitions.push_back({ &info, m_imageBarrierStateLookup.at(pair->first), isOutput,
+							IsAliasedImageFirstUse(info.Image, stageIndex), info.StageFlags, info.MatAccessFlags });
 					}
+				}
+			}
+		}
 
-				for (const auto& pair : node.Node->GetBufferInputInfos())
-					if (!m_bufferInfoBarrierState.contains(pair.first))
-						m_bufferInfoBarrierState.emplace(pair.first, blankBufferInfo);
-					else
+		// A buffer used by several nodes in the stage only needs one barrier, covering the stages and accesses of all of them.
+		std::map<std::string_view, size_t> bufferTransitionLookup{};
+		for (const auto& node : nodes)
+		{
+			if (!m_asyncCompute || (node.Type == RenderNodeType::Pass && !isCompute) || (node.Type == RenderNodeType::Compute && isCompute))
+			{
+				for (const auto* infos : { &node.Node->GetBufferInputInfos(), &node.Node->GetBufferOutputInfos() })
+				{
+					for (const auto* pair : sortedByName(*infos))
+					{
+						const RenderPassBufferInfo& info = pair->second;
+						if (info.StageFlags == MaterialStageFlags::None)
+							continue;
+
+						const auto& search = bufferTransitionLookup.find(pair->first);
+						if (search != bufferTransitionLookup.end())
+						{
+							CompiledBufferTransition& existing = batch.BufferTransitions[search->second];
+							existing.Access |= info.Access;
+							existing.StageFlags |= info.StageFlags;
+							existing.MatAccessFlags |= info.MatAccessFlags;
+							++mergedCount;
+							continue;
+						}
+
+						bufferTransitionLookup.emplace(pair->first, batch.BufferTransitions.size());
+						batch.BufferTransitions.push_back({ &info, m_bufferBarrierStateLookup.at(pair->first), info.Access, info.StageFlags, info.MatAccessFlags });
+					}
+				}
+			}
+		}
+
+		return mergedCount;
+	}
+
+	bool RenderGraph::CompileExecutionPlan(const Renderer& renderer)
+	{
+		uint32_t concurrentFrameCount = renderer.GetConcurrentFrameCount();
+		uint32_t stageCount = static_cast<uint32_t>(m_renderGraph.size());
+
+		m_executionPlan.resize(stageCount);
+		m_renderSubmitInfos.resize(concurrentFrameCount);
+		m_computeSubmitInfos.resize(concurrentFrameCount);
+
+		std::vector<std::string_view> passNames;
+		std::vector<bool> computePasses;
+
+		m_scheduleStats = {};
+		m_scheduleStats.StageCount = stageCount;
+
+		uint32_t renderSubmitCount = 0;
+		uint32_t computeSubmitCount = 0;
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			const std::vector<RenderGraphNode>& nodes = m_renderGraph[stageIndex];
+			CompiledStage& stage = m_executionPlan[stageIndex];
+
+			m_scheduleStats.MergedBarrierCount += CompileBarrierBatch(nodes, false, stageIndex, stage.RenderBarriers);
+			if (m_asyncCompute)
+				m_scheduleStats.MergedBarrierCount += CompileBarrierBatch(nodes, true, stageIndex, stage.ComputeBarriers);
+
+			// Passes are numbered in the order they are recorded, which is the order their statistics are reported in.
+			for (const auto& node : nodes)
+			{
+				if (node.Type == RenderNodeType::Pass)
+				{
+					stage.RenderPasses.push_back({ &node, static_cast<uint32_t>(passNames.size()), &m_passRecordings.at(node.Node), {} });
+					CompileBypassCopies(renderer, stage.RenderPasses.back());
+					passNames.emplace_back(node.Node->GetName());
+					computePasses.push_back(false);
+				}
+			}
+
+			for (const auto& node : nodes)
+			{
+				if (node.Type == RenderNodeType::Compute)
+				{
+					stage.ComputePasses.push_back({ &node, static_cast<uint32_t>(passNames.size()), nullptr, {} });
+					passNames.emplace_back(node.Node->GetName());
+					computePasses.push_back(true);
+				}
+			}
+
+			bool stageHasRenderPasses = !stage.RenderPasses.empty();
+			bool stageHasComputePasses = !stage.ComputePasses.empty();
+
+			if (stageHasRenderPasses || (!m_asyncCompute && stageHasComputePasses))
+				stage.RenderSubmitIndex = renderSubmitCount++;
+
+			if (m_asyncCompute && stageHasComputePasses)
+				stage.ComputeSubmitIndex = computeSubmitCount++;
+		}
+
+		m_renderSignalCount = 0;
+		m_computeSignalCount = 0;
+		if (m_asyncCompute)
+			CompileQueueSynchronisation();
+
+		// Which stages wait on and signal the other queue is known once the graph is built, so the semaphores each
+		// submission uses are too. Only their values change from frame to frame.
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			const CompiledStage& stage = m_executionPlan[stageIndex];
+			for (uint32_t frameIndex = 0; frameIndex < concurrentFrameCount; ++frameIndex)
+			{
+				if (stage.RenderSubmitIndex != ~0U)
+				{
+					SubmitInfo& renderSubmitInfo = m_renderSubmitInfos[frameIndex].emplace_back();
+					renderSubmitInfo.CommandBuffers.emplace_back(m_renderCommandBuffers[stageIndex][frameIndex].get());
+					for (const CompiledPass& pass : stage.RenderPasses)
+					{
+						renderSubmitInfo.CommandBuffers.emplace_back(pass.Recording->DrawCommandBuffers[frameIndex].get());
+						renderSubmitInfo.CommandBuffers.emplace_back(pass.Recording->FollowingCommandBuffers[frameIndex].get());
+					}
+					if (stage.RenderWaitSignal != ~0U)
+					{
+						renderSubmitInfo.WaitSemaphores.emplace_back(m_computeToRenderSemaphore.get());
+						renderSubmitInfo.WaitValues.emplace_back(0);
+						renderSubmitInfo.Stages.emplace_back(MaterialStageFlags::TopOfPipe);
+					}
+
+					if (stage.RenderSignal != ~0U)
+					{
+						renderSubmitInfo.SignalSemaphores.emplace_back(m_renderToComputeSemaphore.get());
+						renderSubmitInfo.SignalValues.emplace_back(0);
+					}
+				}
+
+				if (stage.ComputeSubmitIndex != ~0U)
+				{
+					SubmitInfo& computeSubmitInfo = m_computeSubmitInfos[frameIndex].emplace_back();
+					computeSubmitInfo.CommandBuffers.emplace_back(m_computeCommandBuffers[stageIndex][frameIndex].get());
+					if (stage.ComputeWaitSignal != ~0U)
+					{
+						computeSubmitInfo.WaitSemaphores.emplace_back(m_renderToComputeSemaphore.get());
+						computeSubmitInfo.WaitValues.emplace_back(0);
+						computeSubmitInfo.Stages.emplace_back(MaterialStageFlags::TopOfPipe);
+					}
+
+					if (stage.ComputeSignal != ~0U)
+					{
+						computeSubmitInfo.SignalSemaphores.emplace_back(m_computeToRenderSemaphore.get());
+						computeSubmitInfo.SignalValues.emplace_back(0);
+					}
+				}
+			}
+		}
+
+		// Stages are done compiling, so the passes they hold no longer move.
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			const CompiledStage& stage = m_executionPlan[stageIndex];
+			for (const CompiledPass& pass : stage.RenderPasses)
+				m_recordedRenderPasses.push_back(&pass);
+
+			for (const CompiledBarrierBatch* batch : { &stage.RenderBarriers, &stage.ComputeBarriers })
+			{
+				m_scheduleStats.ImageBarrierCount += static_cast<uint32_t>(batch->ImageTransitions.size());
+				m_scheduleStats.BufferBarrierCount += static_cast<uint32_t>(batch->BufferTransitions.size());
+				if (!batch->ImageTransitions.empty() || !batch->BufferTransitions.empty())
+					++m_scheduleStats.PipelineBarrierCount;
+			}
+
+			if (m_asyncCompute)
+			{
+				// Releases are recorded in one barrier per queue they leave.
+				const std::vector<OwnershipRelease>& releases = m_perStageOwnershipReleaseResources[stageIndex];
+				m_scheduleStats.OwnershipTransferCount += static_cast<uint32_t>(releases.size());
+				m_scheduleStats.PipelineBarrierCount += std::ranges::any_of(releases, [](const OwnershipRelease& release) { return release.RenderToCompute; }) ? 1 : 0;
+				m_scheduleStats.PipelineBarrierCount += std::ranges::any_of(releases, [](const OwnershipRelease& release) { return !release.RenderToCompute; }) ? 1 : 0;
+			}
+
+			m_scheduleStats.SemaphoreWaitCount += (stage.RenderWaitSignal != ~0U ? 1 : 0) + (stage.ComputeWaitSignal != ~0U ? 1 : 0);
+			m_scheduleStats.CrossFrameWaitCount += (stage.RenderWaitsOnPreviousFrame ? 1 : 0) + (stage.ComputeWaitsOnPreviousFrame ? 1 : 0);
+		}
+
+		// The blit to the swapchain is a submission of its own.
+		m_scheduleStats.SubmitCount = renderSubmitCount + computeSubmitCount + 1;
+		m_scheduleStats.SemaphoreSignalCount = m_renderSignalCount + m_computeSignalCount;
+
+		Logger::Verbose("Render graph scheduled {} stages in {} submissions: {} pipeline barriers ({} image, {} buffer, {} merged), "
+			"{} queue ownership transfers, {} semaphore waits ({} on the previous frame) and {} signals per frame. Async compute may "
+			"overlap {} render stages of its own frame and {} of the previous one.", m_scheduleStats.StageCount, m_scheduleStats.SubmitCount,
+			m_scheduleStats.PipelineBarrierCount, m_scheduleStats.ImageBarrierCount, m_scheduleStats.BufferBarrierCount,
+			m_scheduleStats.MergedBarrierCount, m_scheduleStats.OwnershipTransferCount, m_scheduleStats.SemaphoreWaitCount,
+			m_scheduleStats.CrossFrameWaitCount, m_scheduleStats.SemaphoreSignalCount, m_scheduleStats.OverlappedRenderStageCount,
+			m_scheduleStats.CrossFrameOverlappedRenderStageCount);
+
+		for (uint32_t frameIndex = 0; frameIndex < concurrentFrameCount; ++frameIndex)
+		{
+			SubmitInfo& blitSubmitInfo = m_renderSubmitInfos[frameIndex].emplace_back();
+			blitSubmitInfo.CommandBuffers.emplace_back(m_blitCommandBuffers[frameIndex].get());
+		}
+
+		m_finalImage = m_finalNode->OutputImages.at("Output");
+
+		// Normally the upscale has already brought the final image to the swapchain's extent, otherwise the blit scales it.
+		ImageBlit& blit = m_blitRegions.emplace_back();
+		blit.srcSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+		blit.srcOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), m_finalImage->GetDimensions() };
+		blit.dstSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+		blit.dstOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), glm::uvec3(renderer.GetSwapChain().GetExtent(), 1) };
+
+		return m_renderStats.Initialise(renderer.GetPhysicalDevice(), renderer.GetDevice(), passNames, computePasses, m_renderResources);
+	}
+
+	void RenderGraph::CompileQueueSynchronisation()
+	{
+		// A stage only has to wait for the other queue when it uses something the other queue used before it, either
+		// earlier in the frame or, as graph resources are shared between frames, in the previous frame. Waits are placed
+		// on the stage that needs the resource rather than the next stage with work, so compute that nothing waits on
+		// runs alongside the graphics work between. Timeline values tell each wait exactly which signal it needs.
+		constexpr uint32_t renderQueue = 0;
+		constexpr uint32_t computeQueue = 1;
+		constexpr uint32_t queueCount = 2;
+
+		struct ResourceUse
+		{
+			uint32_t Stage;
+			uint32_t Queue;
+		};
+
+		uint32_t stageCount = static_cast<uint32_t>(m_executionPlan.size());
+		std::array<std::vector<bool>, queueCount> hasWork;
+		std::array<std::vector<uint32_t>, queueCount> waitSources;
+		std::array<std::vector<uint32_t>, queueCount> previousFrameWaitSources;
+		for (uint32_t queue = 0; queue < queueCount; ++queue)
+		{
+			hasWork[queue].resize(stageCount);
+			waitSources[queue].resize(stageCount, ~0U);
+			previousFrameWaitSources[queue].resize(stageCount, ~0U);
+		}
+
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			hasWork[renderQueue][stageIndex] = m_executionPlan[stageIndex].RenderSubmitIndex != ~0U;
+			hasWork[computeQueue][stageIndex] = m_executionPlan[stageIndex].ComputeSubmitIndex != ~0U;
+		}
+
+		// Resources are tracked by what they are rather than their names, as several names can share an image.
+		std::unordered_map<const void*, std::vector<ResourceUse>> resourceUses;
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			for (const auto& node : m_renderGraph[stageIndex])
+			{
+				if (node.Type == RenderNodeType::Resource)
+					continue;
+
+				uint32_t queue = node.Type == RenderNodeType::Compute ? computeQueue : renderQueue;
+				auto addUse = [&](const void* resource)
+					{
+						if (resource == nullptr)
+							return;
+
+						std::vector<ResourceUse>& uses = resourceUses[resource];
+						if (uses.empty() || uses.back().Stage != stageIndex || uses.back().Queue != queue)
+							uses.push_back({ stageIndex, queue });
+					};
+
+				for (const auto& pair : node.InputImages)
+					addUse(pair.second);
+				for (const auto& pair : node.OutputImages)
+					addUse(pair.second);
+				for (const auto& pair : node.InputBuffers)
+					addUse(pair.second);
+				for (const auto& pair : node.OutputBuffers)
+					addUse(pair.second);
+			}
+		}
+
+		// Each use waits for the latest earlier use on the other queue. The first use on a queue also waits for the
+		// other queue's last use in the previous frame. Uses in the same stage on both queues only read, so are not ordered.
+		auto addDependencies = [&](const std::vector<ResourceUse>& uses)
+			{
+				for (size_t i = 0; i < uses.size(); ++i)
+				{
+					const ResourceUse& use = uses[i];
+					for (size_t j = i; j-- > 0;)
 					{
-						RenderPassBufferInfo& existing = m_bufferInfoBarrierState.at(pair.first);
-						if (existing.LastUsagePassType == RenderNodeType::Resource)
-							existing.LastUsagePassType = node.Type;
-						else if (existing.LastUsagePassType != node.Type)
+						if (uses[j].Queue != use.Queue && uses[j].Stage < use.Stage)
 						{
-							m_perStageOwnershipReleaseResources[existing.LastUsagePassStageIndex].push_back(std::make_pair(pair.first, node.Type == RenderNodeType::Compute));
-							existing.LastUsagePassType = node.Type;
+							uint32_t& source = waitSources[use.Queue][use.Stage];
+							source = source == ~0U ? uses[j].Stage : std::max(source, uses[j].Stage);
+							break;
 						}
-						existing.LastUsagePassStageIndex = stageIndex;
 					}
+				}
+
+				for (uint32_t queue = 0; queue < queueCount; ++queue)
+				{
+					auto first = std::ranges::find_if(uses, [queue](const ResourceUse& use) { return use.Queue == queue; });
+					auto reversedUses = uses | std::views::reverse;
+					auto last = std::ranges::find_if(reversedUses, [queue](const ResourceUse& use) { return use.Queue != queue; });
+					if (first == uses.end() || last == reversedUses.end())
+						continue;
+
+					uint32_t& source = previousFrameWaitSources[queue][first->Stage];
+					source = source == ~0U ? last->Stage : std::max(source, last->Stage);
+				}
+			};
+
+		for (const auto& pair : resourceUses)
+			addDependencies(pair.second);
+
+		// Images sharing memory are one resource as far as ordering goes, whichever queues use them.
+		for (size_t i = 0; i < m_transientImages.size(); ++i)
+		{
+			const TransientImage& first = m_transientImages[i];
+			for (size_t j = i + 1; j < m_transientImages.size(); ++j)
+			{
+				const TransientImage& second = m_transientImages[j];
+				if (!first.Aliased || !second.Aliased || first.HeapIndex != second.HeapIndex
+					|| first.Offset >= second.Offset + second.Requirements.Size || second.Offset >= first.Offset + first.Requirements.Size)
+					continue;
+
+				const auto& firstSearch = resourceUses.find(first.Image);
+				const auto& secondSearch = resourceUses.find(second.Image);
+				if (firstSearch == resourceUses.end() || secondSearch == resourceUses.end())
+					continue;
 
-				for (const auto& pair : node.Node->GetBufferOutputInfos())
-					if (!m_bufferInfoBarrierState.contains(pair.first))
-						m_bufferInfoBarrierState.emplace(pair.first, blankBufferInfo);
-					else
-					{
-						RenderPassBufferInfo& existing = m_bufferInfoBarrierState.at(pair.first);
-						if (existing.LastUsagePassType == RenderNodeType::Resource)
-							existing.LastUsagePassType = node.Type;
-						else if (existing.LastUsagePassType != node.Type)
-						{
-							m_perStageOwnershipReleaseResources[existing.LastUsagePassStageIndex].push_back(std::make_pair(pair.first, node.Type == RenderNodeType::Compute));
-							existing.LastUsagePassType = node.Type;
-						}
-						existing.LastUsagePassStageIndex = stageIndex;
-					}
+				std::vector<ResourceUse> uses = firstSearch->second;
+				uses.insert(uses.end(), secondSearch->second.begin(), secondSearch->second.end());
+				std::ranges::stable_sort(uses, {}, &ResourceUse::Stage);
+				addDependencies(uses);
 			}
+		}
 
-			std::vector<std::unique_ptr<ICommandBuffer>> renderCommandBuffers;
-			std::vector<std::unique_ptr<ICommandBuffer>> computeCommandBuffers;
-			for (uint32_t i = 0; i < concurrentFrameCount; ++i)
+		// Submissions on a queue run in order, so a wait also covers every later stage on that queue. Only waits for
+		// signals no earlier wait reached are kept. The last wait of a frame carries over to the start of the next.
+		std::array<std::vector<uint32_t>, queueCount> waits;
+		std::array<std::vector<bool>, queueCount> previousFrameWaits;
+		std::array<std::vector<bool>, queueCount> signals;
+		for (uint32_t queue = 0; queue < queueCount; ++queue)
+		{
+			waits[queue].resize(stageCount, ~0U);
+			previousFrameWaits[queue].resize(stageCount, false);
+			signals[queue].resize(stageCount, false);
+		}
+
+		for (uint32_t queue = 0; queue < queueCount; ++queue)
+		{
+			uint32_t otherQueue = queueCount - 1 - queue;
+			uint32_t covered = ~0U;
+			for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
 			{
-				auto commandBuffers = m_renderCommandPools[i]->CreateCommandBuffers(std::format("Stage {} Render Command Buffer {}", stageIndex, i), device, 1);
-				if (commandBuffers.empty())
-					return false;
-				renderCommandBuffers.emplace_back(std::move(commandBuffers[0]));
+				uint32_t source = waitSources[queue][stageIndex];
+				if (!hasWork[queue][stageIndex] || source == ~0U || (covered != ~0U && source <= covered))
+					continue;
 
-				if (m_asyncCompute)
-				{
-					commandBuffers = m_computeCommandPools[i]->CreateCommandBuffers(std::format("Stage {} Compute Command Buffer {}", stageIndex, i), device, 1);
-					if (commandBuffers.empty())
-						return false;
-					computeCommandBuffers.emplace_back(std::move(commandBuffers[0]));
-				}
+				waits[queue][stageIndex] = source;
+				signals[otherQueue][source] = true;
+				covered = source;
 			}
 
-			m_renderCommandBuffers.emplace_back(std::move(renderCommandBuffers));
-			if (m_asyncCompute)
-				m_computeCommandBuffers.emplace_back(std::move(computeCommandBuffers));
+			for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+			{
+				if (waits[queue][stageIndex] != ~0U)
+					break;
 
-			++stageIndex;
+				uint32_t source = previousFrameWaitSources[queue][stageIndex];
+				if (!hasWork[queue][stageIndex] || source == ~0U || (covered != ~0U && source <= covered))
+					continue;
+
+				waits[queue][stageIndex] = source;
+				previousFrameWaits[queue][stageIndex] = true;
+				signals[otherQueue][source] = true;
+				covered = source;
+			}
 		}
 
-		return true;
-	}
+		std::array<std::vector<uint32_t>, queueCount> signalIndices;
+		std::array<uint32_t, queueCount> signalCounts{};
+		for (uint32_t queue = 0; queue < queueCount; ++queue)
+		{
+			signalIndices[queue].resize(stageCount, ~0U);
+			for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+			{
+				if (signals[queue][stageIndex])
+					signalIndices[queue][stageIndex] = signalCounts[queue]++;
+			}
+		}
 
-	bool RenderGraph::FindFinalNode()
-	{
-		// Find the last usage of the 'Output' image and mark it as the final render pass.
-		m_finalNode = nullptr;
-		for (auto it = m_renderGraph.rbegin(); it != m_renderGraph.rend(); ++it)
+		m_renderSignalCount = signalCounts[renderQueue];
+		m_computeSignalCount = signalCounts[computeQueue];
+
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
 		{
-			for (const auto& node : *it)
+			CompiledStage& stage = m_executionPlan[stageIndex];
+			stage.RenderSignal = signalIndices[renderQueue][stageIndex];
+			stage.ComputeSignal = signalIndices[computeQueue][stageIndex];
+
+			uint32_t renderWait = waits[renderQueue][stageIndex];
+			stage.RenderWaitSignal = renderWait != ~0U ? signalIndices[computeQueue][renderWait] : ~0U;
+			stage.RenderWaitsOnPreviousFrame = previousFrameWaits[renderQueue][stageIndex];
+
+			uint32_t computeWait = waits[computeQueue][stageIndex];
+			stage.ComputeWaitSignal = computeWait != ~0U ? signalIndices[renderQueue][computeWait] : ~0U;
+			stage.ComputeWaitsOnPreviousFrame = previousFrameWaits[computeQueue][stageIndex];
+		}
+
+		// How much graphics work each compute submission may overlap. It cannot start before the render stages it or an
+		// earlier compute stage waited on, and has to finish before the first render stage waiting on it or a later
+		// compute stage. Without a wait in its own frame it may also overlap the end of the previous frame.
+		uint32_t currentLowerBound = ~0U;
+		uint32_t previousLowerBound = ~0U;
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+		{
+			if (waits[computeQueue][stageIndex] != ~0U && !previousFrameWaits[computeQueue][stageIndex])
+				currentLowerBound = waits[computeQueue][stageIndex];
+			else if (previousFrameWaits[computeQueue][stageIndex])
+				previousLowerBound = waits[computeQueue][stageIndex];
+
+			if (!hasWork[computeQueue][stageIndex])
+				continue;
+
+			uint32_t upperBound = stageCount;
+			for (uint32_t renderStage = 0; renderStage < stageCount; ++renderStage)
 			{
-				if (node.Type == RenderNodeType::Pass)
+				uint32_t renderWait = waits[renderQueue][renderStage];
+				if (renderWait != ~0U && !previousFrameWaits[renderQueue][renderStage] && renderWait >= stageIndex)
 				{
-					for (const auto& imageOutput : node.Node->GetImageOutputInfos())
-					{
-						if (imageOutput.first == "Output")
-						{
-							m_finalNode = &node;
-							break;
-						}
-					}
+					upperBound = renderStage;
+					break;
 				}
 			}
 
-			if (m_finalNode != nullptr)
-				break;
-		}
+			uint32_t overlapped = 0;
+			uint32_t previousOverlapped = 0;
+			for (uint32_t renderStage = 0; renderStage < stageCount; ++renderStage)
+			{
+				if (!hasWork[renderQueue][renderStage])
+					continue;
 
-		if (m_finalNode == nullptr)
-		{
-			Logger::Error("Render graph could not resolve final 'Output' image usage.");
-			return false;
-		}
+				if (renderStage < upperBound && (currentLowerBound == ~0U || renderStage > currentLowerBound))
+					++overlapped;
 
-		return true;
+				if (currentLowerBound == ~0U && (previousLowerBound == ~0U || renderStage > previousLowerBound))
+					++previousOverlapped;
+			}
+
+			m_scheduleStats.OverlappedRenderStageCount += overlapped;
+			m_scheduleStats.CrossFrameOverlappedRenderStageCount += previousOverlapped;
+			Logger::Verbose("Async compute stage {} may overlap {} render stages of its frame and {} of the previous one.",
+				stageIndex, overlapped, previousOverlapped);
+		}
 	}
 
 	bool RenderGraph::Build(const Renderer& renderer, bool asyncCompute)
 	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
 		const IDevice& device = renderer.GetDevice();
 		const IPhysicalDevice& physicalDevice = renderer.GetPhysicalDevice();
 
+		// Switching queues recreates the command pools, so nothing recorded against them can be kept.
+		m_buildChange = asyncCompute != m_asyncCompute ? RenderGraphChange::All : m_pendingChange;
+
 		std::unordered_map<std::string, RenderGraphNode&> renderGraphNodeLookup;
 		std::unordered_map<Format, std::vector<ImageInfo>> formatRenderTextureLookup;
 		std::unordered_map<IRenderImage*, uint32_t> imageInfoLookup;
-		m_renderTextures.clear();
 		m_renderGraph.clear();
-		m_renderCommandBuffers.clear();
-		m_computeCommandBuffers.clear();
-		m_renderTextures.clear();
-		m_imageInfoBarrierState.clear();
-		m_bufferInfoBarrierState.clear();
+		m_transientImageLookup.clear();
+		m_freshResources.clear();
+
+		if (m_buildChange == RenderGraphChange::All)
+		{
+			m_renderCommandBuffers.clear();
+			m_computeCommandBuffers.clear();
+			m_passRecordings.clear();
+			m_nodeBindings.clear();
+			m_transientImages.clear();
+			m_renderTextures.clear();
+			m_memoryHeaps.clear();
+			m_memoryHeapRequirements.clear();
+		}
+		else
+		{
+			m_previousTransientImages = std::move(m_transientImages);
+			m_previousRenderTextures = std::move(m_renderTextures);
+			m_previousMemoryHeaps = std::move(m_memoryHeaps);
+			m_previousMemoryHeapRequirements = std::move(m_memoryHeapRequirements);
+			m_transientImages.clear();
+			m_renderTextures.clear();
+			m_memoryHeaps.clear();
+			m_memoryHeapRequirements.clear();
+		}
+
+		m_imageBarrierStateLookup.clear();
+		m_bufferBarrierStateLookup.clear();
+		m_imageBarrierStates.clear();
+		m_bufferBarrierStates.clear();
 		m_perStageOwnershipReleaseResources.clear();
+		m_executionPlan.clear();
+		m_recordedRenderPasses.clear();
+		m_renderSubmitInfos.clear();
+		m_computeSubmitInfos.clear();
+		m_blitRegions.clear();
+		m_finalImage = nullptr;
+		m_previousFrameSignalled = false;
 
 		if (asyncCompute != m_asyncCompute)
 		{
@@ -740,16 +2011,15 @@ namespace Engine::Rendering
 				return false;
 		}
 
-		std::unordered_map<std::string, RenderGraphNode*> availableBufferSources{};
-		std::unordered_map<std::string, RenderGraphNode*> availableImageSources{};
-
 		Format depthFormat = physicalDevice.GetDepthFormat();
 		const ISwapChain& swapchain = renderer.GetSwapChain();
-		glm::uvec3 defaultExtents = glm::uvec3(swapchain.GetExtent(), 1);
+		m_renderExtent = renderer.GetRenderExtent();
+		glm::uvec3 defaultExtents = glm::uvec3(m_renderExtent, 1);
 		Format swapchainFormat = swapchain.GetFormat();
 
 		auto nodeLookupKeys = std::views::keys(m_renderNodeLookup);
 		std::vector<std::string_view> passNames{ nodeLookupKeys.begin(), nodeLookupKeys.end() };
+		std::sort(passNames.begin(), passNames.end());
 
 		std::vector<IRenderNode*> renderNodeStack;
 		for (auto& renderResource : m_renderResources)
@@ -765,7 +2035,6 @@ namespace Engine::Rendering
 			}
 		}
 
-		uint32_t enabledPasses = 0;
 		renderNodeStack.reserve(m_renderPasses.size() + m_computePasses.size());
 		for (const auto& pass : m_computePasses)
 		{
@@ -774,7 +2043,6 @@ namespace Engine::Rendering
 				pass->UpdateConnections(renderer, passNames);
 				pass->UpdatePlaceholderFormats(swapchainFormat, depthFormat);
 				renderNodeStack.emplace_back(pass);
-				++enabledPasses;
 			}
 			else
 			{
@@ -789,7 +2057,6 @@ namespace Engine::Rendering
 				pass->UpdatePlaceholderFormats(swapchainFormat, depthFormat);
 
 				renderNodeStack.emplace_back(pass);
-				++enabledPasses;
 			}
 			else
 			{
@@ -797,162 +2064,197 @@ namespace Engine::Rendering
 			}
 		}
 
-		if (!DetermineRequiredResources(renderNodeStack, availableImageSources, availableBufferSources))
+		// The schedule only depends on the enabled nodes and what they declare, so configurations built before reuse theirs.
+		// What follows is compiled on a hit as well. Images and barriers bind to resources created for this build, and
+		// placement depends on which images the incremental rebuild kept, so a cached copy would have to be validated
+		// against both.
+		std::string layoutKey = RenderGraphLayout::CreateKey(renderNodeStack, defaultExtents, asyncCompute);
+		const auto& cachedLayout = m_layoutCache.find(layoutKey);
+		m_layoutCacheHit = cachedLayout != m_layoutCache.end();
+		if (m_layoutCacheHit)
+		{
+			if (!RestoreSchedule(cachedLayout->second))
+				return false;
+		}
+		else if (!DetermineRequiredResources(renderNodeStack))
 			return false;
 
 		if (!ReserveRenderTexturesForPasses(renderer, defaultExtents, formatRenderTextureLookup, imageInfoLookup))
 			return false;
 
-		if (!BuildPasses(renderer, device))
+		if (!FindFinalNode())
 			return false;
 
-		if (!FindFinalNode())
+		if (!AllocateTransientImages(renderer))
+			return false;
+
+		if (!BuildPasses(renderer, device))
 			return false;
 
-		if (!m_renderStats.Initialise(renderer.GetPhysicalDevice(), device, enabledPasses))
+		if (!CompileExecutionPlan(renderer))
 			return false;
 
+		RenderGraphLayout layout = CreateLayout(Hash::CalculateHash(layoutKey.data(), layoutKey.size()));
+		std::string serialisedLayout = layout.Serialise();
+		if (!m_serialisedLayout.empty())
+		{
+			for (const std::string& change : RenderGraphLayout::Diff(m_serialisedLayout, serialisedLayout))
+				Logger::Verbose("Render graph layout change: {}", change);
+		}
+
+		m_serialisedLayout = std::move(serialisedLayout);
+		m_layoutCache.insert_or_assign(std::move(layoutKey), std::move(layout));
+
+		// Whatever the new graph did not take over from the previous one, images before the memory they are bound to.
+		m_previousTransientImages.clear();
+		m_previousRenderTextures.clear();
+		m_previousMemoryHeaps.clear();
+		m_previousMemoryHeapRequirements.clear();
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		float deltaTime = std::chrono::duration<float, std::chrono::milliseconds::period>(endTime - startTime).count();
+
+		static const char* changeNames[] = { "None", "Passes", "RenderExtent", "Resources", "All" };
+		Logger::Verbose("Render graph built for '{}' change in {:.2f}ms: {} of {} nodes built, {} of {} transient images kept, schedule {}.",
+			changeNames[static_cast<uint32_t>(m_buildChange)], deltaTime, m_nodeBuildCount, m_nodeBindings.size(),
+			m_transientMemoryStats.RetainedImageCount, m_transientMemoryStats.ImageCount, m_layoutCacheHit ? "cached" : "compiled");
+
+		++m_buildCount;
+		m_pendingChange = RenderGraphChange::None;
 		m_dirty = false;
 		return true;
 	}
 
+	bool RenderGraph::IsAliasedImageFirstUse(const IRenderImage* image, uint32_t stageIndex) const
+	{
+		const auto& search = m_transientImageLookup.find(image);
+		if (search == m_transientImageLookup.end())
+			return false;
+
+		const TransientImage& transientImage = m_transientImages[search->second];
+		return transientImage.Aliased && transientImage.FirstStage == stageIndex;
+	}
+
 	void RenderGraph::TransitionResourcesForStage(const Renderer& renderer, const ICommandBuffer& commandBuffer, bool isCompute,
-		const std::vector<RenderGraphNode>& nodes)
+		const CompiledBarrierBatch& batch)
 	{
-		const IDevice& device = renderer.GetDevice();
 		uint32_t currentQueueFamilyIndex = commandBuffer.GetQueueFamilyIndex();
 
-		std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
+		IMemoryBarriers& memoryBarriers = *m_stageMemoryBarriers;
 
 		// Transition image layouts where necessary.
-		for (const auto& node : nodes)
+		for (const CompiledImageTransition& transition : batch.ImageTransitions)
 		{
-			if (node.Type == RenderNodeType::Resource)
+			const RenderPassImageInfo& imageInfo = *transition.Info;
+			if (imageInfo.Image == nullptr)
 				continue;
 
-			if (!m_asyncCompute || (node.Type == RenderNodeType::Compute && isCompute) || (node.Type == RenderNodeType::Pass && !isCompute))
-			{
-				for (const auto& pair : node.Node->GetImageInputInfos())
-				{
-					const RenderPassImageInfo& imageInfo = pair.second;
-					if (imageInfo.Image != nullptr && imageInfo.Access != AccessFlags::None)
-					{
-						auto& currentState = m_imageInfoBarrierState.at(pair.first);
-						currentState.Image = imageInfo.Image;
-
-						if (currentState.QueueFamilyIndex == ~0U)
-							currentState.QueueFamilyIndex = currentQueueFamilyIndex;
+			auto& currentState = m_imageBarrierStates[transition.StateIndex];
+			currentState.Image = imageInfo.Image;
 
-						// If image layout is currently undefined, clear it as it may be being used as a read-only input.
-						if (imageInfo.Image->GetLayout() == ImageLayout::Undefined && imageInfo.Layout == ImageLayout::ShaderReadOnly)
-						{
-							imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer,
-								MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, *memoryBarriers);
-							commandBuffer.MemoryBarrier(*memoryBarriers);
-							memoryBarriers->Clear();
-
-							if (imageInfo.Format == renderer.GetDepthFormat())
-								commandBuffer.ClearDepthStencilImage(*imageInfo.Image);
-							else
-								commandBuffer.ClearColourImage(*imageInfo.Image, Engine::Colour());
-						}
+			if (currentState.QueueFamilyIndex == ~0U)
+				currentState.QueueFamilyIndex = currentQueueFamilyIndex;
 
-						imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer, imageInfo.StageFlags, imageInfo.Layout, imageInfo.MatAccessFlags,
-							*memoryBarriers, 0, 0, currentState.QueueFamilyIndex, currentQueueFamilyIndex, isCompute);
+			bool aliasedFirstUse = transition.AliasedFirstUse;
+			if (!transition.IsOutput)
+			{
+				// If image layout is currently undefined, clear it as it may be being used as a read-only input.
+				if ((aliasedFirstUse || imageInfo.Image->GetLayout() == ImageLayout::Undefined) && imageInfo.Layout == ImageLayout::ShaderReadOnly)
+				{
+					if (aliasedFirstUse)
+						imageInfo.Image->AppendAliasingBarrier(commandBuffer, MaterialStageFlags::AllCommands, MaterialAccessFlags::MemoryWrite,
+							MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, memoryBarriers);
+					else
+						imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer,
+							MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, memoryBarriers);
+					commandBuffer.MemoryBarrier(memoryBarriers);
+					memoryBarriers.Clear();
 
-						currentState.StageFlags = imageInfo.StageFlags;
-						currentState.MatAccessFlags = imageInfo.MatAccessFlags;
-						currentState.Layout = imageInfo.Layout;
-						currentState.QueueFamilyIndex = currentQueueFamilyIndex;
-					}
+					if (imageInfo.Format == renderer.GetDepthFormat())
+						commandBuffer.ClearDepthStencilImage(*imageInfo.Image);
+					else
+						commandBuffer.ClearColourImage(*imageInfo.Image, Engine::Colour());
 				}
-
-				for (const auto& pair : node.Node->GetImageOutputInfos())
+				else if (aliasedFirstUse)
 				{
-					const RenderPassImageInfo& imageInfo = pair.second;
-					if (imageInfo.Image != nullptr && imageInfo.Access != AccessFlags::None)
-					{
-						auto& currentState = m_imageInfoBarrierState.at(pair.first);
-						currentState.Image = imageInfo.Image;
-
-						if (currentState.QueueFamilyIndex == ~0U)
-							currentState.QueueFamilyIndex = currentQueueFamilyIndex;
-
-						imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer, imageInfo.StageFlags, imageInfo.Layout, imageInfo.MatAccessFlags,
-							*memoryBarriers, 0, 0, currentState.QueueFamilyIndex, currentQueueFamilyIndex, isCompute);
-
-						currentState.StageFlags = imageInfo.StageFlags;
-						currentState.MatAccessFlags = imageInfo.MatAccessFlags;
-						currentState.Layout = imageInfo.Layout;
-						currentState.QueueFamilyIndex = currentQueueFamilyIndex;
-					}
+					imageInfo.Image->AppendAliasingBarrier(commandBuffer, MaterialStageFlags::AllCommands, MaterialAccessFlags::MemoryWrite,
+						transition.StageFlags, imageInfo.Layout, transition.MatAccessFlags, memoryBarriers);
 				}
-			}
-		}
-
-		// Perform buffer memory barriers where necessary.
 
-		std::unordered_map<std::string, RenderPassBufferInfo> bufferInfos{};
-		for (const auto& node : nodes)
-		{
-			if (!m_asyncCompute || (node.Type == RenderNodeType::Pass && !isCompute) || (node.Type == RenderNodeType::Compute && isCompute))
+				if (!aliasedFirstUse || imageInfo.Layout == ImageLayout::ShaderReadOnly)
+					imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer, transition.StageFlags, imageInfo.Layout, transition.MatAccessFlags,
+						memoryBarriers, 0, 0, currentState.QueueFamilyIndex, currentQueueFamilyIndex, isCompute);
+			}
+			else
 			{
-				const auto& bufferInputInfos = node.Node->GetBufferInputInfos();
-				const auto& bufferOutputInfos = node.Node->GetBufferOutputInfos();
-				bufferInfos.insert(bufferInputInfos.begin(), bufferInputInfos.end());
-				bufferInfos.insert(bufferOutputInfos.begin(), bufferOutputInfos.end());
+				// Memory shared with other images holds whatever they last wrote, wait for all of it before reusing the memory.
+				if (aliasedFirstUse)
+					imageInfo.Image->AppendAliasingBarrier(commandBuffer, MaterialStageFlags::AllCommands, MaterialAccessFlags::MemoryWrite,
+						transition.StageFlags, imageInfo.Layout, transition.MatAccessFlags, memoryBarriers);
+				else
+					imageInfo.Image->AppendImageLayoutTransitionExt(commandBuffer, transition.StageFlags, imageInfo.Layout, transition.MatAccessFlags,
+						memoryBarriers, 0, 0, currentState.QueueFamilyIndex, currentQueueFamilyIndex, isCompute);
 			}
+
+			currentState.StageFlags = transition.StageFlags;
+			currentState.MatAccessFlags = transition.MatAccessFlags;
+			currentState.Layout = imageInfo.Layout;
+			currentState.QueueFamilyIndex = currentQueueFamilyIndex;
 		}
 
-		if (!bufferInfos.empty())
+		// Perform buffer memory barriers where necessary.
+		for (const CompiledBufferTransition& transition : batch.BufferTransitions)
 		{
-			for (const auto& pair : bufferInfos)
-			{
-				const RenderPassBufferInfo& bufferInfo = pair.second;
-				if (bufferInfo.StageFlags != MaterialStageFlags::None && bufferInfo.Buffer != nullptr)
-				{
-					auto& currentState = m_bufferInfoBarrierState.at(pair.first);
-					currentState.Buffer = bufferInfo.Buffer;
+			const RenderPassBufferInfo& bufferInfo = *transition.Info;
+			if (bufferInfo.Buffer == nullptr)
+				continue;
 
-					if (currentState.QueueFamilyIndex == ~0U)
-						currentState.QueueFamilyIndex = currentQueueFamilyIndex;
+			auto& currentState = m_bufferBarrierStates[transition.StateIndex];
+			currentState.Buffer = bufferInfo.Buffer;
 
-					bufferInfo.Buffer->AppendBufferMemoryBarrier(commandBuffer, currentState.StageFlags, currentState.MatAccessFlags,
-						bufferInfo.StageFlags, bufferInfo.MatAccessFlags, *memoryBarriers,
-						currentState.QueueFamilyIndex, currentQueueFamilyIndex);
+			if (currentState.QueueFamilyIndex == ~0U)
+				currentState.QueueFamilyIndex = currentQueueFamilyIndex;
 
-					currentState.Access = bufferInfo.Access;
-					currentState.StageFlags = bufferInfo.StageFlags;
-					currentState.MatAccessFlags = bufferInfo.MatAccessFlags;
-					currentState.QueueFamilyIndex = currentQueueFamilyIndex;
-				}
-			}
+			bufferInfo.Buffer->AppendBufferMemoryBarrier(commandBuffer, currentState.StageFlags, currentState.MatAccessFlags,
+				transition.StageFlags, transition.MatAccessFlags, memoryBarriers,
+				currentState.QueueFamilyIndex, currentQueueFamilyIndex);
+
+			currentState.Access = transition.Access;
+			currentState.StageFlags = transition.StageFlags;
+			currentState.MatAccessFlags = transition.MatAccessFlags;
+			currentState.QueueFamilyIndex = currentQueueFamilyIndex;
 		}
 
-		if (!memoryBarriers->Empty())
-			commandBuffer.MemoryBarrier(*memoryBarriers);
+		if (!memoryBarriers.Empty())
+		{
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
+		}
 	}
 
-	bool RenderGraph::DrawRenderPass(const Renderer& renderer, const RenderGraphNode& node, const ICommandBuffer& commandBuffer,
+	bool RenderGraph::DrawRenderPass(const Renderer& renderer, const CompiledPass& compiledPass, const ICommandBuffer& commandBuffer,
 		uint32_t frameIndex, const glm::uvec2& size) const
 	{
-		const IDevice& device = renderer.GetDevice();
-
+		const RenderGraphNode& node = *compiledPass.Node;
 		IRenderPass* pass = static_cast<IRenderPass*>(node.Node);
 
-		m_renderStats.Begin(commandBuffer, pass->GetName(), false);
+		// Statistics queries have to begin and end in the same command buffer, so they only cover the draw itself.
+		m_renderStats.Begin(commandBuffer, compiledPass.StatsIndex);
 
 		const std::vector<AttachmentInfo>& colourAttachments = pass->GetColourAttachments();
-		const std::optional<AttachmentInfo>& depthAttachment = pass->GetDepthAttachment();
+		std::optional<AttachmentInfo> depthAttachment = pass->GetDepthAttachment();
 
 		glm::uvec2 passSize = size;
 		pass->GetCustomSize(passSize);
 
-		pass->PreDraw(renderer, commandBuffer, passSize, frameIndex, node.InputImages, node.OutputImages);
-
+		// Every layer renders into the whole layered depth attachment, so only the first may clear it. The load op is changed
+		// on a local copy as passes may be recorded in parallel with others and must stay unchanged while drawing.
 		uint32_t layerCount = pass->GetLayerCount();
 		for (uint32_t layerIndex = 0; layerIndex < layerCount; ++layerIndex)
 		{
+			if (layerIndex == 1 && depthAttachment.has_value())
+				depthAttachment->loadOp = AttachmentLoadOp::Load;
+
 			commandBuffer.BeginRendering(colourAttachments, depthAttachment, passSize, layerCount);
 
 			pass->Draw(renderer, commandBuffer, passSize, frameIndex, layerIndex);
@@ -960,29 +2262,108 @@ namespace Engine::Rendering
 			commandBuffer.EndRendering();
 		}
 
-		pass->PostDraw(renderer, commandBuffer, passSize, frameIndex, node.InputImages, node.OutputImages);
-
-		m_renderStats.End(commandBuffer, false);
+		m_renderStats.End(commandBuffer, compiledPass.StatsIndex);
 
 		return true;
 	}
 
-	bool RenderGraph::DispatchComputePass(Renderer& renderer, const RenderGraphNode& node, const ICommandBuffer& commandBuffer,
+	bool RenderGraph::RecordRenderPass(const Renderer& renderer, const CompiledPass& compiledPass, uint32_t frameIndex,
+		const glm::uvec2& size) const
+	{
+		compiledPass.Recording->CommandPools[frameIndex]->Reset(renderer.GetDevice());
+
+		const ICommandBuffer& commandBuffer = *compiledPass.Recording->DrawCommandBuffers[frameIndex];
+		if (!commandBuffer.Begin())
+			return false;
+
+		// A bypassed pass keeps its statistics queries so the results stay available, they just cover no work.
+		bool result = true;
+		if (compiledPass.Node->Node->GetBypassed())
+		{
+			m_renderStats.Begin(commandBuffer, compiledPass.StatsIndex);
+			m_renderStats.End(commandBuffer, compiledPass.StatsIndex);
+		}
+		else
+		{
+			result = DrawRenderPass(renderer, compiledPass, commandBuffer, frameIndex, size);
+		}
+
+		commandBuffer.End();
+
+		return result;
+	}
+
+	void RenderGraph::CompileBypassCopies(const Renderer& renderer, CompiledPass& compiledPass) const
+	{
+		const IRenderNode& node = *compiledPass.Node->Node;
+		const auto& inputInfos = node.GetImageInputInfos();
+		for (const auto& output : node.GetImageOutputInfos())
+		{
+			const auto& input = inputInfos.find(output.first);
+			if (input == inputInfos.end())
+				continue;
+
+			// Images passed straight through already hold the input, and depth images cannot be copied from.
+			const RenderPassImageInfo& inputInfo = input->second;
+			const RenderPassImageInfo& outputInfo = output.second;
+			if (inputInfo.Image == nullptr || outputInfo.Image == nullptr || inputInfo.Image == outputInfo.Image ||
+				outputInfo.Format == renderer.GetDepthFormat())
+				continue;
+
+			BypassCopy& copy = compiledPass.BypassCopies.emplace_back();
+			copy.Input = &inputInfo;
+			copy.Output = &outputInfo;
+
+			ImageBlit& blit = copy.Regions.emplace_back();
+			blit.srcSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+			blit.srcOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), inputInfo.Image->GetDimensions() };
+			blit.dstSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+			blit.dstOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), outputInfo.Image->GetDimensions() };
+		}
+	}
+
+	void RenderGraph::CopyBypassedImages(const ICommandBuffer& commandBuffer, const CompiledPass& compiledPass)
+	{
+		IMemoryBarriers& memoryBarriers = *m_stageMemoryBarriers;
+		for (const BypassCopy& copy : compiledPass.BypassCopies)
+		{
+			IRenderImage& inputImage = *copy.Input->Image;
+			IRenderImage& outputImage = *copy.Output->Image;
+
+			inputImage.AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferSrc, memoryBarriers);
+			outputImage.AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferDst, memoryBarriers);
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
+
+			commandBuffer.BlitImage(inputImage, outputImage, copy.Regions, Filter::Nearest);
+
+			// Both images are left as the stage's barriers left them, other passes in the stage may use them.
+			inputImage.AppendImageLayoutTransitionExt(commandBuffer, copy.Input->StageFlags, copy.Input->Layout,
+				copy.Input->MatAccessFlags, memoryBarriers);
+			outputImage.AppendImageLayoutTransitionExt(commandBuffer, copy.Output->StageFlags, copy.Output->Layout,
+				copy.Output->MatAccessFlags, memoryBarriers);
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
+		}
+	}
+
+	bool RenderGraph::DispatchComputePass(Renderer& renderer, const CompiledPass& compiledPass, const ICommandBuffer& commandBuffer,
 		uint32_t frameIndex) const
 	{
-		IComputePass* pass = static_cast<IComputePass*>(node.Node);
+		IComputePass* pass = static_cast<IComputePass*>(compiledPass.Node->Node);
 
-		m_renderStats.Begin(commandBuffer, pass->GetName(), true);
+		m_renderStats.Begin(commandBuffer, compiledPass.StatsIndex);
 
-		pass->Dispatch(renderer, commandBuffer, frameIndex);
+		// Compute outputs of a bypassed pass keep whatever they last held.
+		if (!pass->GetBypassed())
+			pass->Dispatch(renderer, commandBuffer, frameIndex);
 
-		m_renderStats.End(commandBuffer, true);
+		m_renderStats.End(commandBuffer, compiledPass.StatsIndex);
 
 		return true;
 	}
 
-	bool RenderGraph::BlitToSwapchain(Renderer& renderer, const IDevice& device, uint32_t frameIndex,
-		std::vector<SubmitInfo>& renderSubmitInfos, std::vector<SubmitInfo>& computeSubmitInfos) const
+	bool RenderGraph::BlitToSwapchain(Renderer& renderer, const IDevice& device, uint32_t frameIndex)
 	{
 		ICommandBuffer& blitCommandBuffer = *m_blitCommandBuffers[frameIndex];
 		if (!blitCommandBuffer.Begin())
@@ -990,142 +2371,101 @@ namespace Engine::Rendering
 			return false;
 		}
 
-		IRenderImage* finalImage = m_finalNode->OutputImages.at("Output");
-
-		const glm::uvec3& extents = finalImage->GetDimensions();
-		const glm::uvec3 offset(extents.x, extents.y, extents.z);
-
-		ImageBlit blit{};
-		blit.srcSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
-		blit.srcOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), offset };
-		blit.dstSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
-		blit.dstOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), offset };
-
-		std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
+		IMemoryBarriers& memoryBarriers = *m_stageMemoryBarriers;
 
 		IRenderImage& presentImage = renderer.GetPresentImage();
-		finalImage->AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::TransferSrc, *memoryBarriers);
-		presentImage.AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::TransferDst, *memoryBarriers);
-		blitCommandBuffer.MemoryBarrier(*memoryBarriers);
-		memoryBarriers->Clear();
-
-		blitCommandBuffer.BlitImage(*finalImage, presentImage, { blit }, Filter::Linear);
-		presentImage.AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::PresentSrc, *memoryBarriers);
-		blitCommandBuffer.MemoryBarrier(*memoryBarriers);
+		m_finalImage->AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::TransferSrc, memoryBarriers);
+		presentImage.AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::TransferDst, memoryBarriers);
+		blitCommandBuffer.MemoryBarrier(memoryBarriers);
+		memoryBarriers.Clear();
+
+		blitCommandBuffer.BlitImage(*m_finalImage, presentImage, m_blitRegions, Filter::Linear);
+		presentImage.AppendImageLayoutTransition(blitCommandBuffer, ImageLayout::PresentSrc, memoryBarriers);
+		blitCommandBuffer.MemoryBarrier(memoryBarriers);
+		memoryBarriers.Clear();
 		blitCommandBuffer.End();
 
-		SubmitInfo& blitSubmitInfo = renderSubmitInfos.emplace_back();
-		blitSubmitInfo.CommandBuffers.emplace_back(&blitCommandBuffer);
-
-		m_renderStats.FinaliseResults(renderer.GetPhysicalDevice(), device, m_renderResources);
+		m_renderStats.FinaliseResults(renderer.GetPhysicalDevice(), device);
 
-		return renderer.Present(renderSubmitInfos, computeSubmitInfos);
+		return renderer.Present(m_renderSubmitInfos[frameIndex], m_computeSubmitInfos[frameIndex]);
 	}
 
-	void RenderGraph::ReleaseResourceQueueFamilyOwnership(Renderer& renderer, const ICommandBuffer& renderCommandBuffer,
-		const ICommandBuffer& computeCommandBuffer, const std::vector<std::pair<std::string, bool>>& resourcesToTransfer,
-		bool& renderToCompute, bool& computeToRender)
+	void RenderGraph::ReleaseResourceQueueFamilyOwnership(const ICommandBuffer& renderCommandBuffer,
+		const ICommandBuffer& computeCommandBuffer, const std::vector<OwnershipRelease>& resourcesToTransfer)
 	{
-		renderToCompute = false;
-		computeToRender = false;
-
 		if (resourcesToTransfer.empty())
 			return;
 
-		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
-		std::unique_ptr<IMemoryBarriers> renderToComputeMemoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
-		std::unique_ptr<IMemoryBarriers> computeToRenderMemoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
-
 		uint32_t renderQueueFamilyIndex = renderCommandBuffer.GetQueueFamilyIndex();
 		uint32_t computeQueueFamilyIndex = computeCommandBuffer.GetQueueFamilyIndex();
 
-		for (const auto& pair : resourcesToTransfer)
+		for (const OwnershipRelease& release : resourcesToTransfer)
 		{
-			const std::string& resourceName = pair.first;
-			bool renderToCompute = pair.second;
+			const ICommandBuffer& commandBuffer = release.RenderToCompute ? renderCommandBuffer : computeCommandBuffer;
+			IMemoryBarriers& memoryBarriers = release.RenderToCompute ? *m_renderToComputeMemoryBarriers : *m_computeToRenderMemoryBarriers;
+			uint32_t srcQueueFamilyIndex = release.RenderToCompute ? renderQueueFamilyIndex : computeQueueFamilyIndex;
+			uint32_t dstQueueFamilyIndex = release.RenderToCompute ? computeQueueFamilyIndex : renderQueueFamilyIndex;
 
-			if (renderToCompute)
+			if (release.IsBuffer)
 			{
-				auto bufferIterator = m_bufferInfoBarrierState.find(resourceName);
-				if (bufferIterator != m_bufferInfoBarrierState.end())
-				{
-					auto& bufferResource = bufferIterator->second;
-					if (bufferResource.Buffer != nullptr)
-					{
-						bufferResource.Buffer->AppendBufferMemoryBarrier(renderCommandBuffer, bufferResource.StageFlags, bufferResource.MatAccessFlags,
-							MaterialStageFlags::BottomOfPipe, MaterialAccessFlags::None,
-							*renderToComputeMemoryBarriers, renderQueueFamilyIndex, computeQueueFamilyIndex);
-					}
-				}
-				else
+				const auto& bufferResource = m_bufferBarrierStates[release.StateIndex];
+				if (bufferResource.Buffer != nullptr)
 				{
-					auto& imageResource = m_imageInfoBarrierState.at(resourceName);
-					if (imageResource.Image != nullptr)
-					{
-						imageResource.Image->AppendImageLayoutTransition(renderCommandBuffer, ImageLayout::ShaderReadOnly,
-							*renderToComputeMemoryBarriers, renderQueueFamilyIndex, computeQueueFamilyIndex, false);
-					}
+					bufferResource.Buffer->AppendBufferMemoryBarrier(commandBuffer, bufferResource.StageFlags, bufferResource.MatAccessFlags,
+						MaterialStageFlags::BottomOfPipe, MaterialAccessFlags::None,
+						memoryBarriers, srcQueueFamilyIndex, dstQueueFamilyIndex);
 				}
 			}
 			else
 			{
-				const auto& bufferIterator = m_bufferInfoBarrierState.find(resourceName);
-				if (bufferIterator != m_bufferInfoBarrierState.end())
-				{
-					auto& bufferResource = bufferIterator->second;
-					if (bufferResource.Buffer != nullptr)
-					{
-						bufferResource.Buffer->AppendBufferMemoryBarrier(computeCommandBuffer, bufferResource.StageFlags, bufferResource.MatAccessFlags,
-							MaterialStageFlags::BottomOfPipe, MaterialAccessFlags::None,
-							*computeToRenderMemoryBarriers, computeQueueFamilyIndex, renderQueueFamilyIndex);
-					}
-				}
-				else
+				const auto& imageResource = m_imageBarrierStates[release.StateIndex];
+				if (imageResource.Image != nullptr)
 				{
-					const auto& imageResource = m_imageInfoBarrierState.at(resourceName);
-					if (imageResource.Image != nullptr)
-						imageResource.Image->AppendImageLayoutTransition(computeCommandBuffer, ImageLayout::ShaderReadOnly,
-							*computeToRenderMemoryBarriers, computeQueueFamilyIndex, renderQueueFamilyIndex, true);
+					imageResource.Image->AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly,
+						memoryBarriers, srcQueueFamilyIndex, dstQueueFamilyIndex, !release.RenderToCompute);
 				}
 			}
 		}
 
-		if (!renderToComputeMemoryBarriers->Empty())
+		if (!m_renderToComputeMemoryBarriers->Empty())
 		{
-			renderCommandBuffer.MemoryBarrier(*renderToComputeMemoryBarriers);
-			renderToCompute = true;
+			renderCommandBuffer.MemoryBarrier(*m_renderToComputeMemoryBarriers);
+			m_renderToComputeMemoryBarriers->Clear();
 		}
 
-		if (!computeToRenderMemoryBarriers->Empty())
+		if (!m_computeToRenderMemoryBarriers->Empty())
 		{
-			computeCommandBuffer.MemoryBarrier(*computeToRenderMemoryBarriers);
-			computeToRender = true;
+			computeCommandBuffer.MemoryBarrier(*m_computeToRenderMemoryBarriers);
+			m_computeToRenderMemoryBarriers->Clear();
 		}
 	}
 
 	bool RenderGraph::Draw(Renderer& renderer, uint32_t frameIndex)
 	{
 		const IDevice& device = renderer.GetDevice();
-		const glm::uvec2& size = renderer.GetSwapChain().GetExtent();
-		std::vector<SubmitInfo> renderSubmitInfos;
-		std::vector<SubmitInfo> computeSubmitInfos;
+		const glm::uvec2& size = m_renderExtent;
+		std::vector<SubmitInfo>& renderSubmitInfos = m_renderSubmitInfos[frameIndex];
+		std::vector<SubmitInfo>& computeSubmitInfos = m_computeSubmitInfos[frameIndex];
 
 		m_renderCommandPools[frameIndex]->Reset(device);
 		if (m_asyncCompute)
 			m_computeCommandPools[frameIndex]->Reset(device);
 
 		// Reset family queue index for resource state tracking at start of frame to indicate their first usage do not require a queue family ownership transfer.
-		for (auto& bufferState : m_bufferInfoBarrierState)
-			bufferState.second.QueueFamilyIndex = ~0U;
-		for (auto& imageState : m_imageInfoBarrierState)
-			imageState.second.QueueFamilyIndex = ~0U;
+		for (auto& bufferState : m_bufferBarrierStates)
+			bufferState.QueueFamilyIndex = ~0U;
+		for (auto& imageState : m_imageBarrierStates)
+			imageState.QueueFamilyIndex = ~0U;
 
-		uint32_t stageIndex = 0;
+		// Each queue signals the same number of times a frame, so the values of this frame's signals follow from the last frame's.
+		uint64_t renderSignalBase = m_asyncCompute ? m_renderToComputeSemaphore->Value : 0;
+		uint64_t computeSignalBase = m_asyncCompute ? m_computeToRenderSemaphore->Value : 0;
 
-		bool lastStageUsedRenderToComputeSemaphore = false;
-		bool lastStageUsedComputeToRenderSemaphore = false;
-		for (const auto& stage : m_renderGraph)
+		uint32_t stageCount = static_cast<uint32_t>(m_executionPlan.size());
+		for (uint32_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
 		{
+			const CompiledStage& stage = m_executionPlan[stageIndex];
+
 			const ICommandBuffer& renderCommandBuffer = *m_renderCommandBuffers[stageIndex][frameIndex];
 			if (!renderCommandBuffer.Begin())
 			{
@@ -1142,93 +2482,98 @@ namespace Engine::Rendering
 				}
 			}
 
-			SubmitInfo renderSubmitInfo{};
-			SubmitInfo computeSubmitInfo{};
-
 			// Perform resource transitions in bulk, per stage.
 
-			bool stageHasRenderPasses = false;
-			TransitionResourcesForStage(renderer, renderCommandBuffer, false, stage);
-			for (const auto& node : stage)
+			TransitionResourcesForStage(renderer, renderCommandBuffer, false, stage.RenderBarriers);
+
+			// Each pass draws into its own command buffer, recorded below. What comes before and after it is recorded
+			// here in submission order, into the buffer that precedes the draw and the one that follows it.
+			const ICommandBuffer* currentCommandBuffer = &renderCommandBuffer;
+			for (const CompiledPass& pass : stage.RenderPasses)
 			{
-				if (node.Type == RenderNodeType::Pass)
+				const RenderGraphNode& node = *pass.Node;
+				IRenderPass* renderPass = static_cast<IRenderPass*>(node.Node);
+
+				glm::uvec2 passSize = size;
+				renderPass->GetCustomSize(passSize);
+
+				bool bypassed = renderPass->GetBypassed();
+				if (bypassed)
+					CopyBypassedImages(*currentCommandBuffer, pass);
+				else
+					renderPass->PreDraw(renderer, *currentCommandBuffer, passSize, frameIndex, node.InputImages, node.OutputImages);
+				currentCommandBuffer->End();
+
+				currentCommandBuffer = pass.Recording->FollowingCommandBuffers[frameIndex].get();
+				if (!currentCommandBuffer->Begin())
 				{
-					if (!DrawRenderPass(renderer, node, renderCommandBuffer, frameIndex, size))
-						return false;
-					stageHasRenderPasses = true;
+					return false;
 				}
+
+				if (!bypassed)
+					renderPass->PostDraw(renderer, *currentCommandBuffer, passSize, frameIndex, node.InputImages, node.OutputImages);
 			}
 
-			bool stageHasComputePasses = false;
+			if (!m_asyncCompute)
+				computeCommandBuffer = currentCommandBuffer;
+
 			if (m_asyncCompute)
-				TransitionResourcesForStage(renderer, *computeCommandBuffer, true, stage);
-			for (const auto& node : stage)
+				TransitionResourcesForStage(renderer, *computeCommandBuffer, true, stage.ComputeBarriers);
+			for (const CompiledPass& pass : stage.ComputePasses)
 			{
-				if (node.Type == RenderNodeType::Compute)
-				{
-					if (!DispatchComputePass(renderer, node, *computeCommandBuffer, frameIndex))
-						return false;
-					stageHasComputePasses = true;
-				}
+				if (!DispatchComputePass(renderer, pass, *computeCommandBuffer, frameIndex))
+					return false;
 			}
 
-			bool renderToComputeSemaphore = false;
-			bool computeToRenderSemaphore = false;
 			if (m_asyncCompute)
-			{
-				ReleaseResourceQueueFamilyOwnership(renderer, renderCommandBuffer, *computeCommandBuffer,
-					m_perStageOwnershipReleaseResources[stageIndex], renderToComputeSemaphore, computeToRenderSemaphore);
-			}
+				ReleaseResourceQueueFamilyOwnership(*currentCommandBuffer, *computeCommandBuffer, m_perStageOwnershipReleaseResources[stageIndex]);
 
-			renderCommandBuffer.End();
+			currentCommandBuffer->End();
 			if (m_asyncCompute)
 				computeCommandBuffer->End();
 
-			if (lastStageUsedComputeToRenderSemaphore && stageHasRenderPasses)
-			{
-				renderSubmitInfo.WaitSemaphores.emplace_back(m_computeToRenderSemaphore.get());
-				renderSubmitInfo.WaitValues.emplace_back(m_computeToRenderSemaphore->Value);
-				renderSubmitInfo.Stages.emplace_back(MaterialStageFlags::TopOfPipe);
-				lastStageUsedComputeToRenderSemaphore = false;
-			}
+			// Submissions were laid out when the plan was compiled, only the semaphore values advance each frame.
+			if (stage.RenderWaitSignal != ~0U)
+				renderSubmitInfos[stage.RenderSubmitIndex].WaitValues[0] = GetSignalValue(computeSignalBase, m_computeSignalCount,
+					stage.RenderWaitSignal, stage.RenderWaitsOnPreviousFrame);
 
-			if (lastStageUsedRenderToComputeSemaphore && m_asyncCompute && stageHasComputePasses)
-			{
-				computeSubmitInfo.WaitSemaphores.emplace_back(m_renderToComputeSemaphore.get());
-				computeSubmitInfo.WaitValues.emplace_back(m_renderToComputeSemaphore->Value);
-				computeSubmitInfo.Stages.emplace_back(MaterialStageFlags::TopOfPipe);
-				lastStageUsedRenderToComputeSemaphore = false;
-			}
+			if (stage.ComputeWaitSignal != ~0U)
+				computeSubmitInfos[stage.ComputeSubmitIndex].WaitValues[0] = GetSignalValue(renderSignalBase, m_renderSignalCount,
+					stage.ComputeWaitSignal, stage.ComputeWaitsOnPreviousFrame);
 
-			if (stageHasRenderPasses || (!m_asyncCompute && stageHasComputePasses))
-			{
-				renderSubmitInfo.CommandBuffers.emplace_back(&renderCommandBuffer);
-				if (renderToComputeSemaphore)
-				{
-					++m_renderToComputeSemaphore->Value;
-					renderSubmitInfo.SignalSemaphores.emplace_back(m_renderToComputeSemaphore.get());
-					renderSubmitInfo.SignalValues.emplace_back(m_renderToComputeSemaphore->Value);
-					lastStageUsedRenderToComputeSemaphore = true;
-				}
-				renderSubmitInfos.emplace_back(std::move(renderSubmitInfo));
-			}
+			if (stage.RenderSignal != ~0U)
+				renderSubmitInfos[stage.RenderSubmitIndex].SignalValues[0] = GetSignalValue(renderSignalBase, m_renderSignalCount, stage.RenderSignal, false);
 
-			if (m_asyncCompute && stageHasComputePasses)
+			if (stage.ComputeSignal != ~0U)
+				computeSubmitInfos[stage.ComputeSubmitIndex].SignalValues[0] = GetSignalValue(computeSignalBase, m_computeSignalCount, stage.ComputeSignal, false);
+		}
+
+		if (m_asyncCompute)
+		{
+			m_renderToComputeSemaphore->Value += m_renderSignalCount;
+			m_computeToRenderSemaphore->Value += m_computeSignalCount;
+			m_previousFrameSignalled = true;
+		}
+
+		// Draws only touch their own pass and command buffer, so they can be recorded in any order on any thread.
+		std::atomic_bool recorded = true;
+		auto recordPass = [this, &renderer, &recorded, frameIndex, &size](const CompiledPass* pass)
 			{
-				computeSubmitInfo.CommandBuffers.emplace_back(computeCommandBuffer);
-				if (computeToRenderSemaphore)
-				{
-					++m_computeToRenderSemaphore->Value;
-					computeSubmitInfo.SignalSemaphores.emplace_back(m_computeToRenderSemaphore.get());
-					computeSubmitInfo.SignalValues.emplace_back(m_computeToRenderSemaphore->Value);
-					lastStageUsedComputeToRenderSemaphore = true;
-				}
-				computeSubmitInfos.emplace_back(std::move(computeSubmitInfo));
-			}
+				if (!RecordRenderPass(renderer, *pass, frameIndex, size))
+					recorded = false;
+			};
 
-			++stageIndex;
+		if (m_parallelRecording)
+			std::for_each(std::execution::par, m_recordedRenderPasses.cbegin(), m_recordedRenderPasses.cend(), recordPass);
+		else
+			std::for_each(std::execution::seq, m_recordedRenderPasses.cbegin(), m_recordedRenderPasses.cend(), recordPass);
+
+		if (!recorded)
+		{
+			Logger::Error("Failed to record render passes.");
+			return false;
 		}
 
-		return BlitToSwapchain(renderer, device, frameIndex, renderSubmitInfos, computeSubmitInfos);
+		return BlitToSwapchain(renderer, device, frameIndex);
 	}
 }
\ No newline at end of file
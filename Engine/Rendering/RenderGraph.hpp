@@ -2,13 +2,18 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
 #include <glm/glm.hpp>
 
 #include "RenderPasses/IRenderPass.hpp"
 #include "ComputePasses/IComputePass.hpp"
 #include "RenderResources/IRenderResource.hpp"
 #include "RenderResources/RenderPassResourceInfo.hpp"
+#include "RenderGraphLayout.hpp"
 #include "Resources/SubmitInfo.hpp"
+#include "Resources/ICommandBuffer.hpp"
+#include "Resources/IMemoryHeap.hpp"
 
 namespace Engine::Rendering
 {
@@ -19,6 +24,7 @@ namespace Engine::Rendering
 	class ISemaphore;
 	class RenderStats;
 	class IRenderImage;
+	class IMemoryBarriers;
 
 	struct RenderGraphNode
 	{
@@ -44,6 +50,44 @@ namespace Engine::Rendering
 		}
 	};
 
+	// How much of the graph a change invalidates, a build handles the largest change marked since the last one.
+	enum class RenderGraphChange
+	{
+		None,
+		Passes, // Passes were enabled or disabled. Nodes whose connections are unchanged keep their resources and bindings.
+		RenderExtent, // The render scale changed. As above, images sized by the render extent are recreated and the nodes bound to them rebuilt.
+		Resources, // Resources passes use outside the graph, such as geometry, were replaced. Every node is rebuilt, graph images are kept.
+		All // Extents, formats or queues changed. Everything is recreated.
+	};
+
+	// What a frame of the built graph synchronises, to track how scheduling changes affect it. Barrier counts are
+	// those the graph places for its resources, passes may add their own.
+	struct RenderGraphScheduleStats
+	{
+		uint32_t StageCount;
+		uint32_t SubmitCount;
+		uint32_t PipelineBarrierCount;
+		uint32_t ImageBarrierCount;
+		uint32_t BufferBarrierCount;
+		uint32_t MergedBarrierCount; // Barriers saved by sharing a transition between nodes in the same stage.
+		uint32_t OwnershipTransferCount;
+		uint32_t SemaphoreWaitCount;
+		uint32_t SemaphoreSignalCount;
+		uint32_t CrossFrameWaitCount; // Waits on work the other queue submitted for the previous frame.
+		uint32_t OverlappedRenderStageCount; // Render stages each async compute stage may run alongside, summed.
+		uint32_t CrossFrameOverlappedRenderStageCount; // As above, for render stages of the previous frame.
+	};
+
+	struct TransientMemoryStats
+	{
+		uint32_t ImageCount;
+		uint32_t RetainedImageCount; // Images kept in place from the previous build.
+		uint32_t HeapCount;
+		uint64_t UnaliasedSize; // Total if every image had its own allocation.
+		uint64_t AliasedSize; // Total of the heaps the images are placed in.
+		uint64_t PeakSize; // Largest total of the images in use during a single stage.
+	};
+
 	class RenderGraph
 	{
 	public:
@@ -60,9 +104,32 @@ namespace Engine::Rendering
 		void SetPassEnabled(const std::string& passName, bool enabled);
 		bool GetPassEnabled(const std::string& passName) const;
 
+		// Unlike enabling a pass this leaves the built graph alone, the pass is skipped when the frame is recorded. Only
+		// enabled passes are in the built graph, so a disabled pass cannot be bypassed.
+		void SetPassBypassed(const std::string& passName, bool bypassed);
+		bool GetPassBypassed(const std::string& passName) const;
+
 		inline const std::vector<std::vector<RenderGraphNode>>& GetBuiltGraph() const { return m_renderGraph; }
-		inline void MarkDirty() { m_dirty = true; }
+		inline const TransientMemoryStats& GetTransientMemoryStats() const { return m_transientMemoryStats; }
+		inline const RenderGraphScheduleStats& GetScheduleStats() const { return m_scheduleStats; }
+		inline const std::string& GetSerialisedLayout() const { return m_serialisedLayout; }
+		// Whether the last build restored its schedule from a configuration built before.
+		inline bool GetLayoutCacheHit() const { return m_layoutCacheHit; }
+		inline uint32_t GetBuildCount() const { return m_buildCount; }
+		// Nodes the last build rebuilt, out of all the nodes in the built graph.
+		inline uint32_t GetNodeBuildCount() const { return m_nodeBuildCount; }
+		inline uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodeBindings.size()); }
+		bool DumpLayout(const std::string& filePath) const;
+		inline void MarkDirty(RenderGraphChange change = RenderGraphChange::All)
+		{
+			m_dirty = true;
+			m_pendingChange = std::max(m_pendingChange, change);
+		}
+
 		inline bool CheckDirty() const { return m_dirty; }
+		inline const glm::uvec2& GetRenderExtent() const { return m_renderExtent; }
+		inline void SetParallelRecording(bool enable) { m_parallelRecording = enable; }
+		inline bool GetParallelRecording() const { return m_parallelRecording; }
 
 		inline bool TryGetRenderPass(const std::string& name, const IRenderPass** result) const
 		{
@@ -103,41 +170,219 @@ namespace Engine::Rendering
 			}
 		};
 
-		inline bool TryGetOrAddImage(std::string_view name, const Renderer& renderer, std::unordered_map<Format, std::vector<ImageInfo>>& formatRenderTextureLookup,
-			std::vector<std::unique_ptr<IRenderImage>>& renderTextures, std::unordered_map<IRenderImage*, uint32_t>& imageInfoLookup,
-			Format format, AccessFlags accessFlags, const glm::uvec3& dimensions, IRenderImage** result) const;
+		// Graph images only live between the first and last stage that use them, memory is shared between images whose
+		// lifetimes do not overlap.
+		struct TransientImage
+		{
+			std::string Name;
+			IRenderImage* Image;
+			ImageAspectFlags AspectFlags;
+			MemoryRequirements Requirements;
+			uint32_t FirstStage;
+			uint32_t LastStage;
+			uint32_t HeapIndex;
+			uint64_t Offset;
+			bool Aliased;
+			bool Retained;
+
+			TransientImage(std::string_view name, IRenderImage* image, ImageAspectFlags aspectFlags)
+				: Name(name)
+				, Image(image)
+				, AspectFlags(aspectFlags)
+				, Requirements()
+				, FirstStage(~0U)
+				, LastStage(0)
+				, HeapIndex(0)
+				, Offset(0)
+				, Aliased(false)
+				, Retained(false)
+			{
+			}
+		};
+
+		// Queue family ownership of a resource moves between queues after the last stage it is used in on its current queue.
+		struct OwnershipRelease
+		{
+			uint32_t StateIndex;
+			bool IsBuffer;
+			bool RenderToCompute;
+		};
+
+		// The execution plan is compiled from the built graph so Draw neither looks resources up by name nor allocates.
+		// Resource infos point into the node's own info maps, which are stable until the next build, and barrier state is
+		// addressed by index. Nodes in a stage using the same resource in the same way share one transition, with the
+		// stages and accesses of all of them.
+		struct CompiledImageTransition
+		{
+			const RenderPassImageInfo* Info;
+			uint32_t StateIndex;
+			bool IsOutput;
+			bool AliasedFirstUse;
+			MaterialStageFlags StageFlags;
+			MaterialAccessFlags MatAccessFlags;
+		};
+
+		struct CompiledBufferTransition
+		{
+			const RenderPassBufferInfo* Info;
+			uint32_t StateIndex;
+			AccessFlags Access;
+			MaterialStageFlags StageFlags;
+			MaterialAccessFlags MatAccessFlags;
+		};
+
+		struct CompiledBarrierBatch
+		{
+			std::vector<CompiledImageTransition> ImageTransitions;
+			std::vector<CompiledBufferTransition> BufferTransitions;
+		};
+
+		// Render passes draw into their own command buffers so they can be recorded in parallel. Each has a command pool
+		// per frame, as pools cannot be used from several threads at once. Work recorded before and after the draw, such
+		// as barriers and image layout changes made in PreDraw and PostDraw, stays on the calling thread in the order
+		// it is submitted, since later barriers depend on the layouts it leaves images in.
+		struct PassRecording
+		{
+			std::vector<std::unique_ptr<ICommandPool>> CommandPools;
+			std::vector<std::unique_ptr<ICommandBuffer>> DrawCommandBuffers;
+			std::vector<std::unique_ptr<ICommandBuffer>> FollowingCommandBuffers;
+		};
+
+		// A bypassed render pass copies the images it reads and writes under the same name through unchanged, so the
+		// passes after it see what they would have if it were not in the graph.
+		struct BypassCopy
+		{
+			const RenderPassImageInfo* Input;
+			const RenderPassImageInfo* Output;
+			std::vector<ImageBlit> Regions;
+		};
+
+		struct CompiledPass
+		{
+			const RenderGraphNode* Node;
+			uint32_t StatsIndex;
+			PassRecording* Recording;
+			std::vector<BypassCopy> BypassCopies;
+		};
+
+		struct CompiledStage
+		{
+			CompiledBarrierBatch RenderBarriers;
+			CompiledBarrierBatch ComputeBarriers;
+			std::vector<CompiledPass> RenderPasses;
+			std::vector<CompiledPass> ComputePasses;
+			uint32_t RenderSubmitIndex;
+			uint32_t ComputeSubmitIndex;
+			uint32_t RenderSignal; // Which of the render queue's signals in a frame the stage makes, ~0U if none.
+			uint32_t ComputeSignal;
+			uint32_t RenderWaitSignal; // Which of the compute queue's signals the render submission waits for, ~0U if none.
+			uint32_t ComputeWaitSignal;
+			bool RenderWaitsOnPreviousFrame; // The wait is for the signal the other queue made in the previous frame.
+			bool ComputeWaitsOnPreviousFrame;
+
+			CompiledStage()
+				: RenderBarriers()
+				, ComputeBarriers()
+				, RenderPasses()
+				, ComputePasses()
+				, RenderSubmitIndex(~0U)
+				, ComputeSubmitIndex(~0U)
+				, RenderSignal(~0U)
+				, ComputeSignal(~0U)
+				, RenderWaitSignal(~0U)
+				, ComputeWaitSignal(~0U)
+				, RenderWaitsOnPreviousFrame(false)
+				, ComputeWaitsOnPreviousFrame(false)
+			{
+			}
+		};
+
+		// Resources a node was built against, a node only has to be built again when these change.
+		struct NodeBindings
+		{
+			std::unordered_map<std::string, IRenderImage*> InputImages;
+			std::unordered_map<std::string, IRenderImage*> OutputImages;
+			std::unordered_map<std::string, IBuffer*> InputBuffers;
+			std::unordered_map<std::string, IBuffer*> OutputBuffers;
+		};
+
+		bool InitialiseTransientImage(std::string_view name, const Renderer& renderer, Format format, const glm::uvec3& dimensions,
+			IRenderImage& image, ImageAspectFlags& aspectFlags) const;
+
+		bool ReplaceTransientImage(const Renderer& renderer, TransientImage& transientImage);
+
+		bool NodeRequiresBuild(const RenderGraphNode& node) const;
+
+		inline bool AddTransientImage(std::string_view name, const Renderer& renderer, std::unordered_map<Format, std::vector<ImageInfo>>& formatRenderTextureLookup,
+			std::unordered_map<IRenderImage*, uint32_t>& imageInfoLookup, Format format, AccessFlags accessFlags, const glm::uvec3& dimensions,
+			IRenderImage** result);
+
+		bool DetermineRequiredResources(const std::vector<IRenderNode*>& renderNodeStack);
 
-		bool DetermineRequiredResources(std::vector<IRenderNode*>& renderNodeStack,
-			std::unordered_map<std::string, RenderGraphNode*>& availableImageSources,
-			std::unordered_map<std::string, RenderGraphNode*>& availableBufferSources);
+		bool RestoreSchedule(const RenderGraphLayout& layout);
+
+		RenderGraphLayout CreateLayout(uint64_t keyHash) const;
 
 		bool ReserveRenderTexturesForPasses(const Renderer& renderer, const glm::uvec3& defaultExtents,
 			std::unordered_map<Format, std::vector<ImageInfo>>& formatRenderTextureLookup,
 			std::unordered_map<IRenderImage*, uint32_t>& imageInfoLookup);
 
+		bool AllocateTransientImages(const Renderer& renderer);
+
 		bool BuildPasses(const Renderer& renderer, const IDevice& device);
 
 		bool FindFinalNode();
 
+		bool IsAliasedImageFirstUse(const IRenderImage* image, uint32_t stageIndex) const;
+
+		bool CompileExecutionPlan(const Renderer& renderer);
+
+		void CompileQueueSynchronisation();
+
+		// Timeline value of one of a queue's signals this frame, or the previous one. Until a frame has been drawn with
+		// the current plan the previous frame's signals are unknown, so waits on them cover everything submitted before.
+		inline uint64_t GetSignalValue(uint64_t frameBase, uint32_t signalCount, uint32_t signal, bool previousFrame) const
+		{
+			if (!previousFrame)
+				return frameBase + signal + 1;
+
+			return m_previousFrameSignalled ? frameBase - signalCount + signal + 1 : frameBase;
+		}
+
+		uint32_t CompileBarrierBatch(const std::vector<RenderGraphNode>& nodes, bool isCompute, uint32_t stageIndex,
+			CompiledBarrierBatch& batch) const;
+
 		void TransitionResourcesForStage(const Renderer& renderer, const ICommandBuffer& commandBuffer, bool isCompute,
-			const std::vector<RenderGraphNode>& nodes);
+			const CompiledBarrierBatch& batch);
+
+		void ReleaseResourceQueueFamilyOwnership(const ICommandBuffer& renderCommandBuffer,
+			const ICommandBuffer& computeCommandBuffer, const std::vector<OwnershipRelease>& resourcesToTransfer);
 
-		void ReleaseResourceQueueFamilyOwnership(Renderer& renderer, const ICommandBuffer& renderCommandBuffer,
-			const ICommandBuffer& computeCommandBuffer, const std::vector<std::pair<std::string, bool>>& resourcesToTransfer,
-			bool& renderToCompute, bool& computeToRender);
+		bool CreatePassRecording(const Renderer& renderer, const IDevice& device, const IRenderNode& node, PassRecording& recording) const;
 
-		bool DrawRenderPass(const Renderer& renderer, const RenderGraphNode& node,
+		bool DrawRenderPass(const Renderer& renderer, const CompiledPass& compiledPass,
 			const ICommandBuffer& commandBuffer, uint32_t frameIndex, const glm::uvec2& size) const;
 
-		bool DispatchComputePass(Renderer& renderer, const RenderGraphNode& node, const ICommandBuffer& commandBuffer,
+		bool RecordRenderPass(const Renderer& renderer, const CompiledPass& compiledPass, uint32_t frameIndex, const glm::uvec2& size) const;
+
+		void CompileBypassCopies(const Renderer& renderer, CompiledPass& compiledPass) const;
+
+		void CopyBypassedImages(const ICommandBuffer& commandBuffer, const CompiledPass& compiledPass);
+
+		bool DispatchComputePass(Renderer& renderer, const CompiledPass& compiledPass, const ICommandBuffer& commandBuffer,
 			uint32_t frameIndex) const;
 
-		bool BlitToSwapchain(Renderer& renderer, const IDevice& device, uint32_t frameIndex,
-			std::vector<SubmitInfo>& renderSubmitInfos, std::vector<SubmitInfo>& computeSubmitInfos) const;
+		bool BlitToSwapchain(Renderer& renderer, const IDevice& device, uint32_t frameIndex);
 
 		bool m_dirty;
+		RenderGraphChange m_pendingChange;
+		RenderGraphChange m_buildChange;
+		uint32_t m_nodeBuildCount;
+		uint32_t m_buildCount;
 		bool m_asyncCompute;
+		bool m_parallelRecording;
 		const RenderGraphNode* m_finalNode;
+		glm::uvec2 m_renderExtent; // Extent of graph images not given one of their own, the swapchain's scaled by the render scale.
 		RenderStats& m_renderStats;
 
 		std::unordered_map<std::string, IRenderNode*> m_renderNodeLookup;
@@ -151,14 +396,51 @@ namespace Engine::Rendering
 		std::vector<std::vector<std::unique_ptr<ICommandBuffer>>> m_computeCommandBuffers;
 		std::vector<std::unique_ptr<ICommandPool>> m_renderCommandPools;
 		std::vector<std::unique_ptr<ICommandPool>> m_computeCommandPools;
+		std::unordered_map<const IRenderNode*, PassRecording> m_passRecordings;
 		std::unique_ptr<ISemaphore> m_renderToComputeSemaphore;
 		std::unique_ptr<ISemaphore> m_computeToRenderSemaphore;
-		std::unordered_map<std::string, RenderPassBufferInfo> m_bufferInfoBarrierState;
-		std::unordered_map<std::string, RenderPassImageInfo> m_imageInfoBarrierState;
-		std::vector<std::vector<std::pair<std::string, bool>>> m_perStageOwnershipReleaseResources;
+		uint32_t m_renderSignalCount;
+		uint32_t m_computeSignalCount;
+		bool m_previousFrameSignalled;
+		std::unordered_map<std::string, uint32_t> m_bufferBarrierStateLookup;
+		std::unordered_map<std::string, uint32_t> m_imageBarrierStateLookup;
+		std::vector<RenderPassBufferInfo> m_bufferBarrierStates;
+		std::vector<RenderPassImageInfo> m_imageBarrierStates;
+		std::vector<std::vector<OwnershipRelease>> m_perStageOwnershipReleaseResources;
+
+		std::vector<CompiledStage> m_executionPlan;
+		RenderGraphScheduleStats m_scheduleStats;
+
+		// Layouts of configurations built before, keyed by everything their schedule depends on. Only the schedule is
+		// restored from them, graph images, their memory placement and the barriers are compiled again on a hit.
+		std::unordered_map<std::string, RenderGraphLayout> m_layoutCache;
+		std::string m_serialisedLayout;
+		bool m_layoutCacheHit;
+
+		std::vector<const CompiledPass*> m_recordedRenderPasses;
+		std::vector<std::vector<SubmitInfo>> m_renderSubmitInfos;
+		std::vector<std::vector<SubmitInfo>> m_computeSubmitInfos;
+		std::unique_ptr<IMemoryBarriers> m_stageMemoryBarriers;
+		std::unique_ptr<IMemoryBarriers> m_renderToComputeMemoryBarriers;
+		std::unique_ptr<IMemoryBarriers> m_computeToRenderMemoryBarriers;
+		std::vector<ImageBlit> m_blitRegions;
+		IRenderImage* m_finalImage;
 
 		std::unordered_map<std::string, const IRenderNode*> m_imageResourceNodeLookup;
 		std::unordered_map<std::string, const IRenderNode*> m_bufferResourceNodeLookup;
+		std::vector<TransientImage> m_transientImages;
+		std::unordered_map<const IRenderImage*, uint32_t> m_transientImageLookup;
+		TransientMemoryStats m_transientMemoryStats;
+		std::vector<MemoryRequirements> m_memoryHeapRequirements;
+		std::vector<std::unique_ptr<IMemoryHeap>> m_memoryHeaps;
 		std::vector<std::unique_ptr<IRenderImage>> m_renderTextures;
+
+		// Previous build's state is kept while building so unaffected nodes and images can carry over.
+		std::unordered_map<const IRenderNode*, NodeBindings> m_nodeBindings;
+		std::unordered_set<const void*> m_freshResources;
+		std::vector<TransientImage> m_previousTransientImages;
+		std::vector<MemoryRequirements> m_previousMemoryHeapRequirements;
+		std::vector<std::unique_ptr<IMemoryHeap>> m_previousMemoryHeaps;
+		std::vector<std::unique_ptr<IRenderImage>> m_previousRenderTextures;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "RenderGraphLayout.hpp"
+#include "RenderResources/IRenderNode.hpp"
+#include <algorithm>
+#include <format>
+#include <unordered_map>
+
+namespace Engine::Rendering
+{
+	static const char* GetNodeTypeName(RenderNodeType type)
+	{
+		switch (type)
+		{
+		case RenderNodeType::Pass:
+			return "pass";
+		case RenderNodeType::Compute:
+			return "compute";
+		default:
+			return "resource";
+		}
+	}
+
+	// Resource maps are unordered, facts about them are written in name order so equal graphs give equal text.
+	template <typename T>
+	static std::vector<const std::pair<const std::string, T>*> SortedByName(const std::unordered_map<std::string, T>& infos)
+	{
+		std::vector<const std::pair<const std::string, T>*> sorted;
+		sorted.reserve(infos.size());
+		for (const auto& pair : infos)
+			sorted.push_back(&pair);
+
+		std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+		return sorted;
+	}
+
+	static std::vector<std::string_view> SplitLines(std::string_view text)
+	{
+		std::vector<std::string_view> lines;
+		while (!text.empty())
+		{
+			size_t end = text.find('\n');
+			std::string_view line = text.substr(0, end);
+			if (!line.empty())
+				lines.push_back(line);
+
+			if (end == std::string_view::npos)
+				break;
+
+			text.remove_prefix(end + 1);
+		}
+
+		return lines;
+	}
+
+	RenderGraphLayout::RenderGraphLayout()
+		: KeyHash(0)
+		, Stages()
+		, Images()
+	{
+	}
+
+	std::string RenderGraphLayout::CreateKey(const std::vector<IRenderNode*>& renderNodeStack, const glm::uvec3& defaultExtents, bool asyncCompute)
+	{
+		std::string key = std::format("{}x{}x{} {}\n", defaultExtents.x, defaultExtents.y, defaultExtents.z, asyncCompute ? 1 : 0);
+		for (const IRenderNode* node : renderNodeStack)
+		{
+			key += std::format("{} {}\n", node->GetName(), static_cast<uint32_t>(node->GetNodeType()));
+
+			for (const auto* infos : { &node->GetImageInputInfos(), &node->GetImageOutputInfos() })
+			{
+				key += infos == &node->GetImageInputInfos() ? "<" : ">";
+				for (const auto* pair : SortedByName(*infos))
+				{
+					const RenderPassImageInfo& info = pair->second;
+					key += std::format(" {}:{}:{}:{}x{}x{}:{}:{}:{}", pair->first, static_cast<uint32_t>(info.Access), static_cast<uint32_t>(info.Format),
+						info.Dimensions.x, info.Dimensions.y, info.Dimensions.z, static_cast<uint32_t>(info.Layout),
+						static_cast<uint32_t>(info.StageFlags), static_cast<uint64_t>(info.MatAccessFlags));
+				}
+				key += "\n";
+			}
+
+			for (const auto* infos : { &node->GetBufferInputInfos(), &node->GetBufferOutputInfos() })
+			{
+				key += infos == &node->GetBufferInputInfos() ? "<" : ">";
+				for (const auto* pair : SortedByName(*infos))
+				{
+					const RenderPassBufferInfo& info = pair->second;
+					key += std::format(" {}:{}:{}:{}", pair->first, static_cast<uint32_t>(info.Access),
+						static_cast<uint32_t>(info.StageFlags), static_cast<uint64_t>(info.MatAccessFlags));
+				}
+				key += "\n";
+			}
+		}
+
+		return key;
+	}
+
+	std::string RenderGraphLayout::Serialise() const
+	{
+		// Every line names its stage, so a fact that moves shows up as removed and added wherever it is in the file.
+		std::string text = std::format("layout {:016x}\n", KeyHash);
+		for (uint32_t stageIndex = 0; stageIndex < Stages.size(); ++stageIndex)
+		{
+			const RenderGraphLayoutStage& stage = Stages[stageIndex];
+			for (const RenderGraphLayoutNode& node : stage.Nodes)
+			{
+				text += std::format("stage {} {} {}\n", stageIndex, GetNodeTypeName(node.Type), node.Name);
+				for (const auto& source : node.ImageSources)
+					text += std::format("stage {} {} reads image {} from {}\n", stageIndex, node.Name, source.first, source.second);
+				for (const auto& source : node.BufferSources)
+					text += std::format("stage {} {} reads buffer {} from {}\n", stageIndex, node.Name, source.first, source.second);
+			}
+
+			for (const RenderGraphLayoutBarrier& barrier : stage.Barriers)
+			{
+				if (barrier.IsBuffer)
+				{
+					text += std::format("stage {} {} barrier buffer {} stages {:x} access {:x}\n", stageIndex, barrier.IsCompute ? "compute" : "render",
+						barrier.Name, static_cast<uint32_t>(barrier.StageFlags), static_cast<uint64_t>(barrier.MatAccessFlags));
+				}
+				else
+				{
+					text += std::format("stage {} {} barrier image {} layout {} stages {:x} access {:x}\n", stageIndex, barrier.IsCompute ? "compute" : "render",
+						barrier.Name, static_cast<uint32_t>(barrier.Layout), static_cast<uint32_t>(barrier.StageFlags), static_cast<uint64_t>(barrier.MatAccessFlags));
+				}
+			}
+
+			if (stage.RenderWaitSignal != ~0U)
+				text += std::format("stage {} render waits compute signal {}{}\n", stageIndex, stage.RenderWaitSignal, stage.RenderWaitsOnPreviousFrame ? " of previous frame" : "");
+			if (stage.ComputeWaitSignal != ~0U)
+				text += std::format("stage {} compute waits render signal {}{}\n", stageIndex, stage.ComputeWaitSignal, stage.ComputeWaitsOnPreviousFrame ? " of previous frame" : "");
+			if (stage.RenderSignal != ~0U)
+				text += std::format("stage {} render signal {}\n", stageIndex, stage.RenderSignal);
+			if (stage.ComputeSignal != ~0U)
+				text += std::format("stage {} compute signal {}\n", stageIndex, stage.ComputeSignal);
+		}
+
+		for (const RenderGraphLayoutImage& image : Images)
+		{
+			text += std::format("image {} format {} extent {}x{}x{} stages {}-{} heap {} offset {} size {}{}\n", image.Name, static_cast<uint32_t>(image.Format),
+				image.Dimensions.x, image.Dimensions.y, image.Dimensions.z, image.FirstStage, image.LastStage, image.HeapIndex, image.Offset, image.Size,
+				image.Aliased ? " aliased" : "");
+		}
+
+		return text;
+	}
+
+	std::vector<std::string> RenderGraphLayout::Diff(std::string_view from, std::string_view to)
+	{
+		std::vector<std::string_view> fromLines = SplitLines(from);
+		std::vector<std::string_view> toLines = SplitLines(to);
+
+		std::unordered_map<std::string_view, int32_t> lineCounts;
+		for (std::string_view line : fromLines)
+			++lineCounts[line];
+		for (std::string_view line : toLines)
+			--lineCounts[line];
+
+		// Lines are reported in the order they appear, each as many times as it is missing from the other layout.
+		std::vector<std::string> changes;
+		for (std::string_view line : fromLines)
+		{
+			int32_t& count = lineCounts[line];
+			if (count > 0)
+			{
+				changes.emplace_back(std::format("- {}", line));
+				--count;
+			}
+		}
+
+		for (std::string_view line : toLines)
+		{
+			int32_t& count = lineCounts[line];
+			if (count < 0)
+			{
+				changes.emplace_back(std::format("+ {}", line));
+				++count;
+			}
+		}
+
+		return changes;
+	}
+}
\ No newline at end of file
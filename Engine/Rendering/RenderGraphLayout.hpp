@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Core/Macros.hpp"
+#include "Types.hpp"
+#include "RenderResources/RenderPassResourceInfo.hpp"
+#include <glm/glm.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine::Rendering
+{
+	class IRenderNode;
+
+	struct RenderGraphLayoutNode
+	{
+		std::string Name;
+		RenderNodeType Type;
+		std::vector<std::pair<std::string, std::string>> ImageSources; // Resource name and the node it is read from.
+		std::vector<std::pair<std::string, std::string>> BufferSources;
+	};
+
+	struct RenderGraphLayoutBarrier
+	{
+		std::string Name;
+		bool IsCompute;
+		bool IsBuffer;
+		ImageLayout Layout;
+		MaterialStageFlags StageFlags;
+		MaterialAccessFlags MatAccessFlags;
+	};
+
+	struct RenderGraphLayoutStage
+	{
+		std::vector<RenderGraphLayoutNode> Nodes;
+		std::vector<RenderGraphLayoutBarrier> Barriers;
+		uint32_t RenderSignal;
+		uint32_t ComputeSignal;
+		uint32_t RenderWaitSignal;
+		uint32_t ComputeWaitSignal;
+		bool RenderWaitsOnPreviousFrame;
+		bool ComputeWaitsOnPreviousFrame;
+	};
+
+	struct RenderGraphLayoutImage
+	{
+		std::string Name;
+		Engine::Rendering::Format Format;
+		glm::uvec3 Dimensions;
+		uint32_t FirstStage;
+		uint32_t LastStage;
+		uint32_t HeapIndex;
+		uint64_t Offset;
+		uint64_t Size;
+		bool Aliased;
+	};
+
+	// A built render graph without the resources bound to it: the stage each node runs in and where its inputs come
+	// from, the barriers and semaphores of each stage, and when graph images live and where their memory is placed.
+	// Written out one fact per line in a fixed order, so layouts can be compared with any text diff or with Diff.
+	class RenderGraphLayout
+	{
+	public:
+		RenderGraphLayout();
+
+		// Everything scheduling a graph depends on: the enabled nodes in the order they are added, what they read and
+		// write, in which formats and extents, and whether compute runs on its own queue.
+		static std::string CreateKey(const std::vector<IRenderNode*>& renderNodeStack, const glm::uvec3& defaultExtents, bool asyncCompute);
+
+		EXPORT std::string Serialise() const;
+
+		// Lines only in the first layout are prefixed with '-', lines only in the second with '+'.
+		EXPORT static std::vector<std::string> Diff(std::string_view from, std::string_view to);
+
+		uint64_t KeyHash;
+		std::vector<RenderGraphLayoutStage> Stages;
+		std::vector<RenderGraphLayoutImage> Images;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <optional>
 #include "../IMaterialManager.hpp"
 #include "Core/Logger.hpp"
 #include "../Resources/Material.hpp"
@@ -5,7 +5,6 @@
 #include "../../Resources/ICommandBuffer.hpp"
 #include "../../Resources/IMemoryBarriers.hpp"
 #include "../../IResourceFactory.hpp"
-#include "../../ISwapChain.hpp"
 #include "../../Renderer.hpp"
 
 namespace Engine::Rendering
@@ -13,6 +12,8 @@ namespace Engine::Rendering
 	TAAPass::TAAPass()
 		: IRenderPass("TAA", "TAA")
 		, m_taaHistoryImage()
+		, m_memoryBarriers()
+		, m_historyBlitRegions()
 	{
 		m_imageInputInfos =
 		{
@@ -65,14 +66,24 @@ namespace Engine::Rendering
 
 		const IDevice& device = renderer.GetDevice();
 		const IResourceFactory& resourceFactory = renderer.GetResourceFactory();
-		const ISwapChain& swapchain = renderer.GetSwapChain();
 
-		const glm::uvec2& size = swapchain.GetExtent();
+		// History is resolved at the render scale, before the upscale.
+		const glm::uvec2 size(imageInputs.at("Output")->GetDimensions());
 		if (!CreateTAAHistoryImage(device, resourceFactory, size))
 		{
 			return false;
 		}
 
+		m_memoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+
+		const glm::uvec3& extents = m_taaHistoryImage->GetDimensions();
+		m_historyBlitRegions.clear();
+		ImageBlit& blit = m_historyBlitRegions.emplace_back();
+		blit.srcSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+		blit.srcOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), extents };
+		blit.dstSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
+		blit.dstOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), extents };
+
 		m_colourAttachments.emplace_back(m_material->GetColourAttachmentInfo(0, imageOutputs.at("Output")));
 
 		const IImageSampler& linearSampler = renderer.GetLinearSampler();
@@ -96,22 +107,21 @@ namespace Engine::Rendering
 		const glm::uvec2& size, uint32_t frameIndex, const std::unordered_map<std::string, IRenderImage*>& imageInputs,
 		const std::unordered_map<std::string, IRenderImage*>& imageOutputs)
 	{
-		const IDevice& device = renderer.GetDevice();
-
-		std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
+		IMemoryBarriers& memoryBarriers = *m_memoryBarriers;
 
 		if (m_taaHistoryImage->GetLayout() == ImageLayout::Undefined)
 		{
 			m_taaHistoryImage->AppendImageLayoutTransitionExt(commandBuffer,
-				MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, *memoryBarriers);
-			commandBuffer.MemoryBarrier(*memoryBarriers);
-			memoryBarriers->Clear();
+				MaterialStageFlags::Transfer, ImageLayout::TransferDst, MaterialAccessFlags::TransferWrite, memoryBarriers);
+			commandBuffer.MemoryBarrier(memoryBarriers);
+			memoryBarriers.Clear();
 
 			commandBuffer.ClearColourImage(*m_taaHistoryImage, Engine::Colour());
 		}
 
-		m_taaHistoryImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, *memoryBarriers);
-		commandBuffer.MemoryBarrier(*memoryBarriers);
+		m_taaHistoryImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, memoryBarriers);
+		commandBuffer.MemoryBarrier(memoryBarriers);
+		memoryBarriers.Clear();
 	}
 
 	void TAAPass::Draw(const Renderer& renderer, const ICommandBuffer& commandBuffer,
@@ -125,23 +135,14 @@ namespace Engine::Rendering
 		const glm::uvec2& size, uint32_t frameIndex, const std::unordered_map<std::string, IRenderImage*>& imageInputs,
 		const std::unordered_map<std::string, IRenderImage*>& imageOutputs)
 	{
-		const IDevice& device = renderer.GetDevice();
 		IRenderImage* outputImage = imageOutputs.at("Output");
 
-		std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(renderer.GetResourceFactory().CreateMemoryBarriers());
-		m_taaHistoryImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferDst, *memoryBarriers);
-		outputImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferSrc, *memoryBarriers);
-		commandBuffer.MemoryBarrier(*memoryBarriers);
-
-		const glm::uvec3& extents = m_taaHistoryImage->GetDimensions();
-		const glm::uvec3 offset(extents.x, extents.y, extents.z);
-
-		ImageBlit blit;
-		blit.srcSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
-		blit.srcOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), offset };
-		blit.dstSubresource = ImageSubresourceLayers(ImageAspectFlags::Color, 0, 0, 1);
-		blit.dstOffsets = std::array<glm::uvec3, 2>{ glm::uvec3(), offset };
+		IMemoryBarriers& memoryBarriers = *m_memoryBarriers;
+		m_taaHistoryImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferDst, memoryBarriers);
+		outputImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferSrc, memoryBarriers);
+		commandBuffer.MemoryBarrier(memoryBarriers);
+		memoryBarriers.Clear();
 
-		commandBuffer.BlitImage(*outputImage, *m_taaHistoryImage, { blit }, Filter::Linear);
+		commandBuffer.BlitImage(*outputImage, *m_taaHistoryImage, m_historyBlitRegions, Filter::Linear);
 	}
 }
\ No newline at end of file
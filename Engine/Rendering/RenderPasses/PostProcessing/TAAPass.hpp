@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../IRenderPass.hpp"
+#include "../../Resources/ICommandBuffer.hpp"
+#include "../../Resources/IMemoryBarriers.hpp"
 #include <array>
 #include <glm/glm.hpp>
 #include <memory>
@@ -43,5 +45,9 @@ namespace Engine::Rendering
 		bool CreateTAAHistoryImage(const IDevice& device, const IResourceFactory& resourceFactory, const glm::uvec2& size);
 
 		std::unique_ptr<IRenderImage> m_taaHistoryImage;
+
+		// Kept between frames so recording the history copy does not allocate.
+		std::unique_ptr<IMemoryBarriers> m_memoryBarriers;
+		std::vector<ImageBlit> m_historyBlitRegions;
 	};
 }
\ No newline at end of file
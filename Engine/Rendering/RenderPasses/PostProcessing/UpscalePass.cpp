@@ -0,0 +1,66 @@
+#include "UpscalePass.hpp"
+#include "../../Resources/IBuffer.hpp"
+#include "../../Resources/IRenderImage.hpp"
+#include "../../Resources/ICommandBuffer.hpp"
+#include "../../ISwapChain.hpp"
+#include "../../Renderer.hpp"
+
+namespace Engine::Rendering
+{
+	UpscalePass::UpscalePass()
+		: IRenderPass("Upscale", "Upscale")
+		, m_displayExtent()
+	{
+		m_imageInputInfos =
+		{
+			{"Output", RenderPassImageInfo(AccessFlags::Read, Format::PlaceholderSwapchain, {}, ImageLayout::ShaderReadOnly,
+				MaterialStageFlags::FragmentShader, MaterialAccessFlags::ShaderRead)}
+		};
+
+		m_imageOutputInfos =
+		{
+			{"Output", RenderPassImageInfo(AccessFlags::Write, Format::PlaceholderSwapchain, {}, ImageLayout::ColorAttachment,
+				MaterialStageFlags::ColorAttachmentOutput, MaterialAccessFlags::ColorAttachmentRead | MaterialAccessFlags::ColorAttachmentWrite)}
+		};
+	}
+
+	void UpscalePass::UpdateConnections(const Renderer& renderer, const std::vector<std::string_view>& passNames)
+	{
+		// The output is the only graph image not sized by the render scale.
+		m_displayExtent = renderer.GetSwapChain().GetExtent();
+		m_imageOutputInfos.at("Output").Dimensions = glm::uvec3(m_displayExtent, 1);
+	}
+
+	void UpscalePass::UpdatePlaceholderFormats(Format swapchainFormat, Format depthFormat)
+	{
+		m_imageInputInfos.at("Output").Format = swapchainFormat;
+		m_imageOutputInfos.at("Output").Format = swapchainFormat;
+	}
+
+	bool UpscalePass::Build(const Renderer& renderer,
+		const std::unordered_map<std::string, IRenderImage*>& imageInputs,
+		const std::unordered_map<std::string, IRenderImage*>& imageOutputs,
+		const std::unordered_map<std::string, IBuffer*>& bufferInputs,
+		const std::unordered_map<std::string, IBuffer*>& bufferOutputs)
+	{
+		ClearResources();
+
+		m_colourAttachments.emplace_back(m_material->GetColourAttachmentInfo(0, imageOutputs.at("Output")));
+
+		const IImageSampler& linearSampler = renderer.GetLinearSampler();
+		const IImageView& inputImageView = imageInputs.at("Output")->GetView();
+
+		if (!m_material->BindSampler(0, linearSampler) ||
+			!m_material->BindImageView(1, inputImageView))
+			return false;
+
+		return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
+	}
+
+	void UpscalePass::Draw(const Renderer& renderer, const ICommandBuffer& commandBuffer,
+		const glm::uvec2& size, uint32_t frameIndex, uint32_t layerIndex)
+	{
+		m_material->BindMaterial(commandBuffer, BindPoint::Graphics, frameIndex);
+		commandBuffer.Draw(3, 1, 0, 0);
+	}
+}
\ No newline at end of file
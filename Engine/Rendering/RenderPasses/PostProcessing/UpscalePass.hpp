@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../IRenderPass.hpp"
+#include <glm/glm.hpp>
+
+namespace Engine::Rendering
+{
+	// Boundary between the scaled render extent and the swapchain's. Everything before it renders at the render
+	// scale, it resamples the result up to the swapchain extent the passes after it draw at.
+	class UpscalePass : public IRenderPass
+	{
+	public:
+		UpscalePass();
+
+		virtual void UpdateConnections(const Renderer& renderer, const std::vector<std::string_view>& passNames) override;
+
+		virtual bool Build(const Renderer& renderer,
+			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
+			const std::unordered_map<std::string, IRenderImage*>& imageOutputs,
+			const std::unordered_map<std::string, IBuffer*>& bufferInputs,
+			const std::unordered_map<std::string, IBuffer*>& bufferOutputs) override;
+
+		virtual void UpdatePlaceholderFormats(Format swapchainFormat, Format depthFormat) override;
+
+		virtual void Draw(const Renderer& renderer, const ICommandBuffer& commandBuffer,
+			const glm::uvec2& size, uint32_t frameIndex, uint32_t passIndex) override;
+
+		virtual inline bool GetCustomSize(glm::uvec2& outSize) const override
+		{
+			outSize = m_displayExtent;
+			return true;
+		}
+
+	private:
+		glm::uvec2 m_displayExtent;
+	};
+}
\ No newline at end of file
@@ -3,15 +3,20 @@
 #include "../Resources/IRenderImage.hpp"
 #include "../Resources/ICommandBuffer.hpp"
 #include "../Resources/GeometryBatch.hpp"
+#include "../ComputePasses/FrustumCullingPass.hpp"
+#include "../ComputePasses/ClusterCullingPass.hpp"
 #include "../Renderer.hpp"
 
 namespace Engine::Rendering
 {
-	SceneOpaquePass::SceneOpaquePass(const GeometryBatch& sceneGeometryBatch)
+	SceneOpaquePass::SceneOpaquePass(const FrustumCullingPass& frustumCullingPass, const ClusterCullingPass& clusterCullingPass)
 		: IRenderPass("SceneOpaque", "PBR")
-		, m_sceneGeometryBatch(sceneGeometryBatch)
+		, m_frustumCullingPass(frustumCullingPass)
+		, m_clusterCullingPass(clusterCullingPass)
 		, m_built(false)
 		, m_indirectDrawBuffer(nullptr)
+		, m_drawRegions()
+		, m_vertexBufferOffsets()
 	{
 		m_imageOutputInfos =
 		{
@@ -47,8 +52,33 @@ namespace Engine::Rendering
 		const std::unordered_map<std::string, IBuffer*>& bufferOutputs)
 	{
 		m_built = false;
+
+		m_indirectDrawBuffer = bufferInputs.at("IndirectDraw");
+
+		// Cluster culling replaces the frustum culling output when enabled, draw from whichever regions fill the bound buffer.
+		const std::vector<IndirectDrawRegion>& regions = m_indirectDrawBuffer == m_clusterCullingPass.GetIndirectBuffer()
+			? m_clusterCullingPass.GetIndirectDrawRegions()
+			: m_frustumCullingPass.GetIndirectDrawRegions();
+
+		// Vertex input formats are part of the pipeline, so every batch drawn has to match the first batch's vertex layout.
+		m_drawRegions.clear();
+		for (const IndirectDrawRegion& region : regions)
+		{
+			if (!m_drawRegions.empty() && region.Batch->HasQuantisedVertices() != m_drawRegions.front().Batch->HasQuantisedVertices())
+			{
+				Logger::Warning("Skipping geometry batch with a vertex layout that differs from the first batch.");
+				continue;
+			}
+
+			m_drawRegions.push_back(region);
+		}
+
+		bool quantisedVertices = !m_drawRegions.empty() && m_drawRegions.front().Batch->HasQuantisedVertices();
+		const std::string materialName = quantisedVertices ? "PBRQuantised" : "PBR";
+		if (!renderer.GetMaterialManager().TryGetMaterial(materialName, &m_material))
+			return false;
+
 		const std::vector<std::unique_ptr<IBuffer>>& frameInfoBuffers = renderer.GetFrameInfoBuffers();
-		const std::vector<std::unique_ptr<IBuffer>>& lightBuffers = renderer.GetLightBuffers();
 		const IImageSampler& linearSampler = renderer.GetLinearSampler();
 
 		ClearResources();
@@ -59,26 +89,33 @@ namespace Engine::Rendering
 		m_colourAttachments.emplace_back(m_material->GetColourAttachmentInfo(3, imageOutputs.at("MetalRoughness"), AttachmentLoadOp::Clear));
 		m_colourAttachments.emplace_back(m_material->GetColourAttachmentInfo(4, imageOutputs.at("Velocity"), AttachmentLoadOp::Clear));
 
-		m_indirectDrawBuffer = bufferInputs.at("IndirectDraw");
-
 		m_depthAttachment = AttachmentInfo(imageOutputs.at("Depth"), ImageLayout::DepthStencilAttachment, AttachmentLoadOp::Clear, AttachmentStoreOp::Store, ClearValue(1.0f));
 
-		// If scene manager has not been built or is empty, mark the pass as done so drawing is skipped for this pass.
-		if (!m_sceneGeometryBatch.IsBuilt() || m_sceneGeometryBatch.GetVertexBuffers().empty())
+		// If no batch has been built or they are all empty, mark the pass as done so drawing is skipped for this pass.
+		if (m_drawRegions.empty())
 			return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
 
-		const IBuffer& meshInfoBuffer = m_sceneGeometryBatch.GetMeshInfoBuffer();
-		const std::vector<std::unique_ptr<IRenderImage>>& imageArray = m_sceneGeometryBatch.GetImages();
-
-		std::vector<const IImageView*> imageViews(imageArray.size());
-		for (size_t i = 0; i < imageArray.size(); ++i)
-			imageViews[i] = &imageArray[i]->GetView();
+		m_material->SetInstanceCount(static_cast<uint32_t>(m_drawRegions.size()));
+		for (size_t i = 0; i < m_drawRegions.size(); ++i)
+		{
+			const GeometryBatch& geometryBatch = *m_drawRegions[i].Batch;
+			const std::vector<std::unique_ptr<IRenderImage>>& imageArray = geometryBatch.GetImages();
+
+			// Batches without textures still need a valid image array binding.
+			std::vector<const IImageView*> imageViews(std::max(imageArray.size(), static_cast<size_t>(1)), &renderer.GetBlankImage().GetView());
+			for (size_t j = 0; j < imageArray.size(); ++j)
+				imageViews[j] = &imageArray[j]->GetView();
+
+			m_material->SetBindingInstance(static_cast<uint32_t>(i));
+			if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
+				!m_material->BindStorageBuffer(1, geometryBatch.GetMeshInfoBuffer()) ||
+				!m_material->BindSampler(2, linearSampler) ||
+				!m_material->BindImageViews(3, imageViews))
+				return false;
+		}
 
-		if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
-			!m_material->BindStorageBuffer(1, meshInfoBuffer) ||
-			!m_material->BindSampler(2, linearSampler) ||
-			!m_material->BindImageViews(3, imageViews))
-			return false;
+		// Every batch drawn shares the first one's vertex layout, so one set of zero offsets serves them all.
+		m_vertexBufferOffsets.assign(m_drawRegions.front().Batch->GetVertexBuffers().size(), 0);
 
 		m_built = true;
 		return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
@@ -90,24 +127,18 @@ namespace Engine::Rendering
 		if (!m_built)
 			return;
 
-		m_material->BindMaterial(commandBuffer, BindPoint::Graphics, frameIndex);
-
-		const std::vector<std::unique_ptr<IBuffer>>& vertexBuffers = m_sceneGeometryBatch.GetVertexBuffers();
-		uint32_t vertexBufferCount = static_cast<uint32_t>(vertexBuffers.size());
-
-		std::vector<size_t> vertexBufferOffsets;
-		vertexBufferOffsets.resize(vertexBufferCount);
-		std::vector<IBuffer*> vertexBufferViews;
-		vertexBufferViews.reserve(vertexBufferCount);
-		for (const auto& buffer : vertexBuffers)
+		for (size_t i = 0; i < m_drawRegions.size(); ++i)
 		{
-			vertexBufferViews.emplace_back(buffer.get());
-		}
+			const IndirectDrawRegion& region = m_drawRegions[i];
+			const GeometryBatch& geometryBatch = *region.Batch;
+			const std::vector<IBuffer*>& vertexBuffers = geometryBatch.GetVertexBuffers();
 
-		commandBuffer.BindVertexBuffers(0, vertexBufferViews, vertexBufferOffsets);
-		commandBuffer.BindIndexBuffer(m_sceneGeometryBatch.GetIndexBuffer(), 0, IndexType::Uint32);
+			m_material->BindMaterial(commandBuffer, BindPoint::Graphics, frameIndex, static_cast<uint32_t>(i));
+			commandBuffer.BindVertexBuffers(0, vertexBuffers, m_vertexBufferOffsets);
+			commandBuffer.BindIndexBuffer(geometryBatch.GetIndexBuffer(), 0, IndexType::Uint32);
 
-		uint32_t maxDrawCount = m_sceneGeometryBatch.GetMeshCapacity();
-		commandBuffer.DrawIndexedIndirectCount(*m_indirectDrawBuffer, sizeof(uint32_t), *m_indirectDrawBuffer, 0, maxDrawCount, sizeof(IndexedIndirectCommand));
+			commandBuffer.DrawIndexedIndirectCount(*m_indirectDrawBuffer, region.Offset + sizeof(uint32_t), *m_indirectDrawBuffer, region.Offset,
+				region.MaxDrawCount, sizeof(IndexedIndirectCommand));
+		}
 	}
 }
\ No newline at end of file
@@ -1,15 +1,18 @@
 #pragma once
 
 #include "IRenderPass.hpp"
+#include "../IndirectDrawLayout.hpp"
 
 namespace Engine::Rendering
 {
 	class GeometryBatch;
+	class FrustumCullingPass;
+	class ClusterCullingPass;
 
 	class SceneOpaquePass : public IRenderPass
 	{
 	public:
-		SceneOpaquePass(const GeometryBatch& sceneGeometryBatch);
+		SceneOpaquePass(const FrustumCullingPass& frustumCullingPass, const ClusterCullingPass& clusterCullingPass);
 
 		virtual bool Build(const Renderer& renderer,
 			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
@@ -23,8 +26,11 @@ namespace Engine::Rendering
 			const glm::uvec2& size, uint32_t frameIndex, uint32_t layerIndex) override;
 
 	private:
-		const GeometryBatch& m_sceneGeometryBatch;
+		const FrustumCullingPass& m_frustumCullingPass;
+		const ClusterCullingPass& m_clusterCullingPass;
 		bool m_built;
 		IBuffer* m_indirectDrawBuffer;
+		std::vector<IndirectDrawRegion> m_drawRegions;
+		std::vector<size_t> m_vertexBufferOffsets;
 	};
 }
\ No newline at end of file
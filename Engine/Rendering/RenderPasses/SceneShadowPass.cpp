@@ -3,18 +3,22 @@
 #include "../Resources/IRenderImage.hpp"
 #include "../Resources/ICommandBuffer.hpp"
 #include "../Resources/GeometryBatch.hpp"
+#include "../ComputePasses/ShadowCullingPass.hpp"
 #include "../Renderer.hpp"
 #include "../RenderResources/ShadowMap.hpp"
 
 namespace Engine::Rendering
 {
-	SceneShadowPass::SceneShadowPass(const GeometryBatch& sceneGeometryBatch, const ShadowMap& shadowMap)
+	SceneShadowPass::SceneShadowPass(const ShadowMap& shadowMap, const ShadowCullingPass& shadowCullingPass)
 		: IRenderPass("SceneShadow", "Shadow")
-		, m_sceneGeometryBatch(sceneGeometryBatch)
 		, m_built(false)
 		, m_shadowMap(shadowMap)
+		, m_shadowCullingPass(shadowCullingPass)
 		, m_shadowResolution(4096)
 		, m_indirectDrawBuffer(nullptr)
+		, m_drawRegions()
+		, m_vertexBufferViews()
+		, m_vertexBufferOffsets()
 	{
 		m_imageInputInfos =
 		{
@@ -53,6 +57,24 @@ namespace Engine::Rendering
 	{
 		m_built = false;
 
+		// Vertex input formats are part of the pipeline, so every batch drawn has to match the first batch's vertex layout.
+		m_drawRegions.clear();
+		for (const IndirectDrawRegion& region : m_shadowCullingPass.GetIndirectDrawRegions())
+		{
+			if (!m_drawRegions.empty() && region.Batch->HasQuantisedVertices() != m_drawRegions.front().Batch->HasQuantisedVertices())
+			{
+				Logger::Warning("Skipping geometry batch with a vertex layout that differs from the first batch.");
+				continue;
+			}
+
+			m_drawRegions.push_back(region);
+		}
+
+		bool quantisedVertices = !m_drawRegions.empty() && m_drawRegions.front().Batch->HasQuantisedVertices();
+		const std::string materialName = quantisedVertices ? "ShadowQuantised" : "Shadow";
+		if (!renderer.GetMaterialManager().TryGetMaterial(materialName, &m_material))
+			return false;
+
 		ClearResources();
 
 		const std::vector<std::unique_ptr<IBuffer>>& frameInfoBuffers = renderer.GetFrameInfoBuffers();
@@ -65,23 +87,40 @@ namespace Engine::Rendering
 
 		m_indirectDrawBuffer = bufferInputs.at("ShadowIndirectDraw");
 
-		// If scene manager has not been built or is empty, mark the pass as done so drawing is skipped for this pass.
-		if (!m_sceneGeometryBatch.IsBuilt() || m_sceneGeometryBatch.GetVertexBuffers().empty())
+		// If no batch has been built or they are all empty, mark the pass as done so drawing is skipped for this pass.
+		if (m_drawRegions.empty())
 			return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
 
-		const IBuffer& meshInfoBuffer = m_sceneGeometryBatch.GetMeshInfoBuffer();
-		const std::vector<std::unique_ptr<IRenderImage>>& imageArray = m_sceneGeometryBatch.GetImages();
+		m_material->SetInstanceCount(static_cast<uint32_t>(m_drawRegions.size()));
+		for (size_t i = 0; i < m_drawRegions.size(); ++i)
+		{
+			const GeometryBatch& geometryBatch = *m_drawRegions[i].Batch;
+			const std::vector<std::unique_ptr<IRenderImage>>& imageArray = geometryBatch.GetImages();
+
+			// Batches without textures still need a valid image array binding.
+			std::vector<const IImageView*> imageViews(std::max(imageArray.size(), static_cast<size_t>(1)), &renderer.GetBlankImage().GetView());
+			for (size_t j = 0; j < imageArray.size(); ++j)
+				imageViews[j] = &imageArray[j]->GetView();
+
+			m_material->SetBindingInstance(static_cast<uint32_t>(i));
+			if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
+				!m_material->BindUniformBuffers(1, lightBuffers) ||
+				!m_material->BindStorageBuffer(2, geometryBatch.GetMeshInfoBuffer()) ||
+				!m_material->BindSampler(3, shadowSampler) ||
+				!m_material->BindImageViews(4, imageViews))
+				return false;
+		}
 
-		std::vector<const IImageView*> imageViews(imageArray.size());
-		for (size_t i = 0; i < imageArray.size(); ++i)
-			imageViews[i] = &imageArray[i]->GetView();
+		// Shadows only read the first two vertex streams. They are gathered per batch here as drawing may be recorded in
+		// parallel with other passes, replacing a batch's buffers marks the graph dirty so these cannot go stale.
+		m_vertexBufferViews.resize(m_drawRegions.size());
+		for (size_t i = 0; i < m_drawRegions.size(); ++i)
+		{
+			const std::vector<IBuffer*>& vertexBuffers = m_drawRegions[i].Batch->GetVertexBuffers();
+			m_vertexBufferViews[i].assign(vertexBuffers.begin(), vertexBuffers.begin() + 2);
+		}
 
-		if (!m_material->BindUniformBuffers(0, frameInfoBuffers) ||
-			!m_material->BindUniformBuffers(1, lightBuffers) ||
-			!m_material->BindStorageBuffer(2, meshInfoBuffer) ||
-			!m_material->BindSampler(3, shadowSampler) ||
-			!m_material->BindImageViews(4, imageViews))
-			return false;
+		m_vertexBufferOffsets.assign(2, 0);
 
 		m_built = true;
 		return IRenderNode::Build(renderer, imageInputs, imageOutputs, bufferInputs, bufferOutputs);
@@ -93,31 +132,22 @@ namespace Engine::Rendering
 		if (!m_built)
 			return;
 
-		commandBuffer.PushConstants(m_material, ShaderStageFlags::Vertex, 0, sizeof(uint32_t), &layerIndex);
-
-		if (layerIndex == 0)
+		for (size_t i = 0; i < m_drawRegions.size(); ++i)
 		{
-			const std::vector<std::unique_ptr<IBuffer>>& vertexBuffers = m_sceneGeometryBatch.GetVertexBuffers();
-			std::vector<size_t> vertexBufferOffsets;
-			vertexBufferOffsets.resize(2);
-			std::vector<IBuffer*> vertexBufferViews = { vertexBuffers[0].get(), vertexBuffers[1].get() };
-
-			m_depthAttachment->loadOp = AttachmentLoadOp::Load;
-			m_material->BindMaterial(commandBuffer, BindPoint::Graphics, frameIndex);
-			commandBuffer.BindVertexBuffers(0, vertexBufferViews, vertexBufferOffsets);
-			commandBuffer.BindIndexBuffer(m_sceneGeometryBatch.GetIndexBuffer(), 0, IndexType::Uint32);
+			const IndirectDrawRegion& region = m_drawRegions[i];
+			const GeometryBatch& geometryBatch = *region.Batch;
+
+			m_material->BindMaterial(commandBuffer, BindPoint::Graphics, frameIndex, static_cast<uint32_t>(i));
+			commandBuffer.PushConstants(m_material, ShaderStageFlags::Vertex, 0, sizeof(uint32_t), &layerIndex);
+			commandBuffer.BindVertexBuffers(0, m_vertexBufferViews[i], m_vertexBufferOffsets);
+			commandBuffer.BindIndexBuffer(geometryBatch.GetIndexBuffer(), 0, IndexType::Uint32);
+
+			// Each region holds four cascade counts followed by one block of draws per cascade.
+			commandBuffer.DrawIndexedIndirectCount(*m_indirectDrawBuffer,
+				region.Offset + sizeof(uint32_t) * 4 + layerIndex * region.MaxDrawCount * sizeof(IndexedIndirectCommand),
+				*m_indirectDrawBuffer,
+				region.Offset + sizeof(uint32_t) * layerIndex, region.MaxDrawCount,
+				sizeof(IndexedIndirectCommand));
 		}
-		else if (layerIndex == m_layerCount - 1)
-		{
-			// Reset to 'Clear' for next frame.
-			m_depthAttachment->loadOp = AttachmentLoadOp::Clear;
-		}
-
-		uint32_t maxDrawCount = m_sceneGeometryBatch.GetMeshCapacity();
-		commandBuffer.DrawIndexedIndirectCount(*m_indirectDrawBuffer,
-			sizeof(uint32_t) * 4 + layerIndex * maxDrawCount * sizeof(IndexedIndirectCommand),
-			*m_indirectDrawBuffer,
-			sizeof(uint32_t) * layerIndex, maxDrawCount,
-			sizeof(IndexedIndirectCommand));
 	}
 }
\ No newline at end of file
@@ -1,16 +1,18 @@
 #pragma once
 
 #include "IRenderPass.hpp"
+#include "../IndirectDrawLayout.hpp"
 
 namespace Engine::Rendering
 {
 	class GeometryBatch;
 	class ShadowMap;
+	class ShadowCullingPass;
 
 	class SceneShadowPass : public IRenderPass
 	{
 	public:
-		SceneShadowPass(const GeometryBatch& sceneGeometryBatch, const ShadowMap& shadowMap);
+		SceneShadowPass(const ShadowMap& shadowMap, const ShadowCullingPass& shadowCullingPass);
 
 		virtual bool Build(const Renderer& renderer,
 			const std::unordered_map<std::string, IRenderImage*>& imageInputs,
@@ -30,10 +32,13 @@ namespace Engine::Rendering
 		}
 
 	private:
-		const GeometryBatch& m_sceneGeometryBatch;
 		const ShadowMap& m_shadowMap;
+		const ShadowCullingPass& m_shadowCullingPass;
 		glm::uvec2 m_shadowResolution;
 		IBuffer* m_indirectDrawBuffer;
+		std::vector<IndirectDrawRegion> m_drawRegions;
+		std::vector<std::vector<IBuffer*>> m_vertexBufferViews;
+		std::vector<size_t> m_vertexBufferOffsets;
 		bool m_built;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "../Resources/IBuffer.hpp"
 #include "../Resources/IRenderImage.hpp"
 #include "../Resources/ICommandBuffer.hpp"
+#include "../ISwapChain.hpp"
 #include "../Renderer.hpp"
 #include "UI/UIManager.hpp"
 
@@ -12,6 +13,7 @@ namespace Engine::Rendering
 	UIPass::UIPass(UIManager& uiManager)
 		: IRenderPass("UI", "")
 		, m_uiManager(uiManager)
+		, m_displayExtent()
 	{
 		m_imageInputInfos =
 		{
@@ -25,6 +27,13 @@ namespace Engine::Rendering
 		};
 	}
 
+	void UIPass::UpdateConnections(const Renderer& renderer, const std::vector<std::string_view>& passNames)
+	{
+		// UI is drawn after the upscale, at the swapchain's extent whatever the render scale.
+		m_displayExtent = renderer.GetSwapChain().GetExtent();
+		m_imageOutputInfos.at("Output").Dimensions = glm::uvec3(m_displayExtent, 1);
+	}
+
 	void UIPass::UpdatePlaceholderFormats(Format swapchainFormat, Format depthFormat)
 	{
 		m_imageInputInfos.at("Output").Format = swapchainFormat;
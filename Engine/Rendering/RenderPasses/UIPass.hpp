@@ -25,12 +25,21 @@ namespace Engine::Rendering
 			const std::unordered_map<std::string, IBuffer*>& bufferInputs,
 			const std::unordered_map<std::string, IBuffer*>& bufferOutputs) override;
 
+		virtual void UpdateConnections(const Renderer& renderer, const std::vector<std::string_view>& passNames) override;
+
 		virtual void UpdatePlaceholderFormats(Format swapchainFormat, Format depthFormat) override;
 
 		virtual void Draw(const Renderer& renderer, const ICommandBuffer& commandBuffer,
 			const glm::uvec2& size, uint32_t frameIndex, uint32_t layerIndex) override;
 
+		virtual inline bool GetCustomSize(glm::uvec2& outSize) const override
+		{
+			outSize = m_displayExtent;
+			return true;
+		}
+
 	private:
 		Engine::UI::UIManager& m_uiManager;
+		glm::uvec2 m_displayExtent;
 	};
 }
\ No newline at end of file
@@ -27,6 +27,11 @@ namespace Engine::Rendering
 
 		inline bool GetEnabled() const { return m_enabled; }
 
+		// A bypassed node stays in the built graph with its resources but is not recorded, so it can be switched every frame.
+		inline void SetBypassed(bool bypassed) { m_bypassed = bypassed; }
+
+		inline bool GetBypassed() const { return m_bypassed; }
+
 		inline RenderNodeType GetNodeType() const { return m_nodeType; }
 
 		inline const std::unordered_map<std::string, RenderPassBufferInfo>& GetBufferInputInfos() const { return m_bufferInputInfos; }
@@ -86,6 +91,7 @@ namespace Engine::Rendering
 			, m_imageInputInfos()
 			, m_imageOutputInfos()
 			, m_enabled(true)
+			, m_bypassed(false)
 			, m_nodeType(nodeType)
 		{
 		}
@@ -98,6 +104,7 @@ namespace Engine::Rendering
 	private:
 		std::string m_name;
 		bool m_enabled;
+		bool m_bypassed;
 		RenderNodeType m_nodeType;
 	};
 }
\ No newline at end of file
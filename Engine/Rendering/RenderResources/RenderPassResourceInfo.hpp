@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Types.hpp"
+#include <glm/glm.hpp>
 
 namespace Engine::Rendering
 {
@@ -36,7 +37,7 @@ namespace Engine::Rendering
 
 	struct RenderPassImageInfo : public RenderPassResourceInfo
 	{
-		Format Format;
+		Engine::Rendering::Format Format;
 		glm::uvec3 Dimensions;
 		IRenderImage* Image;
 		ImageLayout Layout;
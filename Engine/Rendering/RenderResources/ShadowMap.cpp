@@ -5,6 +5,7 @@
 #include "../Resources/IRenderImage.hpp"
 #include "../IResourceFactory.hpp"
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include "../Renderer.hpp"
 
 namespace Engine::Rendering
@@ -29,7 +30,8 @@ namespace Engine::Rendering
 	{
 		const float cascadeSplitLambda = 0.95f;
 
-		std::vector<float> cascadeSplits(m_cascadeCount);
+		// Runs every frame, so the splits stay on the stack. The count never grows past the one set at construction.
+		std::array<float, DefaultCascadeCount> cascadeSplits;
 
 		const glm::vec2& nearFar = camera.GetNearFar();
 		float clipRange = nearFar.y - nearFar.x;
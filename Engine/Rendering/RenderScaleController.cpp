@@ -0,0 +1,79 @@
+#include "RenderScaleController.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine::Rendering
+{
+	constexpr float ScaleStep = 0.05f;
+
+	// Frames averaged before a decision, also the cooldown after a change as its rebuild skews the first timings.
+	constexpr uint32_t SettleFrameCount = 30;
+	constexpr float AverageWeight = 0.1f;
+
+	// Scale down as soon as frames run over, but only scale up with clear headroom so the scale does not oscillate.
+	constexpr float OverBudgetRatio = 1.05f;
+	constexpr float UnderBudgetRatio = 0.85f;
+
+	// A new scale aims below the budget, so frame time noise at the new scale does not immediately push it back over.
+	constexpr float TargetRatio = 0.9f;
+
+	RenderScaleController::RenderScaleController()
+		: m_scale(1.0f)
+		, m_minScale(0.5f)
+		, m_maxScale(1.0f)
+		, m_targetFrameTime(1.0f / 60.0f)
+		, m_averageFrameTime(0.0f)
+		, m_sampleCount(0)
+	{
+	}
+
+	float RenderScaleController::Quantise(float scale) const
+	{
+		// Rounding down keeps the predicted frame time at or below the aim, rounding up could land over budget again.
+		// The small bias keeps scales already on a step, give or take float error, on that step.
+		return std::clamp(std::floor(scale / ScaleStep + 0.001f) * ScaleStep, m_minScale, m_maxScale);
+	}
+
+	bool RenderScaleController::Update(float frameTime)
+	{
+		if (frameTime <= 0.0f)
+			return false;
+
+		m_averageFrameTime = m_sampleCount == 0 ? frameTime : m_averageFrameTime + (frameTime - m_averageFrameTime) * AverageWeight;
+		if (++m_sampleCount < SettleFrameCount)
+			return false;
+
+		float ratio = m_averageFrameTime / m_targetFrameTime;
+		if (ratio <= OverBudgetRatio && ratio >= UnderBudgetRatio)
+			return false;
+
+		// Frame time is assumed to follow the pixel count, which goes with the square of the scale.
+		float scale = Quantise(m_scale * std::sqrt(TargetRatio / ratio));
+		if (scale == m_scale)
+			return false;
+
+		m_scale = scale;
+		m_sampleCount = 0;
+		return true;
+	}
+
+	void RenderScaleController::Reset(float scale)
+	{
+		m_scale = Quantise(scale);
+		m_averageFrameTime = 0.0f;
+		m_sampleCount = 0;
+	}
+
+	void RenderScaleController::SetTargetFrameTime(float frameTime)
+	{
+		m_targetFrameTime = std::max(frameTime, 0.001f);
+		m_sampleCount = 0;
+	}
+
+	void RenderScaleController::SetScaleRange(float minScale, float maxScale)
+	{
+		m_minScale = std::clamp(minScale, ScaleStep, 1.0f);
+		m_maxScale = std::clamp(maxScale, m_minScale, 1.0f);
+		m_scale = Quantise(m_scale);
+	}
+}
\ No newline at end of file
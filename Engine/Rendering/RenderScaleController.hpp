@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Macros.hpp"
+#include <cstdint>
+
+namespace Engine::Rendering
+{
+	// Picks the render scale that keeps frames within a target time. Only fed frame times, so it can be driven by
+	// synthetic ones as well as measured. Scales are quantised into steps, so the graph settles on a few extents whose
+	// schedules are cached, and a change is only made once enough frames at the current scale have been seen.
+	class RenderScaleController
+	{
+	public:
+		EXPORT RenderScaleController();
+
+		// Returns true when the scale changed.
+		EXPORT bool Update(float frameTime);
+
+		EXPORT void Reset(float scale);
+
+		EXPORT void SetTargetFrameTime(float frameTime);
+		inline float GetTargetFrameTime() const { return m_targetFrameTime; }
+
+		EXPORT void SetScaleRange(float minScale, float maxScale);
+		inline float GetMinScale() const { return m_minScale; }
+		inline float GetMaxScale() const { return m_maxScale; }
+
+		inline float GetScale() const { return m_scale; }
+		inline float GetAverageFrameTime() const { return m_averageFrameTime; }
+
+	private:
+		float Quantise(float scale) const;
+
+		float m_scale;
+		float m_minScale;
+		float m_maxScale;
+		float m_targetFrameTime;
+		float m_averageFrameTime;
+		uint32_t m_sampleCount;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AntiAliasingMode.hpp"
+#include "CullingMode.hpp"
 
 namespace Engine::Rendering
 {
@@ -8,12 +9,30 @@ namespace Engine::Rendering
 	{
 		uint32_t m_multiSampleCount;
 		AntiAliasingMode m_aaMode;
+		CullingMode m_cullingMode;
 		bool m_hdr;
+		bool m_clusterCulling;
+		bool m_boxCulling;
+		bool m_quantisedVertices;
+		bool m_transferQueueUploads;
+		bool m_parallelRecording;
+		bool m_precompiledPassVariants;
+		bool m_dynamicResolution;
+		float m_renderScale;
 
 		RenderSettings()
 			: m_multiSampleCount(1)
 			, m_aaMode(AntiAliasingMode::TAA)
+			, m_cullingMode(CullingMode::FrustumAndOcclusion)
 			, m_hdr(false)
+			, m_clusterCulling(false)
+			, m_boxCulling(true)
+			, m_quantisedVertices(false)
+			, m_transferQueueUploads(false)
+			, m_parallelRecording(true)
+			, m_precompiledPassVariants(false)
+			, m_dynamicResolution(false)
+			, m_renderScale(1.0f)
 		{
 		}
 	};
@@ -1,10 +1,12 @@
 #include "RenderStats.hpp"
+#include "RenderResources/IRenderResource.hpp"
 
 namespace Engine::Rendering
 {
 	RenderStats::RenderStats()
 		: m_statsData()
 		, m_memoryStats()
+		, m_resourceMemoryUsage()
 	{
 	}
 
@@ -17,4 +19,38 @@ namespace Engine::Rendering
 	{
 		return m_memoryStats;
 	}
+
+	void RenderStats::SetTransientMemoryUsage(uint64_t aliasedSize, uint64_t unaliasedSize, uint64_t peakSize)
+	{
+		m_memoryStats.TransientAliasedSize = aliasedSize;
+		m_memoryStats.TransientUnaliasedSize = unaliasedSize;
+		m_memoryStats.TransientPeakSize = peakSize;
+	}
+
+	void RenderStats::InitialiseResourceMemoryUsage(const std::vector<IRenderResource*>& renderResources)
+	{
+		m_memoryStats.ResourceMemoryUsage.clear();
+		m_resourceMemoryUsage.clear();
+		m_resourceMemoryUsage.reserve(renderResources.size());
+
+		// Entries are created once per build, so updating them each frame neither allocates nor hashes a name.
+		for (const IRenderResource* renderResource : renderResources)
+		{
+			auto [entry, inserted] = m_memoryStats.ResourceMemoryUsage.try_emplace(std::string(renderResource->GetName()), 0);
+			if (inserted)
+				m_resourceMemoryUsage.emplace_back(renderResource, &entry->second);
+		}
+	}
+
+	size_t RenderStats::UpdateResourceMemoryUsage()
+	{
+		size_t totalUsage = 0;
+		for (const auto& [renderResource, usage] : m_resourceMemoryUsage)
+		{
+			*usage = renderResource->GetMemoryUsage();
+			totalUsage += *usage;
+		}
+
+		return totalUsage;
+	}
 }
\ No newline at end of file
@@ -25,6 +25,9 @@ namespace Engine::Rendering
 		uint64_t DedicatedBudget;
 		uint64_t SharedUsage;
 		uint64_t SharedBudget;
+		uint64_t TransientAliasedSize; // Render graph images placed in shared heaps.
+		uint64_t TransientUnaliasedSize; // The same images if each had its own allocation.
+		uint64_t TransientPeakSize; // Largest total of the images in use during a single stage.
 	};
 
 	class IPhysicalDevice;
@@ -38,17 +41,28 @@ namespace Engine::Rendering
 		RenderStats();
 		virtual ~RenderStats() = default;
 
-		virtual bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t renderPassCount) = 0;
-		virtual void Begin(const ICommandBuffer& commandBuffer, std::string_view passName, bool isCompute) = 0;
-		virtual void End(const ICommandBuffer& commandBuffer, bool isCompute) = 0;
-		virtual void FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device,
-			const std::vector<IRenderResource*>& renderResources) = 0;
+		// Passes are identified by their index into the names given at initialisation, so recording a pass neither copies nor hashes its name.
+		// Likewise the render resources are only looked at again to read their memory usage.
+		virtual bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, const std::vector<std::string_view>& passNames,
+			const std::vector<bool>& computePasses, const std::vector<IRenderResource*>& renderResources) = 0;
+		virtual void Begin(const ICommandBuffer& commandBuffer, uint32_t passIndex) = 0;
+		virtual void End(const ICommandBuffer& commandBuffer, uint32_t passIndex) = 0;
+		virtual void FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device) = 0;
 
 		EXPORT const std::unordered_map<std::string, FrameStats>& GetFrameStats() const;
 		EXPORT const MemoryStats& GetMemoryStats() const;
 
+		// Set by the render graph whenever it places its transient images, rather than measured each frame.
+		void SetTransientMemoryUsage(uint64_t aliasedSize, uint64_t unaliasedSize, uint64_t peakSize);
+
 	protected:
+		void InitialiseResourceMemoryUsage(const std::vector<IRenderResource*>& renderResources);
+		size_t UpdateResourceMemoryUsage();
+
 		std::unordered_map<std::string, FrameStats> m_statsData;
 		MemoryStats m_memoryStats;
+
+	private:
+		std::vector<std::pair<const IRenderResource*, size_t*>> m_resourceMemoryUsage;
 	};
 }
\ No newline at end of file
@@ -1,7 +1,13 @@
 #include "Renderer.hpp"
+#include <algorithm>
+#include <cassert>
 #include "Core/SceneManager.hpp"
+#include "Core/AsyncData.hpp"
 #include "Core/Logger.hpp"
+#include "Null/NullRenderer.hpp"
+#ifdef ENGINE_VULKAN
 #include "Vulkan/VulkanRenderer.hpp"
+#endif
 #include "OS/Window.hpp"
 #include "IDevice.hpp"
 #include "IPhysicalDevice.hpp"
@@ -13,9 +19,11 @@
 #include "Resources/FrameInfoUniformBuffer.hpp"
 #include "Resources/LightUniformBuffer.hpp"
 #include "Resources/GeometryBatch.hpp"
+#include "Resources/StagingRing.hpp"
 #include "Resources/ISemaphore.hpp"
 #include "Resources/ICommandPool.hpp"
 #include "Resources/ICommandBuffer.hpp"
+#include "UI/UIManager.hpp"
 #include "RenderResources/ShadowMap.hpp"
 #include "PostProcessing.hpp"
 
@@ -27,15 +35,18 @@
 
 #include "ComputePasses/IComputePass.hpp"
 #include "ComputePasses/FrustumCullingPass.hpp"
+#include "ComputePasses/ClusterCullingPass.hpp"
 #include "ComputePasses/ShadowCullingPass.hpp"
 #include "ComputePasses/DepthReductionPass.hpp"
 
 using namespace Engine::OS;
 using namespace Engine::UI;
-using namespace Engine::Rendering::Vulkan;
 
 namespace Engine::Rendering
 {
+	// Shared by every geometry batch, uploads are staged in chunks and anything that does not fit spills into overflow pages.
+	constexpr uint64_t GeometryStagingRingSize = 16 * 1024 * 1024;
+
 	Renderer::Renderer(Window& window, bool debug)
 		: m_debug(debug)
 		, m_window(window)
@@ -51,6 +62,8 @@ namespace Engine::Rendering
 		, m_lastWindowSize()
 		, m_maxConcurrentFrames()
 		, m_renderSettings()
+		, m_renderScaleController()
+		, m_lastRenderTime()
 		, m_depthFormat(Format::Undefined)
 		, m_frameInfoBuffers()
 		, m_lightBuffers()
@@ -72,7 +85,11 @@ namespace Engine::Rendering
 		, m_nearestSampler(nullptr)
 		, m_shadowSampler(nullptr)
 		, m_reductionSampler(nullptr)
-		, m_sceneGeometryBatch(std::make_unique<GeometryBatch>(*this))
+		, m_geometryBatches()
+		, m_retiredGeometryBatches()
+		, m_geometryStagingRing(std::make_unique<StagingRing>("geometryStagingRing", GeometryStagingRingSize))
+		, m_geometryStagingMutex()
+		, m_renderThreadId()
 		, m_nvidiaReflex(nullptr)
 		, m_blankImage(nullptr)
 		, m_blankShadowImage(nullptr)
@@ -80,6 +97,7 @@ namespace Engine::Rendering
 		, m_asyncComputeSupported(false)
 		, m_asyncComputePendingState(false)
 	{
+		m_geometryBatches.emplace_back(std::make_unique<GeometryBatch>(*this));
 	}
 
 	Renderer::~Renderer()
@@ -106,11 +124,14 @@ namespace Engine::Rendering
 		m_nearestSampler.reset();
 		m_shadowSampler.reset();
 		m_reductionSampler.reset();
-		m_sceneGeometryBatch.reset();
+		// Streamed cell loads reference their batches, so they have to finish first.
+		m_sceneManager.reset();
+		m_retiredGeometryBatches.clear();
+		m_geometryBatches.clear();
+		m_geometryStagingRing.reset();
 		m_postProcessing.reset();
 		m_shadowMap.reset();
 		m_uiManager.reset();
-		m_sceneManager.reset();
 		m_renderStats.reset();
 		m_materialManager.reset();
 	}
@@ -162,13 +183,31 @@ namespace Engine::Rendering
 	{
 		m_renderSettings.m_aaMode = mode;
 
-		m_renderGraph->SetPassEnabled("FXAA", mode == AntiAliasingMode::FXAA);
+		SetPassVariantActive("FXAA", mode == AntiAliasingMode::FXAA);
+
+		SetPassVariantActive("SMAAEdges", mode == AntiAliasingMode::SMAA);
+		SetPassVariantActive("SMAAWeights", mode == AntiAliasingMode::SMAA);
+		SetPassVariantActive("SMAABlend", mode == AntiAliasingMode::SMAA);
+
+		SetPassVariantActive("TAA", mode == AntiAliasingMode::TAA);
+	}
 
-		m_renderGraph->SetPassEnabled("SMAAEdges", mode == AntiAliasingMode::SMAA);
-		m_renderGraph->SetPassEnabled("SMAAWeights", mode == AntiAliasingMode::SMAA);
-		m_renderGraph->SetPassEnabled("SMAABlend", mode == AntiAliasingMode::SMAA);
+	void Renderer::SetPassVariantActive(const std::string& passName, bool active)
+	{
+		// Precompiled variants stay in the graph and are only bypassed, which needs no rebuild.
+		bool precompiled = m_renderSettings.m_precompiledPassVariants;
+		m_renderGraph->SetPassEnabled(passName, precompiled || active);
+		m_renderGraph->SetPassBypassed(passName, precompiled && !active);
+	}
+
+	void Renderer::SetPrecompiledPassVariantsState(bool enable)
+	{
+		if (m_renderSettings.m_precompiledPassVariants == enable)
+			return;
 
-		m_renderGraph->SetPassEnabled("TAA", mode == AntiAliasingMode::TAA);
+		m_renderSettings.m_precompiledPassVariants = enable;
+		SetAntiAliasingMode(m_renderSettings.m_aaMode);
+		SetPassVariantActive("DepthReduction", m_renderSettings.m_cullingMode == CullingMode::FrustumAndOcclusion);
 	}
 
 	bool Renderer::CreateLightUniformBuffer()
@@ -201,7 +240,8 @@ namespace Engine::Rendering
 
 	void Renderer::UpdateFrameInfo()
 	{
-		const glm::vec2& size = m_window.GetSize();
+		// Passes before the upscale render at the extent the graph was built for.
+		const glm::vec2 size(m_renderGraph->GetRenderExtent());
 
 		FrameInfoUniformBuffer* frameInfo = m_frameInfoBufferData[m_currentFrame];
 		frameInfo->view = m_camera.GetView();
@@ -214,6 +254,7 @@ namespace Engine::Rendering
 
 	bool Renderer::Initialise()
 	{
+		m_renderThreadId = std::this_thread::get_id();
 		m_lastWindowSize = m_window.GetSize();
 		m_depthFormat = m_physicalDevice->FindDepthFormat();
 
@@ -287,14 +328,17 @@ namespace Engine::Rendering
 			return false;
 		}
 
-		m_renderPasses["SceneOpaque"] = std::make_unique<SceneOpaquePass>(*m_sceneGeometryBatch);
-		m_renderPasses["SceneShadow"] = std::make_unique<SceneShadowPass>(*m_sceneGeometryBatch, *m_shadowMap);
-		m_renderPasses["Combine"] = std::make_unique<CombinePass>(*m_shadowMap);
-
-		m_computePasses["FrustumCulling"] = std::make_unique<FrustumCullingPass>(*m_sceneGeometryBatch);
-		m_computePasses["ShadowCulling"] = std::make_unique<ShadowCullingPass>(*m_sceneGeometryBatch, *m_shadowMap);
+		m_computePasses["FrustumCulling"] = std::make_unique<FrustumCullingPass>(m_geometryBatches);
+		m_computePasses["ShadowCulling"] = std::make_unique<ShadowCullingPass>(m_geometryBatches, *m_shadowMap);
 		FrustumCullingPass& frustumCullingPass = reinterpret_cast<FrustumCullingPass&>(*m_computePasses["FrustumCulling"].get());
-		m_computePasses["DepthReduction"] = std::make_unique<DepthReductionPass>(frustumCullingPass);
+		ShadowCullingPass& shadowCullingPass = reinterpret_cast<ShadowCullingPass&>(*m_computePasses["ShadowCulling"].get());
+		m_computePasses["ClusterCulling"] = std::make_unique<ClusterCullingPass>(frustumCullingPass, m_geometryBatches);
+		ClusterCullingPass& clusterCullingPass = reinterpret_cast<ClusterCullingPass&>(*m_computePasses["ClusterCulling"].get());
+		m_computePasses["DepthReduction"] = std::make_unique<DepthReductionPass>(frustumCullingPass, clusterCullingPass);
+
+		m_renderPasses["SceneOpaque"] = std::make_unique<SceneOpaquePass>(frustumCullingPass, clusterCullingPass);
+		m_renderPasses["SceneShadow"] = std::make_unique<SceneShadowPass>(*m_shadowMap, shadowCullingPass);
+		m_renderPasses["Combine"] = std::make_unique<CombinePass>(*m_shadowMap);
 
 		for (const auto& pair : m_renderPasses)
 		{
@@ -305,11 +349,12 @@ namespace Engine::Rendering
 			}
 		}
 
-		for (const auto& pair : m_computePasses)
+		// Cluster culling passes frustum culling's output through, so the producer has to be added first whatever the map order.
+		for (const char* passName : { "FrustumCulling", "ShadowCulling", "ClusterCulling", "DepthReduction" })
 		{
-			if (!m_renderGraph->AddRenderNode(pair.second.get(), *m_materialManager))
+			if (!m_renderGraph->AddRenderNode(m_computePasses.at(passName).get(), *m_materialManager))
 			{
-				Logger::Error("Failed to add compute pass '{}' to render graph.", pair.first);
+				Logger::Error("Failed to add compute pass '{}' to render graph.", passName);
 				return false;
 			}
 		}
@@ -326,6 +371,11 @@ namespace Engine::Rendering
 
 		// Disable anti-aliasing passes that aren't active.
 		SetAntiAliasingMode(m_renderSettings.m_aaMode);
+		m_renderGraph->SetPassEnabled("Upscale", m_renderSettings.m_renderScale != 1.0f);
+
+		SetClusterCullingState(m_renderSettings.m_clusterCulling);
+		SetBoxCullingState(m_renderSettings.m_boxCulling);
+		SetParallelRecordingState(m_renderSettings.m_parallelRecording);
 
 		// Add UI pass after post processing.
 		m_renderPasses["UI"] = std::make_unique<UIPass>(*m_uiManager);
@@ -361,8 +411,13 @@ namespace Engine::Rendering
 
 		switch (rendererType)
 		{
+#ifdef ENGINE_VULKAN
 		case RendererType::Vulkan:
-			result = std::make_unique<VulkanRenderer>(window, debug);
+			result = std::make_unique<Vulkan::VulkanRenderer>(window, debug);
+			break;
+#endif
+		case RendererType::Null:
+			result = std::make_unique<Null::NullRenderer>(window, debug);
 			break;
 		default:
 			Logger::Error("Requested renderer type not supported.");
@@ -386,10 +441,39 @@ namespace Engine::Rendering
 	{
 		const std::unique_ptr<FrustumCullingPass>& frustumCullingPass = reinterpret_cast<const std::unique_ptr<FrustumCullingPass>&>(m_computePasses.at("FrustumCulling"));
 		const std::unique_ptr<ShadowCullingPass>& shadowCullingPass = reinterpret_cast<const std::unique_ptr<ShadowCullingPass>&>(m_computePasses.at("ShadowCulling"));
+		const std::unique_ptr<ClusterCullingPass>& clusterCullingPass = reinterpret_cast<const std::unique_ptr<ClusterCullingPass>&>(m_computePasses.at("ClusterCulling"));
 		frustumCullingPass->SetCullingMode(mode);
 		shadowCullingPass->SetCullingMode(mode);
+		clusterCullingPass->SetCullingMode(mode);
+
+		m_renderSettings.m_cullingMode = mode;
+		SetPassVariantActive("DepthReduction", mode == CullingMode::FrustumAndOcclusion);
+	}
+
+	void Renderer::SetClusterCullingState(bool enable)
+	{
+		m_renderSettings.m_clusterCulling = enable;
+		m_renderGraph->SetPassEnabled("ClusterCulling", enable);
+	}
 
-		m_renderGraph->SetPassEnabled("DepthReduction", mode == CullingMode::FrustumAndOcclusion);
+	void Renderer::SetBoxCullingState(bool enable)
+	{
+		m_renderSettings.m_boxCulling = enable;
+		const std::unique_ptr<FrustumCullingPass>& frustumCullingPass = reinterpret_cast<const std::unique_ptr<FrustumCullingPass>&>(m_computePasses.at("FrustumCulling"));
+		const std::unique_ptr<ShadowCullingPass>& shadowCullingPass = reinterpret_cast<const std::unique_ptr<ShadowCullingPass>&>(m_computePasses.at("ShadowCulling"));
+		frustumCullingPass->SetBoxCulling(enable);
+		shadowCullingPass->SetBoxCulling(enable);
+	}
+
+	void Renderer::SetParallelRecordingState(bool enable)
+	{
+		m_renderSettings.m_parallelRecording = enable;
+		m_renderGraph->SetParallelRecording(enable);
+	}
+
+	bool Renderer::DumpRenderGraphLayout(const std::string& filePath) const
+	{
+		return m_renderGraph->DumpLayout(filePath);
 	}
 
 	void Renderer::SetHDRState(bool enable)
@@ -419,10 +503,64 @@ namespace Engine::Rendering
 			combinePass->GetMaterial()->SetSpecialisationConstant("shadowsEnabled", static_cast<uint32_t>(resolution != 0 ? 1 : 0));
 		}
 
-		if (resolution != 0)
+		// Only a new resolution changes the shadow map's images, toggling it just adds or removes its passes.
+		RenderGraphChange change = RenderGraphChange::Passes;
+		if (resolution != 0 && m_shadowMap->GetExtent().x != resolution)
+		{
 			m_shadowMap->SetResolution(resolution);
+			change = RenderGraphChange::Resources;
+		}
+
+		m_renderGraph->MarkDirty(change);
+	}
 
-		m_renderGraph->MarkDirty();
+	GeometryBatch& Renderer::CreateGeometryBatch()
+	{
+		assert(std::this_thread::get_id() == m_renderThreadId);
+		m_geometryBatches.emplace_back(std::make_unique<GeometryBatch>(*this));
+		return *m_geometryBatches.back();
+	}
+
+	bool Renderer::DestroyGeometryBatch(GeometryBatch& geometryBatch)
+	{
+		assert(std::this_thread::get_id() == m_renderThreadId);
+		if (&geometryBatch == m_geometryBatches.front().get())
+		{
+			Logger::Error("The scene geometry batch cannot be destroyed.");
+			return false;
+		}
+
+		auto it = std::find_if(m_geometryBatches.begin(), m_geometryBatches.end(),
+			[&geometryBatch](const std::unique_ptr<GeometryBatch>& batch) { return batch.get() == &geometryBatch; });
+		if (it == m_geometryBatches.end())
+		{
+			Logger::Error("Geometry batch is not owned by this renderer.");
+			return false;
+		}
+
+		// Passes reference the batch's buffers until the graph is rebuilt, and frames in flight until they complete.
+		m_retiredGeometryBatches.emplace_back(std::move(*it), m_maxConcurrentFrames + 1);
+		m_geometryBatches.erase(it);
+		m_renderGraph->MarkDirty(RenderGraphChange::Resources);
+		return true;
+	}
+
+	void Renderer::ReleaseRetiredGeometryBatches()
+	{
+		for (auto it = m_retiredGeometryBatches.begin(); it != m_retiredGeometryBatches.end();)
+		{
+			if (it->second > 0)
+				--it->second;
+
+			if (it->second > 0 || it->first->HasPendingUploads())
+			{
+				it->first->ReleaseRetiredResources();
+				++it;
+				continue;
+			}
+
+			it = m_retiredGeometryBatches.erase(it);
+		}
 	}
 
 	bool Renderer::BeginFrame() const
@@ -444,12 +582,17 @@ namespace Engine::Rendering
 
 		UpdateFrameInfo();
 
+		for (const std::unique_ptr<GeometryBatch>& geometryBatch : m_geometryBatches)
+			geometryBatch->ReleaseRetiredResources();
+
+		ReleaseRetiredGeometryBatches();
+
 		bool drawUi = m_uiManager->GetDrawCallbackCount() > 0;
 		std::unique_ptr<IRenderPass>& uiPass = m_renderPasses["UI"];
 		if (uiPass->GetEnabled() != drawUi)
 		{
 			uiPass->SetEnabled(drawUi);
-			m_renderGraph->MarkDirty();
+			m_renderGraph->MarkDirty(RenderGraphChange::Passes);
 		}
 
 		// Update light buffer
@@ -473,9 +616,65 @@ namespace Engine::Rendering
 			return false;
 		}
 
+		UpdateRenderScale();
+
 		return true;
 	}
 
+	glm::uvec2 Renderer::GetRenderExtent() const
+	{
+		glm::vec2 extent = glm::vec2(m_swapChain->GetExtent()) * m_renderSettings.m_renderScale;
+		return glm::max(glm::uvec2(glm::round(extent)), glm::uvec2(1));
+	}
+
+	void Renderer::SetRenderScale(float scale)
+	{
+		m_renderScaleController.Reset(scale);
+		ApplyRenderScale(m_renderScaleController.GetScale());
+	}
+
+	void Renderer::SetDynamicResolutionState(bool enable)
+	{
+		m_renderSettings.m_dynamicResolution = enable;
+		m_renderScaleController.Reset(m_renderSettings.m_renderScale);
+		m_lastRenderTime = {};
+	}
+
+	void Renderer::ApplyRenderScale(float scale)
+	{
+		if (m_renderSettings.m_renderScale == scale)
+			return;
+
+		m_renderSettings.m_renderScale = scale;
+
+		// Only the graph images sized by the render extent are recreated at the next build, along with the passes bound
+		// to them. At full scale the scene already matches the swapchain and the upscale is left out.
+		m_renderGraph->SetPassEnabled("Upscale", scale != 1.0f);
+		m_renderGraph->MarkDirty(RenderGraphChange::RenderExtent);
+
+		glm::uvec2 renderExtent = GetRenderExtent();
+		m_postProcessing->Rebuild(renderExtent);
+
+		// The next frame stalls on the rebuild, it says nothing about the cost of the new scale.
+		m_lastRenderTime = {};
+
+		Logger::Verbose("Render scale set to {:.2f}, rendering at {}x{}.", scale, renderExtent.x, renderExtent.y);
+	}
+
+	void Renderer::UpdateRenderScale()
+	{
+		auto time = std::chrono::high_resolution_clock::now();
+		bool measured = m_lastRenderTime != std::chrono::high_resolution_clock::time_point();
+		float frameTime = std::chrono::duration<float, std::chrono::seconds::period>(time - m_lastRenderTime).count();
+		m_lastRenderTime = time;
+
+		if (!m_renderSettings.m_dynamicResolution || !measured)
+			return;
+
+		if (m_renderScaleController.Update(frameTime))
+			ApplyRenderScale(m_renderScaleController.GetScale());
+	}
+
 	void Renderer::SetMultiSampleCount(uint32_t multiSampleCount)
 	{
 		if (multiSampleCount > m_maxMultiSampleCount)
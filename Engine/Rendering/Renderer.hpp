@@ -12,8 +12,12 @@
 #include "ISwapChain.hpp"
 #include "RenderGraph.hpp"
 #include "RenderSettings.hpp"
+#include "RenderScaleController.hpp"
 #include "Resources/SubmitInfo.hpp"
 #include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
 #include "CullingMode.hpp"
 #include "AntiAliasingMode.hpp"
 #include "NvidiaReflex.hpp"
@@ -50,10 +54,12 @@ namespace Engine::Rendering
 	class IComputePass;
 	class IImageSampler;
 	class GeometryBatch;
+	class StagingRing;
 
 	enum class RendererType
 	{
-		Vulkan
+		Vulkan,
+		Null
 	};
 
 	class Renderer
@@ -62,13 +68,16 @@ namespace Engine::Rendering
 		EXPORT static std::unique_ptr<Renderer> Create(RendererType rendererType, Engine::OS::Window& window, bool debug);
 		EXPORT virtual ~Renderer();
 
-		inline virtual bool Initialise();
+		EXPORT virtual bool Initialise();
 		EXPORT bool BeginFrame() const;
-		inline virtual bool Render();
+		EXPORT virtual bool Render();
 		inline const std::unordered_map<std::string, FrameStats>& GetRenderStats() const { return m_renderStats->GetFrameStats(); }
 		inline const MemoryStats& GetMemoryStats() const { return m_renderStats->GetMemoryStats(); }
 		inline RenderGraph& GetRenderGraph() const { return *m_renderGraph; }
 
+		// Writes the layout of the last built render graph as text, so layouts from before and after a change can be compared.
+		EXPORT bool DumpRenderGraphLayout(const std::string& filePath) const;
+
 		inline void SetClearColour(const Colour& clearColour) { m_clearColour = clearColour.GetVec4(); }
 		inline const Colour GetClearColor() const { return Colour(m_clearColour); }
 
@@ -78,9 +87,33 @@ namespace Engine::Rendering
 		EXPORT void SetDebugMode(uint32_t mode);
 		inline uint32_t GetDebugMode() const { return m_debugMode; }
 
-		inline NvidiaReflex& NvidiaReflex() const { return *m_nvidiaReflex; }
+		inline Engine::Rendering::NvidiaReflex& NvidiaReflex() const { return *m_nvidiaReflex; }
 
 		EXPORT void SetCullingMode(CullingMode mode);
+		inline CullingMode GetCullingMode() const { return m_renderSettings.m_cullingMode; }
+
+		EXPORT void SetClusterCullingState(bool enable);
+		inline bool GetClusterCullingState() const { return m_renderSettings.m_clusterCulling; }
+
+		// Tests the oriented bounding box after the sphere, rejecting more meshes at a small extra cost per mesh.
+		EXPORT void SetBoxCullingState(bool enable);
+		inline bool GetBoxCullingState() const { return m_renderSettings.m_boxCulling; }
+		EXPORT void SetParallelRecordingState(bool enable);
+		inline bool GetParallelRecordingState() const { return m_renderSettings.m_parallelRecording; }
+
+		// Keeps the passes of every anti-aliasing and culling mode in the render graph and bypasses those not in use,
+		// so switching modes costs no rebuild at the price of the unused passes' memory.
+		EXPORT void SetPrecompiledPassVariantsState(bool enable);
+		inline bool GetPrecompiledPassVariantsState() const { return m_renderSettings.m_precompiledPassVariants; }
+
+		// Applies to scenes loaded afterwards, cached scenes with a different vertex layout are rebuilt.
+		inline void SetVertexQuantisationState(bool enable) { m_renderSettings.m_quantisedVertices = enable; }
+		inline bool GetVertexQuantisationState() const { return m_renderSettings.m_quantisedVertices; }
+
+		// Records initial batch uploads on a dedicated transfer queue where the device has one. Off by default until the
+		// queue ownership transfers have been verified on hardware, applies to uploads submitted afterwards.
+		inline void SetTransferQueueUploadState(bool enable) { m_renderSettings.m_transferQueueUploads = enable; }
+		inline bool GetTransferQueueUploadState() const { return m_renderSettings.m_transferQueueUploads; }
 
 		inline virtual void SetMultiSampleCount(uint32_t multiSampleCount);;
 		inline uint32_t GetMaxMultiSampleCount() const { return m_maxMultiSampleCount; }
@@ -99,6 +132,16 @@ namespace Engine::Rendering
 
 		EXPORT void SetShadowResolution(uint32_t resolution);
 
+		// The scene renders at this fraction of the swapchain extent and is upscaled before the UI is drawn.
+		EXPORT void SetRenderScale(float scale);
+		inline float GetRenderScale() const { return m_renderSettings.m_renderScale; }
+		EXPORT glm::uvec2 GetRenderExtent() const;
+
+		// Adjusts the render scale from measured frame times to hold the controller's target frame time.
+		EXPORT void SetDynamicResolutionState(bool enable);
+		inline bool GetDynamicResolutionState() const { return m_renderSettings.m_dynamicResolution; }
+		inline RenderScaleController& GetRenderScaleController() { return m_renderScaleController; }
+
 		inline const ShadowMap& GetShadowMap() const { return *m_shadowMap; }
 
 		inline void SetCamera(const Camera& camera) { m_camera = camera; }
@@ -125,14 +168,29 @@ namespace Engine::Rendering
 		inline const IImageSampler& GetShadowSampler() const { return *m_shadowSampler; }
 		inline const IImageSampler& GetReductionSampler() const { return *m_reductionSampler; }
 
-		inline GeometryBatch& GetSceneGeometryBatch() const { return *m_sceneGeometryBatch; }
+		inline GeometryBatch& GetSceneGeometryBatch() const { return *m_geometryBatches.front(); }
+		inline const std::vector<std::unique_ptr<GeometryBatch>>& GetGeometryBatches() const { return m_geometryBatches; }
+
+		// Additional batches let independently streamed content load and unload without rebuilding the scene batch.
+		// Both calls must be made on the thread that renders, between frames, as passes walk the batches while recording.
+		EXPORT GeometryBatch& CreateGeometryBatch();
+		// Removes the batch from rendering immediately, it is destroyed once in flight frames and uploads no longer reference it.
+		EXPORT bool DestroyGeometryBatch(GeometryBatch& geometryBatch);
+
+		// Every geometry batch stages its uploads through this ring. Resource commands record one at a time, but completed
+		// uploads release their space from the render thread, so the ring is only touched while holding the mutex.
+		inline StagingRing& GetGeometryStagingRing() const { return *m_geometryStagingRing; }
+		inline std::mutex& GetGeometryStagingMutex() { return m_geometryStagingMutex; }
 
 		inline IRenderImage& GetBlankImage() const { return *m_blankImage; }
 		inline IRenderImage& GetBlankShadowImage() const { return *m_blankShadowImage; }
 
+		// Transfer commands are recorded on the dedicated transfer queue when the device has one. They may only touch
+		// resources nothing else is using yet, and must release them to the graphics queue while recording the matching
+		// acquire on the second command buffer. Otherwise, and on devices without one, both command buffers are the same.
 		virtual bool SubmitResourceCommand(std::function<bool(const IDevice& device, const IPhysicalDevice& physicalDevice,
-			const ICommandBuffer&, std::vector<std::unique_ptr<IBuffer>>&)> command,
-			std::optional<std::function<void()>> postAction = std::nullopt) = 0;
+			const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, std::vector<std::unique_ptr<IBuffer>>&)> command,
+			std::optional<std::function<void()>> postAction = std::nullopt, bool transfer = false) = 0;
 
 		virtual IRenderImage& GetPresentImage() const = 0;
 
@@ -145,6 +203,14 @@ namespace Engine::Rendering
 		bool CreateLightUniformBuffer();
 		void UpdateFrameInfo();
 
+		void ReleaseRetiredGeometryBatches();
+
+		void SetPassVariantActive(const std::string& passName, bool active);
+
+		void ApplyRenderScale(float scale);
+
+		void UpdateRenderScale();
+
 		void OnWindowPrePoll();
 		void OnWindowPostPoll();
 
@@ -164,6 +230,8 @@ namespace Engine::Rendering
 		glm::vec4 m_clearColour;
 		Format m_depthFormat;
 		RenderSettings m_renderSettings;
+		RenderScaleController m_renderScaleController;
+		std::chrono::high_resolution_clock::time_point m_lastRenderTime;
 		bool m_asyncComputeSupported;
 		bool m_asyncComputeEnabled;
 		bool m_asyncComputePendingState;
@@ -184,7 +252,11 @@ namespace Engine::Rendering
 		std::unique_ptr<Engine::Rendering::NvidiaReflex> m_nvidiaReflex;
 
 		std::unique_ptr<SceneManager> m_sceneManager;
-		std::unique_ptr<GeometryBatch> m_sceneGeometryBatch;
+		std::vector<std::unique_ptr<GeometryBatch>> m_geometryBatches;
+		std::vector<std::pair<std::unique_ptr<GeometryBatch>, uint32_t>> m_retiredGeometryBatches;
+		std::unique_ptr<StagingRing> m_geometryStagingRing;
+		std::mutex m_geometryStagingMutex;
+		std::thread::id m_renderThreadId;
 		std::unique_ptr<IResourceFactory> m_resourceFactory;
 		std::unique_ptr<ShadowMap> m_shadowMap;
 		std::unique_ptr<PostProcessing> m_postProcessing;
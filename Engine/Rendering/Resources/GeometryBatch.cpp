@@ -8,46 +8,160 @@
 #include "../Resources/MeshInfo.hpp"
 #include "../Resources/IMemoryBarriers.hpp"
 #include "Core/MeshOptimiser.hpp"
+#include "Core/MeshOptimiserArena.hpp"
+#include "Core/VertexQuantiser.hpp"
+#include "Core/BoundingVolume.hpp"
 #include "Core/Image.hpp"
 #include "../Renderer.hpp"
 #include "../Resources/RenderMeshInfo.hpp"
+#include "../Resources/RenderMeshLODInfo.hpp"
+#include "../Resources/RenderMeshCluster.hpp"
+#include "../Resources/RenderMeshBounds.hpp"
 #include "Core/Logger.hpp"
 #include "Core/ChunkData.hpp"
 #include "Core/AsyncData.hpp"
 #include "Core/VertexData.hpp"
 #include "Core/Colour.hpp"
 #include <execution>
+#include <mutex>
+#include <numeric>
 
 namespace Engine::Rendering
 {
+	// Mantissa bits kept by the exponent filter when caching vertex streams, texture coordinates are stored losslessly.
+	constexpr int32_t PositionFilterBits = 22;
+	constexpr int32_t NormalFilterBits = 16;
+
+	// Compact vertex layout: 16-bit positions relative to the mesh bounds, half float UVs, octahedral normals and 8-bit
+	// snorm tangents.
+	constexpr uint32_t QuantisedElementSizes[4] = { sizeof(QuantisedPosition), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t) };
+
+	// Which per mesh records need rewriting on the next flush, material changes only touch the mesh info.
+	constexpr uint8_t MeshDirtyMaterial = 1;
+	constexpr uint8_t MeshDirtyTransform = 2;
+	constexpr uint8_t MeshDirtyAll = 0xFF;
+
+	// Satisfies the texel block size of every image format the batch uploads.
+	constexpr uint64_t ImageStagingAlignment = 16;
+
+	bool IsBlockCompressed(Format format)
+	{
+		return format == Format::Bc5UnormBlock || format == Format::Bc7SrgbBlock || format == Format::Bc7UnormBlock;
+	}
+
+	bool GetImageFormat(const Image& image, Format& format)
+	{
+		if (image.IsNormalMap() || image.IsMetallicRoughnessMap())
+		{
+			format = image.IsCompressed() ? Format::Bc5UnormBlock : Format::R8G8B8A8Unorm;
+		}
+		else if (image.GetComponentCount() == 4)
+		{
+			bool srgb = image.IsSRGB();
+			if (image.IsCompressed())
+			{
+				format = srgb ? Format::Bc7SrgbBlock : Format::Bc7UnormBlock;
+			}
+			else
+			{
+				format = srgb ? Format::R8G8B8A8Srgb : Format::R8G8B8A8Unorm;
+			}
+		}
+		else
+		{
+			Logger::Error("Images without exactly 4 channels are currently not supported.");
+			return false;
+		}
+
+		return true;
+	}
+
+	// Uploads recorded on the transfer queue release the image there and acquire it on the graphics queue.
+	void TransitionForSampling(IRenderImage& image, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer,
+		IMemoryBarriers& memoryBarriers)
+	{
+		uint32_t srcQueueFamily = commandBuffer.GetQueueFamilyIndex();
+		uint32_t dstQueueFamily = acquireCommandBuffer.GetQueueFamilyIndex();
+
+		memoryBarriers.Clear();
+		image.AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, memoryBarriers, srcQueueFamily, dstQueueFamily);
+		commandBuffer.MemoryBarrier(memoryBarriers);
+
+		if (srcQueueFamily == dstQueueFamily)
+			return;
+
+		memoryBarriers.Clear();
+		image.AppendImageLayoutTransition(acquireCommandBuffer, ImageLayout::ShaderReadOnly, memoryBarriers, srcQueueFamily, dstQueueFamily);
+		acquireCommandBuffer.MemoryBarrier(memoryBarriers);
+	}
+
 	GeometryBatch::GeometryBatch(Renderer& renderer)
 		: m_renderer(renderer)
-		, m_indirectDrawBuffer(nullptr)
+		, m_indirectDrawBuffer("indirectBuffer", BufferUsageFlags::IndirectBuffer | BufferUsageFlags::StorageBuffer,
+			MaterialStageFlags::DrawIndirect | MaterialStageFlags::ComputeShader, MaterialAccessFlags::IndirectCommandRead | MaterialAccessFlags::ShaderRead, true)
 		, m_vertexBuffers()
-		, m_indexBuffer(nullptr)
-		, m_boundsBuffer(nullptr)
-		, m_meshInfoBuffer(nullptr)
+		, m_vertexBufferViews()
+		, m_indexBuffer("indexBuffer", BufferUsageFlags::IndexBuffer, MaterialStageFlags::VertexInput, MaterialAccessFlags::IndexRead, false)
+		, m_boundsBuffer("boundsBuffer", BufferUsageFlags::StorageBuffer, MaterialStageFlags::ComputeShader, MaterialAccessFlags::ShaderRead, true)
+		, m_meshInfoBuffer("meshInfoBuffer", BufferUsageFlags::StorageBuffer, MaterialStageFlags::VertexShader, MaterialAccessFlags::ShaderRead, true)
+		, m_lodBuffer("lodBuffer", BufferUsageFlags::StorageBuffer, MaterialStageFlags::ComputeShader, MaterialAccessFlags::ShaderRead, true)
+		, m_clusterBuffer("clusterBuffer", BufferUsageFlags::StorageBuffer, MaterialStageFlags::ComputeShader, MaterialAccessFlags::ShaderRead, true)
 		, m_imageArray()
 		, m_vertexOffsets()
 		, m_indexOffsets()
 		, m_indexCounts()
+		, m_vertexStrides()
+		, m_vertexAllocator()
+		, m_indexAllocator()
+		, m_clusterAllocator()
 		, m_recycledIds()
 		, m_active()
+		, m_bakedMeshes()
+		, m_meshClusterRanges()
+		, m_dirtyMeshes()
+		, m_meshDirtyFlags()
+		, m_clearedClusterRanges()
 		, m_creating(true)
+		, m_pendingUploads(0)
 		, m_meshCapacity(0)
+		, m_slotCapacity(0)
+		, m_uploadedImageCount(0)
+		, m_optimisePending(false)
+		, m_quantisedVertices(false)
+		, m_retiredMutex()
+		, m_pendingFrees()
+		, m_retiredResources()
+		, m_recycledVertexData()
+		, m_recycledIndexData()
+		, m_recycledMeshDetails()
 		, m_vertexDataArrays()
 		, m_indexArrays()
+		, m_vertexReferenceCounts()
+		, m_indexReferenceCounts()
+		, m_vertexDataHashes()
+		, m_indexDataHashes()
+		, m_vertexDataUploaded()
+		, m_indexDataUploaded()
+		, m_vertexBounds()
+		, m_positionOffsets()
+		, m_positionScales()
+		, m_meshDetails()
 		, m_meshInfos()
 		, m_images()
-		, m_vertexBufferOffsets()
-		, m_indexBufferOffsets()
 		, m_imageHashTable()
 		, m_vertexDataHashTable()
 		, m_indexDataHashTable()
-		, m_indirectDrawCommands()
+		, m_vertexDataMirrored()
+		, m_deduplicationRequests(0)
+		, m_vertexDataHits(0)
+		, m_indexDataHits(0)
+		, m_hashCollisions(0)
+		, m_meshDetailHashTable()
 	{
 	}
 
+	GeometryBatch::~GeometryBatch() = default;
+
 	bool GeometryBatch::CreateMesh(const std::vector<VertexData>& vertexData,
 		const std::vector<uint32_t>& indices,
 		const glm::mat4& transform,
@@ -55,11 +169,12 @@ namespace Engine::Rendering
 		std::shared_ptr<Image> diffuseImage,
 		std::shared_ptr<Image> normalImage,
 		std::shared_ptr<Image> metallicRoughnessImage,
-		bool convertToLHS)
+		bool convertToLHS,
+		uint32_t* meshId)
 	{
-		if (vertexData.empty())
+		if (vertexData.empty() || vertexData[0].GetCount() == 0 || indices.empty())
 		{
-			Logger::Error("Empty vertex buffer vector not permitted.");
+			Logger::Error("Empty vertex or index data not permitted.");
 			return false;
 		}
 
@@ -69,42 +184,110 @@ namespace Engine::Rendering
 			id = m_recycledIds.top();
 			m_recycledIds.pop();
 			m_active[id] = true;
+			m_meshInfos[id] = {};
 		}
 		else
 		{
 			m_meshInfos.push_back({});
 			m_active.push_back(true);
+			m_bakedMeshes.push_back(false);
+			m_meshClusterRanges.push_back({ 0, 0 });
+			m_meshDirtyFlags.push_back(0);
 			id = m_meshCapacity++;
 		}
 
+		MarkMeshDirty(id, MeshDirtyAll);
+		if (meshId != nullptr)
+			*meshId = id;
+
 		MeshInfo& meshInfo = m_meshInfos[id];
 		meshInfo.transform = transform;
 		meshInfo.colour = colour;
 
+		++m_deduplicationRequests;
+
 		uint64_t indexHash = Hash::CalculateHash(indices.data(), indices.size() * sizeof(uint32_t));
-		const auto& indexResult = m_indexDataHashTable.find(indexHash);
-		if (indexResult != m_indexDataHashTable.cend())
+		size_t indexBufferIndex;
+		if (FindIndexData(indexHash, indices, indexBufferIndex))
 		{
-			meshInfo.indexBufferIndex = indexResult->second;
+			meshInfo.indexBufferIndex = indexBufferIndex;
+			++m_indexReferenceCounts[indexBufferIndex];
+			++m_indexDataHits;
 		}
 		else
 		{
-			m_indexDataHashTable[indexHash] = m_indexArrays.size();
-			meshInfo.indexBufferIndex = m_indexArrays.size();
-			m_indexArrays.emplace_back(std::make_unique<std::vector<uint32_t>>(indices));
+			if (m_recycledIndexData.empty())
+			{
+				indexBufferIndex = m_indexArrays.size();
+				m_indexArrays.emplace_back();
+				m_indexReferenceCounts.push_back(0);
+				m_indexDataHashes.push_back(0);
+				m_indexDataUploaded.push_back(false);
+				m_indexOffsets.push_back(0);
+				m_indexCounts.push_back(0);
+			}
+			else
+			{
+				indexBufferIndex = m_recycledIndexData.top();
+				m_recycledIndexData.pop();
+			}
+
+			m_indexDataHashTable.emplace(indexHash, indexBufferIndex);
+			meshInfo.indexBufferIndex = indexBufferIndex;
+			m_indexArrays[indexBufferIndex] = std::make_unique<std::vector<uint32_t>>(indices);
+			m_indexReferenceCounts[indexBufferIndex] = 1;
+			m_indexDataHashes[indexBufferIndex] = indexHash;
+			m_indexDataUploaded[indexBufferIndex] = false;
+			m_indexOffsets[indexBufferIndex] = 0;
+			m_indexCounts[indexBufferIndex] = 0;
 		}
 
-		uint64_t vertexHash = vertexData[0].GetHash(); // Only hash the first vertex buffer to keep things simple.
+		// Each stream caches its hash on construction, so combining them is cheap even for repeated instances.
+		uint64_t vertexHash = Hash::CombineHash(0, convertToLHS ? 1 : 0);
+		for (const VertexData& stream : vertexData)
+		{
+			vertexHash = Hash::CombineHash(vertexHash, stream.GetHash());
+			vertexHash = Hash::CombineHash(vertexHash, (static_cast<uint64_t>(stream.GetElementSize()) << 32) | stream.GetCount());
+		}
 
-		const auto& vertexResult = m_vertexDataHashTable.find(vertexHash);
-		if (vertexResult != m_vertexDataHashTable.cend())
+		size_t vertexBufferIndex;
+		if (FindVertexData(vertexHash, vertexData, convertToLHS, vertexBufferIndex))
 		{
-			meshInfo.vertexBufferIndex = vertexResult->second;
+			meshInfo.vertexBufferIndex = vertexBufferIndex;
+			++m_vertexReferenceCounts[vertexBufferIndex];
+			++m_vertexDataHits;
 		}
 		else
 		{
-			m_vertexDataHashTable[vertexHash] = m_vertexDataArrays.size();
-			meshInfo.vertexBufferIndex = m_vertexDataArrays.size();
+			if (m_recycledVertexData.empty())
+			{
+				vertexBufferIndex = m_vertexDataArrays.size();
+				m_vertexDataArrays.emplace_back();
+				m_vertexDataMirrored.push_back(false);
+				m_vertexReferenceCounts.push_back(0);
+				m_vertexDataHashes.push_back(0);
+				m_vertexDataUploaded.push_back(false);
+				m_vertexOffsets.push_back(0);
+				m_vertexBounds.push_back({});
+				m_positionOffsets.push_back(glm::vec3(0.0f));
+				m_positionScales.push_back(glm::vec3(1.0f));
+			}
+			else
+			{
+				vertexBufferIndex = m_recycledVertexData.top();
+				m_recycledVertexData.pop();
+			}
+
+			m_vertexDataHashTable.emplace(vertexHash, vertexBufferIndex);
+			m_vertexDataMirrored[vertexBufferIndex] = convertToLHS;
+			m_vertexReferenceCounts[vertexBufferIndex] = 1;
+			m_vertexDataHashes[vertexBufferIndex] = vertexHash;
+			m_vertexDataUploaded[vertexBufferIndex] = false;
+			m_vertexOffsets[vertexBufferIndex] = 0;
+			m_vertexBounds[vertexBufferIndex] = {};
+			m_positionOffsets[vertexBufferIndex] = glm::vec3(0.0f);
+			m_positionScales[vertexBufferIndex] = glm::vec3(1.0f);
+			meshInfo.vertexBufferIndex = vertexBufferIndex;
 
 			std::vector<std::unique_ptr<VertexData>> localVertexData;
 			localVertexData.reserve(vertexData.size() + 2);
@@ -129,582 +312,1238 @@ namespace Engine::Rendering
 				}
 			}
 
-			m_vertexDataArrays.push_back(std::move(localVertexData));
+			m_vertexDataArrays[vertexBufferIndex] = std::move(localVertexData);
 		}
 
-		if (diffuseImage.get() != nullptr)
+		// LODs and clusters depend on both the index and vertex data, so they are shared per unique pair.
+		uint64_t meshDetailKey = (static_cast<uint64_t>(meshInfo.indexBufferIndex) << 32) | static_cast<uint64_t>(meshInfo.vertexBufferIndex);
+		const auto& meshDetailResult = m_meshDetailHashTable.find(meshDetailKey);
+		if (meshDetailResult != m_meshDetailHashTable.cend())
 		{
-			uint64_t imageHash = diffuseImage->GetHash();
-			const auto& imageResult = m_imageHashTable.find(imageHash);
-			if (imageResult != m_imageHashTable.cend())
-			{
-				meshInfo.diffuseImageIndex = imageResult->second;
-			}
-			else
-			{
-				m_imageHashTable[imageHash] = m_images.size();
-				meshInfo.diffuseImageIndex = m_images.size();
-				m_images.emplace_back(diffuseImage);
-			}
+			meshInfo.meshDetailIndex = meshDetailResult->second;
+			++m_meshDetails[meshInfo.meshDetailIndex].referenceCount;
 		}
-
-		if (normalImage.get() != nullptr)
+		else
 		{
-			uint64_t imageHash = normalImage->GetHash();
-			const auto& imageResult = m_imageHashTable.find(imageHash);
-			if (imageResult != m_imageHashTable.cend())
+			size_t meshDetailIndex;
+			if (m_recycledMeshDetails.empty())
 			{
-				meshInfo.normalImageIndex = imageResult->second;
+				meshDetailIndex = m_meshDetails.size();
+				m_meshDetails.emplace_back();
 			}
 			else
 			{
-				m_imageHashTable[imageHash] = m_images.size();
-				meshInfo.normalImageIndex = m_images.size();
-				m_images.emplace_back(normalImage);
+				meshDetailIndex = m_recycledMeshDetails.top();
+				m_recycledMeshDetails.pop();
 			}
-		}
 
-		if (metallicRoughnessImage.get() != nullptr)
-		{
-			uint64_t imageHash = metallicRoughnessImage->GetHash();
-			const auto& imageResult = m_imageHashTable.find(imageHash);
-			if (imageResult != m_imageHashTable.cend())
-			{
-				meshInfo.metallicRoughnessImageIndex = imageResult->second;
-			}
-			else
-			{
-				m_imageHashTable[imageHash] = m_images.size();
-				meshInfo.metallicRoughnessImageIndex = m_images.size();
-				m_images.emplace_back(metallicRoughnessImage);
-			}
+			m_meshDetailHashTable[meshDetailKey] = meshDetailIndex;
+			meshInfo.meshDetailIndex = meshDetailIndex;
+
+			MeshDetail& meshDetail = m_meshDetails[meshDetailIndex];
+			meshDetail.indexBufferIndex = meshInfo.indexBufferIndex;
+			meshDetail.vertexBufferIndex = meshInfo.vertexBufferIndex;
+			meshDetail.clusterIndexOffset = 0;
+			meshDetail.indexAllocation = FreeListAllocator::InvalidOffset;
+			meshDetail.referenceCount = 1;
+			meshDetail.mirrored = convertToLHS;
+			meshDetail.generated = false;
+			meshDetail.uploaded = false;
+			m_optimisePending = true;
 		}
 
-		return true;
-	}
+		AddImage(diffuseImage, meshInfo.diffuseImageIndex);
+		AddImage(normalImage, meshInfo.normalImageIndex);
+		AddImage(metallicRoughnessImage, meshInfo.metallicRoughnessImageIndex);
 
-	bool GeometryBatch::Optimise()
-	{
-		std::vector<uint32_t>& indices = *m_indexArrays.back();
-		std::vector<std::unique_ptr<VertexData>>& vertexDataArray = m_vertexDataArrays.back();
-		return MeshOptimiser::Optimise(indices, vertexDataArray);
+		return true;
 	}
 
-	bool GeometryBatch::UploadIndirectDrawBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-		std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, uint32_t drawCount, size_t dataSize)
+	bool GeometryBatch::FindIndexData(uint64_t hash, const std::vector<uint32_t>& indices, size_t& indexBufferIndex)
 	{
-		// Draw count is stored in the first 4 bytes.
-		size_t totalSize = sizeof(uint32_t) + dataSize;
-
-		bool initialised = buffer->Initialise("indirectBuffer", device, totalSize,
-			BufferUsageFlags::TransferDst | BufferUsageFlags::IndirectBuffer | BufferUsageFlags::StorageBuffer,
-			MemoryUsage::AutoPreferDevice,
-			AllocationCreateFlags::None,
-			SharingMode::Exclusive);
-
-		if (!initialised)
+		auto range = m_indexDataHashTable.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
 		{
-			return false;
-		}
+			// Matching hashes are confirmed by comparing contents so a collision can never alias two meshes.
+			if (*m_indexArrays[it->second] == indices)
+			{
+				indexBufferIndex = it->second;
+				return true;
+			}
 
-		IBuffer* stagingBuffer = temporaryBuffers.emplace_back(std::move(resourceFactory.CreateBuffer())).get();
-		if (!stagingBuffer->Initialise("indirectStagingBuffer", device, totalSize,
-			BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
-			AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
-			SharingMode::Exclusive))
-		{
-			return false;
+			++m_hashCollisions;
 		}
 
-		// Upload draw count.
-		if (!stagingBuffer->UpdateContents(&drawCount, 0, sizeof(uint32_t)))
-			return false;
-
-		// Upload actual indirect commands.
-		if (!stagingBuffer->UpdateContents(data, sizeof(uint32_t), dataSize))
-			return false;
+		return false;
+	}
 
-		stagingBuffer->Copy(commandBuffer, *buffer, totalSize);
+	bool GeometryBatch::FindVertexData(uint64_t hash, const std::vector<VertexData>& vertexData, bool convertToLHS, size_t& vertexBufferIndex)
+	{
+		auto range = m_vertexDataHashTable.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (m_vertexDataMirrored[it->second] == convertToLHS && VertexDataMatches(m_vertexDataArrays[it->second], vertexData, convertToLHS))
+			{
+				vertexBufferIndex = it->second;
+				return true;
+			}
 
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-			MaterialStageFlags::DrawIndirect, MaterialAccessFlags::IndirectCommandRead);
+			++m_hashCollisions;
+		}
 
-		return true;
+		return false;
 	}
 
-	bool GeometryBatch::SetupIndirectDrawBuffer(const IDevice& device, const ICommandBuffer& commandBuffer,
-		ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory)
+	bool GeometryBatch::VertexDataMatches(const std::vector<std::unique_ptr<VertexData>>& stored, const std::vector<VertexData>& vertexData, bool convertToLHS)
 	{
-		if (chunkData != nullptr && chunkData->LoadedFromDisk())
+		if (stored.size() != vertexData.size())
+			return false;
+
+		for (size_t i = 0; i < vertexData.size(); ++i)
 		{
-			ChunkMemoryEntry entry;
-			if (!chunkData->GetGenericData(static_cast<uint32_t>(CachedDataType::IndirectDrawBuffer), entry))
-			{
+			const VertexData& storedStream = *stored[i];
+			const VertexData& stream = vertexData[i];
+			if (storedStream.GetElementSize() != stream.GetElementSize() || storedStream.GetCount() != stream.GetCount())
 				return false;
-			}
-
-			std::vector<uint8_t> decompressBuffer;
-			chunkData->Decompress(entry, decompressBuffer);
 
-			m_indirectDrawBuffer = std::move(resourceFactory.CreateBuffer());
+			// Stored positions have already been mirrored, so compare against the mirrored input.
+			if (i == 0 && convertToLHS)
+			{
+				const glm::vec3* storedPositions = storedStream.GetData<glm::vec3>();
+				const glm::vec3* positions = stream.GetData<glm::vec3>();
+				for (uint32_t j = 0; j < stream.GetCount(); ++j)
+				{
+					const glm::vec3& v = positions[j];
+					if (storedPositions[j] != glm::vec3(-v.x, v.y, v.z))
+						return false;
+				}
 
-			m_meshCapacity = static_cast<uint32_t>(decompressBuffer.size() / sizeof(IndexedIndirectCommand));
+				continue;
+			}
 
-			return UploadIndirectDrawBuffer(device, commandBuffer, resourceFactory, temporaryBuffers, m_indirectDrawBuffer.get(),
-				decompressBuffer.data(), m_meshCapacity, decompressBuffer.size());
+			size_t byteCount = static_cast<size_t>(stream.GetCount()) * stream.GetElementSize();
+			if (memcmp(storedStream.GetData<uint8_t>(), stream.GetData<uint8_t>(), byteCount) != 0)
+				return false;
 		}
 
-		std::vector<IndexedIndirectCommand> indirectBufferData;
-		indirectBufferData.reserve(m_meshCapacity);
+		return true;
+	}
 
-		for (size_t i = 0; i < m_meshCapacity; ++i)
+	bool GeometryBatch::DestroyMesh(uint32_t meshId)
+	{
+		if (meshId >= m_meshCapacity || !m_active[meshId])
 		{
-			if (!m_active[i])
-				continue;
-
-			const MeshInfo& meshInfo = m_meshInfos[i];
-			IndexedIndirectCommand indirectCommand{};
-			indirectCommand.VertexOffset = m_vertexOffsets[meshInfo.vertexBufferIndex];
-			indirectCommand.FirstIndex = m_indexOffsets[meshInfo.indexBufferIndex];
-			indirectCommand.IndexCount = m_indexCounts[meshInfo.indexBufferIndex];
-			indirectCommand.InstanceCount = 1;
-			indirectBufferData.emplace_back(indirectCommand);
+			Logger::Error("Mesh {} does not exist and cannot be destroyed.", meshId);
+			return false;
 		}
 
-		m_indirectDrawBuffer = std::move(resourceFactory.CreateBuffer());
+		m_active[meshId] = false;
+		MarkMeshDirty(meshId, MeshDirtyAll);
 
-		size_t totalSize = indirectBufferData.size() * sizeof(IndexedIndirectCommand);
+		// Meshes restored from the scene cache share baked buffer regions and have no clusters of their own to clear,
+		// so their slot is emptied but the id is not reused as clusters may still reference it.
+		if (m_bakedMeshes[meshId])
+			return true;
 
-		if (!UploadIndirectDrawBuffer(device, commandBuffer, resourceFactory, temporaryBuffers, m_indirectDrawBuffer.get(),
-			indirectBufferData.data(), m_meshCapacity, totalSize))
-			return false;
+		const MeshInfo& meshInfo = m_meshInfos[meshId];
+		ReleaseMeshDetail(meshInfo.meshDetailIndex);
+		ReleaseIndexData(meshInfo.indexBufferIndex);
+		ReleaseVertexData(meshInfo.vertexBufferIndex);
 
-		if (chunkData)
+		std::pair<uint64_t, uint32_t>& clusterRange = m_meshClusterRanges[meshId];
+		if (clusterRange.second > 0)
 		{
-			std::span<uint8_t> cacheData(reinterpret_cast<uint8_t*>(indirectBufferData.data()), totalSize);
-			chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::IndirectDrawBuffer), cacheData);
+			m_clearedClusterRanges.push_back(clusterRange);
+			RetireAllocation(m_clusterAllocator, clusterRange.first);
+			clusterRange = { 0, 0 };
 		}
 
+		m_recycledIds.push(meshId);
 		return true;
 	}
 
-	bool GeometryBatch::SetupVertexBuffers(const IDevice& device, const ICommandBuffer& commandBuffer,
-		ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory)
+	bool GeometryBatch::SetMeshTransform(uint32_t meshId, const glm::mat4& transform)
 	{
-		if (chunkData != nullptr && chunkData->LoadedFromDisk())
-		{
-			std::array<ChunkMemoryEntry, 3> cacheEntries;
-			if (!chunkData->GetVertexData(VertexBufferType::Positions, cacheEntries[0]))
-				return false;
-			if (!chunkData->GetVertexData(VertexBufferType::TextureCoordinates, cacheEntries[1]))
-				return false;
-			if (!chunkData->GetVertexData(VertexBufferType::Normals, cacheEntries[2]))
-				return false;
-
-			std::vector<uint8_t> decompressBuffer;
-			m_vertexBuffers.resize(cacheEntries.size());
-			for (size_t i = 0; i < cacheEntries.size(); ++i)
-			{
-				m_vertexBuffers[i] = std::move(resourceFactory.CreateBuffer());
-				IBuffer* buffer = m_vertexBuffers[i].get();
+		if (!IsMeshMutable(meshId))
+			return false;
 
-				chunkData->Decompress(cacheEntries[i], decompressBuffer);
-				const std::span<const uint8_t> span(decompressBuffer.begin(), cacheEntries[i].UncompressedSize);
+		m_meshInfos[meshId].transform = transform;
+		MarkMeshDirty(meshId, MeshDirtyTransform);
+		return true;
+	}
 
-				bool initialised = buffer->Initialise("vertexBuffer", device, span.size(),
-					BufferUsageFlags::TransferDst | BufferUsageFlags::VertexBuffer,
-					MemoryUsage::AutoPreferDevice,
-					AllocationCreateFlags::None,
-					SharingMode::Exclusive);
+	bool GeometryBatch::SetMeshColour(uint32_t meshId, const Colour& colour)
+	{
+		if (!IsMeshMutable(meshId))
+			return false;
 
-				if (!initialised)
-				{
-					return false;
-				}
+		m_meshInfos[meshId].colour = colour;
+		MarkMeshDirty(meshId, MeshDirtyMaterial);
+		return true;
+	}
 
-				if (!CreateStagingBuffer(device, resourceFactory, commandBuffer, buffer, span.data(),
-					span.size(), temporaryBuffers))
-					return false;
-			}
+	bool GeometryBatch::SetMeshImages(uint32_t meshId,
+		std::shared_ptr<Image> diffuseImage,
+		std::shared_ptr<Image> normalImage,
+		std::shared_ptr<Image> metallicRoughnessImage)
+	{
+		if (!IsMeshMutable(meshId))
+			return false;
 
-			commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-				MaterialStageFlags::VertexInput, MaterialAccessFlags::VertexAttributeRead);
+		MeshInfo& meshInfo = m_meshInfos[meshId];
+		AddImage(diffuseImage, meshInfo.diffuseImageIndex);
+		AddImage(normalImage, meshInfo.normalImageIndex);
+		AddImage(metallicRoughnessImage, meshInfo.metallicRoughnessImageIndex);
+		MarkMeshDirty(meshId, MeshDirtyMaterial);
+		return true;
+	}
 
-			return true;
+	bool GeometryBatch::IsMeshMutable(uint32_t meshId) const
+	{
+		if (meshId >= m_meshCapacity || !m_active[meshId])
+		{
+			Logger::Error("Mesh {} does not exist and cannot be updated.", meshId);
+			return false;
 		}
 
-		if (m_vertexDataArrays.empty())
+		// Cached meshes only exist as baked GPU records, there is no CPU state to derive updated records from.
+		if (m_bakedMeshes[meshId])
+		{
+			Logger::Error("Mesh {} was restored from the scene cache and cannot be updated.", meshId);
 			return false;
+		}
 
-		m_vertexBuffers.resize(m_vertexDataArrays[0].size());
-		m_vertexOffsets.resize(m_vertexDataArrays.size());
+		return true;
+	}
 
-		for (size_t vertexBit = 0; vertexBit < m_vertexBuffers.size(); ++vertexBit)
-		{
-			uint64_t totalSize = 0;
-			for (size_t i = 0; i < m_vertexDataArrays.size(); ++i)
-			{
-				if (!m_active[i])
-					continue;
+	void GeometryBatch::MarkMeshDirty(uint32_t meshId, uint8_t flags)
+	{
+		if (m_meshDirtyFlags[meshId] == 0)
+			m_dirtyMeshes.push_back(meshId);
 
-				const std::unique_ptr<VertexData>& data = m_vertexDataArrays[i][vertexBit];
-				totalSize += static_cast<uint64_t>(data->GetElementSize()) * data->GetCount();
-			}
+		m_meshDirtyFlags[meshId] |= flags;
+	}
 
-			std::vector<uint8_t> vertexBufferData;
-			vertexBufferData.resize(totalSize);
-			totalSize = 0;
-			size_t vertexOffset = 0;
-			for (size_t i = 0; i < m_vertexDataArrays.size(); ++i)
-			{
-				if (!m_active[i])
-					continue;
+	void GeometryBatch::AddImage(const std::shared_ptr<Image>& image, size_t& imageIndex)
+	{
+		if (image.get() == nullptr)
+			return;
 
-				const std::unique_ptr<VertexData>& data = m_vertexDataArrays[i][vertexBit];
-				uint32_t size = data->GetElementSize() * data->GetCount();
-				memcpy(vertexBufferData.data() + totalSize, data->GetData<uint8_t>(), size);
+		uint64_t imageHash = image->GetHash();
+		const auto& imageResult = m_imageHashTable.find(imageHash);
+		if (imageResult != m_imageHashTable.cend())
+		{
+			imageIndex = imageResult->second;
+			return;
+		}
 
-				m_vertexOffsets[i] = static_cast<uint32_t>(vertexOffset);
+		m_imageHashTable[imageHash] = m_images.size();
+		imageIndex = m_images.size();
+		m_images.emplace_back(image);
+	}
 
-				vertexOffset += data->GetCount();
-				totalSize += size;
-			}
+	void GeometryBatch::ReleaseVertexData(size_t vertexBufferIndex)
+	{
+		if (--m_vertexReferenceCounts[vertexBufferIndex] > 0)
+			return;
 
-			// TODO: Clean up!
-			if (chunkData)
+		auto range = m_vertexDataHashTable.equal_range(m_vertexDataHashes[vertexBufferIndex]);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == vertexBufferIndex)
 			{
-				if (vertexBit == 0)
-					chunkData->SetVertexData(VertexBufferType::Positions, vertexBufferData);
-				else if (vertexBit == 1)
-					chunkData->SetVertexData(VertexBufferType::TextureCoordinates, vertexBufferData);
-				else if (vertexBit == 2)
-					chunkData->SetVertexData(VertexBufferType::Normals, vertexBufferData);
-				else
-					throw;
+				m_vertexDataHashTable.erase(it);
+				break;
 			}
+		}
 
-			m_vertexBuffers[vertexBit] = std::move(resourceFactory.CreateBuffer());
-			IBuffer* buffer = m_vertexBuffers[vertexBit].get();
+		if (m_vertexDataUploaded[vertexBufferIndex])
+			RetireAllocation(m_vertexAllocator, m_vertexOffsets[vertexBufferIndex]);
+
+		m_vertexDataArrays[vertexBufferIndex].clear();
+		m_vertexDataArrays[vertexBufferIndex].shrink_to_fit();
+		m_recycledVertexData.push(vertexBufferIndex);
+	}
 
-			bool initialised = buffer->Initialise("vertexBuffer", device, totalSize,
-				BufferUsageFlags::TransferDst | BufferUsageFlags::VertexBuffer,
-				MemoryUsage::AutoPreferDevice,
-				AllocationCreateFlags::None,
-				SharingMode::Exclusive);
+	void GeometryBatch::ReleaseIndexData(size_t indexBufferIndex)
+	{
+		if (--m_indexReferenceCounts[indexBufferIndex] > 0)
+			return;
 
-			if (!initialised)
+		auto range = m_indexDataHashTable.equal_range(m_indexDataHashes[indexBufferIndex]);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == indexBufferIndex)
 			{
-				return false;
+				m_indexDataHashTable.erase(it);
+				break;
 			}
-
-			if (!CreateStagingBuffer(device, resourceFactory, commandBuffer, buffer, vertexBufferData.data(),
-				totalSize, temporaryBuffers))
-				return false;
 		}
 
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-			MaterialStageFlags::VertexInput, MaterialAccessFlags::VertexAttributeRead);
+		if (m_indexDataUploaded[indexBufferIndex])
+			RetireAllocation(m_indexAllocator, m_indexOffsets[indexBufferIndex]);
 
-		return true;
+		m_indexArrays[indexBufferIndex].reset();
+		m_recycledIndexData.push(indexBufferIndex);
 	}
 
-	bool GeometryBatch::UploadBoundsBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-		std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize)
+	void GeometryBatch::ReleaseMeshDetail(size_t meshDetailIndex)
 	{
-		bool initialised = buffer->Initialise("boundsBuffer", device, dataSize,
-			BufferUsageFlags::TransferDst | BufferUsageFlags::StorageBuffer,
-			MemoryUsage::AutoPreferDevice,
-			AllocationCreateFlags::None,
-			SharingMode::Exclusive);
-
-		if (!initialised)
-		{
-			return false;
-		}
-
-		if (!CreateStagingBuffer(device, resourceFactory, commandBuffer, buffer, data,
-			dataSize, temporaryBuffers))
-			return false;
+		MeshDetail& meshDetail = m_meshDetails[meshDetailIndex];
+		if (--meshDetail.referenceCount > 0)
+			return;
+
+		uint64_t meshDetailKey = (static_cast<uint64_t>(meshDetail.indexBufferIndex) << 32) | static_cast<uint64_t>(meshDetail.vertexBufferIndex);
+		m_meshDetailHashTable.erase(meshDetailKey);
+
+		if (meshDetail.indexAllocation != FreeListAllocator::InvalidOffset)
+			RetireAllocation(m_indexAllocator, meshDetail.indexAllocation);
+
+		meshDetail.indexAllocation = FreeListAllocator::InvalidOffset;
+		meshDetail.lods = {};
+		meshDetail.lodIndexOffsets = {};
+		meshDetail.clusters = {};
+		meshDetail.clusterIndices = {};
+		m_recycledMeshDetails.push(meshDetailIndex);
+	}
 
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-			MaterialStageFlags::ComputeShader, MaterialAccessFlags::ShaderRead);
+	void GeometryBatch::RetireAllocation(FreeListAllocator& allocator, uint64_t offset)
+	{
+		// Frames in flight may still read the region, it is only returned to the allocator once they have completed.
+		std::lock_guard<std::mutex> lock(m_retiredMutex);
+		m_pendingFrees.push_back({ &allocator, offset });
+	}
 
-		return true;
+	StagingRingStats GeometryBatch::GetStagingStats()
+	{
+		std::lock_guard<std::mutex> lock(m_renderer.GetGeometryStagingMutex());
+		return m_renderer.GetGeometryStagingRing().GetStats();
 	}
 
-	bool GeometryBatch::SetupBoundsBuffer(const IDevice& device, const ICommandBuffer& commandBuffer,
-		ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory)
+	void GeometryBatch::ReleaseRetiredResources()
 	{
-		if (chunkData != nullptr && chunkData->LoadedFromDisk())
+		std::lock_guard<std::mutex> lock(m_retiredMutex);
+		for (auto it = m_retiredResources.begin(); it != m_retiredResources.end();)
 		{
-			ChunkMemoryEntry entry;
-			if (!chunkData->GetGenericData(static_cast<uint32_t>(CachedDataType::BoundsBuffer), entry))
+			if (it->framesRemaining > 0 && --it->framesRemaining > 0)
 			{
-				return false;
+				++it;
+				continue;
 			}
 
-			std::vector<uint8_t> decompressBuffer;
-			chunkData->Decompress(entry, decompressBuffer);
-
-			m_boundsBuffer = std::move(resourceFactory.CreateBuffer());
+			for (const RetiredAllocation& allocation : it->allocations)
+			{
+				allocation.allocator->Free(allocation.offset);
+			}
 
-			return UploadBoundsBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-				m_boundsBuffer.get(), decompressBuffer.data(), decompressBuffer.size());
+			it = m_retiredResources.erase(it);
 		}
+	}
 
-		std::vector<glm::vec4> boundsData;
-		boundsData.reserve(m_meshCapacity);
-
-		for (size_t i = 0; i < m_vertexDataArrays.size(); ++i)
+	bool GeometryBatch::Optimise()
+	{
+		auto optimiseStartTime = std::chrono::high_resolution_clock::now();
+
+		Logger::Verbose("Mesh deduplication - {} meshes, vertex data reused {} times ({} unique), index data reused {} times ({} unique), {} hash collisions.",
+			m_deduplicationRequests, m_vertexDataHits, m_vertexDataArrays.size(), m_indexDataHits, m_indexArrays.size(), m_hashCollisions);
+
+		// Index and vertex data are deduplicated independently, so gather which index arrays reference each vertex array and vice versa.
+		// Only data that has not been uploaded yet is optimised, uploaded regions may be in use by the GPU.
+		std::vector<std::vector<size_t>> indexArraysPerVertexArray(m_vertexDataArrays.size());
+		std::vector<std::vector<size_t>> vertexArraysPerIndexArray(m_indexArrays.size());
+		std::vector<bool> vertexArrayPending(m_vertexDataArrays.size(), false);
+		std::vector<bool> indexArrayPending(m_indexArrays.size(), false);
+		size_t pendingMeshDetailCount = 0;
+		for (const MeshDetail& meshDetail : m_meshDetails)
 		{
-			if (!m_active[i])
+			if (meshDetail.referenceCount == 0)
 				continue;
 
-			const std::unique_ptr<VertexData>& data = m_vertexDataArrays[i][0];
-			uint32_t size = data->GetCount();
-			const auto& positionData = data->GetData<glm::vec3>();
+			indexArraysPerVertexArray[meshDetail.vertexBufferIndex].push_back(meshDetail.indexBufferIndex);
+			vertexArraysPerIndexArray[meshDetail.indexBufferIndex].push_back(meshDetail.vertexBufferIndex);
 
-			float radius = 0.0f;
-			glm::vec3 center{};
-			for (uint32_t j = 0; j < size; ++j)
+			if (!meshDetail.generated)
 			{
-				center += positionData[j];
+				vertexArrayPending[meshDetail.vertexBufferIndex] = true;
+				indexArrayPending[meshDetail.indexBufferIndex] = true;
+				++pendingMeshDetailCount;
 			}
-			center /= static_cast<float>(size);
-			radius = glm::distance2(positionData[0], center);
-			for (uint32_t j = 1; j < size; ++j)
+		}
+
+		// Vertex data can only be remapped when no index array referencing it is shared with other vertex data or already uploaded.
+		// Otherwise the index arrays are only reordered, which leaves the vertex data untouched.
+		std::vector<MeshOptimiseJob> jobs;
+		std::vector<bool> indexArrayQueued(m_indexArrays.size(), false);
+		for (size_t vertexBufferIndex = 0; vertexBufferIndex < m_vertexDataArrays.size(); ++vertexBufferIndex)
+		{
+			const std::vector<size_t>& indexBufferIndices = indexArraysPerVertexArray[vertexBufferIndex];
+			if (indexBufferIndices.empty() || !vertexArrayPending[vertexBufferIndex])
+				continue;
+
+			bool exclusive = !m_vertexDataUploaded[vertexBufferIndex] && std::all_of(indexBufferIndices.begin(), indexBufferIndices.end(),
+				[this, &vertexArraysPerIndexArray](size_t indexBufferIndex)
+				{
+					return vertexArraysPerIndexArray[indexBufferIndex].size() == 1 && !m_indexDataUploaded[indexBufferIndex];
+				});
+
+			if (exclusive)
 			{
-				radius = std::max(radius, glm::distance2(positionData[j], center));
+				jobs.push_back({ vertexBufferIndex, indexBufferIndices, true });
+				continue;
 			}
-			radius = std::nextafter(sqrtf(radius), std::numeric_limits<float>::max());
 
-			const MeshInfo& meshInfo = m_meshInfos[i];
-			center += glm::vec3(meshInfo.transform[3]);
+			for (size_t indexBufferIndex : indexBufferIndices)
+			{
+				if (indexArrayQueued[indexBufferIndex] || !indexArrayPending[indexBufferIndex] || m_indexDataUploaded[indexBufferIndex])
+					continue;
 
-			boundsData.emplace_back(glm::vec4(center, radius));
+				indexArrayQueued[indexBufferIndex] = true;
+				jobs.push_back({ vertexBufferIndex, { indexBufferIndex }, false });
+			}
 		}
 
-		m_boundsBuffer = std::move(resourceFactory.CreateBuffer());
-		size_t totalSize = boundsData.size() * sizeof(glm::vec4);
+		// Arenas are pooled rather than created per job so scratch storage is reused once an arena has grown to fit.
+		std::vector<std::unique_ptr<MeshOptimiserArena>> arenas;
+		std::vector<MeshOptimiserArena*> freeArenas;
+		std::mutex arenaMutex;
 
-		if (!UploadBoundsBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-			m_boundsBuffer.get(), boundsData.data(), totalSize))
-			return false;
+		std::vector<MeshOptimiserStatistics> statistics(jobs.size());
+		std::atomic_bool optimiseIssue = false;
+		std::for_each(
+			std::execution::par,
+			jobs.begin(),
+			jobs.end(),
+			[this, &jobs, &statistics, &optimiseIssue, &arenas, &freeArenas, &arenaMutex](const MeshOptimiseJob& job)
+			{
+				if (optimiseIssue)
+				{
+					return;
+				}
 
-		if (chunkData)
-		{
-			std::span<uint8_t> cacheData(reinterpret_cast<uint8_t*>(boundsData.data()), totalSize);
-			chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::BoundsBuffer), cacheData);
-		}
+				MeshOptimiserArena* arena;
+				{
+					std::lock_guard<std::mutex> lock(arenaMutex);
+					if (freeArenas.empty())
+					{
+						arena = arenas.emplace_back(std::make_unique<MeshOptimiserArena>()).get();
+					}
+					else
+					{
+						arena = freeArenas.back();
+						freeArenas.pop_back();
+					}
+				}
 
-		return true;
-	}
+				std::vector<std::vector<uint32_t>*> indexArrays;
+				for (size_t indexBufferIndex : job.indexBufferIndices)
+				{
+					indexArrays.push_back(m_indexArrays[indexBufferIndex].get());
+				}
 
-	bool GeometryBatch::UploadIndexBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-		std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize)
-	{
-		bool initialised = buffer->Initialise("indexBuffer", device, dataSize,
-			BufferUsageFlags::TransferDst | BufferUsageFlags::IndexBuffer,
-			MemoryUsage::AutoPreferDevice,
-			AllocationCreateFlags::None,
-			SharingMode::Exclusive);
+				size_t jobIndex = &job - jobs.data();
+				if (!MeshOptimiser::Optimise(indexArrays, m_vertexDataArrays[job.vertexBufferIndex], job.remapVertices, *arena, statistics[jobIndex]))
+				{
+					optimiseIssue = true;
+				}
+
+				std::lock_guard<std::mutex> lock(arenaMutex);
+				freeArenas.push_back(arena);
+			});
 
-		if (!initialised)
+		if (optimiseIssue)
 		{
+			Logger::Error("Issue occurred during mesh optimisation.");
 			return false;
 		}
 
-		if (!CreateStagingBuffer(device, resourceFactory, commandBuffer, buffer, data,
-			dataSize, temporaryBuffers))
-			return false;
-
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-			MaterialStageFlags::VertexInput, MaterialAccessFlags::IndexRead);
-
-		return true;
-	}
-
-	bool GeometryBatch::SetupIndexBuffer(const IDevice& device, const ICommandBuffer& commandBuffer,
-		ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory)
-	{
-		if (chunkData != nullptr && chunkData->LoadedFromDisk())
+		MeshOptimiserStatistics totals;
+		for (const MeshOptimiserStatistics& jobStatistics : statistics)
 		{
-			ChunkMemoryEntry entry;
-			if (!chunkData->GetGenericData(static_cast<uint32_t>(CachedDataType::IndexBuffer), entry))
-			{
-				return false;
-			}
+			totals.TriangleCount += jobStatistics.TriangleCount;
+			totals.VerticesTransformedBefore += jobStatistics.VerticesTransformedBefore;
+			totals.VerticesTransformedAfter += jobStatistics.VerticesTransformedAfter;
+			totals.PixelsCoveredBefore += jobStatistics.PixelsCoveredBefore;
+			totals.PixelsCoveredAfter += jobStatistics.PixelsCoveredAfter;
+			totals.PixelsShadedBefore += jobStatistics.PixelsShadedBefore;
+			totals.PixelsShadedAfter += jobStatistics.PixelsShadedAfter;
+		}
 
-			std::vector<uint8_t> decompressBuffer;
-			chunkData->Decompress(entry, decompressBuffer);
+		uint64_t arenaHeapAllocations = 0;
+		for (const std::unique_ptr<MeshOptimiserArena>& arena : arenas)
+		{
+			arenaHeapAllocations += arena->GetHeapAllocationCount();
+		}
 
-			m_indexBuffer = std::move(resourceFactory.CreateBuffer());
+		auto ratio = [](uint64_t numerator, uint64_t denominator) { return denominator == 0 ? 0.0f : static_cast<float>(numerator) / denominator; };
 
-			return UploadIndexBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-				m_indexBuffer.get(), decompressBuffer.data(), decompressBuffer.size());
-		}
+		auto optimiseEndTime = std::chrono::high_resolution_clock::now();
+		float optimiseDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(optimiseEndTime - optimiseStartTime).count();
+		Logger::Verbose("Mesh optimising of {} unique meshes finished in {} seconds.", pendingMeshDetailCount, optimiseDeltaTime);
+		Logger::Verbose("Mesh optimiser used {} arenas with {} heap allocations across {} jobs.", arenas.size(), arenaHeapAllocations, jobs.size());
+		Logger::Verbose("Mesh ACMR {} -> {}, overdraw {} -> {}.",
+			ratio(totals.VerticesTransformedBefore, totals.TriangleCount), ratio(totals.VerticesTransformedAfter, totals.TriangleCount),
+			ratio(totals.PixelsShadedBefore, totals.PixelsCoveredBefore), ratio(totals.PixelsShadedAfter, totals.PixelsCoveredAfter));
 
-		m_indexOffsets.resize(m_indexArrays.size());
-		m_indexCounts.resize(m_indexArrays.size());
+		if (!GenerateLODs() || !GenerateClusters())
+			return false;
 
-		uint64_t totalSize = 0;
-		for (size_t i = 0; i < m_indexArrays.size(); ++i)
+		for (MeshDetail& meshDetail : m_meshDetails)
 		{
-			if (!m_active[i])
-				continue;
-
-			const std::unique_ptr<std::vector<uint32_t>>& data = m_indexArrays[i];
-			totalSize += data->size() * sizeof(uint32_t);
+			if (meshDetail.referenceCount > 0)
+				meshDetail.generated = true;
 		}
 
-		std::vector<uint8_t> indexBufferData;
-		indexBufferData.resize(totalSize);
-		totalSize = 0;
-		size_t index = 0;
-		size_t indexOffset = 0;
-		for (size_t i = 0; i < m_indexArrays.size(); ++i)
+		m_optimisePending = false;
+		return true;
+	}
+
+	bool GeometryBatch::GenerateLODs()
+	{
+		auto lodStartTime = std::chrono::high_resolution_clock::now();
+
+		std::atomic_bool lodIssue = false;
+		std::for_each(
+			std::execution::par,
+			m_meshDetails.begin(),
+			m_meshDetails.end(),
+			[this, &lodIssue](MeshDetail& meshDetail)
+			{
+				if (lodIssue || meshDetail.generated || meshDetail.referenceCount == 0)
+				{
+					return;
+				}
+
+				const std::vector<uint32_t>& indices = *m_indexArrays[meshDetail.indexBufferIndex];
+				const VertexData& positions = *m_vertexDataArrays[meshDetail.vertexBufferIndex][0];
+				if (!MeshOptimiser::GenerateLODs(indices, positions, MaxMeshLODCount, meshDetail.lods))
+				{
+					lodIssue = true;
+				}
+			});
+
+		if (lodIssue)
+		{
+			Logger::Error("Issue occurred during mesh LOD generation.");
+			return false;
+		}
+
+		// Report how many triangles the scene contains at each detail level, counting every mesh instance.
+		std::array<uint64_t, MaxMeshLODCount> triangleCounts{};
+		for (size_t i = 0; i < m_meshCapacity; ++i)
 		{
-			if (!m_active[i])
+			if (!m_active[i] || m_bakedMeshes[i])
 				continue;
 
-			const std::unique_ptr<std::vector<uint32_t>>& data = m_indexArrays[i];
-			uint32_t size = static_cast<uint32_t>(data->size()) * sizeof(uint32_t);
-			memcpy(indexBufferData.data() + totalSize, data->data(), size);
-			m_indexOffsets[i] = static_cast<uint32_t>(indexOffset);
-			m_indexCounts[i] = static_cast<uint32_t>(data->size());
-			indexOffset += data->size();
-			totalSize += size;
-		}
+			const MeshInfo& meshInfo = m_meshInfos[i];
+			const MeshDetail& meshDetail = m_meshDetails[meshInfo.meshDetailIndex];
+			uint64_t triangleCount = m_indexArrays[meshInfo.indexBufferIndex]->size() / 3;
+			for (size_t lod = 0; lod < MaxMeshLODCount; ++lod)
+			{
+				if (lod > 0 && lod <= meshDetail.lods.size())
+				{
+					triangleCount = meshDetail.lods[lod - 1].Indices.size() / 3;
+				}
 
+				triangleCounts[lod] += triangleCount;
+			}
+		}
 
-		m_indexBuffer = std::move(resourceFactory.CreateBuffer());
+		std::string triangleReport;
+		for (size_t lod = 0; lod < MaxMeshLODCount; ++lod)
+		{
+			if (lod > 0)
+				triangleReport += ", ";
 
-		if (!UploadIndexBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-			m_indexBuffer.get(), indexBufferData.data(), totalSize))
-			return false;
+			triangleReport += std::format("LOD{}: {}", lod, triangleCounts[lod]);
+		}
 
-		if (chunkData)
-			chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::IndexBuffer), indexBufferData);
+		auto lodEndTime = std::chrono::high_resolution_clock::now();
+		float lodDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(lodEndTime - lodStartTime).count();
+		Logger::Verbose("Mesh LOD generation finished in {} seconds.", lodDeltaTime);
+		Logger::Verbose("Scene triangle counts per LOD - {}.", triangleReport);
 
 		return true;
 	}
 
-	bool GeometryBatch::CreateStagingBuffer(const IDevice& device, const IResourceFactory& resourceFactory,
-		const ICommandBuffer& commandBuffer, const IBuffer* destinationBuffer, const void* data, uint64_t size,
-		std::vector<std::unique_ptr<IBuffer>>& copyBufferCollection)
+	bool GeometryBatch::QuantiseVertexData(const std::vector<size_t>& vertexBufferIndices, std::vector<std::array<std::vector<uint8_t>, 4>>& quantisedStreams)
 	{
-		IBuffer* stagingBuffer = copyBufferCollection.emplace_back(std::move(resourceFactory.CreateBuffer())).get();
-		if (!stagingBuffer->Initialise("stagingBuffer", device, size,
-			BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
-			AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
-			SharingMode::Exclusive))
+		auto quantiseStartTime = std::chrono::high_resolution_clock::now();
+
+		quantisedStreams.resize(m_vertexDataArrays.size());
+		std::vector<VertexQuantisationError> errors(vertexBufferIndices.size());
+
+		std::vector<size_t> jobIndices(vertexBufferIndices.size());
+		std::iota(jobIndices.begin(), jobIndices.end(), 0);
+
+		std::atomic_bool quantiseIssue = false;
+		std::for_each(
+			std::execution::par,
+			jobIndices.begin(),
+			jobIndices.end(),
+			[this, &vertexBufferIndices, &quantisedStreams, &errors, &quantiseIssue](size_t jobIndex)
+			{
+				size_t i = vertexBufferIndices[jobIndex];
+				const std::vector<std::unique_ptr<VertexData>>& vertexArrays = m_vertexDataArrays[i];
+				if (vertexArrays.size() < 3)
+				{
+					quantiseIssue = true;
+					return;
+				}
+
+				std::vector<QuantisedPosition> positions;
+				std::vector<uint32_t> uvs;
+				std::vector<uint32_t> normals;
+				VertexQuantiser::QuantisePositions(*vertexArrays[0], positions, m_positionOffsets[i], m_positionScales[i]);
+				VertexQuantiser::QuantiseTextureCoordinates(*vertexArrays[1], uvs);
+				VertexQuantiser::QuantiseNormals(*vertexArrays[2], normals);
+				VertexQuantiser::MeasureError(*vertexArrays[0], *vertexArrays[2], *vertexArrays[1],
+					positions, m_positionOffsets[i], m_positionScales[i], normals, uvs, errors[jobIndex]);
+
+				std::array<std::vector<uint8_t>, 4>& streams = quantisedStreams[i];
+				streams[0].resize(positions.size() * sizeof(QuantisedPosition));
+				memcpy(streams[0].data(), positions.data(), streams[0].size());
+				streams[1].resize(uvs.size() * sizeof(uint32_t));
+				memcpy(streams[1].data(), uvs.data(), streams[1].size());
+				streams[2].resize(normals.size() * sizeof(uint32_t));
+				memcpy(streams[2].data(), normals.data(), streams[2].size());
+
+				if (vertexArrays.size() > 3)
+				{
+					std::vector<uint32_t> tangents;
+					VertexQuantiser::QuantiseTangents(*vertexArrays[3], tangents);
+					streams[3].resize(tangents.size() * sizeof(uint32_t));
+					memcpy(streams[3].data(), tangents.data(), streams[3].size());
+				}
+			});
+
+		if (quantiseIssue)
 		{
+			Logger::Error("Vertex quantisation requires position, texture coordinate and normal streams.");
 			return false;
 		}
 
-		if (!stagingBuffer->UpdateContents(data, 0, size))
-			return false;
+		VertexQuantisationError maxError;
+		for (const VertexQuantisationError& error : errors)
+		{
+			maxError.MaxPositionError = std::max(maxError.MaxPositionError, error.MaxPositionError);
+			maxError.MaxNormalAngle = std::max(maxError.MaxNormalAngle, error.MaxNormalAngle);
+			maxError.MaxUVError = std::max(maxError.MaxUVError, error.MaxUVError);
+		}
 
-		stagingBuffer->Copy(commandBuffer, *destinationBuffer, size);
+		auto quantiseEndTime = std::chrono::high_resolution_clock::now();
+		float quantiseDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(quantiseEndTime - quantiseStartTime).count();
+		Logger::Verbose("Vertex quantisation finished in {} seconds.", quantiseDeltaTime);
+		Logger::Verbose("Vertex quantisation max error - position: {}, normal: {} degrees, uv: {}.",
+			maxError.MaxPositionError, maxError.MaxNormalAngle, maxError.MaxUVError);
 
 		return true;
 	}
 
-	bool GeometryBatch::CreateImageStagingBuffer(const IDevice& device, const IResourceFactory& resourceFactory,
-		const ICommandBuffer& commandBuffer, const IRenderImage* destinationImage, uint32_t mipLevel, const void* data, uint64_t size,
-		std::vector<std::unique_ptr<IBuffer>>& copyBufferCollection)
+	bool GeometryBatch::GenerateClusters()
 	{
-		IBuffer* stagingBuffer = copyBufferCollection.emplace_back(std::move(resourceFactory.CreateBuffer())).get();
-		if (!stagingBuffer->Initialise("imageStagingBuffer", device, size,
-			BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
-			AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
-			SharingMode::Exclusive))
+		auto clusterStartTime = std::chrono::high_resolution_clock::now();
+
+		std::atomic_bool clusterIssue = false;
+		std::for_each(
+			std::execution::par,
+			m_meshDetails.begin(),
+			m_meshDetails.end(),
+			[this, &clusterIssue](MeshDetail& meshDetail)
+			{
+				if (clusterIssue || meshDetail.generated || meshDetail.referenceCount == 0)
+				{
+					return;
+				}
+
+				const std::vector<uint32_t>& indices = *m_indexArrays[meshDetail.indexBufferIndex];
+				const VertexData& positions = *m_vertexDataArrays[meshDetail.vertexBufferIndex][0];
+				if (!MeshOptimiser::BuildClusters(indices, positions, meshDetail.clusters, meshDetail.clusterIndices))
+				{
+					clusterIssue = true;
+				}
+			});
+
+		if (clusterIssue)
 		{
+			Logger::Error("Issue occurred during mesh cluster generation.");
 			return false;
 		}
 
-		if (!stagingBuffer->UpdateContents(data, 0, size))
-			return false;
+		uint64_t clusterCount = 0;
+		for (size_t i = 0; i < m_meshCapacity; ++i)
+		{
+			if (!m_active[i] || m_bakedMeshes[i])
+				continue;
+
+			clusterCount += m_meshDetails[m_meshInfos[i].meshDetailIndex].clusters.size();
+		}
 
-		stagingBuffer->CopyToImage(mipLevel, commandBuffer, *destinationImage);
+		auto clusterEndTime = std::chrono::high_resolution_clock::now();
+		float clusterDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(clusterEndTime - clusterStartTime).count();
+		Logger::Verbose("Mesh cluster generation finished in {} seconds, scene contains {} clusters.", clusterDeltaTime, clusterCount);
 
 		return true;
 	}
 
-	bool GeometryBatch::SetupRenderImage(AsyncData* asyncData, const IDevice& device, const IPhysicalDevice& physicalDevice,
-		const ICommandBuffer& commandBuffer, ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers,
-		const IResourceFactory& resourceFactory, float maxAnisotropy, uint32_t& imageCount)
+	// Inverse transpose of the upper 3x3 via its cofactors, avoiding a full inverse for every updated mesh.
+	glm::mat3 CalculateNormalMatrix(const glm::mat4& transform)
 	{
-		if (chunkData != nullptr && chunkData->LoadedFromDisk())
+		glm::vec3 c0 = glm::vec3(transform[0]);
+		glm::vec3 c1 = glm::vec3(transform[1]);
+		glm::vec3 c2 = glm::vec3(transform[2]);
+
+		glm::mat3 cofactors(glm::cross(c1, c2), glm::cross(c2, c0), glm::cross(c0, c1));
+		float determinant = glm::dot(c0, cofactors[0]);
+		if (determinant == 0.0f)
+			return glm::mat3(1.0f);
+
+		return cofactors / determinant;
+	}
+
+	uint64_t GeometryBatch::AllocateRange(FreeListAllocator& allocator, uint64_t size)
+	{
+		uint64_t offset = allocator.Allocate(size);
+		if (offset != FreeListAllocator::InvalidOffset)
+			return offset;
+
+		// Fragmentation can leave no block large enough even after reserving, grow past the end instead.
+		allocator.Grow(allocator.GetCapacity() + std::max(size, allocator.GetCapacity() / 2));
+		return allocator.Allocate(size);
+	}
+
+	void GeometryBatch::ReserveRange(FreeListAllocator& allocator, uint64_t size)
+	{
+		if (size == 0 || allocator.GetLargestFreeBlock() >= size)
+			return;
+
+		// The initial build is sized exactly, later growth leaves headroom so streaming meshes in does not reallocate every flush.
+		uint64_t growth = m_creating ? size : std::max(size, allocator.GetCapacity() / 2);
+		allocator.Grow(allocator.GetCapacity() + growth);
+	}
+
+	bool GeometryBatch::StageVertexData()
+	{
+		std::vector<size_t> vertexBufferIndices;
+		uint64_t vertexCount = 0;
+		for (size_t i = 0; i < m_vertexDataArrays.size(); ++i)
 		{
-			std::vector<ImageData>* cachedImageData;
-			if (!chunkData->GetImageData(&cachedImageData))
+			if (m_vertexReferenceCounts[i] == 0 || m_vertexDataUploaded[i])
+				continue;
+
+			vertexBufferIndices.push_back(i);
+			vertexCount += m_vertexDataArrays[i][0]->GetCount();
+		}
+
+		if (vertexBufferIndices.empty())
+			return true;
+
+		std::vector<std::array<std::vector<uint8_t>, 4>> quantisedStreams;
+		if (m_quantisedVertices && !QuantiseVertexData(vertexBufferIndices, quantisedStreams))
+			return false;
+
+		if (m_vertexBuffers.empty())
+		{
+			const std::vector<std::unique_ptr<VertexData>>& vertexArrays = m_vertexDataArrays[vertexBufferIndices[0]];
+			for (size_t vertexBit = 0; vertexBit < vertexArrays.size(); ++vertexBit)
 			{
-				return false;
+				m_vertexStrides.push_back(m_quantisedVertices ? QuantisedElementSizes[vertexBit] : vertexArrays[vertexBit]->GetElementSize());
+				m_vertexBuffers.emplace_back(std::make_unique<GrowableBuffer>("vertexBuffer", BufferUsageFlags::VertexBuffer,
+					MaterialStageFlags::VertexInput, MaterialAccessFlags::VertexAttributeRead, false));
 			}
+		}
 
-			imageCount = static_cast<uint32_t>(cachedImageData->size());
-			m_imageArray.reserve(cachedImageData->size());
+		ReserveRange(m_vertexAllocator, vertexCount);
 
-			float subTicks = 400.0f / static_cast<float>(cachedImageData->size());
+		std::for_each(std::execution::par, vertexBufferIndices.begin(), vertexBufferIndices.end(), [this](size_t i)
+			{
+				m_vertexBounds[i] = BoundingVolume::Calculate(*m_vertexDataArrays[i][0]);
+			});
 
-			std::vector<uint8_t> decompressBuffer;
-			for (auto it = cachedImageData->begin(); it != cachedImageData->end(); ++it)
+		for (size_t i : vertexBufferIndices)
+		{
+			const std::vector<std::unique_ptr<VertexData>>& vertexArrays = m_vertexDataArrays[i];
+			if (vertexArrays.size() != m_vertexBuffers.size())
 			{
-				const ImageData& imageData = *it;
-				Format format = static_cast<Format>(imageData.Header.Format);
-				glm::uvec3 dimensions(imageData.Header.Width, imageData.Header.Height, 1);
+				Logger::Error("Vertex data stream count does not match the existing geometry batch layout.");
+				return false;
+			}
 
-				chunkData->Decompress(imageData.Entry, decompressBuffer);
+			uint32_t count = vertexArrays[0]->GetCount();
+			uint64_t vertexOffset = AllocateRange(m_vertexAllocator, count);
+			m_vertexOffsets[i] = static_cast<uint32_t>(vertexOffset);
 
-				std::vector<std::span<const uint8_t>> spans(imageData.Header.MipLevels);
-				uint64_t offset = 0;
-				uint64_t size = imageData.Header.FirstMipSize;
-				for (uint32_t i = 0; i < imageData.Header.MipLevels; ++i)
+			for (size_t vertexBit = 0; vertexBit < vertexArrays.size(); ++vertexBit)
+			{
+				const std::unique_ptr<VertexData>& data = vertexArrays[vertexBit];
+				if (!m_quantisedVertices && data->GetElementSize() != m_vertexStrides[vertexBit])
 				{
-					spans[i] = std::span<const uint8_t>(decompressBuffer.begin() + offset, size);
-					offset += size;
-					size /= 4;
+					Logger::Error("Vertex data element size does not match the existing geometry batch layout.");
+					return false;
 				}
 
-				std::unique_ptr<IRenderImage>& renderImage = m_imageArray.emplace_back(std::move(resourceFactory.CreateRenderImage()));
-				bool imageInitialised = renderImage->Initialise("SceneImage", device, ImageType::e2D, format, dimensions,
-					imageData.Header.MipLevels, 1, ImageTiling::Optimal,
-					ImageUsageFlags::TransferSrc | ImageUsageFlags::TransferDst | ImageUsageFlags::Sampled, ImageAspectFlags::Color,
-					MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive);
+				const uint8_t* source = m_quantisedVertices ? quantisedStreams[i][vertexBit].data() : data->GetData<uint8_t>();
+				uint64_t stride = m_vertexStrides[vertexBit];
+				m_vertexBuffers[vertexBit]->Write(vertexOffset * stride, source, count * stride);
+			}
 
-				if (!imageInitialised)
+			m_vertexDataUploaded[i] = true;
+		}
+
+		for (size_t vertexBit = 0; vertexBit < m_vertexBuffers.size(); ++vertexBit)
+		{
+			m_vertexBuffers[vertexBit]->Reserve(m_vertexAllocator.GetCapacity() * m_vertexStrides[vertexBit]);
+		}
+
+		return true;
+	}
+
+	void GeometryBatch::StageIndexData()
+	{
+		uint64_t indexCount = 0;
+		for (size_t i = 0; i < m_indexArrays.size(); ++i)
+		{
+			if (m_indexReferenceCounts[i] > 0 && !m_indexDataUploaded[i])
+				indexCount += m_indexArrays[i]->size();
+		}
+
+		for (const MeshDetail& meshDetail : m_meshDetails)
+		{
+			if (meshDetail.referenceCount == 0 || meshDetail.uploaded)
+				continue;
+
+			for (const MeshLOD& lod : meshDetail.lods)
+			{
+				indexCount += lod.Indices.size();
+			}
+			indexCount += meshDetail.clusterIndices.size();
+		}
+
+		ReserveRange(m_indexAllocator, indexCount);
+
+		for (size_t i = 0; i < m_indexArrays.size(); ++i)
+		{
+			if (m_indexReferenceCounts[i] == 0 || m_indexDataUploaded[i])
+				continue;
+
+			const std::vector<uint32_t>& indices = *m_indexArrays[i];
+			uint64_t indexOffset = AllocateRange(m_indexAllocator, indices.size());
+			m_indexBuffer.Write(indexOffset * sizeof(uint32_t), indices.data(), indices.size() * sizeof(uint32_t));
+			m_indexOffsets[i] = static_cast<uint32_t>(indexOffset);
+			m_indexCounts[i] = static_cast<uint32_t>(indices.size());
+			m_indexDataUploaded[i] = true;
+		}
+
+		// Simplified LODs and the cluster ordered copy of the full detail triangles share one region per mesh detail,
+		// both use the same vertices as the full detail index data.
+		for (MeshDetail& meshDetail : m_meshDetails)
+		{
+			if (meshDetail.referenceCount == 0 || meshDetail.uploaded)
+				continue;
+
+			uint64_t detailIndexCount = meshDetail.clusterIndices.size();
+			for (const MeshLOD& lod : meshDetail.lods)
+			{
+				detailIndexCount += lod.Indices.size();
+			}
+
+			meshDetail.uploaded = true;
+			if (detailIndexCount == 0)
+				continue;
+
+			uint64_t indexOffset = AllocateRange(m_indexAllocator, detailIndexCount);
+			meshDetail.indexAllocation = indexOffset;
+
+			meshDetail.lodIndexOffsets.resize(meshDetail.lods.size());
+			for (size_t lod = 0; lod < meshDetail.lods.size(); ++lod)
+			{
+				const std::vector<uint32_t>& lodIndices = meshDetail.lods[lod].Indices;
+				m_indexBuffer.Write(indexOffset * sizeof(uint32_t), lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
+				meshDetail.lodIndexOffsets[lod] = static_cast<uint32_t>(indexOffset);
+				indexOffset += lodIndices.size();
+			}
+
+			m_indexBuffer.Write(indexOffset * sizeof(uint32_t), meshDetail.clusterIndices.data(), meshDetail.clusterIndices.size() * sizeof(uint32_t));
+			meshDetail.clusterIndexOffset = static_cast<uint32_t>(indexOffset);
+		}
+
+		m_indexBuffer.Reserve(m_indexAllocator.GetCapacity() * sizeof(uint32_t));
+	}
+
+	void GeometryBatch::StageMeshSlots()
+	{
+		if (m_meshCapacity > m_slotCapacity)
+		{
+			m_slotCapacity = m_creating ? m_meshCapacity : std::max(m_meshCapacity, m_slotCapacity + m_slotCapacity / 2);
+
+			// Draw count is stored in the first 4 bytes, it covers every slot as empty ones are skipped during culling.
+			m_indirectDrawBuffer.Write(0, &m_slotCapacity, sizeof(uint32_t));
+			m_indirectDrawBuffer.Reserve(sizeof(uint32_t) + m_slotCapacity * sizeof(IndexedIndirectCommand));
+			m_meshInfoBuffer.Reserve(m_slotCapacity * sizeof(RenderMeshInfo));
+			m_boundsBuffer.Reserve(m_slotCapacity * sizeof(RenderMeshBounds));
+			m_lodBuffer.Reserve(m_slotCapacity * sizeof(RenderMeshLODInfo));
+		}
+
+		// Clusters of destroyed meshes are emptied so culling skips them until the range is reused.
+		for (const std::pair<uint64_t, uint32_t>& clusterRange : m_clearedClusterRanges)
+		{
+			std::vector<RenderMeshCluster> emptyClusters(clusterRange.second);
+			m_clusterBuffer.Write(clusterRange.first * sizeof(RenderMeshCluster), emptyClusters.data(), emptyClusters.size() * sizeof(RenderMeshCluster));
+		}
+		m_clearedClusterRanges.clear();
+
+		std::sort(m_dirtyMeshes.begin(), m_dirtyMeshes.end());
+		m_dirtyMeshes.erase(std::unique(m_dirtyMeshes.begin(), m_dirtyMeshes.end()), m_dirtyMeshes.end());
+
+		uint64_t clusterCount = 0;
+		for (uint32_t id : m_dirtyMeshes)
+		{
+			if (m_active[id] && !m_bakedMeshes[id] && m_meshClusterRanges[id].second == 0)
+				clusterCount += m_meshDetails[m_meshInfos[id].meshDetailIndex].clusters.size();
+		}
+
+		ReserveRange(m_clusterAllocator, clusterCount);
+
+		std::vector<RenderMeshCluster> clusterData;
+		for (uint32_t id : m_dirtyMeshes)
+		{
+			uint8_t dirtyFlags = m_meshDirtyFlags[id];
+			m_meshDirtyFlags[id] = 0;
+
+			RenderMeshInfo renderMeshInfo = {};
+			IndexedIndirectCommand indirectCommand{};
+			RenderMeshLODInfo lodInfo = {};
+			RenderMeshBounds bounds = {};
+
+			if (m_active[id])
+			{
+				const MeshInfo& meshInfo = m_meshInfos[id];
+				const MeshDetail& meshDetail = m_meshDetails[meshInfo.meshDetailIndex];
+				const glm::mat4& transform = meshInfo.transform;
+
+				renderMeshInfo.transform = transform;
+				renderMeshInfo.normalMatrix = glm::mat4(CalculateNormalMatrix(transform));
+				renderMeshInfo.colour = meshInfo.colour.GetVec4();
+				if (m_quantisedVertices)
 				{
-					return false;
+					renderMeshInfo.positionOffset = glm::vec4(m_positionOffsets[meshInfo.vertexBufferIndex], 0.0f);
+					renderMeshInfo.positionScale = glm::vec4(m_positionScales[meshInfo.vertexBufferIndex], 0.0f);
+				}
+				else
+				{
+					renderMeshInfo.positionOffset = glm::vec4(0.0f);
+					renderMeshInfo.positionScale = glm::vec4(1.0f);
+				}
+				renderMeshInfo.diffuseImageIndex = static_cast<uint32_t>(meshInfo.diffuseImageIndex);
+				renderMeshInfo.normalImageIndex = static_cast<uint32_t>(meshInfo.normalImageIndex);
+				renderMeshInfo.metallicRoughnessImageIndex = static_cast<uint32_t>(meshInfo.metallicRoughnessImageIndex);
+
+				indirectCommand.VertexOffset = m_vertexOffsets[meshInfo.vertexBufferIndex];
+				indirectCommand.FirstIndex = m_indexOffsets[meshInfo.indexBufferIndex];
+				indirectCommand.IndexCount = m_indexCounts[meshInfo.indexBufferIndex];
+				indirectCommand.InstanceCount = 1;
+
+				WorldBounds worldBounds = BoundingVolume::Transform(m_vertexBounds[meshInfo.vertexBufferIndex], transform);
+				bounds.sphere = worldBounds.Sphere;
+				bounds.boxCenter = glm::vec4(worldBounds.BoxCenter, 0.0f);
+				for (int axis = 0; axis < 3; ++axis)
+					bounds.boxAxes[axis] = glm::vec4(worldBounds.BoxAxes[axis], 0.0f);
+
+				lodInfo.lodCount = 1;
+				lodInfo.lods[0].firstIndex = indirectCommand.FirstIndex;
+				lodInfo.lods[0].indexCount = indirectCommand.IndexCount;
+				lodInfo.lods[0].error = 0.0f;
+
+				// LOD errors are stored in object space, scale them by the largest axis of the transform.
+				float transformScale = std::max(glm::length(glm::vec3(transform[0])),
+					std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+
+				for (size_t lod = 0; lod < meshDetail.lods.size() && lodInfo.lodCount < MaxMeshLODCount; ++lod)
+				{
+					RenderMeshLOD& renderLOD = lodInfo.lods[lodInfo.lodCount++];
+					renderLOD.firstIndex = meshDetail.lodIndexOffsets[lod];
+					renderLOD.indexCount = static_cast<uint32_t>(meshDetail.lods[lod].Indices.size());
+					renderLOD.error = meshDetail.lods[lod].Error * transformScale;
 				}
 
-				std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
-				renderImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferDst, *memoryBarriers);
-				commandBuffer.MemoryBarrier(*memoryBarriers);
-				memoryBarriers->Clear();
+				std::pair<uint64_t, uint32_t>& clusterRange = m_meshClusterRanges[id];
+				if (clusterRange.second == 0 && !meshDetail.clusters.empty())
+					clusterRange = { AllocateRange(m_clusterAllocator, meshDetail.clusters.size()), static_cast<uint32_t>(meshDetail.clusters.size()) };
 
-				for (uint32_t i = 0; i < imageData.Header.MipLevels; ++i)
+				lodInfo.firstCluster = static_cast<uint32_t>(clusterRange.first);
+				lodInfo.clusterCount = clusterRange.second;
+
+				// Material only changes leave the world space clusters untouched.
+				if ((dirtyFlags & MeshDirtyTransform) != 0)
 				{
-					if (!CreateImageStagingBuffer(device, resourceFactory, commandBuffer, renderImage.get(), i, spans[i].data(),
-						spans[i].size(), temporaryBuffers))
-						return false;
+					glm::mat3 normalMatrix = glm::mat3(renderMeshInfo.normalMatrix);
+
+					// Mirroring positions on import or a transform with a negative determinant flips the winding the cone axis was derived from.
+					bool mirroredTransform = glm::determinant(glm::mat3(transform)) < 0.0f;
+					float coneSign = meshDetail.mirrored != mirroredTransform ? -1.0f : 1.0f;
+
+					clusterData.clear();
+					for (size_t j = 0; j < meshDetail.clusters.size(); ++j)
+					{
+						const MeshCluster& cluster = meshDetail.clusters[j];
+
+						glm::vec3 coneAxis = normalMatrix * cluster.ConeAxis;
+						float coneAxisLength = glm::length(coneAxis);
+						coneAxis = coneAxisLength > 0.0f ? coneAxis * (coneSign / coneAxisLength) : coneAxis;
+
+						RenderMeshCluster& renderCluster = clusterData.emplace_back();
+						renderCluster.sphere = glm::vec4(glm::vec3(transform * glm::vec4(cluster.Center, 1.0f)), cluster.Radius * transformScale);
+						renderCluster.cone = glm::vec4(coneAxis, cluster.ConeCutoff);
+						renderCluster.meshIndex = id;
+						renderCluster.firstIndex = meshDetail.clusterIndexOffset + cluster.FirstIndex;
+						renderCluster.indexCount = cluster.IndexCount;
+					}
+
+					m_clusterBuffer.Write(clusterRange.first * sizeof(RenderMeshCluster), clusterData.data(), clusterData.size() * sizeof(RenderMeshCluster));
 				}
+			}
 
-				renderImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, *memoryBarriers);
-				commandBuffer.MemoryBarrier(*memoryBarriers);
+			// Destroyed meshes keep their slot with zero instances, culling skips them until the id is reused.
+			m_meshInfoBuffer.Write(id * sizeof(RenderMeshInfo), &renderMeshInfo, sizeof(RenderMeshInfo));
+			if (dirtyFlags == MeshDirtyAll)
+				m_indirectDrawBuffer.Write(sizeof(uint32_t) + id * sizeof(IndexedIndirectCommand), &indirectCommand, sizeof(IndexedIndirectCommand));
 
-				if (asyncData != nullptr)
-					asyncData->AddSubProgress(subTicks);
+			if ((dirtyFlags & MeshDirtyTransform) != 0)
+			{
+				m_boundsBuffer.Write(id * sizeof(RenderMeshBounds), &bounds, sizeof(RenderMeshBounds));
+				m_lodBuffer.Write(id * sizeof(RenderMeshLODInfo), &lodInfo, sizeof(RenderMeshLODInfo));
 			}
+		}
 
-			commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-				MaterialStageFlags::FragmentShader, MaterialAccessFlags::ShaderRead);
+		m_dirtyMeshes.clear();
+		m_clusterBuffer.Reserve(m_clusterAllocator.GetCapacity() * sizeof(RenderMeshCluster));
+	}
 
-			return true;
+	void GeometryBatch::WriteCacheData(ChunkData* chunkData)
+	{
+		// The first build packs every buffer from offset zero, so the queued writes describe the complete contents.
+		std::vector<uint8_t> data;
+		for (size_t vertexBit = 0; vertexBit < m_vertexBuffers.size(); ++vertexBit)
+		{
+			m_vertexBuffers[vertexBit]->GetPendingContents(data);
+
+			// Quantised streams are already compact integers, the exponent filter only applies to floats.
+			uint32_t elementSize = m_vertexStrides[vertexBit];
+			int32_t positionFilterBits = m_quantisedVertices ? 0 : PositionFilterBits;
+			int32_t normalFilterBits = m_quantisedVertices ? 0 : NormalFilterBits;
+			if (vertexBit == 0)
+				chunkData->SetVertexData(VertexBufferType::Positions, data, elementSize, positionFilterBits);
+			else if (vertexBit == 1)
+				chunkData->SetVertexData(VertexBufferType::TextureCoordinates, data, elementSize);
+			else if (vertexBit == 2)
+				chunkData->SetVertexData(VertexBufferType::Normals, data, elementSize, normalFilterBits);
+			else if (vertexBit == 3)
+				chunkData->SetVertexData(VertexBufferType::Tangents, data, elementSize, normalFilterBits);
 		}
 
-		m_imageArray.reserve(m_images.size());
-		imageCount = 0;
+		m_indexBuffer.GetPendingContents(data);
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::IndexBuffer), data, ChunkCompression::IndexCodec);
+
+		m_meshInfoBuffer.GetPendingContents(data);
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::MeshInfo), data);
+
+		// The draw count is derived from the cached command count on load.
+		m_indirectDrawBuffer.GetPendingContents(data);
+		size_t headerSize = std::min(data.size(), sizeof(uint32_t));
+		std::span<uint8_t> commandData(data.begin() + headerSize, data.end());
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::IndirectDrawBuffer), commandData);
+
+		m_boundsBuffer.GetPendingContents(data);
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::BoundsBuffer), data);
+
+		m_lodBuffer.GetPendingContents(data);
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::LODBuffer), data);
+
+		m_clusterBuffer.GetPendingContents(data);
+		chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::ClusterBuffer), data);
+	}
+
+	bool GeometryBatch::LoadCachedData(ChunkData* chunkData)
+	{
+		// Tangents are last and optional, batches built from meshes without them have three streams.
+		constexpr std::array<VertexBufferType, 4> vertexTypes = { VertexBufferType::Positions, VertexBufferType::TextureCoordinates, VertexBufferType::Normals,
+			VertexBufferType::Tangents };
+		constexpr std::array<CachedDataType, 6> genericTypes = { CachedDataType::IndexBuffer, CachedDataType::MeshInfo, CachedDataType::IndirectDrawBuffer,
+			CachedDataType::BoundsBuffer, CachedDataType::LODBuffer, CachedDataType::ClusterBuffer };
+
+		// Everything is decoded before any state changes so a damaged cache leaves the batch untouched for a rebuild.
+		auto decodeStartTime = std::chrono::high_resolution_clock::now();
+		uint64_t decodedSize = 0;
+
+		std::array<std::vector<uint8_t>, 4> vertexData;
+		std::array<uint32_t, 4> vertexStrides;
+		size_t vertexStreamCount = 0;
+		for (size_t i = 0; i < vertexTypes.size(); ++i)
+		{
+			ChunkMemoryEntry entry;
+			if (!chunkData->GetVertexData(vertexTypes[i], entry))
+			{
+				if (vertexTypes[i] == VertexBufferType::Tangents)
+					break;
+
+				return false;
+			}
+
+			if (entry.ElementSize == 0 || !chunkData->Decompress(entry, vertexData[i]))
+				return false;
+
+			vertexData[i].resize(entry.UncompressedSize);
+			vertexStrides[i] = entry.ElementSize;
+			decodedSize += entry.UncompressedSize;
+			++vertexStreamCount;
+		}
+
+		auto decodeEndTime = std::chrono::high_resolution_clock::now();
+		float decodeDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(decodeEndTime - decodeStartTime).count();
+		float decodeRate = decodeDeltaTime > 0.0f ? static_cast<float>(decodedSize) / decodeDeltaTime / 1e9f : 0.0f;
+		Logger::Verbose("Vertex data decoded in {} seconds ({} GB/s).", decodeDeltaTime, decodeRate);
+
+		std::array<std::vector<uint8_t>, 6> genericData;
+		for (size_t i = 0; i < genericTypes.size(); ++i)
+		{
+			decodeStartTime = std::chrono::high_resolution_clock::now();
+
+			ChunkMemoryEntry entry;
+			if (!chunkData->GetGenericData(static_cast<uint32_t>(genericTypes[i]), entry) || !chunkData->Decompress(entry, genericData[i]))
+				return false;
+
+			genericData[i].resize(entry.UncompressedSize);
+
+			if (genericTypes[i] == CachedDataType::IndexBuffer)
+			{
+				decodeEndTime = std::chrono::high_resolution_clock::now();
+				decodeDeltaTime = std::chrono::duration<float, std::chrono::seconds::period>(decodeEndTime - decodeStartTime).count();
+				decodeRate = decodeDeltaTime > 0.0f ? static_cast<float>(entry.UncompressedSize) / decodeDeltaTime / 1e9f : 0.0f;
+				Logger::Verbose("Index data decoded in {} seconds ({} GB/s).", decodeDeltaTime, decodeRate);
+			}
+		}
+
+		const std::vector<uint8_t>& indexData = genericData[0];
+		const std::vector<uint8_t>& meshInfoData = genericData[1];
+		const std::vector<uint8_t>& indirectData = genericData[2];
+		const std::vector<uint8_t>& boundsData = genericData[3];
+		const std::vector<uint8_t>& lodData = genericData[4];
+		const std::vector<uint8_t>& clusterData = genericData[5];
+
+		// Cached meshes have no CPU side geometry, they are baked into the buffers and can only be hidden.
+		uint32_t meshCount = static_cast<uint32_t>(indirectData.size() / sizeof(IndexedIndirectCommand));
+		if (boundsData.size() != meshCount * sizeof(RenderMeshBounds))
+		{
+			Logger::Info("Scene cache bounds layout does not match, rebuilding.");
+			return false;
+		}
+
+		m_meshCapacity = meshCount;
+		m_slotCapacity = meshCount;
+		m_meshInfos.resize(meshCount);
+		m_active.assign(meshCount, true);
+		m_bakedMeshes.assign(meshCount, true);
+		m_meshClusterRanges.assign(meshCount, { 0, 0 });
+		m_meshDirtyFlags.assign(meshCount, 0);
+
+		for (size_t i = 0; i < vertexStreamCount; ++i)
+		{
+			m_vertexStrides.push_back(vertexStrides[i]);
+			std::unique_ptr<GrowableBuffer>& buffer = m_vertexBuffers.emplace_back(std::make_unique<GrowableBuffer>("vertexBuffer", BufferUsageFlags::VertexBuffer,
+				MaterialStageFlags::VertexInput, MaterialAccessFlags::VertexAttributeRead, false));
+			buffer->Write(0, vertexData[i].data(), vertexData[i].size());
+		}
+
+		uint64_t vertexCount = vertexData[0].size() / vertexStrides[0];
+		m_vertexAllocator.Reset(vertexCount);
+		m_vertexAllocator.Allocate(vertexCount);
+
+		uint64_t indexCount = indexData.size() / sizeof(uint32_t);
+		m_indexAllocator.Reset(indexCount);
+		m_indexAllocator.Allocate(indexCount);
+		m_indexBuffer.Write(0, indexData.data(), indexData.size());
+
+		uint64_t clusterCount = clusterData.size() / sizeof(RenderMeshCluster);
+		m_clusterAllocator.Reset(clusterCount);
+		m_clusterAllocator.Allocate(clusterCount);
+		m_clusterBuffer.Write(0, clusterData.data(), clusterData.size());
+
+		m_indirectDrawBuffer.Write(0, &m_slotCapacity, sizeof(uint32_t));
+		m_indirectDrawBuffer.Write(sizeof(uint32_t), indirectData.data(), indirectData.size());
+		m_meshInfoBuffer.Write(0, meshInfoData.data(), meshInfoData.size());
+		m_boundsBuffer.Write(0, boundsData.data(), boundsData.size());
+		m_lodBuffer.Write(0, lodData.data(), lodData.size());
+
+		return true;
+	}
+
+	bool GeometryBatch::CommitBuffers(const IDevice& device, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, const IResourceFactory& resourceFactory,
+		std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, RetiredResources& retiredResources, bool& reallocated)
+	{
+		reallocated = false;
+		StagingRing& stagingRing = m_renderer.GetGeometryStagingRing();
+		auto commit = [&](GrowableBuffer& buffer)
+			{
+				bool bufferReallocated = false;
+				if (!buffer.Commit(device, commandBuffer, acquireCommandBuffer, resourceFactory, &stagingRing, temporaryBuffers, retiredResources.buffers, bufferReallocated))
+					return false;
+
+				reallocated |= bufferReallocated;
+				return true;
+			};
+
+		for (std::unique_ptr<GrowableBuffer>& vertexBuffer : m_vertexBuffers)
+		{
+			if (!commit(*vertexBuffer))
+				return false;
+		}
+
+		if (!commit(m_indexBuffer) || !commit(m_meshInfoBuffer) || !commit(m_indirectDrawBuffer)
+			|| !commit(m_lodBuffer) || !commit(m_clusterBuffer) || !commit(m_boundsBuffer))
+		{
+			return false;
+		}
+
+		m_vertexBufferViews.resize(m_vertexBuffers.size());
+		for (size_t i = 0; i < m_vertexBuffers.size(); ++i)
+		{
+			m_vertexBufferViews[i] = m_vertexBuffers[i]->Get();
+		}
+
+		retiredResources.stagingSubmission = stagingRing.Submit();
+		return true;
+	}
+
+	bool GeometryBatch::StageImageData(const ICommandBuffer& commandBuffer, const IRenderImage* destinationImage, uint32_t mipLevel,
+		const void* data, uint64_t size)
+	{
+		// Mips are copied in runs of whole block rows so a large mip does not need one contiguous staging allocation.
+		uint32_t blockHeight = IsBlockCompressed(destinationImage->GetFormat()) ? 4 : 1;
+		uint32_t height = std::max(destinationImage->GetDimensions().y >> mipLevel, 1u);
+		uint32_t blockRows = (height + blockHeight - 1) / blockHeight;
+		uint64_t rowSize = size / blockRows;
+		StagingRing& stagingRing = m_renderer.GetGeometryStagingRing();
+		uint32_t rowsPerChunk = static_cast<uint32_t>(std::max<uint64_t>(stagingRing.GetChunkSize() / std::max<uint64_t>(rowSize, 1), 1));
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (uint32_t row = 0; row < blockRows; row += rowsPerChunk)
+		{
+			uint32_t rowCount = std::min(rowsPerChunk, blockRows - row);
+			StagingAllocation allocation;
+			if (!stagingRing.Stage(bytes + row * rowSize, rowCount * rowSize, ImageStagingAlignment, allocation))
+				return false;
+
+			uint32_t firstTexelRow = row * blockHeight;
+			uint32_t texelRowCount = std::min(rowCount * blockHeight, height - firstTexelRow);
+			allocation.Buffer->CopyToImage(mipLevel, commandBuffer, *destinationImage, allocation.Offset, firstTexelRow, texelRowCount);
+		}
+
+		return true;
+	}
+
+	bool GeometryBatch::OptimiseImages(const IPhysicalDevice& physicalDevice, AsyncData* asyncData)
+	{
+		if (m_uploadedImageCount == m_images.size())
+			return true;
 
 		bool compress = false;
 		if (physicalDevice.SupportsBCTextureCompression() && physicalDevice.FormatSupported(Format::Bc7SrgbBlock))
@@ -714,19 +1553,16 @@ namespace Engine::Rendering
 
 		if (asyncData != nullptr)
 			asyncData->InitSubProgress("Optimising Images", 400.0f);
-		float imageSubTicks = 400.0f / static_cast<float>(m_images.size());
+		float imageSubTicks = 400.0f / static_cast<float>(m_images.size() - m_uploadedImageCount);
 
 		uint32_t totalImageCount = static_cast<uint32_t>(m_images.size());
 		std::atomic_bool textureIssue = false;
-		std::atomic_int imageIndex = 0;
 		std::for_each(
 			std::execution::par,
-			m_images.begin(),
+			m_images.begin() + m_uploadedImageCount,
 			m_images.end(),
-			[&imageIndex, &textureIssue, &totalImageCount, asyncData, compress, imageSubTicks](std::shared_ptr<Image>& image)
+			[&textureIssue, &totalImageCount, asyncData, compress, imageSubTicks](std::shared_ptr<Image>& image)
 			{
-				int32_t idx = imageIndex++;
-
 				if (textureIssue || image.get() == nullptr)
 				{
 					return;
@@ -743,7 +1579,8 @@ namespace Engine::Rendering
 					return;
 				}
 
-				asyncData->AddSubProgress(imageSubTicks);
+				if (asyncData != nullptr)
+					asyncData->AddSubProgress(imageSubTicks);
 			});
 
 		if (textureIssue)
@@ -753,38 +1590,105 @@ namespace Engine::Rendering
 			return false;
 		}
 
-		for (size_t i = 0; i < m_images.size(); ++i)
+		return true;
+	}
+
+	bool GeometryBatch::SetupRenderImage(AsyncData* asyncData, const IDevice& device, const IPhysicalDevice& physicalDevice,
+		const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, ChunkData* chunkData, const IResourceFactory& resourceFactory, float maxAnisotropy,
+		uint32_t& imageCount)
+	{
+		if (chunkData != nullptr && chunkData->LoadedFromDisk())
 		{
-			std::shared_ptr<Image>& image = m_images[i];
-			if (image.get() == nullptr)
+			std::vector<ImageData>* cachedImageData;
+			if (!chunkData->GetImageData(&cachedImageData))
 			{
-				continue;
+				return false;
 			}
 
-			uint32_t componentCount = image->GetComponentCount();
-			Format format;
-			if (image->IsNormalMap() || image->IsMetallicRoughnessMap())
-			{
-				format = image->IsCompressed() ? Format::Bc5UnormBlock : Format::R8G8B8A8Unorm;
-			}
-			else if (componentCount == 4)
+			imageCount = static_cast<uint32_t>(cachedImageData->size());
+			m_imageArray.reserve(cachedImageData->size());
+
+			float subTicks = 400.0f / static_cast<float>(cachedImageData->size());
+
+			std::vector<uint8_t> decompressBuffer;
+			for (auto it = cachedImageData->begin(); it != cachedImageData->end(); ++it)
 			{
-				bool srgb = image->IsSRGB();
-				if (image->IsCompressed())
+				const ImageData& imageData = *it;
+				Format format = static_cast<Format>(imageData.Header.Format);
+				glm::uvec3 dimensions(imageData.Header.Width, imageData.Header.Height, 1);
+
+				if (!chunkData->Decompress(imageData.Entry, decompressBuffer))
 				{
-					format = srgb ? Format::Bc7SrgbBlock : Format::Bc7UnormBlock;
+					return false;
 				}
-				else
+
+				std::vector<std::span<const uint8_t>> spans(imageData.Header.MipLevels);
+				uint64_t offset = 0;
+				uint64_t size = imageData.Header.FirstMipSize;
+				for (uint32_t i = 0; i < imageData.Header.MipLevels; ++i)
+				{
+					spans[i] = std::span<const uint8_t>(decompressBuffer.begin() + offset, size);
+					offset += size;
+					size /= 4;
+				}
+
+				std::unique_ptr<IRenderImage>& renderImage = m_imageArray.emplace_back(std::move(resourceFactory.CreateRenderImage()));
+				bool imageInitialised = renderImage->Initialise("SceneImage", device, ImageType::e2D, format, dimensions,
+					imageData.Header.MipLevels, 1, ImageTiling::Optimal,
+					ImageUsageFlags::TransferSrc | ImageUsageFlags::TransferDst | ImageUsageFlags::Sampled, ImageAspectFlags::Color,
+					MemoryUsage::AutoPreferDevice, AllocationCreateFlags::None, SharingMode::Exclusive);
+
+				if (!imageInitialised)
 				{
-					format = srgb ? Format::R8G8B8A8Srgb : Format::R8G8B8A8Unorm;
+					return false;
 				}
+
+				std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+				renderImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::TransferDst, *memoryBarriers);
+				commandBuffer.MemoryBarrier(*memoryBarriers);
+				memoryBarriers->Clear();
+
+				for (uint32_t i = 0; i < imageData.Header.MipLevels; ++i)
+				{
+					if (!StageImageData(commandBuffer, renderImage.get(), i, spans[i].data(), spans[i].size()))
+						return false;
+				}
+
+				TransitionForSampling(*renderImage, commandBuffer, acquireCommandBuffer, *memoryBarriers);
+
+				if (asyncData != nullptr)
+					asyncData->AddSubProgress(subTicks);
 			}
-			else
+
+			// Cached images take the first indices, images added afterwards are appended behind them.
+			m_images.resize(m_imageArray.size());
+			m_uploadedImageCount = static_cast<uint32_t>(m_imageArray.size());
+
+			acquireCommandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+				MaterialStageFlags::FragmentShader, MaterialAccessFlags::ShaderRead);
+
+			return true;
+		}
+
+		imageCount = 0;
+		if (m_uploadedImageCount == m_images.size())
+			return true;
+
+		// The images were already optimised by OptimiseImages, outside the staging ring lock.
+		m_imageArray.reserve(m_images.size());
+
+		for (size_t i = m_uploadedImageCount; i < m_images.size(); ++i)
+		{
+			std::shared_ptr<Image>& image = m_images[i];
+			if (image.get() == nullptr)
 			{
-				Logger::Error("Images without exactly 4 channels are currently not supported.");
-				return false;
+				continue;
 			}
 
+			Format format;
+			if (!GetImageFormat(*image, format))
+				return false;
+
 			const std::vector<std::vector<uint8_t>>& pixels = image->GetPixels();
 			const glm::uvec2& size = image->GetSize();
 			glm::uvec3 dimensions(size.x, size.y, 1);
@@ -807,8 +1711,7 @@ namespace Engine::Rendering
 
 			for (size_t i = 0; i < pixels.size(); ++i)
 			{
-				if (!CreateImageStagingBuffer(device, resourceFactory, commandBuffer, renderImage.get(), static_cast<uint32_t>(i),
-					pixels[i].data(), pixels[i].size(), temporaryBuffers))
+				if (!StageImageData(commandBuffer, renderImage.get(), static_cast<uint32_t>(i), pixels[i].data(), pixels[i].size()))
 					return false;
 			}
 
@@ -821,155 +1724,270 @@ namespace Engine::Rendering
 				chunkData->AddImageData(header, pixels);
 			}
 
-			renderImage->AppendImageLayoutTransition(commandBuffer, ImageLayout::ShaderReadOnly, *memoryBarriers);
-			commandBuffer.MemoryBarrier(*memoryBarriers);
+			TransitionForSampling(*renderImage, commandBuffer, acquireCommandBuffer, *memoryBarriers);
 
 			++imageCount;
 
 			image.reset();
 		}
 
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+		m_uploadedImageCount = static_cast<uint32_t>(m_images.size());
+
+		acquireCommandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
 			MaterialStageFlags::FragmentShader, MaterialAccessFlags::ShaderRead);
 
 		return true;
 	}
 
-	bool GeometryBatch::UploadMeshInfoBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-		std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize)
+	bool GeometryBatch::SubmitUpload(ChunkData* chunkData, AsyncData* asyncData)
 	{
-		bool initialised = buffer->Initialise("meshInfoBuffer", device, dataSize,
-			BufferUsageFlags::TransferDst | BufferUsageFlags::StorageBuffer,
-			MemoryUsage::AutoPreferDevice,
-			AllocationCreateFlags::None,
-			SharingMode::Exclusive);
+		auto startTime = std::chrono::high_resolution_clock::now();
 
-		if (!initialised)
-		{
-			return false;
-		}
+		bool loadCache = chunkData != nullptr && chunkData->LoadedFromDisk();
+		std::shared_ptr<RetiredResources> retiredResources = std::make_shared<RetiredResources>();
+		std::shared_ptr<bool> reallocated = std::make_shared<bool>(false);
 
-		if (!CreateStagingBuffer(device, resourceFactory, commandBuffer, buffer, data,
-			dataSize, temporaryBuffers))
-			return false;
+		// Nothing renders from the batch until its first upload completes, so that upload can run on the transfer queue.
+		// Later uploads update buffers in flight frames are reading and stay on the graphics queue.
+		bool transfer = m_creating;
 
-		commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
-			MaterialStageFlags::VertexShader, MaterialAccessFlags::ShaderRead);
+		// Tracked so the owner can tell when the batch is no longer referenced by queued resource commands.
+		++m_pendingUploads;
+		bool submitted = m_renderer.SubmitResourceCommand([this, chunkData, asyncData, loadCache, retiredResources, reallocated](const IDevice& device,
+			const IPhysicalDevice& physicalDevice, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer,
+			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers)
+			{
+				const IResourceFactory& resourceFactory = m_renderer.GetResourceFactory();
+				std::lock_guard<std::mutex> lock(m_retiredMutex);
 
-		return true;
+				if (loadCache)
+				{
+					if (!LoadCachedData(chunkData))
+						return false;
+				}
+				else
+				{
+					if (!StageVertexData())
+						return false;
+
+					StageIndexData();
+					StageMeshSlots();
+
+					if (chunkData != nullptr)
+						WriteCacheData(chunkData);
+				}
+
+				if (asyncData != nullptr)
+					asyncData->AddSubProgress(100.0f);
+
+				// Compressing images can take a while, it happens before taking the ring so completed uploads are not held up.
+				if (!loadCache && !OptimiseImages(physicalDevice, asyncData))
+				{
+					if (asyncData != nullptr && asyncData->State != AsyncState::Cancelled)
+						asyncData->State = AsyncState::Failed;
+					return false;
+				}
+
+				StagingRing& stagingRing = m_renderer.GetGeometryStagingRing();
+				std::lock_guard<std::mutex> stagingLock(m_renderer.GetGeometryStagingMutex());
+				if (!stagingRing.IsInitialised() && !stagingRing.Initialise(device, resourceFactory))
+				{
+					Logger::Error("Failed to create geometry staging ring.");
+					return false;
+				}
+
+				uint32_t imageCount;
+				size_t previousImageCount = m_imageArray.size();
+				if (!SetupRenderImage(asyncData, device, physicalDevice, commandBuffer, acquireCommandBuffer, chunkData, resourceFactory, physicalDevice.GetMaxAnisotropy(), imageCount)
+					|| !CommitBuffers(device, commandBuffer, acquireCommandBuffer, resourceFactory, temporaryBuffers, *retiredResources, *reallocated))
+				{
+					if (asyncData != nullptr && asyncData->State != AsyncState::Cancelled)
+						asyncData->State = AsyncState::Failed;
+					return false;
+				}
+
+				// Passes bind the buffers and image array when the render graph is built, so any replacement requires a rebuild.
+				*reallocated = *reallocated || m_imageArray.size() != previousImageCount;
+
+				// Regions freed before this upload are no longer referenced by it, they can be reused once prior frames complete.
+				retiredResources->allocations = std::move(m_pendingFrees);
+				m_pendingFrees.clear();
+
+				return true;
+			}, [this, startTime, retiredResources, reallocated]()
+				{
+					{
+						std::lock_guard<std::mutex> lock(m_retiredMutex);
+						StagingRing& stagingRing = m_renderer.GetGeometryStagingRing();
+						std::lock_guard<std::mutex> stagingLock(m_renderer.GetGeometryStagingMutex());
+
+						// The upload has completed once this runs, so its staging ring space can be reused immediately.
+						stagingRing.Release(retiredResources->stagingSubmission);
+						retiredResources->framesRemaining = m_renderer.GetConcurrentFrameCount() + 1;
+						m_retiredResources.emplace_back(std::move(*retiredResources));
+
+						const StagingRingStats& stagingStats = stagingRing.GetStats();
+						Logger::Verbose("Geometry batch staging - {} allocations totalling {} bytes, {} overflow pages, peak staging memory {} bytes.",
+							stagingStats.AllocationCount, stagingStats.AllocatedBytes, stagingStats.OverflowPageCount, stagingStats.PeakUsedSize);
+					}
+
+					bool built = !m_creating;
+					m_creating = false;
+
+					auto endTime = std::chrono::high_resolution_clock::now();
+					float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(endTime - startTime).count();
+					if (built)
+						Logger::Verbose("Geometry batch update finished in {} seconds.", deltaTime);
+					else
+						Logger::Verbose("Scene manager build finished in {} seconds.", deltaTime);
+
+					// Rebuild render graph when batch has loaded or its buffers were replaced.
+					if (!built || *reallocated)
+						m_renderer.GetRenderGraph().MarkDirty(RenderGraphChange::Resources);
+
+					--m_pendingUploads;
+				}, transfer);
+
+		if (!submitted)
+			--m_pendingUploads;
+
+		return submitted;
 	}
 
-	bool GeometryBatch::SetupMeshInfoBuffer(const IDevice& device, const ICommandBuffer& commandBuffer,
-		ChunkData* chunkData, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory)
+	bool GeometryBatch::Build(ChunkData* chunkData, AsyncData& asyncData)
 	{
+		if (!m_creating)
+			return Flush();
+
+		bool quantiseVertices = m_renderer.GetVertexQuantisationState();
 		if (chunkData != nullptr && chunkData->LoadedFromDisk())
 		{
 			ChunkMemoryEntry entry;
-			if (!chunkData->GetGenericData(static_cast<uint32_t>(CachedDataType::MeshInfo), entry))
+			std::vector<uint8_t> decompressBuffer;
+			if (!chunkData->GetGenericData(static_cast<uint32_t>(CachedDataType::VertexLayout), entry)
+				|| !chunkData->Decompress(entry, decompressBuffer) || entry.UncompressedSize != sizeof(uint32_t))
 			{
 				return false;
 			}
 
-			std::vector<uint8_t> decompressBuffer;
-			chunkData->Decompress(entry, decompressBuffer);
-
-			m_meshInfoBuffer = std::move(resourceFactory.CreateBuffer());
-
-			return UploadMeshInfoBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-				m_meshInfoBuffer.get(), decompressBuffer.data(), decompressBuffer.size());
+			uint32_t cachedLayout = *reinterpret_cast<const uint32_t*>(decompressBuffer.data());
+			if ((cachedLayout != 0) != quantiseVertices)
+			{
+				Logger::Info("Scene cache vertex layout does not match the requested layout, rebuilding.");
+				return false;
+			}
 		}
-
-		uint64_t totalSize = 0;
-		for (uint32_t i = 0; i < m_meshCapacity; ++i)
+		else
 		{
-			if (!m_active[i])
-				continue;
+			if (m_optimisePending && !Optimise())
+			{
+				asyncData.State = AsyncState::Failed;
+				return false;
+			}
 
-			totalSize += sizeof(RenderMeshInfo);
+			if (chunkData != nullptr)
+			{
+				uint32_t layout = quantiseVertices ? 1 : 0;
+				std::span<uint8_t> cacheData(reinterpret_cast<uint8_t*>(&layout), sizeof(uint32_t));
+				chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::VertexLayout), cacheData);
+			}
 		}
 
-		std::vector<uint8_t> uniformBufferData;
-		uniformBufferData.resize(totalSize);
-		totalSize = 0;
+		m_quantisedVertices = quantiseVertices;
+
+		return SubmitUpload(chunkData, &asyncData);
+	}
 
-		for (uint32_t i = 0; i < m_meshCapacity; ++i)
+	bool GeometryBatch::Bake(ChunkData& chunkData, AsyncData& asyncData, uint64_t& deviceSize)
+	{
+		if (!m_creating)
 		{
-			if (!m_active[i])
-				continue;
+			Logger::Error("Geometry batch has already been built and cannot be baked.");
+			return false;
+		}
 
-			const MeshInfo& meshInfo = m_meshInfos[i];
-			RenderMeshInfo data = {};
-			data.transform = meshInfo.transform;
-			data.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(meshInfo.transform))));
-			data.colour = meshInfo.colour.GetVec4();
-			data.diffuseImageIndex = static_cast<uint32_t>(meshInfo.diffuseImageIndex);
-			data.normalImageIndex = static_cast<uint32_t>(meshInfo.normalImageIndex);
-			data.metallicRoughnessImageIndex = static_cast<uint32_t>(meshInfo.metallicRoughnessImageIndex);
-			memcpy(uniformBufferData.data() + totalSize, &data, sizeof(RenderMeshInfo));
-			totalSize += sizeof(RenderMeshInfo);
+		if (m_optimisePending && !Optimise())
+		{
+			asyncData.State = AsyncState::Failed;
+			return false;
 		}
 
-		if (chunkData)
-			chunkData->SetGenericData(static_cast<uint32_t>(CachedDataType::MeshInfo), uniformBufferData);
+		bool quantiseVertices = m_renderer.GetVertexQuantisationState();
+		uint32_t layout = quantiseVertices ? 1 : 0;
+		std::span<uint8_t> layoutData(reinterpret_cast<uint8_t*>(&layout), sizeof(uint32_t));
+		chunkData.SetGenericData(static_cast<uint32_t>(CachedDataType::VertexLayout), layoutData);
+		m_quantisedVertices = quantiseVertices;
 
-		m_meshInfoBuffer = std::move(resourceFactory.CreateBuffer());
+		std::lock_guard<std::mutex> lock(m_retiredMutex);
+		if (!StageVertexData())
+			return false;
 
-		return UploadMeshInfoBuffer(device, commandBuffer, resourceFactory, temporaryBuffers,
-			m_meshInfoBuffer.get(), uniformBufferData.data(), uniformBufferData.size());
-	}
+		StageIndexData();
+		StageMeshSlots();
+		WriteCacheData(&chunkData);
+		asyncData.AddSubProgress(100.0f);
 
-	bool GeometryBatch::Build(ChunkData* chunkData, AsyncData& asyncData)
-	{
-		// TODO: Handle resizing
-		if (m_indexBuffer.get() != nullptr)
+		if (!OptimiseImages(m_renderer.GetPhysicalDevice(), &asyncData))
 		{
-			Logger::Error("Rebuilding existing scene render data currently not supported.");
-			asyncData.State = AsyncState::Failed;
+			if (asyncData.State != AsyncState::Cancelled)
+				asyncData.State = AsyncState::Failed;
 			return false;
 		}
 
-		auto startTime = std::chrono::high_resolution_clock::now();
+		// Images are stored with their full mip chain, so the cached pixels match what the device will hold.
+		deviceSize = 0;
+		for (size_t i = m_uploadedImageCount; i < m_images.size(); ++i)
+		{
+			std::shared_ptr<Image>& image = m_images[i];
+			if (image.get() == nullptr)
+				continue;
 
-		return m_renderer.SubmitResourceCommand([this, chunkData, &asyncData](const IDevice& device, const IPhysicalDevice& physicalDevice,
-			const ICommandBuffer& commandBuffer, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers)
-			{
-				const IResourceFactory& resourceFactory = m_renderer.GetResourceFactory();
+			Format format;
+			if (!GetImageFormat(*image, format))
+				return false;
 
-				uint32_t imageCount;
-				if (!SetupVertexBuffers(device, commandBuffer, chunkData, temporaryBuffers, resourceFactory))
-				{
-					return false;
-				}
+			const std::vector<std::vector<uint8_t>>& pixels = image->GetPixels();
+			const glm::uvec2& size = image->GetSize();
+			ImageHeader header;
+			header.Width = static_cast<uint32_t>(size.x);
+			header.Height = static_cast<uint32_t>(size.y);
+			header.Format = static_cast<uint32_t>(format);
+			chunkData.AddImageData(header, pixels);
 
-				asyncData.AddSubProgress(50.0f);
+			for (const std::vector<uint8_t>& mip : pixels)
+				deviceSize += mip.size();
 
-				if (!SetupIndexBuffer(device, commandBuffer, chunkData, temporaryBuffers, resourceFactory))
-				{
-					return false;
-				}
+			image.reset();
+		}
 
-				asyncData.AddSubProgress(50.0f);
+		m_uploadedImageCount = static_cast<uint32_t>(m_images.size());
 
-				if (!SetupRenderImage(&asyncData, device, physicalDevice, commandBuffer, chunkData, temporaryBuffers, resourceFactory, physicalDevice.GetMaxAnisotropy(), imageCount)
-					|| !SetupMeshInfoBuffer(device, commandBuffer, chunkData, temporaryBuffers, resourceFactory)
-					|| !SetupIndirectDrawBuffer(device, commandBuffer, chunkData, temporaryBuffers, resourceFactory)
-					|| !SetupBoundsBuffer(device, commandBuffer, chunkData, temporaryBuffers, resourceFactory))
-				{
-					if (asyncData.State != AsyncState::Cancelled)
-						asyncData.State = AsyncState::Failed;
-					return false;
-				}
+		for (const std::unique_ptr<GrowableBuffer>& vertexBuffer : m_vertexBuffers)
+			deviceSize += vertexBuffer->GetRequiredSize();
+
+		deviceSize += m_indexBuffer.GetRequiredSize() + m_meshInfoBuffer.GetRequiredSize() + m_indirectDrawBuffer.GetRequiredSize()
+			+ m_lodBuffer.GetRequiredSize() + m_clusterBuffer.GetRequiredSize() + m_boundsBuffer.GetRequiredSize();
 
+		return true;
+	}
+
+	bool GeometryBatch::Flush()
+	{
+		if (m_creating)
+		{
+			Logger::Error("Geometry batch must be built before changes can be flushed.");
+			return false;
+		}
+
+		if (m_optimisePending && !Optimise())
+			return false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_retiredMutex);
+			if (m_dirtyMeshes.empty() && m_clearedClusterRanges.empty() && m_pendingFrees.empty() && m_uploadedImageCount == m_images.size())
 				return true;
-			}, [this, startTime]()
-				{
-					m_creating = false;
-					auto endTime = std::chrono::high_resolution_clock::now();
-					float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(endTime - startTime).count();
-					Logger::Verbose("Scene manager build finished in {} seconds.", deltaTime);
+		}
 
-					// Rebuild render graph when batch has loaded.
-					m_renderer.GetRenderGraph().MarkDirty();
-				});
+		return SubmitUpload(nullptr, nullptr);
 	}
 }
\ No newline at end of file
@@ -2,12 +2,20 @@
 
 #include <memory>
 #include <vector>
+#include <array>
 #include <stack>
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include "../Resources/IndexedIndirectCommand.hpp"
 #include "Core/VertexData.hpp"
+#include "Core/MeshOptimiser.hpp"
+#include "Core/BoundingVolume.hpp"
+#include "Core/FreeListAllocator.hpp"
 #include "../Resources/MeshInfo.hpp"
+#include "GrowableBuffer.hpp"
+#include "StagingRing.hpp"
 
 namespace Engine
 {
@@ -32,27 +40,67 @@ namespace Engine::Rendering
 	{
 	public:
 		GeometryBatch(Renderer& renderer);
+		~GeometryBatch();
 
-		bool CreateMesh(const std::vector<VertexData>& vertexData,
+		EXPORT bool CreateMesh(const std::vector<VertexData>& vertexData,
 			const std::vector<uint32_t>& indices,
 			const glm::mat4& transform,
 			const Colour& colour,
 			std::shared_ptr<Image> diffuseImage,
 			std::shared_ptr<Image> normalImage,
 			std::shared_ptr<Image> metallicRoughnessImage,
-			bool convertToLHS);
+			bool convertToLHS,
+			uint32_t* meshId = nullptr);
+
+		// Removes a mesh, its geometry is released once no other mesh shares it and in flight frames have completed.
+		EXPORT bool DestroyMesh(uint32_t meshId);
+
+		// Per mesh updates are coalesced until the next Flush, which only uploads the records that changed.
+		bool SetMeshTransform(uint32_t meshId, const glm::mat4& transform);
+		bool SetMeshColour(uint32_t meshId, const Colour& colour);
+		bool SetMeshImages(uint32_t meshId,
+			std::shared_ptr<Image> diffuseImage,
+			std::shared_ptr<Image> normalImage,
+			std::shared_ptr<Image> metallicRoughnessImage);
 
 		bool Optimise();
 		bool Build(ChunkData* chunkData, AsyncData& asyncData);
 
-		inline const IBuffer& GetIndirectDrawBuffer() const { return *m_indirectDrawBuffer; }
-		inline const IBuffer& GetBoundsBuffer() const { return *m_boundsBuffer; }
-		inline const std::vector<std::unique_ptr<IBuffer>>& GetVertexBuffers() const { return m_vertexBuffers; }
-		inline const IBuffer& GetIndexBuffer() const { return *m_indexBuffer; }
-		inline const IBuffer& GetMeshInfoBuffer() const { return *m_meshInfoBuffer; }
+		// Writes the batch to the chunk data without creating device resources or touching the render graph, so a cache
+		// can be prepared for content that is not shown yet. Device size receives the bytes its buffers and images will
+		// occupy once loaded. The batch cannot be built afterwards.
+		bool Bake(ChunkData& chunkData, AsyncData& asyncData, uint64_t& deviceSize);
+
+		// Uploads meshes created, destroyed or updated since the last build into the existing buffers.
+		// Must be called between frames on the render thread once the batch has been built.
+		bool Flush();
+
+		// Called once per frame to recycle buffer regions and buffers that frames in flight can no longer reference.
+		void ReleaseRetiredResources();
+
+		// Totals of the renderer's shared geometry staging ring, the peak includes overflow pages alive at the same time as the ring.
+		StagingRingStats GetStagingStats();
+
+		inline const IBuffer& GetIndirectDrawBuffer() const { return *m_indirectDrawBuffer.Get(); }
+		inline const IBuffer& GetBoundsBuffer() const { return *m_boundsBuffer.Get(); }
+		inline const std::vector<IBuffer*>& GetVertexBuffers() const { return m_vertexBufferViews; }
+		inline const IBuffer& GetIndexBuffer() const { return *m_indexBuffer.Get(); }
+		inline const IBuffer& GetMeshInfoBuffer() const { return *m_meshInfoBuffer.Get(); }
+		inline const IBuffer& GetLODBuffer() const { return *m_lodBuffer.Get(); }
+		inline const IBuffer& GetClusterBuffer() const { return *m_clusterBuffer.Get(); }
 		inline const std::vector<std::unique_ptr<IRenderImage>>& GetImages() const { return m_imageArray; }
 		inline bool IsBuilt() const { return !m_creating; }
-		inline uint32_t GetMeshCapacity() const { return m_meshCapacity; }
+		inline uint32_t GetMeshCapacity() const { return m_slotCapacity; }
+		inline uint32_t GetClusterCount() const { return static_cast<uint32_t>(m_clusterAllocator.GetCapacity()); }
+		// Every visible cluster is drawn on its own, while meshes drawn whole add at most one draw each.
+		inline uint32_t GetClusterDrawCapacity() const { return GetClusterCount() + m_slotCapacity; }
+		inline bool HasQuantisedVertices() const { return m_quantisedVertices; }
+		inline bool HasPendingUploads() const { return m_pendingUploads > 0; }
+
+		// Slots for unique vertex data, index data and their pairings, released slots are reused before new ones are added.
+		inline size_t GetVertexDataSlotCount() const { return m_vertexDataArrays.size(); }
+		inline size_t GetIndexDataSlotCount() const { return m_indexArrays.size(); }
+		inline size_t GetMeshDetailSlotCount() const { return m_meshDetails.size(); }
 
 	private:
 		enum class CachedDataType
@@ -60,72 +108,152 @@ namespace Engine::Rendering
 			IndexBuffer,
 			MeshInfo,
 			IndirectDrawBuffer,
-			BoundsBuffer
+			BoundsBuffer,
+			LODBuffer,
+			ClusterBuffer,
+			VertexLayout
+		};
+
+		struct MeshDetail
+		{
+			size_t indexBufferIndex;
+			size_t vertexBufferIndex;
+			std::vector<MeshLOD> lods;
+			std::vector<uint32_t> lodIndexOffsets;
+			std::vector<MeshCluster> clusters;
+			std::vector<uint32_t> clusterIndices;
+			uint32_t clusterIndexOffset;
+			uint64_t indexAllocation;
+			uint32_t referenceCount;
+			bool mirrored;
+			bool generated;
+			bool uploaded;
 		};
 
-		bool SetupIndirectDrawBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory);
-		bool UploadIndirectDrawBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, uint32_t drawCount, size_t dataSize);
+		struct RetiredAllocation
+		{
+			FreeListAllocator* allocator;
+			uint64_t offset;
+		};
+
+		struct RetiredResources
+		{
+			std::vector<std::unique_ptr<IBuffer>> buffers;
+			std::vector<RetiredAllocation> allocations;
+			uint64_t stagingSubmission;
+			uint32_t framesRemaining;
+		};
+
+		struct MeshOptimiseJob
+		{
+			size_t vertexBufferIndex;
+			std::vector<size_t> indexBufferIndices;
+			bool remapVertices;
+		};
+
+		bool FindIndexData(uint64_t hash, const std::vector<uint32_t>& indices, size_t& indexBufferIndex);
+		bool FindVertexData(uint64_t hash, const std::vector<VertexData>& vertexData, bool convertToLHS, size_t& vertexBufferIndex);
+		bool VertexDataMatches(const std::vector<std::unique_ptr<VertexData>>& stored, const std::vector<VertexData>& vertexData, bool convertToLHS);
 
-		bool SetupBoundsBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory);
-		bool UploadBoundsBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize);
+		bool IsMeshMutable(uint32_t meshId) const;
+		void MarkMeshDirty(uint32_t meshId, uint8_t flags);
+		void AddImage(const std::shared_ptr<Image>& image, size_t& imageIndex);
 
-		bool SetupVertexBuffers(const IDevice& device, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory);
+		void ReleaseVertexData(size_t vertexBufferIndex);
+		void ReleaseIndexData(size_t indexBufferIndex);
+		void ReleaseMeshDetail(size_t meshDetailIndex);
+		void RetireAllocation(FreeListAllocator& allocator, uint64_t offset);
 
-		bool SetupIndexBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory);
-		bool UploadIndexBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize);
+		bool GenerateLODs();
+		bool GenerateClusters();
+		bool QuantiseVertexData(const std::vector<size_t>& vertexBufferIndices, std::vector<std::array<std::vector<uint8_t>, 4>>& quantisedStreams);
 
-		bool SetupRenderImage(AsyncData* asyncData, const IDevice& device, const IPhysicalDevice& physicalDevice, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory, float maxAnisotropy, uint32_t& imageCount);
+		uint64_t AllocateRange(FreeListAllocator& allocator, uint64_t size);
+		void ReserveRange(FreeListAllocator& allocator, uint64_t size);
 
-		bool SetupMeshInfoBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, ChunkData* chunkData,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, const IResourceFactory& resourceFactory);
-		bool UploadMeshInfoBuffer(const IDevice& device, const ICommandBuffer& commandBuffer, const IResourceFactory& resourceFactory,
-			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, IBuffer* buffer, const void* data, size_t dataSize);
+		bool StageVertexData();
+		void StageIndexData();
+		void StageMeshSlots();
+		void WriteCacheData(ChunkData* chunkData);
+		bool LoadCachedData(ChunkData* chunkData);
+		bool CommitBuffers(const IDevice& device, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, const IResourceFactory& resourceFactory,
+			std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers, RetiredResources& retiredResources, bool& reallocated);
+		bool SubmitUpload(ChunkData* chunkData, AsyncData* asyncData);
 
-		bool CreateStagingBuffer(const IDevice& device, const IResourceFactory& resourceFactory,
-			const ICommandBuffer& commandBuffer, const IBuffer* destinationBuffer, const void* data,
-			uint64_t size, std::vector<std::unique_ptr<IBuffer>>& copyBufferCollection);
+		bool OptimiseImages(const IPhysicalDevice& physicalDevice, AsyncData* asyncData);
+		bool SetupRenderImage(AsyncData* asyncData, const IDevice& device, const IPhysicalDevice& physicalDevice, const ICommandBuffer& commandBuffer,
+			const ICommandBuffer& acquireCommandBuffer, ChunkData* chunkData, const IResourceFactory& resourceFactory, float maxAnisotropy, uint32_t& imageCount);
 
-		bool CreateImageStagingBuffer(const IDevice& device, const IResourceFactory& resourceFactory,
-			const ICommandBuffer& commandBuffer, const IRenderImage* destinationImage, uint32_t mipLevel, const void* data, uint64_t size,
-			std::vector<std::unique_ptr<IBuffer>>& copyBufferCollection);
+		bool StageImageData(const ICommandBuffer& commandBuffer, const IRenderImage* destinationImage, uint32_t mipLevel,
+			const void* data, uint64_t size);
 
 		Renderer& m_renderer;
 
-		std::unique_ptr<IBuffer> m_indirectDrawBuffer;
-		std::vector<std::unique_ptr<IBuffer>> m_vertexBuffers;
-		std::unique_ptr<IBuffer> m_indexBuffer;
-		std::unique_ptr<IBuffer> m_boundsBuffer;
-		std::unique_ptr<IBuffer> m_meshInfoBuffer;
+		GrowableBuffer m_indirectDrawBuffer;
+		std::vector<std::unique_ptr<GrowableBuffer>> m_vertexBuffers;
+		std::vector<IBuffer*> m_vertexBufferViews;
+		GrowableBuffer m_indexBuffer;
+		GrowableBuffer m_boundsBuffer;
+		GrowableBuffer m_meshInfoBuffer;
+		GrowableBuffer m_lodBuffer;
+		GrowableBuffer m_clusterBuffer;
 		std::vector<std::unique_ptr<IRenderImage>> m_imageArray;
 
 		std::vector<uint32_t> m_vertexOffsets;
 		std::vector<uint32_t> m_indexOffsets;
 		std::vector<uint32_t> m_indexCounts;
+		std::vector<uint32_t> m_vertexStrides;
+
+		// Vertices, indices and clusters are sub-allocated in element units, per mesh records are indexed by mesh id.
+		FreeListAllocator m_vertexAllocator;
+		FreeListAllocator m_indexAllocator;
+		FreeListAllocator m_clusterAllocator;
 
 		std::stack<uint32_t> m_recycledIds;
 		std::vector<bool> m_active;
+		std::vector<bool> m_bakedMeshes;
+		std::vector<std::pair<uint64_t, uint32_t>> m_meshClusterRanges;
+		std::vector<uint32_t> m_dirtyMeshes;
+		std::vector<uint8_t> m_meshDirtyFlags;
+		std::vector<std::pair<uint64_t, uint32_t>> m_clearedClusterRanges;
 		std::atomic<bool> m_creating;
+		std::atomic<uint32_t> m_pendingUploads;
 		uint32_t m_meshCapacity;
+		uint32_t m_slotCapacity;
+		uint32_t m_uploadedImageCount;
+		bool m_optimisePending;
+		bool m_quantisedVertices;
+
+		std::mutex m_retiredMutex;
+		std::vector<RetiredAllocation> m_pendingFrees;
+		std::vector<RetiredResources> m_retiredResources;
 
+		std::stack<size_t> m_recycledVertexData;
+		std::stack<size_t> m_recycledIndexData;
+		std::stack<size_t> m_recycledMeshDetails;
 		std::vector<std::vector<std::unique_ptr<VertexData>>> m_vertexDataArrays;
 		std::vector<std::unique_ptr<std::vector<uint32_t>>> m_indexArrays;
+		std::vector<uint32_t> m_vertexReferenceCounts;
+		std::vector<uint32_t> m_indexReferenceCounts;
+		std::vector<uint64_t> m_vertexDataHashes;
+		std::vector<uint64_t> m_indexDataHashes;
+		std::vector<bool> m_vertexDataUploaded;
+		std::vector<bool> m_indexDataUploaded;
+		std::vector<LocalBounds> m_vertexBounds;
+		std::vector<glm::vec3> m_positionOffsets;
+		std::vector<glm::vec3> m_positionScales;
+		std::vector<MeshDetail> m_meshDetails;
 		std::vector<Engine::Rendering::MeshInfo> m_meshInfos;
 		std::vector<std::shared_ptr<Image>> m_images;
-		std::vector<uint32_t> m_vertexBufferOffsets;
-		std::vector<uint32_t> m_indexBufferOffsets;
 
 		std::unordered_map<uint64_t, size_t> m_imageHashTable;
-		std::unordered_map<uint64_t, size_t> m_vertexDataHashTable;
-		std::unordered_map<uint64_t, size_t> m_indexDataHashTable;
-
-		std::vector<IndexedIndirectCommand> m_indirectDrawCommands;
+		std::unordered_multimap<uint64_t, size_t> m_vertexDataHashTable;
+		std::unordered_multimap<uint64_t, size_t> m_indexDataHashTable;
+		std::vector<bool> m_vertexDataMirrored;
+		uint32_t m_deduplicationRequests;
+		uint32_t m_vertexDataHits;
+		uint32_t m_indexDataHits;
+		uint32_t m_hashCollisions;
+		std::unordered_map<uint64_t, size_t> m_meshDetailHashTable;
 	};
 }
\ No newline at end of file
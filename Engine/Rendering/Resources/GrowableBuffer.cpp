@@ -0,0 +1,191 @@
+#include "GrowableBuffer.hpp"
+#include "IBuffer.hpp"
+#include "ICommandBuffer.hpp"
+#include "StagingRing.hpp"
+#include "IMemoryBarriers.hpp"
+#include "../IResourceFactory.hpp"
+#include "Core/Logger.hpp"
+
+namespace Engine::Rendering
+{
+	// Vulkan does not permit zero sized buffers, empty batches still need something to bind.
+	constexpr uint64_t MinBufferSize = 16;
+	constexpr uint64_t StagingAlignment = 16;
+
+	GrowableBuffer::GrowableBuffer(std::string_view name, BufferUsageFlags usage, MaterialStageFlags stageFlags, MaterialAccessFlags accessFlags, bool zeroGrowth)
+		: m_name(name)
+		, m_usage(usage)
+		, m_stageFlags(stageFlags)
+		, m_accessFlags(accessFlags)
+		, m_zeroGrowth(zeroGrowth)
+		, m_buffer(nullptr)
+		, m_size(0)
+		, m_requiredSize(0)
+		, m_writes()
+		, m_writeData()
+	{
+	}
+
+	GrowableBuffer::~GrowableBuffer() = default;
+
+	void GrowableBuffer::Reserve(uint64_t size)
+	{
+		m_requiredSize = std::max(m_requiredSize, size);
+	}
+
+	void GrowableBuffer::Write(uint64_t offset, const void* data, uint64_t size)
+	{
+		if (size == 0)
+			return;
+
+		Reserve(offset + size);
+
+		// Contiguous writes are merged so uploading many small records still records few copies.
+		if (!m_writes.empty())
+		{
+			PendingWrite& last = m_writes.back();
+			if (last.offset + last.size == offset && last.dataOffset + last.size == m_writeData.size())
+			{
+				last.size += size;
+				m_writeData.insert(m_writeData.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+				return;
+			}
+		}
+
+		m_writes.push_back({ offset, m_writeData.size(), size });
+		m_writeData.insert(m_writeData.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+	}
+
+	void GrowableBuffer::GetPendingContents(std::vector<uint8_t>& data) const
+	{
+		data.assign(m_requiredSize, 0);
+		for (const PendingWrite& write : m_writes)
+		{
+			memcpy(data.data() + write.offset, m_writeData.data() + write.dataOffset, write.size);
+		}
+	}
+
+	bool GrowableBuffer::Commit(const IDevice& device, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer,
+		const IResourceFactory& resourceFactory, StagingRing* stagingRing, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers,
+		std::vector<std::unique_ptr<IBuffer>>& retiredBuffers, bool& reallocated)
+	{
+		reallocated = false;
+		if (m_buffer != nullptr && m_requiredSize <= m_size && m_writes.empty())
+			return true;
+
+		uint32_t srcQueueFamily = commandBuffer.GetQueueFamilyIndex();
+		uint32_t dstQueueFamily = acquireCommandBuffer.GetQueueFamilyIndex();
+		if (srcQueueFamily != dstQueueFamily && m_buffer != nullptr)
+		{
+			Logger::Error("Buffer {} is owned by the graphics queue and cannot be updated from the transfer queue.", m_name);
+			return false;
+		}
+
+		if (m_buffer == nullptr || m_requiredSize > m_size)
+		{
+			uint64_t newSize = std::max(m_requiredSize, MinBufferSize);
+			std::unique_ptr<IBuffer> buffer = std::move(resourceFactory.CreateBuffer());
+			if (!buffer->Initialise(m_name, device, newSize,
+				m_usage | BufferUsageFlags::TransferSrc | BufferUsageFlags::TransferDst,
+				MemoryUsage::AutoPreferDevice,
+				AllocationCreateFlags::None,
+				SharingMode::Exclusive))
+			{
+				return false;
+			}
+
+			if (m_buffer != nullptr)
+			{
+				// Earlier uploads into the previous buffer must land before its contents are carried over.
+				commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+					MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryRead);
+				m_buffer->Copy(commandBuffer, *buffer, m_size);
+				retiredBuffers.emplace_back(std::move(m_buffer));
+			}
+
+			// Records beyond the previous size may be read before they are written, so they need to start out empty.
+			if (m_zeroGrowth && newSize > m_size)
+			{
+				std::vector<uint8_t> zeroes(newSize - m_size, 0);
+				m_writes.insert(m_writes.begin(), PendingWrite{ m_size, m_writeData.size(), zeroes.size() });
+				m_writeData.insert(m_writeData.end(), zeroes.begin(), zeroes.end());
+			}
+
+			m_buffer = std::move(buffer);
+			m_size = newSize;
+			reallocated = true;
+		}
+
+		if (!m_writes.empty())
+		{
+			// Wait for earlier readers and for the copy out of a retired buffer before overwriting regions.
+			// A buffer filled on the transfer queue is new, so only earlier transfers can touch it there.
+			MaterialStageFlags readerStageFlags = srcQueueFamily == dstQueueFamily ? m_stageFlags | MaterialStageFlags::Transfer : MaterialStageFlags::Transfer;
+			commandBuffer.MemoryBarrier(readerStageFlags, MaterialAccessFlags::MemoryRead | MaterialAccessFlags::MemoryWrite,
+				MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite);
+
+			if (stagingRing != nullptr)
+			{
+				// Writes are applied in submission order so a later write to the same region wins.
+				// Large writes are split so no single staging allocation exceeds the ring's chunk size.
+				uint64_t chunkSize = stagingRing->GetChunkSize();
+				for (const PendingWrite& write : m_writes)
+				{
+					for (uint64_t chunkOffset = 0; chunkOffset < write.size; chunkOffset += chunkSize)
+					{
+						uint64_t size = std::min(chunkSize, write.size - chunkOffset);
+						StagingAllocation allocation;
+						if (!stagingRing->Stage(m_writeData.data() + write.dataOffset + chunkOffset, size, StagingAlignment, allocation))
+							return false;
+
+						allocation.Buffer->Copy(commandBuffer, *m_buffer, size, allocation.Offset, write.offset + chunkOffset);
+					}
+				}
+			}
+			else
+			{
+				IBuffer* temporaryBuffer = temporaryBuffers.emplace_back(std::move(resourceFactory.CreateBuffer())).get();
+				if (!temporaryBuffer->Initialise(m_name + "Staging", device, m_writeData.size(),
+					BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
+					AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
+					SharingMode::Exclusive))
+				{
+					return false;
+				}
+
+				if (!temporaryBuffer->UpdateContents(m_writeData.data(), 0, m_writeData.size()))
+					return false;
+
+				// Writes are applied in submission order so a later write to the same region wins.
+				for (const PendingWrite& write : m_writes)
+				{
+					temporaryBuffer->Copy(commandBuffer, *m_buffer, write.size, write.dataOffset, write.offset);
+				}
+			}
+		}
+
+		if (srcQueueFamily == dstQueueFamily)
+		{
+			commandBuffer.MemoryBarrier(MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+				m_stageFlags, m_accessFlags);
+		}
+		else
+		{
+			// Release on the transfer queue, the matching acquire makes the writes visible to the graphics queue readers.
+			std::unique_ptr<IMemoryBarriers> memoryBarriers = std::move(resourceFactory.CreateMemoryBarriers());
+			m_buffer->AppendBufferMemoryBarrier(commandBuffer, MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+				m_stageFlags, m_accessFlags, *memoryBarriers, srcQueueFamily, dstQueueFamily);
+			commandBuffer.MemoryBarrier(*memoryBarriers);
+
+			memoryBarriers->Clear();
+			m_buffer->AppendBufferMemoryBarrier(acquireCommandBuffer, MaterialStageFlags::Transfer, MaterialAccessFlags::MemoryWrite,
+				m_stageFlags, m_accessFlags, *memoryBarriers, srcQueueFamily, dstQueueFamily);
+			acquireCommandBuffer.MemoryBarrier(*memoryBarriers);
+		}
+
+		m_writes.clear();
+		m_writeData.clear();
+
+		return true;
+	}
+}
\ No newline at end of file
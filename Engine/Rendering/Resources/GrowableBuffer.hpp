@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include "../Types.hpp"
+
+namespace Engine::Rendering
+{
+	class IDevice;
+	class ICommandBuffer;
+	class IResourceFactory;
+	class IBuffer;
+	class StagingRing;
+
+	// Device local buffer that is updated in place through batched region writes.
+	// Growing allocates a larger buffer and copies the previous contents on the GPU, the old buffer is handed back
+	// to the caller so it can be kept alive until frames that may still reference it have completed.
+	class GrowableBuffer
+	{
+	public:
+		GrowableBuffer(std::string_view name, BufferUsageFlags usage, MaterialStageFlags stageFlags, MaterialAccessFlags accessFlags, bool zeroGrowth);
+		~GrowableBuffer();
+
+		void Reserve(uint64_t size);
+		void Write(uint64_t offset, const void* data, uint64_t size);
+
+		// Flattens the queued writes into a single blob covering the reserved size, gaps are zeroed.
+		void GetPendingContents(std::vector<uint8_t>& data) const;
+
+		// Pending writes are staged through the ring in chunks when one is given, otherwise through a temporary staging buffer.
+		// When the command buffers belong to different queue families the buffer must be new, it is released to the acquiring queue.
+		bool Commit(const IDevice& device, const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer,
+			const IResourceFactory& resourceFactory, StagingRing* stagingRing, std::vector<std::unique_ptr<IBuffer>>& temporaryBuffers,
+			std::vector<std::unique_ptr<IBuffer>>& retiredBuffers, bool& reallocated);
+
+		inline IBuffer* Get() const { return m_buffer.get(); }
+		inline uint64_t GetSize() const { return m_size; }
+		// Size needed to hold every write so far, the next commit grows the buffer to at least this.
+		inline uint64_t GetRequiredSize() const { return m_requiredSize; }
+		inline bool HasPendingWrites() const { return !m_writes.empty() || m_requiredSize > m_size; }
+
+	private:
+		struct PendingWrite
+		{
+			uint64_t offset;
+			uint64_t dataOffset;
+			uint64_t size;
+		};
+
+		std::string m_name;
+		BufferUsageFlags m_usage;
+		MaterialStageFlags m_stageFlags;
+		MaterialAccessFlags m_accessFlags;
+		bool m_zeroGrowth;
+		std::unique_ptr<IBuffer> m_buffer;
+		uint64_t m_size;
+		uint64_t m_requiredSize;
+		std::vector<PendingWrite> m_writes;
+		std::vector<uint8_t> m_writeData;
+	};
+}
\ No newline at end of file
@@ -26,8 +26,11 @@ namespace Engine::Rendering
 			MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode) = 0;
 		virtual bool UpdateContents(const void* data, size_t offset, size_t size) = 0;
 		virtual uint64_t GetDeviceAddress(const IDevice& device) = 0;
-		virtual void Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size) const = 0;
-		virtual void CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination) const = 0;
+		virtual void Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size,
+			size_t sourceOffset = 0, size_t destinationOffset = 0) const = 0;
+		// A row count of zero copies every row of the mip from the first row onwards.
+		virtual void CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination,
+			size_t sourceOffset = 0, uint32_t firstRow = 0, uint32_t rowCount = 0) const = 0;
 
 		virtual bool AppendBufferMemoryBarrier(const ICommandBuffer& commandBuffer,
 			MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
@@ -5,6 +5,7 @@
 #include <array>
 #include "AttachmentInfo.hpp"
 #include <optional>
+#include <vector>
 
 namespace Engine::Rendering
 {
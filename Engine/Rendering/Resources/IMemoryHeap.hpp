@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <string_view>
+
+namespace Engine::Rendering
+{
+	class IDevice;
+
+	struct MemoryRequirements
+	{
+		uint64_t Size;
+		uint64_t Alignment;
+		uint32_t MemoryTypeBits;
+	};
+
+	// A block of device memory that several resources are placed into at explicit offsets. Resources whose ranges
+	// overlap alias each other, only one of them may be in use at a time.
+	class IMemoryHeap
+	{
+	public:
+		IMemoryHeap()
+			: m_size(0)
+		{
+		}
+
+		virtual ~IMemoryHeap() = default;
+
+		virtual bool Initialise(std::string_view name, const IDevice& device, const MemoryRequirements& requirements) = 0;
+
+		inline uint64_t GetSize() const { return m_size; }
+
+	protected:
+		uint64_t m_size;
+	};
+}
\ No newline at end of file
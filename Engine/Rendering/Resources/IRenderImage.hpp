@@ -4,6 +4,7 @@
 #include "../Types.hpp"
 #include <glm/glm.hpp>
 #include "IImageView.hpp"
+#include "IMemoryHeap.hpp"
 #include <memory>
 #include <string_view>
 
@@ -37,6 +38,16 @@ namespace Engine::Rendering
 
 		virtual bool InitialiseView(std::string_view name, const IDevice& device, ImageAspectFlags aspectFlags) = 0;
 
+		// Creates the image without any memory, BindMemory places it in a heap before it can be used.
+		virtual bool InitialiseUnbound(std::string_view name, const IDevice& device, ImageType imageType,
+			Format format, const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount,
+			ImageTiling tiling, ImageUsageFlags imageUsage, SharingMode sharingMode) = 0;
+
+		virtual MemoryRequirements GetMemoryRequirements(const IDevice& device) const = 0;
+
+		virtual bool BindMemory(std::string_view name, const IDevice& device, const IMemoryHeap& memoryHeap,
+			uint64_t offset, ImageAspectFlags aspectFlags) = 0;
+
 		virtual bool UpdateContents(const void* data, size_t offset, uint64_t size) = 0;
 
 		virtual bool AppendImageLayoutTransition(const ICommandBuffer& commandBuffer,
@@ -48,6 +59,13 @@ namespace Engine::Rendering
 			IMemoryBarriers& memoryBarriers, uint32_t baseMipLevel = 0, uint32_t mipLevelCount = 0,
 			uint32_t srcQueueFamily = 0, uint32_t dstQueueFamily = 0, bool compute = false) = 0;
 
+		// Discards the contents left in memory shared with other images. Waits for the given work on those images
+		// instead of this image's own last usage, then transitions from an undefined layout.
+		virtual bool AppendAliasingBarrier(const ICommandBuffer& commandBuffer,
+			MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+			MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+			IMemoryBarriers& memoryBarriers) = 0;
+
 		virtual void GenerateMipmaps(const ICommandBuffer& commandBuffer) = 0;
 
 		virtual bool CreateView(std::string_view name, const IDevice& device, uint32_t baseMipLevel,
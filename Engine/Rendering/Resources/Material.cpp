@@ -10,7 +10,9 @@ using namespace simdjson;
 namespace Engine::Rendering
 {
 	Material::Material()
-		: m_name()
+		: m_instanceCount(1)
+		, m_bindingInstance(0)
+		, m_name()
 		, m_programData()
 		, m_attachmentFormats()
 		, m_depthTest(false)
@@ -155,7 +157,7 @@ namespace Engine::Rendering
 		return true;
 	}
 
-	bool Material::Parse(const std::filesystem::path& path)
+	bool Material::Parse(const std::filesystem::path& path, bool loadPrograms)
 	{
 		m_name = path.stem().string();
 
@@ -200,7 +202,7 @@ namespace Engine::Rendering
 			}
 
 			std::vector<uint8_t> programData;
-			if (!Files::TryReadBinaryFile(pathString, programData))
+			if (loadPrograms && !Files::TryReadBinaryFile(pathString, programData))
 			{
 				Logger::Error("Could not read program at path '{}' defined in material '{}'.", pathString, m_name);
 				return false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -28,7 +29,8 @@ namespace Engine::Rendering
 		Material();
 		virtual ~Material() = default;
 
-		bool Parse(const std::filesystem::path& path);
+		// Backends that never build pipelines can skip reading the compiled programs, only their stages are recorded.
+		bool Parse(const std::filesystem::path& path, bool loadPrograms = true);
 
 		inline std::string_view GetName() const { return m_name; };
 		inline const std::unordered_map<ShaderStageFlags, std::vector<uint8_t>>& GetProgramData() const { return m_programData; }
@@ -113,6 +115,11 @@ namespace Engine::Rendering
 			return BindStorageBuffersImp(binding, { &storageBuffer });
 		}
 
+		inline bool BindStorageBufferRange(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size)
+		{
+			return BindStorageBufferRangeImp(binding, storageBuffer, offset, size);
+		}
+
 		inline bool BindStorageImage(uint32_t binding, const std::unique_ptr<IImageView>& imageView)
 		{
 			return BindStorageImagesImp(binding, { imageView.get() });
@@ -182,8 +189,19 @@ namespace Engine::Rendering
 			return BindUniformBuffersImp(binding, uniformBufferPtrs);
 		}
 
+		// Passes drawing several geometry batches keep a set of bindings per batch on the same pipeline.
+		// The count must be set before binding, Bind calls then write to the selected instance.
+		inline void SetInstanceCount(uint32_t instanceCount)
+		{
+			m_instanceCount = std::max(instanceCount, 1u);
+			m_bindingInstance = 0;
+		}
+
+		inline void SetBindingInstance(uint32_t instance) { m_bindingInstance = instance; }
+		inline uint32_t GetInstanceCount() const { return m_instanceCount; }
+
 		virtual bool SetSpecialisationConstant(std::string name, int32_t value) = 0;
-		virtual	bool BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex) const = 0;
+		virtual	bool BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex, uint32_t instance = 0) const = 0;
 
 	protected:
 		virtual bool BindImageViewsImp(uint32_t binding, const std::vector<const IImageView*>& imageViews) = 0;
@@ -191,9 +209,13 @@ namespace Engine::Rendering
 		virtual bool BindCombinedImageSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers,
 			const std::vector<const IImageView*>& imageViews, const std::vector<ImageLayout>& imageLayouts) = 0;
 		virtual bool BindStorageBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& storageBuffers) = 0;
+		virtual bool BindStorageBufferRangeImp(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size) = 0;
 		virtual bool BindStorageImagesImp(uint32_t binding, const std::vector<const IImageView*>& imageViews) = 0;
 		virtual bool BindUniformBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& uniformBuffers) = 0;
 
+		uint32_t m_instanceCount;
+		uint32_t m_bindingInstance;
+
 	private:
 		std::string m_name;
 		std::unordered_map<ShaderStageFlags, std::vector<uint8_t>> m_programData;
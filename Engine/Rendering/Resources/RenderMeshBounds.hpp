@@ -0,0 +1,15 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Engine::Rendering
+{
+	// Laid out to match the 80 byte Bounds struct in FrustumCulling.comp and ShadowCulling.comp.
+	struct RenderMeshBounds
+	{
+		glm::vec4 sphere; // World space centre and radius, used for occlusion and LOD selection.
+		glm::vec4 boxCenter;
+		glm::vec4 boxAxes[3]; // World space half extent vectors of the oriented box.
+	};
+	static_assert(sizeof(RenderMeshBounds) == 80);
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Engine::Rendering
+{
+	// Laid out to match the std430 Cluster struct in ClusterCulling.comp, which strides the cluster buffer by 48 bytes.
+	struct alignas(16) RenderMeshCluster
+	{
+		glm::vec4 sphere; // world space center and radius
+		glm::vec4 cone; // world space axis and cutoff
+		uint32_t meshIndex;
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t padding;
+	};
+	static_assert(sizeof(RenderMeshCluster) == 48);
+}
@@ -9,6 +9,8 @@ namespace Engine::Rendering
 		glm::mat4 transform;
 		glm::mat4 normalMatrix;
 		glm::vec4 colour;
+		glm::vec4 positionOffset; // Dequantisation of compact positions, unused with full precision vertices.
+		glm::vec4 positionScale;
 
 		uint32_t diffuseImageIndex;
 		uint32_t normalImageIndex;
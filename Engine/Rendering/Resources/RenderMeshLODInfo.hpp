@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Engine::Rendering
+{
+	constexpr uint32_t MaxMeshLODCount = 4;
+
+	struct RenderMeshLOD
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float error;
+		uint32_t padding;
+	};
+
+	struct alignas(16) RenderMeshLODInfo
+	{
+		uint32_t lodCount;
+		uint32_t firstCluster; // full detail clusters of the mesh, used by cluster culling
+		uint32_t clusterCount;
+		uint32_t padding;
+		RenderMeshLOD lods[MaxMeshLODCount];
+	};
+}
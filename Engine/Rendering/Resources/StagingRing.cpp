@@ -0,0 +1,174 @@
+#include "StagingRing.hpp"
+#include "IBuffer.hpp"
+#include "../IResourceFactory.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+
+namespace Engine::Rendering
+{
+	StagingRing::StagingRing(std::string_view name, uint64_t capacity)
+		: m_name(name)
+		, m_device(nullptr)
+		, m_resourceFactory(nullptr)
+		, m_buffer(nullptr)
+		, m_capacity(capacity)
+		, m_head(0)
+		, m_usedSize(0)
+		, m_openSize(0)
+		, m_nextSubmission(0)
+		, m_overflowSize(0)
+		, m_openPages()
+		, m_submissions()
+		, m_stats()
+	{
+	}
+
+	StagingRing::~StagingRing() = default;
+
+	bool StagingRing::Initialise(const IDevice& device, const IResourceFactory& resourceFactory)
+	{
+		m_device = &device;
+		m_resourceFactory = &resourceFactory;
+		m_buffer = std::move(resourceFactory.CreateBuffer());
+		return m_buffer->Initialise(m_name, device, m_capacity,
+			BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
+			AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
+			SharingMode::Exclusive);
+	}
+
+	bool StagingRing::Allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+	{
+		if (size == 0 || size > m_capacity)
+			return false;
+
+		if (m_usedSize == 0)
+			m_head = 0;
+
+		uint64_t alignedHead = (m_head + alignment - 1) / alignment * alignment;
+		uint64_t padding = alignedHead - m_head;
+
+		// The oldest allocation still in use starts where the used region wraps back to.
+		uint64_t tail = (m_head + m_capacity - m_usedSize % m_capacity) % m_capacity;
+		bool wrapped = m_usedSize > 0 && tail >= m_head;
+
+		if (!wrapped && alignedHead + size <= m_capacity)
+		{
+			offset = alignedHead;
+		}
+		else if (!wrapped && size <= tail)
+		{
+			// Skip the remainder at the end of the buffer and continue from the start.
+			padding = m_capacity - m_head;
+			offset = 0;
+		}
+		else if (wrapped && alignedHead + size <= tail)
+		{
+			offset = alignedHead;
+		}
+		else
+		{
+			return false;
+		}
+
+		uint64_t allocationSize = padding + size;
+		m_usedSize += allocationSize;
+		m_openSize += allocationSize;
+		m_head = (offset + size) % m_capacity;
+		UpdatePeak();
+		return true;
+	}
+
+	bool StagingRing::Write(uint64_t offset, const void* data, uint64_t size)
+	{
+		return m_buffer->UpdateContents(data, offset, size);
+	}
+
+	bool StagingRing::Stage(const void* data, uint64_t size, uint64_t alignment, StagingAllocation& allocation)
+	{
+		IBuffer* buffer = m_buffer.get();
+		uint64_t offset = 0;
+		if (!Allocate(size, alignment, offset) && !AllocateOverflow(size, alignment, buffer, offset))
+			return false;
+
+		if (!buffer->UpdateContents(data, offset, size))
+			return false;
+
+		allocation = { buffer, offset };
+
+		++m_stats.AllocationCount;
+		m_stats.AllocatedBytes += size;
+		return true;
+	}
+
+	bool StagingRing::AllocateOverflow(uint64_t size, uint64_t alignment, IBuffer*& buffer, uint64_t& offset)
+	{
+		if (!m_openPages.empty())
+		{
+			OverflowPage& page = m_openPages.back();
+			uint64_t alignedHead = (page.head + alignment - 1) / alignment * alignment;
+			if (alignedHead + size <= page.buffer->Size())
+			{
+				page.head = alignedHead + size;
+				buffer = page.buffer.get();
+				offset = alignedHead;
+				return true;
+			}
+		}
+
+		// Pages match the ring capacity, only uploads that were not split into chunks need a larger one.
+		uint64_t pageSize = std::max(m_capacity, size);
+		std::unique_ptr<IBuffer> pageBuffer = std::move(m_resourceFactory->CreateBuffer());
+		if (!pageBuffer->Initialise(m_name + "Overflow", *m_device, pageSize,
+			BufferUsageFlags::TransferSrc, MemoryUsage::Auto,
+			AllocationCreateFlags::HostAccessSequentialWrite | AllocationCreateFlags::Mapped,
+			SharingMode::Exclusive))
+		{
+			Logger::Error("Failed to create {} overflow page of {} bytes.", m_name, pageSize);
+			return false;
+		}
+
+		buffer = pageBuffer.get();
+		offset = 0;
+		m_openPages.push_back({ std::move(pageBuffer), size });
+		m_overflowSize += pageSize;
+		++m_stats.OverflowPageCount;
+		UpdatePeak();
+		return true;
+	}
+
+	void StagingRing::UpdatePeak()
+	{
+		m_stats.PeakUsedSize = std::max(m_stats.PeakUsedSize, m_usedSize + m_overflowSize);
+	}
+
+	uint64_t StagingRing::Submit()
+	{
+		uint64_t identifier = m_nextSubmission++;
+		m_submissions.push_back({ identifier, m_openSize, std::move(m_openPages), false });
+		m_openPages.clear();
+		m_openSize = 0;
+		return identifier;
+	}
+
+	void StagingRing::Release(uint64_t submission)
+	{
+		for (Submission& entry : m_submissions)
+		{
+			if (entry.identifier == submission)
+			{
+				entry.completed = true;
+				break;
+			}
+		}
+
+		// Submissions on the same queue complete in order, space only returns from the oldest one.
+		while (!m_submissions.empty() && m_submissions.front().completed)
+		{
+			m_usedSize -= m_submissions.front().size;
+			for (const OverflowPage& page : m_submissions.front().overflowPages)
+				m_overflowSize -= page.buffer->Size();
+
+			m_submissions.pop_front();
+		}
+	}
+}
\ No newline at end of file
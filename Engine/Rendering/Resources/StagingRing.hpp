@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <deque>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace Engine::Rendering
+{
+	class IDevice;
+	class IResourceFactory;
+	class IBuffer;
+
+	struct StagingAllocation
+	{
+		const IBuffer* Buffer;
+		uint64_t Offset;
+	};
+
+	struct StagingRingStats
+	{
+		uint64_t AllocationCount;
+		uint64_t AllocatedBytes;
+		uint64_t OverflowPageCount;
+		uint64_t PeakUsedSize;
+	};
+
+	// Persistently mapped upload buffer that is sub-allocated in submission order.
+	// Space is reclaimed once the submission that used it has completed, so small per frame updates
+	// avoid creating a staging buffer each time.
+	class StagingRing
+	{
+	public:
+		StagingRing(std::string_view name, uint64_t capacity);
+		~StagingRing();
+
+		bool Initialise(const IDevice& device, const IResourceFactory& resourceFactory);
+
+		// Returns false when the ring cannot fit the allocation until earlier submissions complete.
+		bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+		bool Write(uint64_t offset, const void* data, uint64_t size);
+
+		// Allocates and writes in one step. When the ring is full the data goes to an overflow page of the same size
+		// that lives until the open submission completes, so large uploads never fall back to one buffer per copy.
+		bool Stage(const void* data, uint64_t size, uint64_t alignment, StagingAllocation& allocation);
+
+		// Closes the allocations made since the previous submission, returning an identifier to release them with.
+		uint64_t Submit();
+		void Release(uint64_t submission);
+
+		inline IBuffer& GetBuffer() const { return *m_buffer; }
+		inline bool IsInitialised() const { return m_buffer != nullptr; }
+		inline uint64_t GetCapacity() const { return m_capacity; }
+		inline uint64_t GetUsedSize() const { return m_usedSize; }
+
+		// Uploads larger than this should be split so each piece can be placed in the ring or an overflow page.
+		inline uint64_t GetChunkSize() const { return m_capacity / 4; }
+		inline const StagingRingStats& GetStats() const { return m_stats; }
+
+	private:
+		struct OverflowPage
+		{
+			std::unique_ptr<IBuffer> buffer;
+			uint64_t head;
+		};
+
+		struct Submission
+		{
+			uint64_t identifier;
+			uint64_t size;
+			std::vector<OverflowPage> overflowPages;
+			bool completed;
+		};
+
+		bool AllocateOverflow(uint64_t size, uint64_t alignment, IBuffer*& buffer, uint64_t& offset);
+		void UpdatePeak();
+
+		std::string m_name;
+		const IDevice* m_device;
+		const IResourceFactory* m_resourceFactory;
+		std::unique_ptr<IBuffer> m_buffer;
+		uint64_t m_capacity;
+		uint64_t m_head;
+		uint64_t m_usedSize;
+		uint64_t m_openSize;
+		uint64_t m_nextSubmission;
+		uint64_t m_overflowSize;
+		std::vector<OverflowPage> m_openPages;
+		std::deque<Submission> m_submissions;
+		StagingRingStats m_stats;
+	};
+}
\ No newline at end of file
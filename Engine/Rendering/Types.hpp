@@ -26,6 +26,8 @@ namespace Engine::Rendering
 		R8G8B8Unorm,
 		B8G8R8A8Unorm,
 		A2B10G10R10UnormPack32,
+		R32Uint,
+		R32G32Uint,
 		PlaceholderSwapchain,
 		PlaceholderDepth
 	};
@@ -153,6 +155,8 @@ namespace Engine::Rendering
 		Transfer = 4096,
 		BottomOfPipe = 8192,
 		Host = 16384,
+		AllGraphics = 32768,
+		AllCommands = 65536,
 		TaskShader = 524288,
 		MeshShader = 1048576,
 		RayTracingShader = 2097152,
@@ -428,6 +432,7 @@ namespace Engine::Rendering
 		case Format::R8G8B8A8Unorm:
 		case Format::R16G16Sfloat:
 		case Format::R32Sfloat:
+		case Format::R32Uint:
 		case Format::D32Sfloat:
 		case Format::D24UnormS8Uint:
 			return 4;
@@ -436,6 +441,7 @@ namespace Engine::Rendering
 		case Format::R16G16B16Sfloat:
 			return 6;
 		case Format::R32G32Sfloat:
+		case Format::R32G32Uint:
 		case Format::R16G16B16A16Sfloat:
 			return 8;
 		case Format::R32G32B32Sfloat:
@@ -4,6 +4,7 @@
 #include "CommandBuffer.hpp"
 #include "Device.hpp"
 #include "VulkanMemoryBarriers.hpp"
+#include <algorithm>
 
 namespace Engine::Rendering::Vulkan
 {
@@ -48,26 +49,30 @@ namespace Engine::Rendering::Vulkan
 		return static_cast<uint64_t>(static_cast<const Device&>(device).Get().getBufferAddress(info));
 	}
 
-	void Buffer::Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size) const
+	void Buffer::Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size,
+		size_t sourceOffset, size_t destinationOffset) const
 	{
 		const Buffer& vulkanDestination = static_cast<const Buffer&>(destination);
 		const CommandBuffer& vulkanCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer);
-		vk::BufferCopy copyRegion(0, 0, size);
+		vk::BufferCopy copyRegion(sourceOffset, destinationOffset, size);
 		vulkanCommandBuffer.Get().copyBuffer(m_buffer, vulkanDestination.Get(), 1, &copyRegion);
 	}
 
-	void Buffer::CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination) const
+	void Buffer::CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination,
+		size_t sourceOffset, uint32_t firstRow, uint32_t rowCount) const
 	{
 		vk::Extent3D extents = GetExtent3D(destination.GetDimensions());
 		for (uint32_t i = 0; i < mipLevel; ++i)
 		{
-			extents.width /= 2;
-			extents.height /= 2;
+			extents.width = std::max(extents.width / 2, 1u);
+			extents.height = std::max(extents.height / 2, 1u);
 		}
 
+		uint32_t rowLength = extents.width;
+		extents.height = rowCount == 0 ? extents.height - firstRow : rowCount;
+
 		vk::ImageSubresourceLayers subresource(vk::ImageAspectFlagBits::eColor, mipLevel, 0, 1);
-		vk::BufferImageCopy region(0, 0, 0, subresource, vk::Offset3D(0, 0, 0), extents);
-		region.bufferRowLength = extents.width;
+		vk::BufferImageCopy region(sourceOffset, rowLength, 0, subresource, vk::Offset3D(0, static_cast<int32_t>(firstRow), 0), extents);
 
 		const RenderImage& vulkanDestination = static_cast<const RenderImage&>(destination);
 		const CommandBuffer& vulkanCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer);
@@ -15,8 +15,10 @@ namespace Engine::Rendering::Vulkan
 			MemoryUsage memoryUsage, AllocationCreateFlags createFlags, SharingMode sharingMode) override;
 		virtual bool UpdateContents(const void* data, size_t offset, size_t size) override;
 		virtual uint64_t GetDeviceAddress(const IDevice& device) override;
-		virtual void Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size) const override;
-		virtual void CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination) const override;
+		virtual void Copy(const ICommandBuffer& commandBuffer, const IBuffer& destination, size_t size,
+			size_t sourceOffset = 0, size_t destinationOffset = 0) const override;
+		virtual void CopyToImage(uint32_t mipLevel, const ICommandBuffer& commandBuffer, const IRenderImage& destination,
+			size_t sourceOffset = 0, uint32_t firstRow = 0, uint32_t rowCount = 0) const override;
 
 		bool ProcessQueueFamilyIndices(const ICommandBuffer& commandBuffer, uint32_t& srcQueueFamily,
 			uint32_t& dstQueueFamily, vk::AccessFlags2& srcAccessMask, vk::AccessFlags2& dstAccessMask,
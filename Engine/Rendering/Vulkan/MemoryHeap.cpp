@@ -0,0 +1,42 @@
+#include "MemoryHeap.hpp"
+#include "Core/Logger.hpp"
+#include <string>
+
+namespace Engine::Rendering::Vulkan
+{
+	MemoryHeap::MemoryHeap(VmaAllocator allocator)
+		: IMemoryHeap()
+		, m_allocation(nullptr)
+		, m_allocator(allocator)
+	{
+	}
+
+	MemoryHeap::~MemoryHeap()
+	{
+		if (m_allocation != nullptr)
+			vmaFreeMemory(m_allocator, m_allocation);
+	}
+
+	bool MemoryHeap::Initialise(std::string_view name, const IDevice& device, const MemoryRequirements& requirements)
+	{
+		VkMemoryRequirements memoryRequirements = {};
+		memoryRequirements.size = requirements.Size;
+		memoryRequirements.alignment = requirements.Alignment;
+		memoryRequirements.memoryTypeBits = requirements.MemoryTypeBits;
+
+		VmaAllocationCreateInfo allocCreateInfo = {};
+		allocCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+		VkResult result = vmaAllocateMemory(m_allocator, &memoryRequirements, &allocCreateInfo, &m_allocation, nullptr);
+		if (result != VK_SUCCESS)
+		{
+			Logger::Error("Failed to allocate {} bytes for memory heap '{}'.", requirements.Size, name);
+			return false;
+		}
+
+		vmaSetAllocationName(m_allocator, m_allocation, std::string(name).c_str());
+		m_size = requirements.Size;
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vma/vk_mem_alloc.h>
+#include "../Resources/IMemoryHeap.hpp"
+
+namespace Engine::Rendering::Vulkan
+{
+	class MemoryHeap : public IMemoryHeap
+	{
+	public:
+		MemoryHeap(VmaAllocator allocator);
+		MemoryHeap(const MemoryHeap&) = delete;
+		~MemoryHeap();
+
+		virtual bool Initialise(std::string_view name, const IDevice& device, const MemoryRequirements& requirements) override;
+
+		inline VmaAllocation GetAllocation() const { return m_allocation; }
+
+	private:
+		VmaAllocation m_allocation;
+		VmaAllocator m_allocator;
+	};
+}
\ No newline at end of file
@@ -255,12 +255,9 @@ namespace Engine::Rendering::Vulkan
 			imageInfos[i] = vk::DescriptorImageInfo(nullptr, static_cast<const ImageView&>(*imageViews[i]).Get(), vk::ImageLayout::eShaderReadOnlyOptimal);
 		}
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
-
-		bindingInfo->Binding.descriptorCount = static_cast<uint32_t>(imageViews.size());
+		SetDescriptorCount(*bindingInfo, static_cast<uint32_t>(imageViews.size()));
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eSampledImage, imageInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eSampledImage, imageInfos));
 		return true;
 	}
 
@@ -285,12 +282,9 @@ namespace Engine::Rendering::Vulkan
 			imageInfos[i] = vk::DescriptorImageInfo(static_cast<const ImageSampler&>(*samplers[i]).Get(), static_cast<const ImageView&>(*imageViews[i]).Get(), GetImageLayout(imageLayouts[i]));
 		}
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
-
-		bindingInfo->Binding.descriptorCount = static_cast<uint32_t>(imageViews.size());
+		SetDescriptorCount(*bindingInfo, static_cast<uint32_t>(imageViews.size()));
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eCombinedImageSampler, imageInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eCombinedImageSampler, imageInfos));
 		return true;
 	}
 
@@ -304,12 +298,9 @@ namespace Engine::Rendering::Vulkan
 		for (size_t i = 0; i < samplers.size(); ++i)
 			samplerInfos[i] = vk::DescriptorImageInfo(static_cast<const ImageSampler&>(*samplers[i]).Get(), nullptr, vk::ImageLayout::eShaderReadOnlyOptimal);
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
-
-		bindingInfo->Binding.descriptorCount = static_cast<uint32_t>(samplers.size());
+		SetDescriptorCount(*bindingInfo, static_cast<uint32_t>(samplers.size()));
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eSampler, samplerInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eSampler, samplerInfos));
 
 		return true;
 	}
@@ -350,12 +341,40 @@ namespace Engine::Rendering::Vulkan
 		for (size_t i = 0; i < storageBuffers.size(); ++i)
 			bufferInfos[i] = vk::DescriptorBufferInfo(static_cast<const Buffer&>(*storageBuffers[i]).Get(), 0, storageBuffers[i]->Size());
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
+		SetDescriptorCount(*bindingInfo, static_cast<uint32_t>(storageBuffers.size()));
+		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eStorageBuffer, nullptr, bufferInfos));
+
+		return true;
+	}
+
+	bool PipelineLayout::BindStorageBufferRangeImp(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size)
+	{
+		std::vector<const IBuffer*> storageBuffers = { &storageBuffer };
+		DescriptorBindingInfo* bindingInfo = GetBindingInfo(binding, storageBuffers, vk::DescriptorType::eStorageBuffer, "storage buffer");
+		if (!bindingInfo)
+			return false;
 
-		bindingInfo->Binding.descriptorCount = static_cast<uint32_t>(storageBuffers.size());
+		if (size == 0 || offset + size > storageBuffer.Size())
+		{
+			Logger::Error("Binding at index {} for material '{}' has a range ({}, {}) outside of the buffer size {}.",
+				binding, GetName(), offset, size, storageBuffer.Size());
+			return false;
+		}
+
+		if (bindingInfo->BlockSize > 0 && size != bindingInfo->BlockSize)
+		{
+			Logger::Error("Binding at index {} for material '{}' has mismatching block size ({} != {}).",
+				binding, GetName(), bindingInfo->BlockSize, size);
+			return false;
+		}
+
+		std::vector<vk::DescriptorBufferInfo>& bufferInfos = m_descriptorBufferInfos.emplace_back(std::vector<vk::DescriptorBufferInfo>());
+		bufferInfos.emplace_back(vk::DescriptorBufferInfo(static_cast<const Buffer&>(storageBuffer).Get(), offset, size));
+
+		SetDescriptorCount(*bindingInfo, 1);
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eStorageBuffer, nullptr, bufferInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eStorageBuffer, nullptr, bufferInfos));
 
 		return true;
 	}
@@ -380,12 +399,9 @@ namespace Engine::Rendering::Vulkan
 			imageInfos[i] = vk::DescriptorImageInfo(nullptr, static_cast<const ImageView&>(*imageViews[i]).Get(), vk::ImageLayout::eGeneral);
 		}
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
-
-		bindingInfo->Binding.descriptorCount = static_cast<uint32_t>(imageViews.size());
+		SetDescriptorCount(*bindingInfo, static_cast<uint32_t>(imageViews.size()));
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eStorageImage, imageInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eStorageImage, imageInfos));
 		return true;
 	}
 
@@ -404,15 +420,12 @@ namespace Engine::Rendering::Vulkan
 		if (!ValidateBufferBlockBinding(binding, uniformBuffers, *bindingInfo))
 			return false;
 
-		if (m_writeDescriptorSets.empty())
-			m_writeDescriptorSets.resize(m_concurrentFrames);
-
-		bindingInfo->Binding.descriptorCount = 1;
+		SetDescriptorCount(*bindingInfo, 1);
 		for (uint32_t i = 0; i < m_concurrentFrames; ++i)
 		{
 			std::vector<vk::DescriptorBufferInfo>& bufferInfos = m_descriptorBufferInfos.emplace_back(std::vector<vk::DescriptorBufferInfo>());
 			bufferInfos.emplace_back(vk::DescriptorBufferInfo(static_cast<const Buffer&>(*uniformBuffers[i]).Get(), 0, uniformBuffers[i]->Size()));
-			m_writeDescriptorSets[i].emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eUniformBuffer, nullptr, bufferInfos));
+			GetWriteDescriptorSets(i).emplace_back(vk::WriteDescriptorSet(nullptr, binding, 0, vk::DescriptorType::eUniformBuffer, nullptr, bufferInfos));
 		}
 
 		return true;
@@ -427,8 +440,10 @@ namespace Engine::Rendering::Vulkan
 			if (!CreateDescriptorSetLayout(device))
 				return false;
 
+			PadImageArrayWrites();
+
 			vk::Device deviceImp = static_cast<const Device&>(device).Get();
-			for (size_t i = 0; i < m_writeDescriptorSets.size(); ++i)
+			for (size_t i = 0; i < m_writeDescriptorSets.size() && i < m_descriptorSets.size(); ++i)
 			{
 				uint32_t descriptorCount = 0;
 				std::vector<vk::WriteDescriptorSet> writeDescriptorSet = m_writeDescriptorSets[i];
@@ -451,6 +466,43 @@ namespace Engine::Rendering::Vulkan
 		return true;
 	}
 
+	void PipelineLayout::PadImageArrayWrites()
+	{
+		if (m_instanceCount == 1)
+			return;
+
+		// Instances binding fewer images than the layout holds repeat their last image, so every descriptor in the array stays valid.
+		const DescriptorSetInfo& setInfo = m_descriptorSetInfos[0];
+		std::unordered_map<const vk::DescriptorImageInfo*, const vk::DescriptorImageInfo*> paddedInfos;
+		for (std::vector<vk::WriteDescriptorSet>& writeDescriptorSet : m_writeDescriptorSets)
+		{
+			for (vk::WriteDescriptorSet& writeDescriptor : writeDescriptorSet)
+			{
+				const auto& bindingInfoSearch = setInfo.BindingInfos.find(writeDescriptor.dstBinding);
+				if (writeDescriptor.pImageInfo == nullptr || bindingInfoSearch == setInfo.BindingInfos.end())
+					continue;
+
+				uint32_t descriptorCount = bindingInfoSearch->second.Binding.descriptorCount;
+				if (writeDescriptor.descriptorCount >= descriptorCount)
+					continue;
+
+				auto paddedSearch = paddedInfos.find(writeDescriptor.pImageInfo);
+				if (paddedSearch == paddedInfos.end())
+				{
+					std::vector<vk::DescriptorImageInfo> imageInfos(writeDescriptor.pImageInfo, writeDescriptor.pImageInfo + writeDescriptor.descriptorCount);
+					vk::DescriptorImageInfo lastInfo = imageInfos.back();
+					imageInfos.resize(descriptorCount, lastInfo);
+
+					const vk::DescriptorImageInfo* padded = m_descriptorImageInfos.emplace_back(std::move(imageInfos)).data();
+					paddedSearch = paddedInfos.emplace(writeDescriptor.pImageInfo, padded).first;
+				}
+
+				writeDescriptor.pImageInfo = paddedSearch->second;
+				writeDescriptor.descriptorCount = descriptorCount;
+			}
+		}
+	}
+
 	bool PipelineLayout::SetSpecialisationConstant(std::string name, int32_t value)
 	{
 		const auto& it = m_specialisationConstants.find(name);
@@ -484,7 +536,7 @@ namespace Engine::Rendering::Vulkan
 		}
 	}
 
-	bool PipelineLayout::BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex) const
+	bool PipelineLayout::BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex, uint32_t instance) const
 	{
 		vk::PipelineBindPoint vulkanBindPoint;
 		if (!GetVulkanBindPoint(bindPoint, &vulkanBindPoint))
@@ -498,7 +550,14 @@ namespace Engine::Rendering::Vulkan
 
 		vk::CommandBuffer vkCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer).Get();
 		vkCommandBuffer.bindPipeline(vulkanBindPoint, m_pipeline.get());
-		vkCommandBuffer.bindDescriptorSets(vulkanBindPoint, m_pipelineLayout.get(), 0, m_descriptorSets[frameIndex], nullptr);
+		size_t setIndex = static_cast<size_t>(instance) * m_concurrentFrames + frameIndex;
+		if (setIndex >= m_descriptorSets.size())
+		{
+			Logger::Error("Material '{}' has no bindings for instance {}.", GetName(), instance);
+			return false;
+		}
+
+		vkCommandBuffer.bindDescriptorSets(vulkanBindPoint, m_pipelineLayout.get(), 0, m_descriptorSets[setIndex], nullptr);
 		return true;
 	}
 
@@ -532,18 +591,19 @@ namespace Engine::Rendering::Vulkan
 			std::vector<vk::DescriptorSetLayoutBinding> bindings;
 			std::vector<vk::DescriptorPoolSize> poolSizes;
 			uint32_t descriptorCount = 0;
+			uint32_t setCount = m_concurrentFrames * m_instanceCount;
 			for (const auto& bindingPair : info.BindingInfos)
 			{
 				const vk::DescriptorSetLayoutBinding& binding = bindingPair.second.Binding;
 				bindings.emplace_back(binding);
 				descriptorCount += binding.descriptorCount;
 				if (binding.descriptorCount > 0)
-					poolSizes.emplace_back(vk::DescriptorPoolSize(binding.descriptorType, binding.descriptorCount));
+					poolSizes.emplace_back(vk::DescriptorPoolSize(binding.descriptorType, binding.descriptorCount * setCount));
 			}
 
 			const Device& vkDevice = static_cast<const Device&>(device);
 			m_descriptorPool = std::make_unique<DescriptorPool>();
-			if (!m_descriptorPool->Initialise(vkDevice, m_concurrentFrames, poolSizes))
+			if (!m_descriptorPool->Initialise(vkDevice, setCount, poolSizes))
 				return false;
 
 			vk::DescriptorSetLayoutCreateInfo createInfo(vk::DescriptorSetLayoutCreateFlags(), bindings);
@@ -555,7 +615,7 @@ namespace Engine::Rendering::Vulkan
 			}
 
 			std::vector<vk::DescriptorSetLayout> layouts;
-			for (uint32_t i = 0; i < m_concurrentFrames; ++i)
+			for (uint32_t i = 0; i < setCount; ++i)
 			{
 				layouts.push_back(m_descriptorSetLayout.get());
 			}
@@ -35,7 +35,7 @@ namespace Engine::Rendering::Vulkan
 
 		virtual bool SetSpecialisationConstant(std::string name, int32_t value) override;
 
-		virtual bool BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex) const override;
+		virtual bool BindMaterial(const ICommandBuffer& commandBuffer, BindPoint bindPoint, uint32_t frameIndex, uint32_t instance = 0) const override;
 
 		inline bool IsDirty() const { return m_specConstantsDirty || !m_writeDescriptorSets.empty(); };
 
@@ -85,14 +85,41 @@ namespace Engine::Rendering::Vulkan
 			const std::vector<const IImageView*>& imageViews, const std::vector<ImageLayout>& imageLayouts) override;
 		virtual bool BindSamplersImp(uint32_t binding, const std::vector<const IImageSampler*>& samplers) override;
 		virtual bool BindStorageBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& storageBuffers) override;
+		virtual bool BindStorageBufferRangeImp(uint32_t binding, const IBuffer& storageBuffer, uint64_t offset, uint64_t size) override;
 		virtual bool BindStorageImagesImp(uint32_t binding, const std::vector<const IImageView*>& imageViews) override;
 		virtual bool BindUniformBuffersImp(uint32_t binding, const std::vector<const IBuffer*>& uniformBuffers) override;
 		bool GetVulkanBindPoint(BindPoint bindPoint, vk::PipelineBindPoint* vulkanBindPoint) const;
+		void PadImageArrayWrites();
+
+		// Descriptor sets are stored per instance, each holding one set per concurrent frame.
+		inline std::vector<vk::WriteDescriptorSet>& GetWriteDescriptorSets(uint32_t frameIndex)
+		{
+			size_t setCount = static_cast<size_t>(m_concurrentFrames) * m_instanceCount;
+			if (m_writeDescriptorSets.size() < setCount)
+				m_writeDescriptorSets.resize(setCount);
+
+			return m_writeDescriptorSets[m_bindingInstance * m_concurrentFrames + frameIndex];
+		}
+
+		// The layout is shared by every instance, so array bindings are sized for the largest one bound.
+		inline void SetDescriptorCount(DescriptorBindingInfo& bindingInfo, uint32_t descriptorCount)
+		{
+			if (m_bindingInstance == 0)
+				bindingInfo.Binding.descriptorCount = descriptorCount;
+			else
+				bindingInfo.Binding.descriptorCount = std::max(bindingInfo.Binding.descriptorCount, descriptorCount);
+		}
 
 		template <typename T>
 		inline DescriptorBindingInfo* GetBindingInfo(uint32_t binding, const std::vector<T>& bindingData,
 			vk::DescriptorType expectedType, std::string_view typeName)
 		{
+			if (m_bindingInstance >= m_instanceCount)
+			{
+				Engine::Logger::Error("Binding instance {} exceeds instance count of {} for material '{}'.", m_bindingInstance, m_instanceCount, GetName());
+				return nullptr;
+			}
+
 			auto& setInfo = m_descriptorSetInfos[0];
 			const auto& bindingInfoSearch = setInfo.BindingInfos.find(binding);
 			if (bindingInfoSearch == setInfo.BindingInfos.end())
@@ -4,6 +4,7 @@
 #include "VulkanTypesInterop.hpp"
 #include "Device.hpp"
 #include "VulkanMemoryBarriers.hpp"
+#include "MemoryHeap.hpp"
 
 namespace Engine::Rendering::Vulkan
 {
@@ -13,6 +14,8 @@ namespace Engine::Rendering::Vulkan
 		, m_imageAlloc(nullptr)
 		, m_imageAllocInfo()
 		, m_allocator(allocator)
+		, m_releaseLayout(ImageLayout::Undefined)
+		, m_placed(false)
 	{
 	}
 
@@ -22,6 +25,8 @@ namespace Engine::Rendering::Vulkan
 		, m_imageAlloc(nullptr)
 		, m_imageAllocInfo()
 		, m_allocator(nullptr)
+		, m_releaseLayout(ImageLayout::Undefined)
+		, m_placed(false)
 	{
 		m_format = FromVulkanFormat(format);
 		m_layerCount = 1;
@@ -33,6 +38,12 @@ namespace Engine::Rendering::Vulkan
 	{
 		if (m_imageAlloc != nullptr)
 			vmaDestroyImage(m_allocator, m_image, m_imageAlloc);
+		else if (m_placed && m_image != nullptr)
+		{
+			VmaAllocatorInfo allocatorInfo;
+			vmaGetAllocatorInfo(m_allocator, &allocatorInfo);
+			vk::Device(allocatorInfo.device).destroyImage(vk::Image(m_image));
+		}
 	}
 
 	bool RenderImage::UpdateContents(const void* data, size_t offset, size_t size)
@@ -167,6 +178,67 @@ namespace Engine::Rendering::Vulkan
 		return true;
 	}
 
+	bool RenderImage::InitialiseUnbound(std::string_view name, const IDevice& device, ImageType imageType, Format format,
+		const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount, ImageTiling tiling, ImageUsageFlags imageUsage,
+		SharingMode sharingMode)
+	{
+		m_format = format;
+		m_dimensions = dimensions;
+		m_mipLevels = mipLevels;
+		m_layerCount = layerCount;
+		m_usageFlags = imageUsage;
+		m_placed = true;
+
+		vk::ImageCreateInfo renderImageInfo(vk::ImageCreateFlags(), GetImageType(imageType), GetVulkanFormat(format), GetExtent3D(dimensions),
+			mipLevels, layerCount, vk::SampleCountFlagBits::e1, GetImageTiling(tiling), static_cast<vk::ImageUsageFlagBits>(imageUsage), GetSharingMode(sharingMode), {}, vk::ImageLayout::eUndefined);
+
+		const Device& deviceImp = static_cast<const Device&>(device);
+		m_image = static_cast<VkImage>(deviceImp.Get().createImage(renderImageInfo));
+		if (m_image == nullptr)
+		{
+			Logger::Error("Failed to create RenderImage '{}'.", name);
+			return false;
+		}
+
+		deviceImp.SetResourceName(ResourceType::Image, m_image, name);
+
+		return true;
+	}
+
+	MemoryRequirements RenderImage::GetMemoryRequirements(const IDevice& device) const
+	{
+		const Device& deviceImp = static_cast<const Device&>(device);
+		vk::MemoryRequirements requirements = deviceImp.Get().getImageMemoryRequirements(vk::Image(m_image));
+
+		return { requirements.size, requirements.alignment, requirements.memoryTypeBits };
+	}
+
+	bool RenderImage::BindMemory(std::string_view name, const IDevice& device, const IMemoryHeap& memoryHeap,
+		uint64_t offset, ImageAspectFlags aspectFlags)
+	{
+		if (!m_placed)
+		{
+			Logger::Error("Only images created unbound can be placed in a memory heap.");
+			return false;
+		}
+
+		const MemoryHeap& vulkanMemoryHeap = static_cast<const MemoryHeap&>(memoryHeap);
+		VkResult result = vmaBindImageMemory2(m_allocator, vulkanMemoryHeap.GetAllocation(), offset, m_image, nullptr);
+		if (result != VK_SUCCESS)
+		{
+			Logger::Error("Failed to bind memory for image '{}'.", name);
+			return false;
+		}
+
+		if (!InitialiseView(name, device, aspectFlags))
+		{
+			Logger::Error("Failed to create image view for image '{}'.", name);
+			return false;
+		}
+
+		return true;
+	}
+
 	bool RenderImage::CreateView(std::string_view name, const IDevice& device, uint32_t baseMipLevel, ImageAspectFlags aspectFlags, std::unique_ptr<IImageView>& imageView) const
 	{
 		if (m_layerCount != 1)
@@ -366,8 +438,9 @@ namespace Engine::Rendering::Vulkan
 			return false;
 		}
 
+		// An acquire that completes a matching release repeats its transition exactly so the contents are kept.
 		ImageLayout oldLayout = m_layout;
-		if (srcQueueFamily != commandBuffer.GetQueueFamilyIndex()) // acquire
+		if (srcQueueFamily != dstQueueFamily && srcQueueFamily != commandBuffer.GetQueueFamilyIndex() && newLayout != m_releaseLayout) // acquire
 			oldLayout = ImageLayout::Undefined;
 
 		vk::ImageAspectFlags aspectFlags = GetAspectFlags(m_format);
@@ -378,7 +451,9 @@ namespace Engine::Rendering::Vulkan
 		vulkanMemoryBarriers.AddImageMemoryBarrier(vk::ImageMemoryBarrier2(srcStage, srcAccessMask, dstStage, dstAccessMask, GetImageLayout(oldLayout), GetImageLayout(newLayout),
 			srcQueueFamily, dstQueueFamily, m_image, subResourceRange));
 
-		if (!isQueueRelease)
+		if (isQueueRelease)
+			m_releaseLayout = newLayout;
+		else
 			m_layout = newLayout;
 
 		return true;
@@ -411,8 +486,9 @@ namespace Engine::Rendering::Vulkan
 			srcAccessMask, dstAccessMask, srcStage, dstStage, newLayout, isQueueRelease))
 			return false;
 
+		// An acquire that completes a matching release repeats its transition exactly so the contents are kept.
 		ImageLayout oldLayout = m_layout;
-		if (srcQueueFamily != commandBuffer.GetQueueFamilyIndex()) // acquire
+		if (srcQueueFamily != dstQueueFamily && srcQueueFamily != commandBuffer.GetQueueFamilyIndex() && newLayout != m_releaseLayout) // acquire
 			oldLayout = ImageLayout::Undefined;
 
 		vk::ImageAspectFlags aspectFlags = GetAspectFlags(m_format);
@@ -423,9 +499,36 @@ namespace Engine::Rendering::Vulkan
 		vulkanMemoryBarriers.AddImageMemoryBarrier(vk::ImageMemoryBarrier2(srcStage, srcAccessMask, dstStage, dstAccessMask, GetImageLayout(oldLayout), GetImageLayout(newLayout),
 			srcQueueFamily, dstQueueFamily, m_image, subResourceRange));
 
-		if (!isQueueRelease)
+		if (isQueueRelease)
+			m_releaseLayout = newLayout;
+		else
 			m_layout = newLayout;
 
 		return true;
 	}
+
+	bool RenderImage::AppendAliasingBarrier(const ICommandBuffer& commandBuffer,
+		MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+		MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+		IMemoryBarriers& imageMemoryBarriers)
+	{
+		if (!LayoutSupported(m_usageFlags, newLayout))
+		{
+			Logger::Error("Image was not created with usage flags that support the requested layout.");
+			return false;
+		}
+
+		vk::ImageSubresourceRange subResourceRange(GetAspectFlags(m_format), 0, m_mipLevels, 0, m_layerCount);
+
+		VulkanMemoryBarriers& vulkanMemoryBarriers = static_cast<VulkanMemoryBarriers&>(imageMemoryBarriers);
+		vulkanMemoryBarriers.AddImageMemoryBarrier(vk::ImageMemoryBarrier2(static_cast<vk::PipelineStageFlagBits2>(srcStageFlags),
+			static_cast<vk::AccessFlagBits2>(srcAccessFlags), static_cast<vk::PipelineStageFlagBits2>(newStageFlags),
+			static_cast<vk::AccessFlagBits2>(newAccessFlags), vk::ImageLayout::eUndefined, GetImageLayout(newLayout),
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_image, subResourceRange));
+
+		m_layout = newLayout;
+		m_releaseLayout = ImageLayout::Undefined;
+
+		return true;
+	}
 }
\ No newline at end of file
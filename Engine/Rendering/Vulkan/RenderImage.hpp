@@ -23,6 +23,15 @@ namespace Engine::Rendering::Vulkan
 
 		virtual bool InitialiseView(std::string_view name, const IDevice& device, ImageAspectFlags aspectFlags) override;
 
+		virtual bool InitialiseUnbound(std::string_view name, const IDevice& device, ImageType imageType,
+			Format format, const glm::uvec3& dimensions, uint32_t mipLevels, uint32_t layerCount,
+			ImageTiling tiling, ImageUsageFlags imageUsage, SharingMode sharingMode) override;
+
+		virtual MemoryRequirements GetMemoryRequirements(const IDevice& device) const override;
+
+		virtual bool BindMemory(std::string_view name, const IDevice& device, const IMemoryHeap& memoryHeap,
+			uint64_t offset, ImageAspectFlags aspectFlags) override;
+
 		virtual bool UpdateContents(const void* data, size_t offset, size_t size) override;
 
 		virtual bool AppendImageLayoutTransition(const ICommandBuffer& commandBuffer,
@@ -34,6 +43,11 @@ namespace Engine::Rendering::Vulkan
 			IMemoryBarriers& memoryBarriers, uint32_t baseMipLevel, uint32_t mipLevelCount,
 			uint32_t srcQueueFamily, uint32_t dstQueueFamily, bool compute) override;
 
+		virtual bool AppendAliasingBarrier(const ICommandBuffer& commandBuffer,
+			MaterialStageFlags srcStageFlags, MaterialAccessFlags srcAccessFlags,
+			MaterialStageFlags newStageFlags, ImageLayout newLayout, MaterialAccessFlags newAccessFlags,
+			IMemoryBarriers& memoryBarriers) override;
+
 		virtual void GenerateMipmaps(const ICommandBuffer& commandBuffer) override;
 
 		virtual bool CreateView(std::string_view name, const IDevice& device, uint32_t baseMipLevel,
@@ -51,5 +65,7 @@ namespace Engine::Rendering::Vulkan
 		VmaAllocation m_imageAlloc;
 		VmaAllocationInfo m_imageAllocInfo;
 		VmaAllocator m_allocator; // Bit gnarly, but makes RAII easier.
+		ImageLayout m_releaseLayout;
+		bool m_placed; // Created unbound and placed in a memory heap it does not own.
 	};
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "CommandPool.hpp"
 #include "Semaphore.hpp"
 #include "VulkanMemoryBarriers.hpp"
+#include "MemoryHeap.hpp"
 
 namespace Engine::Rendering::Vulkan
 {
@@ -43,4 +44,9 @@ namespace Engine::Rendering::Vulkan
 	{
 		return std::make_unique<VulkanMemoryBarriers>();
 	}
+
+	std::unique_ptr<IMemoryHeap> ResourceFactory::CreateMemoryHeap() const
+	{
+		return std::make_unique<MemoryHeap>(*m_allocator);
+	}
 }
\ No newline at end of file
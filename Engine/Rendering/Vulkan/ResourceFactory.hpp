@@ -15,6 +15,7 @@ namespace Engine::Rendering::Vulkan
 		virtual std::unique_ptr<ICommandPool> CreateCommandPool() const override;
 		virtual std::unique_ptr<ISemaphore> CreateGraphicsSemaphore() const override;
 		virtual std::unique_ptr<IMemoryBarriers> CreateMemoryBarriers() const override;
+		virtual std::unique_ptr<IMemoryHeap> CreateMemoryHeap() const override;
 
 	private:
 		VmaAllocator* m_allocator;
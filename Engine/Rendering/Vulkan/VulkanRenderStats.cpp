@@ -3,8 +3,8 @@
 #include "PhysicalDevice.hpp"
 #include "Core/Logger.hpp"
 #include "CommandBuffer.hpp"
-#include "../RenderResources/IRenderResource.hpp"
 #include <algorithm>
+#include <array>
 
 namespace Engine::Rendering::Vulkan
 {
@@ -18,15 +18,22 @@ namespace Engine::Rendering::Vulkan
 		, m_statisticsSupported(false)
 		, m_timestampPeriod(0.0f)
 		, m_renderPassCount(0)
-		, m_renderPassIndex(0)
-		, m_renderPassNames()
 		, m_isComputePass()
+		, m_passStats()
+		, m_totalStats(nullptr)
 	{
 	}
 
-	bool VulkanRenderStats::Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t renderPassCount)
+	bool VulkanRenderStats::Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, const std::vector<std::string_view>& passNames,
+		const std::vector<bool>& computePasses, const std::vector<IRenderResource*>& renderResources)
 	{
-		m_renderPassCount = renderPassCount;
+		InitialiseResourceMemoryUsage(renderResources);
+
+		m_renderPassCount = static_cast<uint32_t>(passNames.size());
+		m_isComputePass = computePasses;
+		m_passStats.clear();
+		m_totalStats = nullptr;
+		m_statsData.clear();
 
 		const Device& vkDevice = static_cast<const Device&>(device);
 		const PhysicalDevice& vkPhysicalDevice = static_cast<const PhysicalDevice&>(physicalDevice);
@@ -80,44 +87,47 @@ namespace Engine::Rendering::Vulkan
 			Logger::Warning("Pipeline statistics not supported, statistics will be limited.");
 		}
 
+		// Entries are created once per build, results are written through these pointers each frame.
+		if (m_timestampSupported || m_statisticsSupported)
+		{
+			m_passStats.reserve(m_renderPassCount);
+			for (std::string_view passName : passNames)
+				m_passStats.emplace_back(&m_statsData[std::string(passName)]);
+			m_totalStats = &m_statsData["Total"];
+		}
+
 		return true;
 	}
 
-	void VulkanRenderStats::Begin(const ICommandBuffer& commandBuffer, std::string_view passName, bool isCompute)
+	void VulkanRenderStats::Begin(const ICommandBuffer& commandBuffer, uint32_t passIndex)
 	{
 		const vk::CommandBuffer& vkCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer).Get();
 
 		if (m_timestampSupported)
 		{
-			vkCommandBuffer.resetQueryPool(m_timestampQueryPool.get(), m_renderPassIndex * 2, 2);
-			vkCommandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_timestampQueryPool.get(), m_renderPassIndex * 2);
+			vkCommandBuffer.resetQueryPool(m_timestampQueryPool.get(), passIndex * 2, 2);
+			vkCommandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_timestampQueryPool.get(), passIndex * 2);
 		}
 
-		if (!isCompute && m_statisticsSupported)
+		if (!m_isComputePass[passIndex] && m_statisticsSupported)
 		{
-			vkCommandBuffer.resetQueryPool(m_statisticsQueryPool.get(), m_renderPassIndex, 1);
-			vkCommandBuffer.beginQuery(m_statisticsQueryPool.get(), m_renderPassIndex, vk::QueryControlFlags());
+			vkCommandBuffer.resetQueryPool(m_statisticsQueryPool.get(), passIndex, 1);
+			vkCommandBuffer.beginQuery(m_statisticsQueryPool.get(), passIndex, vk::QueryControlFlags());
 		}
-
-		m_renderPassNames.emplace_back(passName);
-		m_isComputePass.emplace_back(isCompute);
 	}
 
-	void VulkanRenderStats::End(const ICommandBuffer& commandBuffer, bool isCompute)
+	void VulkanRenderStats::End(const ICommandBuffer& commandBuffer, uint32_t passIndex)
 	{
 		const vk::CommandBuffer& vkCommandBuffer = static_cast<const CommandBuffer&>(commandBuffer).Get();
 
 		if (m_timestampSupported)
-			vkCommandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_timestampQueryPool.get(), m_renderPassIndex * 2 + 1);
+			vkCommandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_timestampQueryPool.get(), passIndex * 2 + 1);
 
-		if (!isCompute && m_statisticsSupported)
-			vkCommandBuffer.endQuery(m_statisticsQueryPool.get(), m_renderPassIndex);
-
-		++m_renderPassIndex;
+		if (!m_isComputePass[passIndex] && m_statisticsSupported)
+			vkCommandBuffer.endQuery(m_statisticsQueryPool.get(), passIndex);
 	}
 
-	void VulkanRenderStats::FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device,
-		const std::vector<IRenderResource*>& renderResources)
+	void VulkanRenderStats::FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device)
 	{
 		const Device& vkDevice = static_cast<const Device&>(device);
 		const PhysicalDevice& vkPhysicalDevice = static_cast<const PhysicalDevice&>(physicalDevice);
@@ -126,14 +136,7 @@ namespace Engine::Rendering::Vulkan
 		m_memoryStats.DedicatedUsage = 0;
 		m_memoryStats.SharedBudget = 0;
 		m_memoryStats.SharedUsage = 0;
-		m_memoryStats.ResourceMemoryUsage.clear();
-
-		for (const auto& renderResource : renderResources)
-		{
-			std::string_view name = renderResource->GetName();
-			size_t size = renderResource->GetMemoryUsage();
-			m_memoryStats.ResourceMemoryUsage.emplace(name, size);
-		}
+		UpdateResourceMemoryUsage();
 
 		vk::PhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
 		vk::PhysicalDeviceMemoryProperties2 memoryProperties{};
@@ -160,16 +163,15 @@ namespace Engine::Rendering::Vulkan
 		if (!m_timestampSupported && !m_statisticsSupported)
 			return;
 
-		m_renderPassIndex = 0;
-		m_statsData.clear();
 		const vk::Device& deviceImp = vkDevice.Get();
 
 		uint64_t earliestTimestamp = ~0ULL;
 		uint64_t latestTimestamp = 0;
 		for (uint32_t i = 0; i < m_renderPassCount; ++i)
 		{
-			FrameStats& data = m_statsData[m_renderPassNames[i]];
-			std::vector<uint64_t> buffer(static_cast<size_t>(statisticsCount) + 1);
+			FrameStats& data = *m_passStats[i];
+			data = {};
+			std::array<uint64_t, statisticsCount + 1> buffer{};
 			bool isCompute = m_isComputePass[i];
 
 			if (m_timestampSupported)
@@ -202,14 +204,11 @@ namespace Engine::Rendering::Vulkan
 			}
 		}
 
-		m_renderPassNames.clear();
-		m_isComputePass.clear();
-
 		// Add a 'Total' entry.
 		FrameStats total = {};
-		for (const auto& entry : m_statsData)
+		for (const FrameStats* passStats : m_passStats)
 		{
-			const FrameStats& data = entry.second;
+			const FrameStats& data = *passStats;
 			total.InputAssemblyVertexCount += data.InputAssemblyVertexCount;
 			total.InputAssemblyPrimitivesCount += data.InputAssemblyPrimitivesCount;
 			total.VertexShaderInvocations += data.VertexShaderInvocations;
@@ -219,6 +218,6 @@ namespace Engine::Rendering::Vulkan
 		total.RenderTime = float(latestTimestamp - earliestTimestamp) * m_timestampPeriod / 1000000.0f;
 		total.RenderBegin = earliestTimestamp;
 		total.RenderEnd = latestTimestamp;
-		m_statsData["Total"] = total;
+		*m_totalStats = total;
 	}
 }
\ No newline at end of file
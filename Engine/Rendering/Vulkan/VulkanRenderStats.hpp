@@ -14,22 +14,22 @@ namespace Engine::Rendering::Vulkan
 	{
 	public:
 		VulkanRenderStats();
-		virtual bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, uint32_t renderPassCount) override;
-		virtual void Begin(const ICommandBuffer& commandBuffer, std::string_view passName, bool isCompute) override;
-		virtual void End(const ICommandBuffer& commandBuffer, bool isCompute) override;
-		virtual void FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device,
-			const std::vector<IRenderResource*>& renderResources) override;
+		virtual bool Initialise(const IPhysicalDevice& physicalDevice, const IDevice& device, const std::vector<std::string_view>& passNames,
+			const std::vector<bool>& computePasses, const std::vector<IRenderResource*>& renderResources) override;
+		virtual void Begin(const ICommandBuffer& commandBuffer, uint32_t passIndex) override;
+		virtual void End(const ICommandBuffer& commandBuffer, uint32_t passIndex) override;
+		virtual void FinaliseResults(const IPhysicalDevice& physicalDevice, const IDevice& device) override;
 
 	private:
 		vk::UniqueQueryPool m_statisticsQueryPool;
 		vk::UniqueQueryPool m_timestampQueryPool;
-		std::vector<std::string> m_renderPassNames;
 		std::vector<bool> m_isComputePass;
+		std::vector<FrameStats*> m_passStats;
+		FrameStats* m_totalStats;
 
 		bool m_timestampSupported;
 		bool m_statisticsSupported;
 		float m_timestampPeriod;
 		uint32_t m_renderPassCount;
-		uint32_t m_renderPassIndex;
 	};
 }
\ No newline at end of file
@@ -47,12 +47,16 @@ namespace Engine::Rendering::Vulkan
 		, m_Debug()
 		, m_surface()
 		, m_resourceCommandPool()
+		, m_transferCommandPool()
+		, m_uploadTimeline()
+		, m_uploadTimelineValue(0)
 		, m_acquireSemaphores()
 		, m_releaseSemaphores()
 		, m_inFlightRenderFences()
 		, m_inFlightComputeFences()
 		, m_inFlightResources()
 		, m_pendingResources()
+		, m_pendingTransferResources()
 		, m_actionQueue()
 		, m_swapChainOutOfDate(false)
 		, m_allocator()
@@ -65,7 +69,9 @@ namespace Engine::Rendering::Vulkan
 	void VulkanRenderer::DestroyResources()
 	{
 		m_pendingResources.clear();
+		m_pendingTransferResources.clear();
 		m_inFlightResources.clear();
+		m_uploadTimeline.reset();
 		m_acquireSemaphores.clear();
 		m_releaseSemaphores.clear();
 		m_inFlightRenderFences.clear();
@@ -74,6 +80,7 @@ namespace Engine::Rendering::Vulkan
 		Renderer::DestroyResources();
 
 		m_resourceCommandPool.reset();
+		m_transferCommandPool.reset();
 		m_swapChain.reset();
 
 		if (m_allocator != nullptr)
@@ -111,20 +118,118 @@ namespace Engine::Rendering::Vulkan
 	}
 
 	bool VulkanRenderer::SubmitResourceCommand(std::function<bool(const IDevice& device, const IPhysicalDevice& physicalDevice, const ICommandBuffer&,
-		std::vector<std::unique_ptr<IBuffer>>&)> command, std::optional<std::function<void()>> postAction)
+		const ICommandBuffer&, std::vector<std::unique_ptr<IBuffer>>&)> command, std::optional<std::function<void()>> postAction, bool transfer)
 	{
+		// Scene and cell loads record resource commands from their own threads.
+		std::lock_guard<std::mutex> lock(m_resourceSubmitMutex);
+
 		ResourceCommandData resourceData = {};
 		resourceData.commandBuffer = std::move(m_resourceCommandPool->BeginResourceCommandBuffer(*m_device));
 
-		if (!command(*m_device, *m_physicalDevice, *resourceData.commandBuffer, resourceData.buffers))
+		// Without a dedicated transfer queue, or with it turned off, the release and acquire halves end up in the same graphics
+		// command buffer.
+		bool useTransferQueue = transfer && m_transferCommandPool != nullptr && m_renderSettings.m_transferQueueUploads;
+		if (useTransferQueue)
+		{
+			resourceData.acquireCommandBuffer = std::move(resourceData.commandBuffer);
+			resourceData.commandBuffer = std::move(m_transferCommandPool->BeginResourceCommandBuffer(*m_device));
+		}
+
+		const ICommandBuffer& acquireCommandBuffer = useTransferQueue ? *resourceData.acquireCommandBuffer : *resourceData.commandBuffer;
+		if (!command(*m_device, *m_physicalDevice, *resourceData.commandBuffer, acquireCommandBuffer, resourceData.buffers))
 		{
 			return false;
 		}
 
 		resourceData.commandBuffer->End();
+		if (useTransferQueue)
+			resourceData.acquireCommandBuffer->End();
+
 		resourceData.postAction = postAction;
 
-		m_pendingResources.emplace_back(std::move(resourceData));
+		if (useTransferQueue)
+			m_pendingTransferResources.emplace_back(std::move(resourceData));
+		else
+			m_pendingResources.emplace_back(std::move(resourceData));
+
+		return true;
+	}
+
+	bool VulkanRenderer::SubmitPendingResources()
+	{
+		Device* vkDevice = static_cast<Device*>(m_device.get());
+		const vk::Device& deviceImp = vkDevice->Get();
+
+		std::lock_guard<std::mutex> lock(m_resourceSubmitMutex);
+		if (!m_pendingResources.empty())
+		{
+			std::vector<vk::CommandBuffer> commandBuffers(m_pendingResources.size());
+			for (size_t i = 0; i < m_pendingResources.size(); ++i)
+			{
+				commandBuffers[i] = static_cast<CommandBuffer*>(m_pendingResources[i].commandBuffer.get())->Get();
+			}
+
+			vk::SubmitInfo submitInfo;
+			submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+			submitInfo.pCommandBuffers = commandBuffers.data();
+
+			vk::UniqueFence fence = deviceImp.createFenceUnique(vk::FenceCreateInfo());
+
+			vk::Queue graphicsQueue = vkDevice->GetGraphicsQueue();
+			vk::Result submitResult = graphicsQueue.submit(1, &submitInfo, fence.get());
+			if (submitResult != vk::Result::eSuccess)
+			{
+				return false;
+			}
+
+			std::vector<ResourceCommandData> resources = std::move(m_pendingResources);
+			m_inFlightResources.push_back(std::make_pair(std::move(fence), std::move(resources)));
+			m_pendingResources.clear();
+		}
+
+		if (!m_pendingTransferResources.empty())
+		{
+			std::vector<vk::CommandBuffer> transferCommandBuffers(m_pendingTransferResources.size());
+			std::vector<vk::CommandBuffer> acquireCommandBuffers(m_pendingTransferResources.size());
+			for (size_t i = 0; i < m_pendingTransferResources.size(); ++i)
+			{
+				transferCommandBuffers[i] = static_cast<CommandBuffer*>(m_pendingTransferResources[i].commandBuffer.get())->Get();
+				acquireCommandBuffers[i] = static_cast<CommandBuffer*>(m_pendingTransferResources[i].acquireCommandBuffer.get())->Get();
+			}
+
+			const vk::Semaphore& uploadTimeline = static_cast<Semaphore*>(m_uploadTimeline.get())->Get();
+			uint64_t uploadValue = ++m_uploadTimelineValue;
+
+			vk::TimelineSemaphoreSubmitInfo transferTimelineInfo(0, nullptr, 1, &uploadValue);
+			vk::SubmitInfo transferSubmitInfo(0, nullptr, nullptr, static_cast<uint32_t>(transferCommandBuffers.size()), transferCommandBuffers.data(),
+				1, &uploadTimeline, &transferTimelineInfo);
+
+			vk::Queue transferQueue = vkDevice->GetTransferQueue();
+			if (transferQueue.submit(1, &transferSubmitInfo, nullptr) != vk::Result::eSuccess)
+			{
+				return false;
+			}
+
+			// The acquire barriers wait for the copies to land, frames submitted afterwards are ordered behind them on the graphics queue
+			// so rendering never stalls on an upload it does not yet reference.
+			vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+			vk::TimelineSemaphoreSubmitInfo acquireTimelineInfo(1, &uploadValue, 0, nullptr);
+			vk::SubmitInfo acquireSubmitInfo(1, &uploadTimeline, &waitStage, static_cast<uint32_t>(acquireCommandBuffers.size()), acquireCommandBuffers.data(),
+				0, nullptr, &acquireTimelineInfo);
+
+			vk::UniqueFence fence = deviceImp.createFenceUnique(vk::FenceCreateInfo());
+
+			vk::Queue graphicsQueue = vkDevice->GetGraphicsQueue();
+			if (graphicsQueue.submit(1, &acquireSubmitInfo, fence.get()) != vk::Result::eSuccess)
+			{
+				return false;
+			}
+
+			std::vector<ResourceCommandData> resources = std::move(m_pendingTransferResources);
+			m_inFlightResources.push_back(std::make_pair(std::move(fence), std::move(resources)));
+			m_pendingTransferResources.clear();
+		}
+
 		return true;
 	}
 
@@ -224,7 +329,8 @@ namespace Engine::Rendering::Vulkan
 		m_swapChain = std::make_unique<SwapChain>();
 		m_resourceCommandPool = std::make_unique<CommandPool>();
 		m_Debug = std::make_unique<Debug>();
-		m_sceneGeometryBatch = std::make_unique<GeometryBatch>(*this);
+		m_geometryBatches.clear();
+		m_geometryBatches.emplace_back(std::make_unique<GeometryBatch>(*this));
 		m_renderStats = std::make_unique<VulkanRenderStats>();
 		m_materialManager = std::make_unique<PipelineManager>();
 		m_resourceFactory = std::make_unique<ResourceFactory>(&m_allocator);
@@ -248,13 +354,30 @@ namespace Engine::Rendering::Vulkan
 
 		if (!CreateAllocator()
 			|| !static_cast<SwapChain*>(m_swapChain.get())->Initialise(*m_physicalDevice, *m_device, *m_surface, m_window, m_allocator, m_lastWindowSize, m_renderSettings.m_hdr)
-			//|| !m_resourceCommandPool->Initialise("ResourceCommandPool", *m_physicalDevice, *m_device, indices.TransferFamily.value(), CommandPoolFlags::Transient)
 			|| !m_resourceCommandPool->Initialise("ResourceCommandPool", *m_physicalDevice, *m_device, indices.GraphicsFamily.value(), CommandPoolFlags::Transient)
 			|| !CreateSyncObjects())
 		{
 			return false;
 		}
 
+		// Uploads copy images in partial row ranges, which a transfer queue with a coarser copy granularity cannot do.
+		std::vector<vk::QueueFamilyProperties> queueFamilies = vkPhysicalDevice->Get().getQueueFamilyProperties();
+		const vk::Extent3D& transferGranularity = queueFamilies[indices.TransferFamily.value()].minImageTransferGranularity;
+		bool transferGranularitySupported = transferGranularity.width == 1 && transferGranularity.height == 1 && transferGranularity.depth == 1;
+
+		if (indices.TransferFamily != indices.GraphicsFamily && transferGranularitySupported)
+		{
+			m_transferCommandPool = std::make_unique<CommandPool>();
+			m_uploadTimeline = std::move(m_resourceFactory->CreateGraphicsSemaphore());
+			if (!m_transferCommandPool->Initialise("TransferCommandPool", *m_physicalDevice, *m_device, indices.TransferFamily.value(), CommandPoolFlags::Transient)
+				|| !m_uploadTimeline->Initialise("UploadTimelineSemaphore", *m_device))
+			{
+				return false;
+			}
+
+			Logger::Verbose("Dedicated transfer queue available for initial geometry uploads.");
+		}
+
 		VulkanNvidiaReflex& nvidiaReflex = static_cast<VulkanNvidiaReflex&>(*m_nvidiaReflex);
 		if (!nvidiaReflex.Initialise(*m_physicalDevice))
 		{
@@ -292,7 +415,7 @@ namespace Engine::Rendering::Vulkan
 			return false;
 		}
 
-		if (!m_postProcessing->Rebuild(size))
+		if (!m_postProcessing->Rebuild(GetRenderExtent()))
 		{
 			return false;
 		}
@@ -488,32 +611,10 @@ namespace Engine::Rendering::Vulkan
 		}
 
 		// Submit all currently pending resources.
-		if (!m_pendingResources.empty())
+		if (!SubmitPendingResources())
 		{
-			std::vector<vk::CommandBuffer> commandBuffers(m_pendingResources.size());
-			for (size_t i = 0; i < m_pendingResources.size(); ++i)
-			{
-				commandBuffers[i] = static_cast<CommandBuffer*>(m_pendingResources[i].commandBuffer.get())->Get();
-			}
-
-			vk::SubmitInfo submitInfo;
-			submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
-			submitInfo.pCommandBuffers = commandBuffers.data();
-
-			vk::UniqueFence fence = deviceImp.createFenceUnique(vk::FenceCreateInfo());
-
-			//vk::Queue transferQueue = vkDevice->GetTransferQueue();
-			//vk::Result submitResult = transferQueue.submit(1, &submitInfo, fence.get());
-			vk::Queue graphicsQueue = vkDevice->GetGraphicsQueue();
-			vk::Result submitResult = graphicsQueue.submit(1, &submitInfo, fence.get());
-			if (submitResult != vk::Result::eSuccess)
-			{
-				return false;
-			}
-
-			std::vector<ResourceCommandData> resources = std::move(m_pendingResources);
-			m_inFlightResources.push_back(std::make_pair(std::move(fence), std::move(resources)));
-			m_pendingResources.clear();
+			Logger::Error("Failed to submit pending resource commands.");
+			return false;
 		}
 
 		// Skip rendering in minimised state.
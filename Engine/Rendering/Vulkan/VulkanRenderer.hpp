@@ -56,8 +56,8 @@ namespace Engine::Rendering::Vulkan
 		inline VmaAllocator GetAllocator() const { return m_allocator; };
 
 		virtual bool SubmitResourceCommand(std::function<bool(const IDevice& device, const IPhysicalDevice& physicalDevice,
-			const ICommandBuffer&, std::vector<std::unique_ptr<IBuffer>>&)> command,
-			std::optional<std::function<void()>> postAction = std::nullopt) override;
+			const ICommandBuffer& commandBuffer, const ICommandBuffer& acquireCommandBuffer, std::vector<std::unique_ptr<IBuffer>>&)> command,
+			std::optional<std::function<void()>> postAction = std::nullopt, bool transfer = false) override;
 
 		virtual IRenderImage& GetPresentImage() const override;
 		virtual bool Present(const std::vector<SubmitInfo>& renderSubmitInfos, const std::vector<SubmitInfo>& computeSubmitInfos) override;
@@ -70,11 +70,13 @@ namespace Engine::Rendering::Vulkan
 		bool CreateAllocator();
 		bool RecreateSwapChain(const glm::uvec2& size, bool rebuildPipelines);
 		bool SubmitQueue(const std::vector<SubmitInfo>& submitInfos, const vk::Queue& queue, const vk::Fence& fence, bool present) const;
+		bool SubmitPendingResources();
 
 		struct ResourceCommandData
 		{
 			std::vector<std::unique_ptr<IBuffer>> buffers;
 			std::unique_ptr<ICommandBuffer> commandBuffer;
+			std::unique_ptr<ICommandBuffer> acquireCommandBuffer;
 			std::optional<std::function<void()>> postAction;
 		};
 
@@ -85,6 +87,9 @@ namespace Engine::Rendering::Vulkan
 		uint32_t m_presentImageIndex;
 
 		std::unique_ptr<CommandPool> m_resourceCommandPool;
+		std::unique_ptr<CommandPool> m_transferCommandPool;
+		std::unique_ptr<ISemaphore> m_uploadTimeline;
+		uint64_t m_uploadTimelineValue;
 
 		std::vector<vk::UniqueSemaphore> m_releaseSemaphores;
 		std::vector<vk::UniqueSemaphore> m_acquireSemaphores;
@@ -92,6 +97,7 @@ namespace Engine::Rendering::Vulkan
 		std::vector<vk::UniqueFence> m_inFlightComputeFences;
 		std::vector<std::pair<vk::UniqueFence, std::vector<ResourceCommandData>>> m_inFlightResources;
 		std::vector<ResourceCommandData> m_pendingResources;
+		std::vector<ResourceCommandData> m_pendingTransferResources;
 
 		std::queue<std::function<bool()>> m_actionQueue;
 
@@ -171,6 +171,10 @@ namespace Engine::Rendering::Vulkan
 			return vk::Format::eB8G8R8A8Unorm;
 		case Format::A2B10G10R10UnormPack32:
 			return vk::Format::eA2B10G10R10UnormPack32;
+		case Format::R32Uint:
+			return vk::Format::eR32Uint;
+		case Format::R32G32Uint:
+			return vk::Format::eR32G32Uint;
 		default:
 			throw;
 		}
@@ -218,6 +222,10 @@ namespace Engine::Rendering::Vulkan
 			return Format::B8G8R8A8Unorm;
 		case vk::Format::eA2B10G10R10UnormPack32:
 			return Format::A2B10G10R10UnormPack32;
+		case vk::Format::eR32Uint:
+			return Format::R32Uint;
+		case vk::Format::eR32G32Uint:
+			return Format::R32G32Uint;
 		default:
 			throw;
 		}
@@ -3,6 +3,8 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui.h>
 #include <implot.h>
+#include <cassert>
+#include <cmath>
 
 namespace Engine::UI
 {
@@ -234,7 +236,7 @@ namespace Engine::UI
 	{
 		assert(fillColour || borderColour);
 
-		if (std::fabsf(max.x - min.x) < 1e-6f || std::fabsf(max.y - min.y) < 1e-6f)
+		if (std::fabs(max.x - min.x) < 1e-6f || std::fabs(max.y - min.y) < 1e-6f)
 			return;
 
 		ImDrawList* drawList = ImGui::GetWindowDrawList();
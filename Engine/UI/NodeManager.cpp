@@ -170,15 +170,8 @@ namespace Engine::UI
 
 		ImRect rect = ImRect(a, b);
 		ImDrawList* drawList = ImGui::GetWindowDrawList();
-		float rect_x = rect.Min.x;
-		float rect_y = rect.Min.y;
 		float rect_w = rect.Max.x - rect.Min.x;
-		float rect_h = rect.Max.y - rect.Min.y;
-		float rect_center_x = (rect.Min.x + rect.Max.x) * 0.5f;
-		float rect_center_y = (rect.Min.y + rect.Max.y) * 0.5f;
-		ImVec2 rect_center = ImVec2(rect_center_x, rect_center_y);
 		const float outline_scale = rect_w / 24.0f;
-		const int32_t extra_segments = static_cast<int32_t>(2 * outline_scale); // for full circle
 
 		const float origin_scale = rect_w / 24.0f;
 
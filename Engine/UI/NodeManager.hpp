@@ -13,7 +13,7 @@ namespace Engine::UI
 	struct NodePin
 	{
 		std::string Name;
-		Colour Colour;
+		Engine::Colour Colour;
 
 		NodePin(std::string_view name, const Engine::Colour& colour = {1.0f, 1.0f, 1.0f})
 			: Name(name)
@@ -49,7 +49,7 @@ namespace Engine::UI
 		struct Pin
 		{
 			uint32_t ID;
-			Node* Node;
+			NodeManager::Node* Node;
 			PinKind Kind;
 
 			inline void Setup(uint32_t id)
@@ -65,7 +65,7 @@ namespace Engine::UI
 			uint32_t ID;
 			std::unordered_map<std::string, Pin> Inputs;
 			std::unordered_map<std::string, Pin> Outputs;
-			Colour Colour;
+			Engine::Colour Colour;
 
 			inline void Setup(uint32_t id, Engine::Colour colour = { 0.4f, 0.4f, 0.4f })
 			{
@@ -79,7 +79,7 @@ namespace Engine::UI
 			uint32_t ID;
 			uint32_t StartPinID;
 			uint32_t EndPinID;
-			Colour Colour;
+			Engine::Colour Colour;
 
 			Link(uint32_t id, uint32_t startPinId, uint32_t endPinId, Engine::Colour colour = { 1.0f, 1.0f, 1.0f })
 				: ID(id)
@@ -0,0 +1,16 @@
+#include "NullUIManager.hpp"
+
+using namespace Engine::OS;
+using namespace Engine::Rendering;
+
+namespace Engine::UI::Null
+{
+	NullUIManager::NullUIManager(Window& window, Renderer& renderer)
+		: UIManager(window, renderer)
+	{
+	}
+
+	void NullUIManager::Draw(const ICommandBuffer& commandBuffer, float width, float height)
+	{
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "UI/UIManager.hpp"
+
+namespace Engine::Rendering
+{
+	class Renderer;
+	class ICommandBuffer;
+}
+
+namespace Engine::OS
+{
+	class Window;
+}
+
+namespace Engine::UI::Null
+{
+	// Draw callbacks can be registered as usual, but nothing is drawn as there is no ImGui render backend.
+	class NullUIManager : public UIManager
+	{
+	public:
+		NullUIManager(Engine::OS::Window& window, Engine::Rendering::Renderer& renderer);
+
+		virtual void Draw(const Engine::Rendering::ICommandBuffer& commandBuffer, float width, float height) override;
+	};
+}
\ No newline at end of file
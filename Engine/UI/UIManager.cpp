@@ -4,11 +4,10 @@
 #include "Core/Logger.hpp"
 #include "imgui.h"
 #include <functional>
+#include <cfloat>
 
 #ifdef _WIN32
 #include "backends/imgui_impl_win32.h"
-#else
-#error Not implemented.
 #endif
 
 using namespace Engine::OS;
@@ -27,21 +26,25 @@ namespace Engine::UI
 
 	UIManager::~UIManager()
 	{
-		if (m_initialised)
-		{
-			m_window.UnregisterDPIChangeCallback(std::bind(&UIManager::OnDPIChanged, this, std::placeholders::_1));
-			m_initialised = false;
-		}
+		// Backends without a UI never create the ImGui context.
+		if (!m_initialised)
+			return;
+
+		m_window.UnregisterDPIChangeCallback(std::bind(&UIManager::OnDPIChanged, this, std::placeholders::_1));
+		m_initialised = false;
 
 #ifdef _WIN32
 		ImGui_ImplWin32_Shutdown();
-#else
-#error Not implemented.
 #endif
 	}
 
 	bool UIManager::Initialise()
 	{
+#ifndef _WIN32
+		Logger::Error("There is no platform UI backend on this platform.");
+		return false;
+#endif
+
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
 		ImGui::CreateContext();
@@ -57,8 +60,6 @@ namespace Engine::UI
 		{
 			return false;
 		}
-#else
-#error Not implemented.
 #endif
 
 		IM_DELETE(io.Fonts);
@@ -120,6 +121,9 @@ namespace Engine::UI
 
 	float UIManager::GetFPS() const
 	{
+		if (!m_initialised)
+			return 0.0f;
+
 		return ImGui::GetIO().Framerate;
 	}
 
@@ -137,8 +141,6 @@ namespace Engine::UI
 
 #ifdef _WIN32
 		ImGui_ImplWin32_NewFrame();
-#else
-#error Not implemented.
 #endif
 
 		return true;
@@ -16,9 +16,18 @@ namespace Sandbox
 			, AntiAliasingMode(Engine::Rendering::AntiAliasingMode::TAA)
 			, UseHDR(false)
 			, CullingMode(Engine::Rendering::CullingMode::FrustumAndOcclusion)
+			, UseClusterCulling(false)
+			, UseBoxCulling(true)
+			, QuantiseVertices(false)
+			, UseTransferQueueUploads(false)
 			, ShadowResolutionIndex(3)
 			, NvidiaReflexMode(Engine::Rendering::NvidiaReflexMode::On)
 			, UseAsyncCompute(true)
+			, UseParallelRecording(true)
+			, UsePrecompiledPassVariants(false)
+			, RenderScale(1.0f)
+			, UseDynamicResolution(false)
+			, TargetFrameRate(60)
 		{
 		}
 
@@ -28,7 +37,16 @@ namespace Sandbox
 		Engine::Rendering::AntiAliasingMode AntiAliasingMode;
 		bool UseHDR;
 		bool UseAsyncCompute;
+		bool UseParallelRecording;
+		bool UsePrecompiledPassVariants;
+		float RenderScale;
+		bool UseDynamicResolution;
+		int32_t TargetFrameRate;
 		Engine::Rendering::CullingMode CullingMode;
+		bool UseClusterCulling;
+		bool UseBoxCulling;
+		bool QuantiseVertices;
+		bool UseTransferQueueUploads;
 		int32_t ShadowResolutionIndex;
 		Engine::Rendering::NvidiaReflexMode NvidiaReflexMode;
 	};
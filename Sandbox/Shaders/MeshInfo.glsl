@@ -3,6 +3,8 @@ struct MeshInfo
 	mat4 transform;
 	mat4 normalMatrix;
 	vec4 color;
+	vec4 positionOffset; // Dequantisation of compact positions, unused with full precision vertices.
+	vec4 positionScale;
 	uint diffuseImageIndex;
 	uint normalImageIndex;
 	uint metallicRoughnessImageIndex;
@@ -21,6 +21,7 @@ layout(location = 5) in vec4 fragPrevPos;
 layout(location = 6) in vec4 fragPos;
 layout(location = 7) in vec4 fragWorldPosAndViewDepth;
 layout(location = 8) in vec3 fragNormal;
+layout(location = 9) in vec4 fragTangent;
 
 layout(binding = 2) uniform sampler samp;
 layout(binding = 3) uniform texture2D textures[];
@@ -38,14 +39,10 @@ vec3 unpackNormal()
 	float z = sqrt(1.0 - packed.x * packed.x - packed.y * packed.y);
 	vec3 tangentNormal = normalize(vec3(packed, z));
 
-	vec3 q1 = dFdx(fragWorldPosAndViewDepth.xyz);
-	vec3 q2 = dFdy(fragWorldPosAndViewDepth.xyz);
-	vec2 st1 = dFdx(fragUv);
-	vec2 st2 = dFdy(fragUv);
-
+	// Interpolation skews the vertex frame, so the tangent is made orthogonal to the normal again.
 	vec3 N = normalize(fragNormal);
-	vec3 T = normalize(q1 * st2.t - q2 * st1.t);
-	vec3 B = -normalize(cross(N, T));
+	vec3 T = normalize(fragTangent.xyz - N * dot(N, fragTangent.xyz));
+	vec3 B = cross(N, T) * (fragTangent.w < 0.0 ? -1.0 : 1.0);
 	mat3 TBN = mat3(T, B, N);
 
 	return normalize(TBN * tangentNormal);
@@ -21,6 +21,7 @@ layout(std140, binding = 1) readonly buffer MeshInfoBuffer
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 uv;
 layout(location = 2) in vec3 normal;
+layout(location = 3) in vec4 tangent;
 
 layout(location = 0) flat out uint fragDiffuseImageIndex;
 layout(location = 1) flat out uint fragNormalImageIndex;
@@ -32,6 +33,7 @@ layout(location = 5) out vec4 fragPrevPos;
 layout(location = 6) out vec4 fragPos;
 layout(location = 7) out vec4 fragWorldPosAndViewDepth;
 layout(location = 8) out vec3 fragNormal;
+layout(location = 9) out vec4 fragTangent;
 
 void main()
 {
@@ -47,6 +49,11 @@ void main()
     fragWorldPosAndViewDepth.xyz = transformedPos.xyz / transformedPos.w;
 	fragWorldPosAndViewDepth.w = (frameInfo.view * transformedPos).z;
     fragNormal = normalize(vec3(infoBuffer.meshInfo[gl_InstanceIndex].normalMatrix * vec4(normal, 0.0)));
+
+	// Tangents lie in the surface so they follow the transform itself, a mirroring transform flips the bitangent.
+	mat3 tangentTransform = mat3(infoBuffer.meshInfo[gl_InstanceIndex].transform);
+	fragTangent.xyz = normalize(tangentTransform * tangent.xyz);
+	fragTangent.w = determinant(tangentTransform) < 0.0 ? -tangent.w : tangent.w;
 	fragPrevPos = frameInfo.prevViewProj * vec4(fragWorldPosAndViewDepth.xyz, 1.0);
 
 	fragWorldPosAndViewDepth.xyz += frameInfo.viewPos.xyz;
@@ -0,0 +1,17 @@
+#version 460
+#extension GL_EXT_samplerless_texture_functions : require
+
+#include "catmullsample.glsl"
+
+layout(binding = 0) uniform sampler linearSampler;
+layout(binding = 1) uniform texture2D inputImage;
+
+layout(location = 0) in vec2 fragUv;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	vec2 texDimensions = textureSize(inputImage, 0);
+	outColor = SampleTextureCatmullRom(inputImage, linearSampler, fragUv, texDimensions);
+}
\ No newline at end of file
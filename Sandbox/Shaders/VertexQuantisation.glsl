@@ -0,0 +1,17 @@
+// Positions are stored as 16-bit unorm components relative to the mesh bounds.
+vec3 decode_position(uvec2 packedPosition, vec3 offset, vec3 scale)
+{
+	vec3 position = vec3(unpackUnorm2x16(packedPosition.x), unpackUnorm2x16(packedPosition.y).x);
+	return offset + position * scale;
+}
+
+// Normals are stored as 2x16-bit snorm octahedral coordinates.
+vec3 decode_octahedral(uint packedNormal)
+{
+	vec2 projected = unpackSnorm2x16(packedNormal);
+	vec3 normal = vec3(projected, 1.0 - abs(projected.x) - abs(projected.y));
+	float fold = max(-normal.z, 0.0);
+	normal.x += normal.x >= 0.0 ? -fold : fold;
+	normal.y += normal.y >= 0.0 ? -fold : fold;
+	return normalize(normal);
+}
\ No newline at end of file
@@ -91,6 +91,18 @@ namespace Sandbox
 			m_renderer->SetCullingMode(m_options.CullingMode);
 		}
 
+		m_options.UseClusterCulling = m_renderer->GetClusterCullingState();
+		if (drawer.Checkbox("Cluster Culling", &m_options.UseClusterCulling))
+		{
+			m_renderer->SetClusterCullingState(m_options.UseClusterCulling);
+		}
+
+		m_options.UseBoxCulling = m_renderer->GetBoxCullingState();
+		if (drawer.Checkbox("Box Culling", &m_options.UseBoxCulling))
+		{
+			m_renderer->SetBoxCullingState(m_options.UseBoxCulling);
+		}
+
 		if (m_renderer->NvidiaReflex().IsSupported())
 		{
 			int32_t nvidiaReflexMode = static_cast<int32_t>(m_options.NvidiaReflexMode);
@@ -106,6 +118,28 @@ namespace Sandbox
 			m_renderer->SetShadowResolution(shadowResolutionValues[m_options.ShadowResolutionIndex]);
 		}
 
+		m_options.UseDynamicResolution = m_renderer->GetDynamicResolutionState();
+		if (drawer.Checkbox("Dynamic Resolution", &m_options.UseDynamicResolution))
+		{
+			m_renderer->SetDynamicResolutionState(m_options.UseDynamicResolution);
+		}
+
+		if (m_options.UseDynamicResolution)
+		{
+			if (drawer.SliderInt("Target Frame Rate", &m_options.TargetFrameRate, 30, 240))
+			{
+				m_renderer->GetRenderScaleController().SetTargetFrameTime(1.0f / static_cast<float>(m_options.TargetFrameRate));
+			}
+		}
+
+		m_options.RenderScale = m_renderer->GetRenderScale();
+		drawer.BeginDisabled(m_options.UseDynamicResolution);
+		if (drawer.SliderFloat("Render Scale", &m_options.RenderScale, 0.5f, 1.0f))
+		{
+			m_renderer->SetRenderScale(m_options.RenderScale);
+		}
+		drawer.EndDisabled();
+
 		bool hdrSupported = m_renderer->IsHDRSupported();
 		drawer.BeginDisabled(!hdrSupported);
 		if (drawer.Checkbox("Use HDR", &m_options.UseHDR))
@@ -123,6 +157,18 @@ namespace Sandbox
 		}
 		drawer.EndDisabled();
 
+		m_options.UseParallelRecording = m_renderer->GetParallelRecordingState();
+		if (drawer.Checkbox("Parallel Recording", &m_options.UseParallelRecording))
+		{
+			m_renderer->SetParallelRecordingState(m_options.UseParallelRecording);
+		}
+
+		m_options.UsePrecompiledPassVariants = m_renderer->GetPrecompiledPassVariantsState();
+		if (drawer.Checkbox("Precompiled Pass Variants", &m_options.UsePrecompiledPassVariants))
+		{
+			m_renderer->SetPrecompiledPassVariantsState(m_options.UsePrecompiledPassVariants);
+		}
+
 		if (drawer.Colour3("Clear Colour", m_options.ClearColour))
 		{
 			m_renderer->SetClearColour(m_options.ClearColour);
@@ -159,6 +205,10 @@ namespace Sandbox
 
 			drawer.Text("Dedicated VRAM Usage: %.2f MB / %.2f MB (%.2f%%)", dedicatedUsage, dedicatedBudget, dedicatedPercent);
 			drawer.Text("Shared VRAM Usage: %.2f MB / %.2f MB (%.2f%%)", sharedUsage, sharedBudget, sharedPercent);
+			drawer.Text("Transient Images: %.2f MB aliased, %.2f MB unaliased, %.2f MB peak in use",
+				static_cast<float>(memoryStats.TransientAliasedSize) / 1024.0f / 1024.0f,
+				static_cast<float>(memoryStats.TransientUnaliasedSize) / 1024.0f / 1024.0f,
+				static_cast<float>(memoryStats.TransientPeakSize) / 1024.0f / 1024.0f);
 		}
 
 		if (drawer.CollapsingHeader("Performance", true))
@@ -57,6 +57,8 @@ int main()
 	renderer->SetClearColour(g_options.ClearColour);
 	renderer->SetSunLightColour(g_options.SunColour);
 	renderer->SetSunLightIntensity(g_options.SunIntensity);
+	renderer->SetVertexQuantisationState(g_options.QuantiseVertices);
+	renderer->SetTransferQueueUploadState(g_options.UseTransferQueueUploads);
 
 	renderer->GetUIManager().RegisterDrawCallback(DrawLoadProgress);
 	renderer->GetSceneManager().LoadScene("DownloadedAssets/Bistro_small.glb", renderer.get(), true, g_sceneLoad);
@@ -96,6 +98,9 @@ int main()
 				renderer->GetUIManager().UnregisterDrawCallback(uiDrawCallback);
 		}
 
+		if (window->InputState.KeyDown(KeyCode::F2))
+			renderer->DumpRenderGraphLayout("RenderGraph.txt");
+
 		// Rotate sunlight for testing
 		glm::vec3 sunDir = glm::vec3(cosf(totalTime), -5.0f, sinf(totalTime));
 		//glm::vec3 sunDir = glm::vec3(0, 1, 0) * glm::angleAxis(totalTime, glm::vec3(1, 0, 0));
@@ -0,0 +1,114 @@
+#include "TestUtilities.hpp"
+#include <Core/BoundingVolume.hpp>
+#include <Core/VertexData.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define CLOUD_POINT_COUNT 2048
+#define CONTAINMENT_EPSILON 0.0001f
+
+// Point sets that are hard for Ritter's approximation: a lopsided cloud whose extremes are not the first pair found, a
+// thin needle, a flat disc, duplicated points and a single point.
+static std::vector<std::vector<glm::vec3>> CreatePointSets()
+{
+	std::vector<std::vector<glm::vec3>> pointSets(5);
+	for (uint32_t i = 0; i < CLOUD_POINT_COUNT; ++i)
+	{
+		float t = static_cast<float>(i);
+		glm::vec3 direction = glm::normalize(glm::vec3(std::sin(t * 1.7f), std::cos(t * 2.3f), std::sin(t * 0.9f + 1.0f)));
+		float distance = 1.0f + 4.0f * std::abs(std::sin(t * 0.31f)) * (direction.x > 0.5f ? 3.0f : 1.0f);
+		pointSets[0].push_back(glm::vec3(10.0f, -5.0f, 2.0f) + direction * distance);
+		pointSets[1].push_back(glm::vec3(t * 0.01f, std::sin(t) * 0.001f, 0.0f));
+		pointSets[2].push_back(glm::vec3(std::cos(t * 0.37f), 0.0f, std::sin(t * 0.37f)) * std::abs(std::sin(t * 0.11f)) * 50.0f);
+		pointSets[3].push_back(i % 2 == 0 ? glm::vec3(-1.0f, 2.0f, 3.0f) : glm::vec3(4.0f, -2.0f, 0.5f));
+	}
+
+	pointSets[4].push_back(glm::vec3(7.0f, 8.0f, 9.0f));
+	return pointSets;
+}
+
+static bool SphereContains(const glm::vec4& sphere, const glm::vec3& point, float epsilon)
+{
+	return glm::length(point - glm::vec3(sphere)) <= sphere.w + epsilon;
+}
+
+// The local sphere is measured against the final centre, so every input point lies inside it without any tolerance, and
+// the box is exact.
+static void TestLocalBoundsContainPoints()
+{
+	for (const std::vector<glm::vec3>& points : CreatePointSets())
+	{
+		LocalBounds bounds = BoundingVolume::Calculate(VertexData(points));
+
+		bool sphereContains = true;
+		bool boxContains = true;
+		for (const glm::vec3& point : points)
+		{
+			sphereContains &= SphereContains(bounds.Sphere, point, 0.0f);
+			boxContains &= glm::min(point, bounds.BoxMin) == bounds.BoxMin && glm::max(point, bounds.BoxMax) == bounds.BoxMax;
+		}
+
+		TEST_CHECK(sphereContains);
+		TEST_CHECK(boxContains);
+
+		// Neither sphere can be larger than the one around the box corners.
+		TEST_CHECK(bounds.Sphere.w <= glm::length(bounds.BoxMax - bounds.BoxMin) * 0.5f + CONTAINMENT_EPSILON);
+	}
+}
+
+// An instance rotated about an oblique axis and scaled by a different amount along each axis still has every transformed
+// vertex inside both its world space sphere and its oriented box.
+static void TestTransformedBoundsContainVertices()
+{
+	glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(-30.0f, 12.0f, 5.0f));
+	transform = glm::rotate(transform, 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f)));
+	transform = glm::scale(transform, glm::vec3(4.0f, 0.25f, 1.5f));
+
+	for (const std::vector<glm::vec3>& points : CreatePointSets())
+	{
+		LocalBounds localBounds = BoundingVolume::Calculate(VertexData(points));
+		WorldBounds worldBounds = BoundingVolume::Transform(localBounds, transform);
+
+		bool sphereContains = true;
+		bool boxContains = true;
+		for (const glm::vec3& point : points)
+		{
+			glm::vec3 worldPoint = glm::vec3(transform * glm::vec4(point, 1.0f));
+			sphereContains &= SphereContains(worldBounds.Sphere, worldPoint, worldBounds.Sphere.w * CONTAINMENT_EPSILON + CONTAINMENT_EPSILON);
+
+			// Without shear the box axes stay orthogonal, so a point's distance along each is a projection. Flat meshes have
+			// zero length axes, what is left after projecting onto the others must then be nothing. The tolerance is a world
+			// space distance, as rounding the transformed points is large next to the half extents of thin meshes.
+			glm::vec3 offset = worldPoint - worldBounds.BoxCenter;
+			glm::vec3 residual = offset;
+			for (const glm::vec3& axis : worldBounds.BoxAxes)
+			{
+				float halfExtent = glm::length(axis);
+				if (halfExtent == 0.0f)
+					continue;
+
+				float distance = glm::dot(offset, axis) / halfExtent;
+				boxContains &= std::abs(distance) <= halfExtent + CONTAINMENT_EPSILON;
+				residual -= axis * (distance / halfExtent);
+			}
+
+			boxContains &= glm::length(residual) <= CONTAINMENT_EPSILON;
+		}
+
+		TEST_CHECK(sphereContains);
+		TEST_CHECK(boxContains);
+	}
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestLocalBoundsContainPoints", TestLocalBoundsContainPoints },
+		{ "TestTransformedBoundsContainVertices", TestTransformedBoundsContainVertices }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "TestUtilities.hpp"
+#include <Core/CellStreamer.hpp>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define CELL_SIZE 100.0f
+#define CELL_COUNT 10
+#define CELL_BYTE_SIZE (1ull << 20)
+#define LOAD_DISTANCE 100.0f
+#define UNLOAD_DISTANCE 150.0f
+#define LOAD_LATENCY 2
+
+// A single row of equally sized cells along X, the viewer walks down the middle of it.
+static void AddCellRow(CellStreamer& streamer)
+{
+	for (uint32_t i = 0; i < CELL_COUNT; ++i)
+	{
+		float x = i * CELL_SIZE;
+		streamer.AddCell(glm::vec3(x, 0.0f, 0.0f), glm::vec3(x + CELL_SIZE, 10.0f, CELL_SIZE), CELL_BYTE_SIZE);
+	}
+}
+
+static std::vector<glm::vec3> CreateWalkPath(float startX, float endX, float stepSize, uint32_t settleSteps)
+{
+	std::vector<glm::vec3> path;
+	for (float x = startX; x <= endX; x += stepSize)
+		path.emplace_back(x, 5.0f, CELL_SIZE * 0.5f);
+
+	path.insert(path.end(), settleSteps, path.back());
+	return path;
+}
+
+static void TestStaysWithinBudget()
+{
+	CellStreamer streamer(LOAD_DISTANCE, UNLOAD_DISTANCE, 3 * CELL_BYTE_SIZE, 2);
+	AddCellRow(streamer);
+
+	std::vector<CellStreamingStep> steps = CellStreamer::Simulate(streamer, CreateWalkPath(50.0f, 950.0f, 10.0f, 8), LOAD_LATENCY);
+	for (const CellStreamingStep& step : steps)
+	{
+		if (!TEST_CHECK(step.Stats.ResidentBytes <= streamer.GetMemoryBudget()))
+			break;
+	}
+
+	// Once the viewer stops, the cell it stands in and its neighbour are resident and nothing is left waiting.
+	const std::vector<StreamingCell>& cells = streamer.GetCells();
+	TEST_CHECK(cells[CELL_COUNT - 1].State == CellState::Resident);
+	TEST_CHECK(cells[CELL_COUNT - 2].State == CellState::Resident);
+	TEST_CHECK(steps.back().Stats.QueueDepth == 0);
+	TEST_CHECK(steps.back().Stats.LoadingCount == 0);
+}
+
+// Walking forward, cells are requested nearest first so they load in the order they are reached, and the budget is met
+// by evicting the cells furthest behind first. No cell is loaded or evicted twice.
+static void TestLoadsNearestAndEvictsFurthest()
+{
+	CellStreamer streamer(LOAD_DISTANCE, UNLOAD_DISTANCE, 3 * CELL_BYTE_SIZE, 2);
+	AddCellRow(streamer);
+
+	std::vector<CellStreamingStep> steps = CellStreamer::Simulate(streamer, CreateWalkPath(50.0f, 950.0f, 10.0f, 8), LOAD_LATENCY);
+
+	std::vector<uint32_t> loads;
+	std::vector<uint32_t> unloads;
+	for (const CellStreamingStep& step : steps)
+	{
+		loads.insert(loads.end(), step.LoadRequests.begin(), step.LoadRequests.end());
+		unloads.insert(unloads.end(), step.UnloadRequests.begin(), step.UnloadRequests.end());
+	}
+
+	if (TEST_CHECK(loads.size() == CELL_COUNT))
+	{
+		for (uint32_t i = 0; i < loads.size(); ++i)
+			TEST_CHECK(loads[i] == i);
+	}
+
+	// The last three cells fit the budget and stay resident.
+	if (TEST_CHECK(unloads.size() == CELL_COUNT - 3))
+	{
+		for (uint32_t i = 0; i < unloads.size(); ++i)
+			TEST_CHECK(unloads[i] == i);
+	}
+
+	// The budget alone forces the first eviction, before the cell is beyond the unload distance.
+	for (size_t i = 0; i < steps.size(); ++i)
+	{
+		if (steps[i].UnloadRequests.empty())
+			continue;
+
+		float viewerX = 50.0f + i * 10.0f;
+		TEST_CHECK(viewerX - CELL_SIZE <= UNLOAD_DISTANCE);
+		break;
+	}
+}
+
+// Crossing back and forth over a cell border only loads each cell once when unloading waits for the larger distance,
+// while equal distances reload the same cells on every crossing.
+static uint32_t CountRequestsWhileOscillating(float unloadDistance)
+{
+	CellStreamer streamer(LOAD_DISTANCE, unloadDistance, CELL_COUNT * CELL_BYTE_SIZE, 2);
+	AddCellRow(streamer);
+
+	std::vector<glm::vec3> path;
+	for (uint32_t i = 0; i < 40; ++i)
+		path.emplace_back(i % 2 == 0 ? 395.0f : 445.0f, 5.0f, CELL_SIZE * 0.5f);
+
+	std::vector<CellStreamingStep> steps = CellStreamer::Simulate(streamer, path, LOAD_LATENCY);
+
+	// Skip the steps needed to load the cells around both positions.
+	uint32_t requestCount = 0;
+	for (size_t i = 8; i < steps.size(); ++i)
+		requestCount += static_cast<uint32_t>(steps[i].LoadRequests.size() + steps[i].UnloadRequests.size());
+
+	return requestCount;
+}
+
+static void TestHysteresisAvoidsThrashing()
+{
+	TEST_CHECK(CountRequestsWhileOscillating(UNLOAD_DISTANCE) == 0);
+	TEST_CHECK(CountRequestsWhileOscillating(LOAD_DISTANCE) > 0);
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestStaysWithinBudget", TestStaysWithinBudget },
+		{ "TestLoadsNearestAndEvictsFurthest", TestLoadsNearestAndEvictsFurthest },
+		{ "TestHysteresisAvoidsThrashing", TestHysteresisAvoidsThrashing }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "TestUtilities.hpp"
+#include <Core/ChunkData.hpp>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define GRID_SIZE 256
+#define POSITION_FILTER_BITS 22
+#define NORMAL_FILTER_BITS 16
+#define BENCHMARK_DECODE_COUNT 50
+
+// The same streams are stored twice, once with the mesh codecs the geometry cache uses and once with LZ4 alone.
+#define INDEX_IDENTIFIER 0
+#define LZ4_POSITIONS_IDENTIFIER 1
+#define LZ4_TEXTURE_COORDINATES_IDENTIFIER 2
+#define LZ4_NORMALS_IDENTIFIER 3
+#define LZ4_INDEX_IDENTIFIER 4
+
+struct TestMesh
+{
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::vec2> TextureCoordinates;
+	std::vector<glm::vec3> Normals;
+	std::vector<uint32_t> Indices;
+};
+
+struct EncodedStream
+{
+	const char* Name;
+	ChunkMemoryEntry CodecEntry;
+	ChunkMemoryEntry LZ4Entry;
+};
+
+// A rolling height field, smooth like most authored geometry and with triangles in a cache friendly order.
+static TestMesh CreateTerrainMesh()
+{
+	TestMesh mesh;
+	for (uint32_t z = 0; z < GRID_SIZE; ++z)
+	{
+		for (uint32_t x = 0; x < GRID_SIZE; ++x)
+		{
+			float u = static_cast<float>(x) * 0.1f;
+			float v = static_cast<float>(z) * 0.1f;
+			float height = std::sin(u) * std::cos(v) * 4.0f;
+			glm::vec3 gradient(std::cos(u) * std::cos(v) * 0.4f, 1.0f, -std::sin(u) * std::sin(v) * 0.4f);
+
+			mesh.Positions.emplace_back(static_cast<float>(x), height, static_cast<float>(z));
+			mesh.TextureCoordinates.emplace_back(x / (GRID_SIZE - 1.0f), z / (GRID_SIZE - 1.0f));
+			mesh.Normals.push_back(glm::normalize(glm::vec3(-gradient.x, gradient.y, -gradient.z)));
+		}
+	}
+
+	for (uint32_t z = 0; z < GRID_SIZE - 1; ++z)
+	{
+		for (uint32_t x = 0; x < GRID_SIZE - 1; ++x)
+		{
+			uint32_t corner = z * GRID_SIZE + x;
+			mesh.Indices.insert(mesh.Indices.end(), { corner, corner + GRID_SIZE, corner + 1, corner + 1, corner + GRID_SIZE, corner + GRID_SIZE + 1 });
+		}
+	}
+
+	return mesh;
+}
+
+template <typename T>
+static std::span<uint8_t> GetBytes(std::vector<T>& data)
+{
+	return std::span<uint8_t>(reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(T));
+}
+
+// Chunks are only encoded when written, so the streams go through a file and are parsed back before decoding.
+static bool WriteAndParseChunk(TestMesh& mesh, ChunkData& chunkData)
+{
+	ChunkData writeData;
+	writeData.SetVertexData(VertexBufferType::Positions, GetBytes(mesh.Positions), sizeof(glm::vec3), POSITION_FILTER_BITS);
+	writeData.SetVertexData(VertexBufferType::TextureCoordinates, GetBytes(mesh.TextureCoordinates), sizeof(glm::vec2));
+	writeData.SetVertexData(VertexBufferType::Normals, GetBytes(mesh.Normals), sizeof(glm::vec3), NORMAL_FILTER_BITS);
+	writeData.SetGenericData(INDEX_IDENTIFIER, GetBytes(mesh.Indices), ChunkCompression::IndexCodec);
+
+	writeData.SetGenericData(LZ4_POSITIONS_IDENTIFIER, GetBytes(mesh.Positions));
+	writeData.SetGenericData(LZ4_TEXTURE_COORDINATES_IDENTIFIER, GetBytes(mesh.TextureCoordinates));
+	writeData.SetGenericData(LZ4_NORMALS_IDENTIFIER, GetBytes(mesh.Normals));
+	writeData.SetGenericData(LZ4_INDEX_IDENTIFIER, GetBytes(mesh.Indices));
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "ChunkDataTests.chunk";
+	bool parsed = TEST_CHECK(writeData.WriteToFile(path, nullptr)) && TEST_CHECK(chunkData.Parse(path, nullptr));
+
+	std::error_code error;
+	std::filesystem::remove(path, error);
+	return parsed;
+}
+
+// Positions, texture coordinates, normals and indices, each with both of its entries.
+static bool GetStreams(ChunkData& chunkData, std::array<EncodedStream, 4>& streams)
+{
+	streams = { { { "Positions", {}, {} }, { "TextureCoordinates", {}, {} }, { "Normals", {}, {} }, { "Indices", {}, {} } } };
+	return TEST_CHECK(chunkData.GetVertexData(VertexBufferType::Positions, streams[0].CodecEntry))
+		&& TEST_CHECK(chunkData.GetVertexData(VertexBufferType::TextureCoordinates, streams[1].CodecEntry))
+		&& TEST_CHECK(chunkData.GetVertexData(VertexBufferType::Normals, streams[2].CodecEntry))
+		&& TEST_CHECK(chunkData.GetGenericData(INDEX_IDENTIFIER, streams[3].CodecEntry))
+		&& TEST_CHECK(chunkData.GetGenericData(LZ4_POSITIONS_IDENTIFIER, streams[0].LZ4Entry))
+		&& TEST_CHECK(chunkData.GetGenericData(LZ4_TEXTURE_COORDINATES_IDENTIFIER, streams[1].LZ4Entry))
+		&& TEST_CHECK(chunkData.GetGenericData(LZ4_NORMALS_IDENTIFIER, streams[2].LZ4Entry))
+		&& TEST_CHECK(chunkData.GetGenericData(LZ4_INDEX_IDENTIFIER, streams[3].LZ4Entry));
+}
+
+static bool DecodeStream(ChunkData& chunkData, const EncodedStream& stream, std::vector<uint8_t>& codecData, std::vector<uint8_t>& lz4Data)
+{
+	return TEST_CHECK(chunkData.Decompress(stream.CodecEntry, codecData)) && TEST_CHECK(chunkData.Decompress(stream.LZ4Entry, lz4Data));
+}
+
+// The exponent filter keeps the given mantissa bits relative to the largest component of each vector.
+static bool MatchesFiltered(const std::vector<glm::vec3>& expected, const std::vector<uint8_t>& decoded, int32_t filterBits)
+{
+	const glm::vec3* values = reinterpret_cast<const glm::vec3*>(decoded.data());
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		glm::vec3 magnitude = glm::abs(expected[i]);
+		float tolerance = std::max(std::max(magnitude.x, magnitude.y), magnitude.z) * std::ldexp(1.0f, 2 - filterBits);
+		glm::vec3 error = glm::abs(values[i] - expected[i]);
+		if (error.x > tolerance || error.y > tolerance || error.z > tolerance)
+			return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+static bool MatchesExactly(const std::vector<T>& expected, const std::vector<uint8_t>& decoded)
+{
+	return decoded.size() >= expected.size() * sizeof(T) && std::memcmp(decoded.data(), expected.data(), expected.size() * sizeof(T)) == 0;
+}
+
+static void TestMeshCodecsRoundTrip()
+{
+	TestMesh mesh = CreateTerrainMesh();
+	ChunkData chunkData;
+	std::array<EncodedStream, 4> streams;
+	if (!WriteAndParseChunk(mesh, chunkData) || !GetStreams(chunkData, streams))
+		return;
+
+	std::vector<uint8_t> codecData;
+	std::vector<uint8_t> lz4Data;
+	if (DecodeStream(chunkData, streams[0], codecData, lz4Data))
+	{
+		TEST_CHECK(streams[0].CodecEntry.Compression == ChunkCompression::VertexCodecExp);
+		TEST_CHECK(MatchesFiltered(mesh.Positions, codecData, POSITION_FILTER_BITS));
+		TEST_CHECK(MatchesExactly(mesh.Positions, lz4Data));
+	}
+
+	// Texture coordinates are stored losslessly.
+	if (DecodeStream(chunkData, streams[1], codecData, lz4Data))
+	{
+		TEST_CHECK(streams[1].CodecEntry.Compression == ChunkCompression::VertexCodec);
+		TEST_CHECK(MatchesExactly(mesh.TextureCoordinates, codecData));
+		TEST_CHECK(MatchesExactly(mesh.TextureCoordinates, lz4Data));
+	}
+
+	if (DecodeStream(chunkData, streams[2], codecData, lz4Data))
+	{
+		TEST_CHECK(streams[2].CodecEntry.Compression == ChunkCompression::VertexCodecExp);
+		TEST_CHECK(MatchesFiltered(mesh.Normals, codecData, NORMAL_FILTER_BITS));
+		TEST_CHECK(MatchesExactly(mesh.Normals, lz4Data));
+	}
+
+	if (DecodeStream(chunkData, streams[3], codecData, lz4Data))
+	{
+		TEST_CHECK(streams[3].CodecEntry.Compression == ChunkCompression::IndexCodec);
+		TEST_CHECK(MatchesExactly(mesh.Indices, codecData));
+		TEST_CHECK(MatchesExactly(mesh.Indices, lz4Data));
+	}
+}
+
+// The mesh codecs exploit vertex and triangle order, so each stream should end up smaller than LZ4 manages.
+static void TestMeshCodecsAreSmallerThanLZ4()
+{
+	TestMesh mesh = CreateTerrainMesh();
+	ChunkData chunkData;
+	std::array<EncodedStream, 4> streams;
+	if (!WriteAndParseChunk(mesh, chunkData) || !GetStreams(chunkData, streams))
+		return;
+
+	for (const EncodedStream& stream : streams)
+	{
+		TEST_CHECK(stream.CodecEntry.UncompressedSize == stream.LZ4Entry.UncompressedSize);
+		if (!TEST_CHECK(stream.CodecEntry.Size < stream.LZ4Entry.Size))
+			Logger::Error("{} encoded to {} bytes, LZ4 produced {} bytes.", stream.Name, stream.CodecEntry.Size, stream.LZ4Entry.Size);
+	}
+}
+
+// Not a pass or fail check, reports the size and decode throughput of both schemes on the same streams.
+static void BenchmarkMeshDecode()
+{
+	TestMesh mesh = CreateTerrainMesh();
+	ChunkData chunkData;
+	std::array<EncodedStream, 4> streams;
+	if (!WriteAndParseChunk(mesh, chunkData) || !GetStreams(chunkData, streams))
+		return;
+
+	std::vector<uint8_t> decompressBuffer;
+	auto measureDecode = [&](const ChunkMemoryEntry& entry, float& gigabytesPerSecond)
+		{
+			auto startTime = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < BENCHMARK_DECODE_COUNT; ++i)
+			{
+				if (!TEST_CHECK(chunkData.Decompress(entry, decompressBuffer)))
+					return false;
+			}
+
+			auto endTime = std::chrono::high_resolution_clock::now();
+			float decodeTime = std::chrono::duration<float, std::chrono::seconds::period>(endTime - startTime).count() / BENCHMARK_DECODE_COUNT;
+			gigabytesPerSecond = static_cast<float>(entry.UncompressedSize) / (1024.0f * 1024.0f * 1024.0f) / decodeTime;
+			return true;
+		};
+
+	for (const EncodedStream& stream : streams)
+	{
+		float codecThroughput = 0.0f;
+		float lz4Throughput = 0.0f;
+		if (!measureDecode(stream.CodecEntry, codecThroughput) || !measureDecode(stream.LZ4Entry, lz4Throughput))
+			return;
+
+		Logger::Info("{} ({} bytes) - meshopt {} bytes decoded at {} GB/s, LZ4 {} bytes decoded at {} GB/s.", stream.Name,
+			stream.CodecEntry.UncompressedSize, stream.CodecEntry.Size, codecThroughput, stream.LZ4Entry.Size, lz4Throughput);
+	}
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestMeshCodecsRoundTrip", TestMeshCodecsRoundTrip },
+		{ "TestMeshCodecsAreSmallerThanLZ4", TestMeshCodecsAreSmallerThanLZ4 },
+		{ "BenchmarkMeshDecode", BenchmarkMeshDecode }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+
+// Replaces the global operator new so a test can count the heap allocations made while s_countAllocations is set. Only one
+// source file of a test executable may include it.
+static std::atomic<bool> s_countAllocations = false;
+static std::atomic<uint64_t> s_allocationCount = 0;
+
+// On Windows the engine DLL allocates through its own runtime, so only platforms where the executable's global
+// operator new replaces the library's can count allocations made inside the engine.
+#ifndef _WIN32
+#define COUNTING_ALLOCATOR
+
+static void* CountedAllocate(std::size_t size, std::size_t alignment)
+{
+	if (s_countAllocations)
+		++s_allocationCount;
+
+	size = std::max<std::size_t>(size, 1);
+	void* memory = alignment > alignof(std::max_align_t)
+		? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+		: std::malloc(size);
+
+	if (memory == nullptr)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new(std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+#endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "TestUtilities.hpp"
+#include <Core/Colour.hpp>
+#include <Core/FreeListAllocator.hpp>
+#include <Core/VertexData.hpp>
+#include <OS/HeadlessWindow.hpp>
+#include <Rendering/Renderer.hpp>
+#include <Rendering/Resources/GeometryBatch.hpp>
+#include <memory>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::OS;
+using namespace Engine::Rendering;
+using namespace Engine::Tests;
+
+#define LIVE_MESH_COUNT 8
+#define CHURN_ROUND_COUNT 16
+
+static void TestFreeListCoalescesNeighbours()
+{
+	FreeListAllocator allocator(100);
+	uint64_t first = allocator.Allocate(10);
+	uint64_t second = allocator.Allocate(20);
+	uint64_t third = allocator.Allocate(30);
+	TEST_CHECK(first == 0 && second == 10 && third == 30);
+	TEST_CHECK(allocator.GetFreeBlockCount() == 1);
+
+	// A hole in the middle stays separate from the tail until its neighbours are freed.
+	TEST_CHECK(allocator.Free(second));
+	TEST_CHECK(allocator.GetFreeBlockCount() == 2);
+	TEST_CHECK(allocator.Validate());
+
+	TEST_CHECK(allocator.Free(first));
+	TEST_CHECK(allocator.GetFreeBlockCount() == 2);
+	TEST_CHECK(allocator.GetLargestFreeBlock() == 40);
+	TEST_CHECK(allocator.Validate());
+
+	TEST_CHECK(allocator.Free(third));
+	TEST_CHECK(allocator.GetFreeBlockCount() == 1);
+	TEST_CHECK(allocator.GetLargestFreeBlock() == 100);
+	TEST_CHECK(allocator.GetUsedSize() == 0);
+	TEST_CHECK(allocator.Validate());
+
+	TEST_CHECK(!allocator.Free(third));
+}
+
+static void TestFreeListPicksBestFit()
+{
+	FreeListAllocator allocator(100);
+	uint64_t small = allocator.Allocate(10);
+	allocator.Allocate(5);
+	uint64_t large = allocator.Allocate(40);
+	allocator.Allocate(5);
+	TEST_CHECK(allocator.Free(small));
+	TEST_CHECK(allocator.Free(large));
+
+	// The smallest hole that fits is taken, rather than the first or the largest.
+	TEST_CHECK(allocator.Allocate(8) == small);
+	TEST_CHECK(allocator.Allocate(35) != FreeListAllocator::InvalidOffset);
+	TEST_CHECK(allocator.Allocate(50) == FreeListAllocator::InvalidOffset);
+
+	allocator.Grow(150);
+	TEST_CHECK(allocator.GetLargestFreeBlock() >= 50);
+	TEST_CHECK(allocator.Allocate(50) != FreeListAllocator::InvalidOffset);
+	TEST_CHECK(allocator.Validate());
+}
+
+static bool CreateUniqueMesh(GeometryBatch& geometryBatch, uint32_t seed, uint32_t& meshId)
+{
+	// Offset positions make the vertex data unique, while the index data is shared by every mesh and only reference counted.
+	float offset = static_cast<float>(seed);
+	std::vector<VertexData> vertexData;
+	vertexData.emplace_back(std::vector<glm::vec3>{ glm::vec3(offset, 0.0f, 0.0f), glm::vec3(offset + 1.0f, 0.0f, 0.0f),
+		glm::vec3(offset, 1.0f, 0.0f), glm::vec3(offset + 1.0f, 1.0f, 0.0f) });
+
+	std::vector<uint32_t> indices = { 0, 1, 2, 2, 1, 3 };
+
+	return TEST_CHECK(geometryBatch.CreateMesh(vertexData, indices, glm::mat4(1.0f), Colour(), nullptr, nullptr, nullptr, false, &meshId));
+}
+
+// Destroying a mesh releases its vertex, index and detail slots, later meshes take those slots instead of growing the batch.
+static void TestGeometryBatchReusesSlots()
+{
+	std::unique_ptr<HeadlessWindow> window = HeadlessWindow::Create("GeometryBatchTests", glm::uvec2(320, 240));
+	if (!TEST_CHECK(window != nullptr))
+		return;
+
+	std::unique_ptr<Renderer> renderer = Renderer::Create(RendererType::Null, *window, false);
+	if (!TEST_CHECK(renderer != nullptr) || !TEST_CHECK(renderer->Initialise()))
+		return;
+
+	GeometryBatch& geometryBatch = renderer->CreateGeometryBatch();
+	std::vector<uint32_t> meshIds(LIVE_MESH_COUNT);
+	uint32_t seed = 0;
+	for (uint32_t& meshId : meshIds)
+	{
+		if (!CreateUniqueMesh(geometryBatch, seed++, meshId))
+			return;
+	}
+
+	size_t vertexSlotCount = geometryBatch.GetVertexDataSlotCount();
+	size_t indexSlotCount = geometryBatch.GetIndexDataSlotCount();
+	size_t meshDetailSlotCount = geometryBatch.GetMeshDetailSlotCount();
+	TEST_CHECK(vertexSlotCount == LIVE_MESH_COUNT);
+	TEST_CHECK(indexSlotCount == 1);
+	TEST_CHECK(meshDetailSlotCount == LIVE_MESH_COUNT);
+
+	for (uint32_t round = 0; round < CHURN_ROUND_COUNT; ++round)
+	{
+		for (size_t i = round % 2; i < meshIds.size(); i += 2)
+		{
+			if (!TEST_CHECK(geometryBatch.DestroyMesh(meshIds[i])) || !CreateUniqueMesh(geometryBatch, seed++, meshIds[i]))
+				return;
+		}
+	}
+
+	TEST_CHECK(geometryBatch.GetVertexDataSlotCount() == vertexSlotCount);
+	TEST_CHECK(geometryBatch.GetIndexDataSlotCount() == indexSlotCount);
+	TEST_CHECK(geometryBatch.GetMeshDetailSlotCount() == meshDetailSlotCount);
+
+	TEST_CHECK(renderer->DestroyGeometryBatch(geometryBatch));
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestFreeListCoalescesNeighbours", TestFreeListCoalescesNeighbours },
+		{ "TestFreeListPicksBestFit", TestFreeListPicksBestFit },
+		{ "TestGeometryBatchReusesSlots", TestGeometryBatchReusesSlots }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "TestUtilities.hpp"
+#include <Rendering/MeshLODSelector.hpp>
+#include <cmath>
+
+using namespace Engine;
+using namespace Engine::Rendering;
+using namespace Engine::Tests;
+
+#define VIEW_HEIGHT 1080.0f
+#define NEAR_PLANE 0.1f
+
+// Errors grow with each LOD, the coarsest is only acceptable once it projects to less than the threshold.
+static RenderMeshLODInfo CreateLODInfo(uint32_t lodCount)
+{
+	RenderMeshLODInfo lodInfo = {};
+	lodInfo.lodCount = lodCount;
+
+	const float errors[MaxMeshLODCount] = { 0.0f, 0.01f, 0.05f, 0.2f };
+	for (uint32_t i = 0; i < MaxMeshLODCount; ++i)
+		lodInfo.lods[i].error = errors[i];
+
+	return lodInfo;
+}
+
+static void TestLODScaleFollowsThreshold()
+{
+	float lodScale = MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 1.0f);
+	TEST_CHECK(std::abs(lodScale - 540.0f) < 0.001f);
+
+	// A coarser pixel threshold tolerates proportionally more error, and a flipped projection gives the same scale.
+	TEST_CHECK(std::abs(MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 2.0f) - lodScale * 0.5f) < 0.001f);
+	TEST_CHECK(MeshLODSelector::CalculateLODScale(-1.0f, VIEW_HEIGHT, 1.0f) == lodScale);
+	TEST_CHECK(std::isfinite(MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 0.0f)));
+}
+
+// With a one pixel threshold at 1080 lines a LOD is picked once its error over the distance projects below a pixel,
+// so the switches happen at 540 times each error: 5.4, 27 and 108 units from the nearest point of the bounds.
+static void TestLODFollowsProjectedError()
+{
+	RenderMeshLODInfo lodInfo = CreateLODInfo(MaxMeshLODCount);
+	float lodScale = MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 1.0f);
+
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 2.0f, 1.0f, NEAR_PLANE, lodScale) == 0);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 6.0f, 1.0f, NEAR_PLANE, lodScale) == 0);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 7.0f, 1.0f, NEAR_PLANE, lodScale) == 1);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 27.0f, 1.0f, NEAR_PLANE, lodScale) == 1);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 29.0f, 1.0f, NEAR_PLANE, lodScale) == 2);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 108.0f, 1.0f, NEAR_PLANE, lodScale) == 2);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 110.0f, 1.0f, NEAR_PLANE, lodScale) == 3);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 10000.0f, 1.0f, NEAR_PLANE, lodScale) == 3);
+
+	// Raising the threshold to four pixels moves every switch four times closer.
+	float coarseLODScale = MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 4.0f);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 3.0f, 1.0f, NEAR_PLANE, coarseLODScale) == 1);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 29.0f, 1.0f, NEAR_PLANE, coarseLODScale) == 3);
+}
+
+// Distance is measured from the nearest point of the bounding sphere and clamped to the near plane.
+static void TestLODUsesNearestPointOfBounds()
+{
+	RenderMeshLODInfo lodInfo = CreateLODInfo(MaxMeshLODCount);
+	float lodScale = MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 1.0f);
+
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 29.0f, 1.0f, NEAR_PLANE, lodScale) == 2);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 29.0f, 10.0f, NEAR_PLANE, lodScale) == 1);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 29.0f, 25.0f, NEAR_PLANE, lodScale) == 0);
+
+	// Inside the bounds the near plane is used, which keeps the full detail mesh.
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 0.5f, 1.0f, NEAR_PLANE, lodScale) == 0);
+	TEST_CHECK(MeshLODSelector::SelectLOD(lodInfo, 0.5f, 1.0f, 200.0f, lodScale) == 3);
+}
+
+static void TestLODStaysWithinCount()
+{
+	float lodScale = MeshLODSelector::CalculateLODScale(1.0f, VIEW_HEIGHT, 1.0f);
+	TEST_CHECK(MeshLODSelector::SelectLOD(CreateLODInfo(1), 10000.0f, 1.0f, NEAR_PLANE, lodScale) == 0);
+	TEST_CHECK(MeshLODSelector::SelectLOD(CreateLODInfo(2), 10000.0f, 1.0f, NEAR_PLANE, lodScale) == 1);
+	TEST_CHECK(MeshLODSelector::SelectLOD(CreateLODInfo(MaxMeshLODCount + 4), 10000.0f, 1.0f, NEAR_PLANE, lodScale) == MaxMeshLODCount - 1);
+
+	// Moving away never picks a finer LOD than a nearer distance did.
+	RenderMeshLODInfo lodInfo = CreateLODInfo(MaxMeshLODCount);
+	uint32_t previousLOD = 0;
+	for (float distance = 0.0f; distance < 500.0f; distance += 0.25f)
+	{
+		uint32_t lod = MeshLODSelector::SelectLOD(lodInfo, distance, 1.0f, NEAR_PLANE, lodScale);
+		if (!TEST_CHECK(lod >= previousLOD))
+			break;
+
+		previousLOD = lod;
+	}
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestLODScaleFollowsThreshold", TestLODScaleFollowsThreshold },
+		{ "TestLODFollowsProjectedError", TestLODFollowsProjectedError },
+		{ "TestLODUsesNearestPointOfBounds", TestLODUsesNearestPointOfBounds },
+		{ "TestLODStaysWithinCount", TestLODStaysWithinCount }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,336 @@
+#include "TestUtilities.hpp"
+#include "CountingAllocator.hpp"
+#include <Core/MeshOptimiser.hpp>
+#include <Core/MeshOptimiserArena.hpp>
+#include <Core/VertexData.hpp>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define GRID_SIZE 16
+#define WARM_UP_CALL_COUNT 2
+#define COUNTED_CALL_COUNT 16
+#define BENCHMARK_ITERATION_COUNT 20
+#define MAX_CLUSTER_VERTICES 64
+#define MAX_CLUSTER_TRIANGLES 124
+#define CLUSTER_RADIUS_EPSILON 0.0001f
+
+struct TestMesh
+{
+	std::vector<uint32_t> Indices;
+	std::vector<std::unique_ptr<VertexData>> VertexArrays;
+};
+
+// A height field whose quads each own their four vertices, so deduplication has shared corners to merge, and whose
+// triangles are listed column by column to leave the vertex cache something to improve.
+static TestMesh CreateGridMesh()
+{
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec2> textureCoordinates;
+	std::vector<glm::vec3> normals;
+
+	TestMesh mesh;
+	for (uint32_t x = 0; x < GRID_SIZE; ++x)
+	{
+		for (uint32_t z = 0; z < GRID_SIZE; ++z)
+		{
+			uint32_t base = static_cast<uint32_t>(positions.size());
+			for (uint32_t corner = 0; corner < 4; ++corner)
+			{
+				float cornerX = static_cast<float>(x + (corner & 1));
+				float cornerZ = static_cast<float>(z + (corner >> 1));
+				positions.push_back(glm::vec3(cornerX, std::sin(cornerX * 0.3f) * std::cos(cornerZ * 0.2f), cornerZ));
+				textureCoordinates.push_back(glm::vec2(cornerX, cornerZ) / static_cast<float>(GRID_SIZE));
+				normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+			}
+
+			mesh.Indices.insert(mesh.Indices.end(), { base, base + 2, base + 1, base + 1, base + 2, base + 3 });
+		}
+	}
+
+	mesh.VertexArrays.emplace_back(std::make_unique<VertexData>(positions));
+	mesh.VertexArrays.emplace_back(std::make_unique<VertexData>(textureCoordinates));
+	mesh.VertexArrays.emplace_back(std::make_unique<VertexData>(normals));
+	return mesh;
+}
+
+// The same height field with every corner shared by its neighbouring quads, so clusters are limited by triangle count
+// as well as vertex count.
+static std::vector<uint32_t> CreateWeldedGridIndices(std::vector<glm::vec3>& positions)
+{
+	const uint32_t rowSize = GRID_SIZE + 1;
+	for (uint32_t x = 0; x < rowSize; ++x)
+	{
+		for (uint32_t z = 0; z < rowSize; ++z)
+		{
+			float cornerX = static_cast<float>(x);
+			float cornerZ = static_cast<float>(z);
+			positions.push_back(glm::vec3(cornerX, std::sin(cornerX * 0.3f) * std::cos(cornerZ * 0.2f), cornerZ));
+		}
+	}
+
+	std::vector<uint32_t> indices;
+	for (uint32_t x = 0; x < GRID_SIZE; ++x)
+	{
+		for (uint32_t z = 0; z < GRID_SIZE; ++z)
+		{
+			uint32_t base = x * rowSize + z;
+			indices.insert(indices.end(), { base, base + 1, base + rowSize, base + rowSize, base + 1, base + rowSize + 1 });
+		}
+	}
+
+	return indices;
+}
+
+static std::vector<std::unique_ptr<VertexData>> CopyVertexArrays(const std::vector<std::unique_ptr<VertexData>>& vertexArrays)
+{
+	std::vector<std::unique_ptr<VertexData>> copies;
+	for (const std::unique_ptr<VertexData>& vertexData : vertexArrays)
+		copies.emplace_back(std::make_unique<VertexData>(*vertexData));
+
+	return copies;
+}
+
+// Every triangle as the concatenated bytes of its three vertices, starting from the smallest so the winding is kept but
+// a rotated triangle still compares equal. Sorted, as the optimiser reorders triangles.
+typedef std::array<std::string, 3> TriangleBytes;
+
+static void SortTriangles(std::vector<TriangleBytes>& triangles)
+{
+	for (TriangleBytes& triangle : triangles)
+	{
+		auto smallest = std::min_element(triangle.begin(), triangle.end());
+		std::rotate(triangle.begin(), smallest, triangle.end());
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+}
+
+static std::vector<TriangleBytes> GetSourceTriangles(const TestMesh& mesh)
+{
+	std::vector<TriangleBytes> triangles(mesh.Indices.size() / 3);
+	for (size_t i = 0; i < mesh.Indices.size(); ++i)
+	{
+		for (const std::unique_ptr<VertexData>& vertexData : mesh.VertexArrays)
+		{
+			const char* vertex = vertexData->GetData<char>() + static_cast<size_t>(mesh.Indices[i]) * vertexData->GetElementSize();
+			triangles[i / 3][i % 3].append(vertex, vertexData->GetElementSize());
+		}
+	}
+
+	SortTriangles(triangles);
+	return triangles;
+}
+
+static std::vector<TriangleBytes> GetOutputTriangles(const MeshOptimiserOutput& output)
+{
+	std::vector<TriangleBytes> triangles(output.IndexCount / 3);
+	for (size_t i = 0; i < output.IndexCount; ++i)
+	{
+		for (size_t stream = 0; stream < output.StreamCount; ++stream)
+		{
+			const uint8_t* vertex = output.Streams[stream] + static_cast<size_t>(output.Indices[i]) * output.Strides[stream];
+			triangles[i / 3][i % 3].append(reinterpret_cast<const char*>(vertex), output.Strides[stream]);
+		}
+	}
+
+	SortTriangles(triangles);
+	return triangles;
+}
+
+// The interleaved stream holds each vertex's attributes back to back in input order, so after undoing the reordering the
+// optimised mesh describes exactly the same triangles as the source, with the duplicate corners merged.
+static void TestInterleavedOutputRoundTrips()
+{
+	TestMesh mesh = CreateGridMesh();
+	std::vector<TriangleBytes> sourceTriangles = GetSourceTriangles(mesh);
+
+	MeshOptimiserArena arena;
+	MeshOptimiserOutput output;
+	if (!TEST_CHECK(MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, true, arena, output)))
+		return;
+
+	size_t stride = 0;
+	for (const std::unique_ptr<VertexData>& vertexData : mesh.VertexArrays)
+		stride += vertexData->GetElementSize();
+
+	TEST_CHECK(output.StreamCount == 1);
+	TEST_CHECK(output.Strides[0] == stride);
+	TEST_CHECK(output.IndexCount == mesh.Indices.size());
+	TEST_CHECK(output.VertexCount == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+	TEST_CHECK(arena.Owns(output.Indices) && arena.Owns(output.Streams[0]));
+	TEST_CHECK(std::all_of(output.Indices, output.Indices + output.IndexCount, [&output](uint32_t index) { return index < output.VertexCount; }));
+	TEST_CHECK(GetOutputTriangles(output) == sourceTriangles);
+
+	// Separate streams hold the same vertices in the same order as the interleaved one.
+	std::vector<uint8_t> interleaved(output.Streams[0], output.Streams[0] + output.VertexCount * stride);
+	std::vector<uint32_t> interleavedIndices(output.Indices, output.Indices + output.IndexCount);
+	if (!TEST_CHECK(MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, false, arena, output)))
+		return;
+
+	TEST_CHECK(output.StreamCount == mesh.VertexArrays.size());
+	TEST_CHECK(std::equal(interleavedIndices.begin(), interleavedIndices.end(), output.Indices, output.Indices + output.IndexCount));
+	TEST_CHECK(GetOutputTriangles(output) == sourceTriangles);
+
+	size_t offset = 0;
+	for (size_t stream = 0; stream < output.StreamCount; ++stream)
+	{
+		bool matches = true;
+		for (size_t vertex = 0; vertex < output.VertexCount; ++vertex)
+		{
+			const uint8_t* separate = output.Streams[stream] + vertex * output.Strides[stream];
+			matches &= memcmp(separate, interleaved.data() + vertex * stride + offset, output.Strides[stream]) == 0;
+		}
+
+		TEST_CHECK(matches);
+		offset += output.Strides[stream];
+	}
+}
+
+// A fresh arena has to allocate its storage on every call. One reused across calls grows to the peak usage of the
+// previous call on Reset, after which optimising meshes of the same size stays off the heap, meshoptimizer's own
+// scratch included.
+static void TestReusedArenaStopsAllocating()
+{
+	TestMesh mesh = CreateGridMesh();
+	std::vector<uint32_t> indices = mesh.Indices;
+	std::vector<std::vector<uint32_t>*> indexArrays = { &indices };
+	std::vector<std::unique_ptr<VertexData>> vertexArrays = CopyVertexArrays(mesh.VertexArrays);
+
+	MeshOptimiserArena arena;
+	MeshOptimiserOutput output;
+	MeshOptimiserStatistics statistics;
+	bool optimised = true;
+	for (uint32_t i = 0; i < WARM_UP_CALL_COUNT; ++i)
+	{
+		optimised &= MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, true, arena, output);
+		optimised &= MeshOptimiser::Optimise(indexArrays, vertexArrays, true, arena, statistics);
+	}
+
+	if (!TEST_CHECK(optimised))
+		return;
+
+	uint64_t unboundAllocationCount = MeshOptimiserArena::GetUnboundHeapAllocationCount();
+	uint64_t arenaAllocationCount = arena.GetHeapAllocationCount();
+	uint64_t freshArenaAllocationCount = 0;
+
+#ifdef COUNTING_ALLOCATOR
+	s_allocationCount = 0;
+	s_countAllocations = true;
+#endif
+	for (uint32_t i = 0; i < COUNTED_CALL_COUNT; ++i)
+	{
+		optimised &= MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, true, arena, output);
+		optimised &= MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, false, arena, output);
+		optimised &= MeshOptimiser::Optimise(indexArrays, vertexArrays, true, arena, statistics);
+	}
+#ifdef COUNTING_ALLOCATOR
+	s_countAllocations = false;
+	uint64_t reusedAllocationCount = s_allocationCount;
+#endif
+
+	TEST_CHECK(optimised);
+	TEST_CHECK(arena.GetHeapAllocationCount() == arenaAllocationCount);
+	TEST_CHECK(MeshOptimiserArena::GetUnboundHeapAllocationCount() == unboundAllocationCount);
+
+	for (uint32_t i = 0; i < COUNTED_CALL_COUNT; ++i)
+	{
+		MeshOptimiserArena freshArena;
+		optimised &= MeshOptimiser::Optimise(mesh.Indices, mesh.VertexArrays, true, freshArena, output);
+		freshArenaAllocationCount += freshArena.GetHeapAllocationCount();
+	}
+
+	TEST_CHECK(optimised);
+	TEST_CHECK(freshArenaAllocationCount >= COUNTED_CALL_COUNT);
+
+#ifdef COUNTING_ALLOCATOR
+	if (!TEST_CHECK(reusedAllocationCount == 0))
+		Logger::Error("{} heap allocations over {} calls with a reused arena.", reusedAllocationCount, COUNTED_CALL_COUNT * 3);
+#else
+	Logger::Info("Skipping allocation counting, global operator new is not replaceable across the engine library here.");
+#endif
+}
+
+// Every source triangle ends up in exactly one cluster with its winding intact, no cluster exceeds the limits the
+// cluster culling shader is written for, and each cluster's bounding sphere contains all of its vertices.
+static void TestClustersCoverMesh()
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices = CreateWeldedGridIndices(positions);
+
+	std::vector<MeshCluster> clusters;
+	std::vector<uint32_t> clusterIndices;
+	if (!TEST_CHECK(MeshOptimiser::BuildClusters(indices, VertexData(positions), clusters, clusterIndices)))
+		return;
+
+	TEST_CHECK(clusters.size() > 1);
+	TEST_CHECK(clusterIndices.size() == indices.size());
+
+	std::vector<std::array<uint32_t, 3>> sourceTriangles;
+	std::vector<std::array<uint32_t, 3>> clusterTriangles;
+	for (size_t i = 0; i < indices.size(); i += 3)
+		sourceTriangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+
+	uint32_t nextIndex = 0;
+	for (const MeshCluster& cluster : clusters)
+	{
+		// Clusters are packed back to back, so any triangle outside of one would leave a gap or an overlap.
+		TEST_CHECK(cluster.FirstIndex == nextIndex);
+		TEST_CHECK(cluster.IndexCount > 0 && cluster.IndexCount % 3 == 0);
+		TEST_CHECK(cluster.IndexCount / 3 <= MAX_CLUSTER_TRIANGLES);
+		nextIndex = cluster.FirstIndex + cluster.IndexCount;
+		if (!TEST_CHECK(nextIndex <= clusterIndices.size()))
+			return;
+
+		std::vector<uint32_t> vertices(clusterIndices.begin() + cluster.FirstIndex, clusterIndices.begin() + nextIndex);
+		for (size_t i = 0; i < vertices.size(); i += 3)
+			clusterTriangles.push_back({ vertices[i], vertices[i + 1], vertices[i + 2] });
+
+		std::sort(vertices.begin(), vertices.end());
+		vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+		TEST_CHECK(vertices.size() <= MAX_CLUSTER_VERTICES);
+
+		bool contained = true;
+		for (uint32_t vertex : vertices)
+			contained &= glm::length(positions[vertex] - cluster.Center) <= cluster.Radius + CLUSTER_RADIUS_EPSILON;
+
+		TEST_CHECK(contained);
+	}
+
+	TEST_CHECK(nextIndex == clusterIndices.size());
+
+	for (std::vector<std::array<uint32_t, 3>>* triangles : { &sourceTriangles, &clusterTriangles })
+	{
+		for (std::array<uint32_t, 3>& triangle : *triangles)
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+
+		std::sort(triangles->begin(), triangles->end());
+	}
+
+	TEST_CHECK(clusterTriangles == sourceTriangles);
+}
+
+// Not a pass or fail check, reports the time and heap allocations of fresh versus reused arenas.
+static void BenchmarkArenaReuse()
+{
+	TestMesh mesh = CreateGridMesh();
+	MeshOptimiser::Benchmark(mesh.Indices, mesh.VertexArrays, BENCHMARK_ITERATION_COUNT);
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestInterleavedOutputRoundTrips", TestInterleavedOutputRoundTrips },
+		{ "TestReusedArenaStopsAllocating", TestReusedArenaStopsAllocating },
+		{ "TestClustersCoverMesh", TestClustersCoverMesh },
+		{ "BenchmarkArenaReuse", BenchmarkArenaReuse }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,487 @@
+#include "TestUtilities.hpp"
+#include <OS/HeadlessWindow.hpp>
+#include <Rendering/Renderer.hpp>
+#include <Rendering/RenderGraph.hpp>
+#include <Rendering/Null/CommandBuffer.hpp>
+#include <Rendering/Null/NullRenderer.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::OS;
+using namespace Engine::Rendering;
+using namespace Engine::Tests;
+
+#define BENCHMARK_FRAME_COUNT 200
+#define BENCHMARK_BUILD_COUNT 20
+#define VARIANT_SWITCH_FRAME_COUNT 64
+#define RECORDING_COMPARISON_FRAME_COUNT 8
+
+static bool CreateRenderer(std::unique_ptr<HeadlessWindow>& window, std::unique_ptr<Renderer>& renderer)
+{
+	window = HeadlessWindow::Create("NullRendererTests", glm::uvec2(1280, 720));
+	if (!TEST_CHECK(window != nullptr))
+		return false;
+
+	renderer = Renderer::Create(RendererType::Null, *window, false);
+	return TEST_CHECK(renderer != nullptr) && TEST_CHECK(renderer->Initialise());
+}
+
+static bool RenderFrame(Renderer& renderer)
+{
+	return TEST_CHECK(renderer.BeginFrame()) && TEST_CHECK(renderer.Render());
+}
+
+typedef std::array<uint32_t, static_cast<size_t>(Null::CommandType::FillBuffer) + 1> CommandTypeCounts;
+
+static CommandTypeCounts CountCommandTypes(const Null::NullRenderer& renderer)
+{
+	CommandTypeCounts counts = {};
+	for (const Null::CommandBuffer* commandBuffer : renderer.GetSubmittedCommandBuffers())
+	{
+		for (const Null::RecordedCommand& command : commandBuffer->GetCommands())
+			++counts[static_cast<size_t>(command.Type)];
+	}
+
+	return counts;
+}
+
+static void TestFramesRecordCommands()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	const Null::NullRenderer& nullRenderer = static_cast<const Null::NullRenderer&>(*renderer);
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		if (!RenderFrame(*renderer))
+			return;
+
+		const Null::RecordedFrameStats& stats = nullRenderer.GetFrameStats();
+		TEST_CHECK(stats.CommandBufferCount > 0);
+		TEST_CHECK(stats.CommandCount > 0);
+		TEST_CHECK(stats.PipelineBarrierCount > 0);
+		TEST_CHECK(stats.ImageBarrierCount > 0);
+	}
+
+	TEST_CHECK(!renderer->GetRenderGraph().GetBuiltGraph().empty());
+	TEST_CHECK(!renderer->GetRenderGraph().CheckDirty());
+}
+
+static void TestResizeRebuildsGraph()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer) || !RenderFrame(*renderer))
+		return;
+
+	window->Resize(glm::uvec2(640, 360));
+	if (!RenderFrame(*renderer))
+		return;
+
+	TEST_CHECK(renderer->GetSwapChain().GetExtent() == glm::uvec2(640, 360));
+	TEST_CHECK(renderer->GetRenderGraph().GetRenderExtent() == glm::uvec2(640, 360));
+}
+
+// Placing transient images in shared heaps is only worthwhile if it takes less memory than giving each its own allocation,
+// and the heaps can never hold less than the images in use at once.
+static void TestTransientMemoryIsAliased()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer) || !RenderFrame(*renderer))
+		return;
+
+	const MemoryStats& memoryStats = renderer->GetMemoryStats();
+	const TransientMemoryStats& transientStats = renderer->GetRenderGraph().GetTransientMemoryStats();
+	TEST_CHECK(memoryStats.TransientAliasedSize == transientStats.AliasedSize);
+	TEST_CHECK(memoryStats.TransientUnaliasedSize == transientStats.UnaliasedSize);
+	TEST_CHECK(memoryStats.TransientPeakSize == transientStats.PeakSize);
+
+	TEST_CHECK(memoryStats.TransientPeakSize > 0);
+	TEST_CHECK(memoryStats.TransientPeakSize <= memoryStats.TransientAliasedSize);
+	TEST_CHECK(memoryStats.TransientAliasedSize < memoryStats.TransientUnaliasedSize);
+
+	// Extent sized images shrink with the window, so both totals follow a resize.
+	uint64_t aliasedSize = memoryStats.TransientAliasedSize;
+	uint64_t unaliasedSize = memoryStats.TransientUnaliasedSize;
+	window->Resize(glm::uvec2(640, 360));
+	if (!RenderFrame(*renderer))
+		return;
+
+	TEST_CHECK(memoryStats.TransientAliasedSize < aliasedSize);
+	TEST_CHECK(memoryStats.TransientUnaliasedSize < unaliasedSize);
+}
+
+// With precompiled variants every anti-aliasing pass and the depth reduction stay in the graph, so switching modes every
+// frame only flips bypass flags and never waits on a rebuild. Recording costs about the same as frames that keep a mode.
+static void TestPassVariantsSwitchWithoutRebuild()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	const Null::NullRenderer& nullRenderer = static_cast<const Null::NullRenderer&>(*renderer);
+	const RenderGraph& renderGraph = renderer->GetRenderGraph();
+	const AntiAliasingMode aaModes[] = { AntiAliasingMode::None, AntiAliasingMode::FXAA, AntiAliasingMode::SMAA, AntiAliasingMode::TAA };
+	const CullingMode cullingModes[] = { CullingMode::Frustum, CullingMode::FrustumAndOcclusion };
+
+	// Every mode draws once before timing, passes create some of their resources on first use.
+	renderer->SetPrecompiledPassVariantsState(true);
+	for (AntiAliasingMode aaMode : aaModes)
+	{
+		renderer->SetAntiAliasingMode(aaMode);
+		if (!RenderFrame(*renderer))
+			return;
+	}
+
+	// The same modes are held for a run of frames each first, so both measurements record the same mix of passes.
+	float steadyRecordTime = 0.0f;
+	for (AntiAliasingMode aaMode : aaModes)
+	{
+		for (CullingMode cullingMode : cullingModes)
+		{
+			renderer->SetAntiAliasingMode(aaMode);
+			renderer->SetCullingMode(cullingMode);
+			for (uint32_t i = 0; i < VARIANT_SWITCH_FRAME_COUNT / (std::size(aaModes) * std::size(cullingModes)); ++i)
+			{
+				if (!RenderFrame(*renderer))
+					return;
+
+				steadyRecordTime += nullRenderer.GetFrameStats().RecordTime;
+			}
+		}
+	}
+
+	uint32_t buildCount = renderGraph.GetBuildCount();
+
+	float switchingRecordTime = 0.0f;
+	bool stayedClean = true;
+	for (uint32_t i = 0; i < VARIANT_SWITCH_FRAME_COUNT; ++i)
+	{
+		renderer->SetAntiAliasingMode(aaModes[i % std::size(aaModes)]);
+		renderer->SetCullingMode(cullingModes[(i / std::size(aaModes)) % std::size(cullingModes)]);
+		stayedClean &= !renderGraph.CheckDirty();
+		if (!RenderFrame(*renderer))
+			return;
+
+		switchingRecordTime += nullRenderer.GetFrameStats().RecordTime;
+	}
+
+	TEST_CHECK(stayedClean);
+	TEST_CHECK(renderGraph.GetBuildCount() == buildCount);
+
+	// Bypassing trades a draw for a blit, a rebuild costs far more than recording a frame. The bound only allows for
+	// timing noise.
+	float steadyAverage = steadyRecordTime / VARIANT_SWITCH_FRAME_COUNT;
+	float switchingAverage = switchingRecordTime / VARIANT_SWITCH_FRAME_COUNT;
+	Logger::Info("Frame record time: {}ms switching variants, {}ms keeping them.", switchingAverage, steadyAverage);
+	TEST_CHECK(switchingAverage < steadyAverage * 2.0f + 0.5f);
+}
+
+// A bypassed pass records nothing but the blits that pass its images through and the barriers around them, so with
+// every anti-aliasing variant bypassed a frame does the same work as one from a graph built without them.
+static void TestBypassedPassesOnlyCopy()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	std::unique_ptr<HeadlessWindow> variantWindow;
+	std::unique_ptr<Renderer> variantRenderer;
+	if (!CreateRenderer(window, renderer) || !CreateRenderer(variantWindow, variantRenderer))
+		return;
+
+	renderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	variantRenderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	variantRenderer->SetPrecompiledPassVariantsState(true);
+	if (!RenderFrame(*renderer) || !RenderFrame(*variantRenderer))
+		return;
+
+	TEST_CHECK(variantRenderer->GetRenderGraph().GetPassBypassed("FXAA"));
+	TEST_CHECK(variantRenderer->GetRenderGraph().GetPassBypassed("TAA"));
+
+	CommandTypeCounts counts = CountCommandTypes(static_cast<const Null::NullRenderer&>(*renderer));
+	CommandTypeCounts variantCounts = CountCommandTypes(static_cast<const Null::NullRenderer&>(*variantRenderer));
+	for (size_t type = 0; type < counts.size(); ++type)
+	{
+		Null::CommandType commandType = static_cast<Null::CommandType>(type);
+		if (commandType == Null::CommandType::BlitImage || commandType == Null::CommandType::PipelineBarrier)
+			TEST_CHECK(variantCounts[type] >= counts[type]);
+		else if (!TEST_CHECK(variantCounts[type] == counts[type]))
+			Logger::Error("Command type {} recorded {} times with bypassed variants, {} without them.", type, variantCounts[type], counts[type]);
+	}
+
+	TEST_CHECK(variantCounts[static_cast<size_t>(Null::CommandType::BlitImage)] > counts[static_cast<size_t>(Null::CommandType::BlitImage)]);
+}
+
+// Bypassing is only meaningful for passes in the built graph, a pass that was disabled instead is left alone.
+static void TestDisabledPassCannotBeBypassed()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	// The first frame drops the UI pass, as nothing draws UI, which the second frame builds.
+	renderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	if (!RenderFrame(*renderer) || !RenderFrame(*renderer))
+		return;
+
+	RenderGraph& renderGraph = renderer->GetRenderGraph();
+	renderGraph.SetPassBypassed("FXAA", true);
+	TEST_CHECK(!renderGraph.GetPassBypassed("FXAA"));
+	TEST_CHECK(!renderGraph.CheckDirty());
+}
+
+// Enabling a pass only rebuilds the nodes whose connections it changes, the rest keep their bindings and the graph images
+// that still fit stay where they were placed.
+static void TestPassToggleRebuildsPartially()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	// The first frame drops the UI pass, as nothing draws UI, which the second frame builds.
+	renderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	if (!RenderFrame(*renderer) || !RenderFrame(*renderer))
+		return;
+
+	const RenderGraph& renderGraph = renderer->GetRenderGraph();
+	uint32_t buildCount = renderGraph.GetBuildCount();
+	renderer->SetAntiAliasingMode(AntiAliasingMode::FXAA);
+	TEST_CHECK(renderGraph.CheckDirty());
+	if (!RenderFrame(*renderer))
+		return;
+
+	TEST_CHECK(renderGraph.GetBuildCount() == buildCount + 1);
+	TEST_CHECK(renderGraph.GetTransientMemoryStats().RetainedImageCount > 0);
+	TEST_CHECK(renderGraph.GetNodeBuildCount() > 0);
+	TEST_CHECK(renderGraph.GetNodeBuildCount() < renderGraph.GetNodeCount());
+}
+
+// Going back to a configuration built before restores its schedule from the layout cache, and the graph built from it
+// is laid out exactly as it was the first time.
+static void TestLayoutCacheRestoresSchedule()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	// The first frame drops the UI pass, as nothing draws UI, which the second frame builds.
+	renderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	if (!RenderFrame(*renderer) || !RenderFrame(*renderer))
+		return;
+
+	const RenderGraph& renderGraph = renderer->GetRenderGraph();
+	TEST_CHECK(!renderGraph.GetLayoutCacheHit());
+	std::string layout = renderGraph.GetSerialisedLayout();
+
+	renderer->SetAntiAliasingMode(AntiAliasingMode::FXAA);
+	if (!RenderFrame(*renderer))
+		return;
+
+	TEST_CHECK(!renderGraph.GetLayoutCacheHit());
+	std::string fxaaLayout = renderGraph.GetSerialisedLayout();
+
+	renderer->SetAntiAliasingMode(AntiAliasingMode::None);
+	if (!RenderFrame(*renderer))
+		return;
+
+	TEST_CHECK(renderGraph.GetLayoutCacheHit());
+	TEST_CHECK(renderGraph.GetSerialisedLayout() == layout);
+
+	// Enabling FXAA adds lines for the pass among other changes, and undoing it reports as many changes the other way.
+	std::vector<std::string> changes = RenderGraphLayout::Diff(layout, fxaaLayout);
+	std::vector<std::string> reverseChanges = RenderGraphLayout::Diff(fxaaLayout, layout);
+	TEST_CHECK(!changes.empty());
+	TEST_CHECK(changes.size() == reverseChanges.size());
+	TEST_CHECK(std::any_of(changes.begin(), changes.end(), [](const std::string& change) { return change.starts_with("+ ") && change.contains("FXAA"); }));
+	TEST_CHECK(RenderGraphLayout::Diff(layout, layout).empty());
+}
+
+// Lines are matched regardless of where they are, each reported as many times as it is missing from the other side.
+static void TestLayoutDiff()
+{
+	std::vector<std::string> changes = RenderGraphLayout::Diff("a\nb\nb\nc", "c\nb\nd");
+	TEST_CHECK((changes == std::vector<std::string>{ "- a", "- b", "+ d" }));
+	TEST_CHECK((RenderGraphLayout::Diff("", "a") == std::vector<std::string>{ "+ a" }));
+	TEST_CHECK(RenderGraphLayout::Diff("a\nb", "b\na").empty());
+}
+
+typedef std::vector<std::vector<Null::RecordedCommand>> RecordedFrame;
+
+static bool SameCommands(const std::vector<Null::RecordedCommand>& a, const std::vector<Null::RecordedCommand>& b)
+{
+	return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Null::RecordedCommand& x, const Null::RecordedCommand& y)
+		{
+			return x.Type == y.Type && x.Resource == y.Resource && x.Arguments == y.Arguments;
+		});
+}
+
+// Renders frames and keeps a copy of every command buffer submitted, one per pass, along with the frame's totals.
+static bool RecordFrames(Renderer& renderer, uint32_t frameCount, std::vector<RecordedFrame>& frames,
+	std::vector<Null::RecordedFrameStats>& frameStats)
+{
+	const Null::NullRenderer& nullRenderer = static_cast<const Null::NullRenderer&>(renderer);
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		if (!RenderFrame(renderer))
+			return false;
+
+		RecordedFrame& frame = frames.emplace_back();
+		for (const Null::CommandBuffer* commandBuffer : nullRenderer.GetSubmittedCommandBuffers())
+			frame.push_back(commandBuffer->GetCommands());
+
+		frameStats.push_back(nullRenderer.GetFrameStats());
+	}
+
+	return true;
+}
+
+// Recording passes in parallel produces exactly the commands sequential recording does, pass for pass, per frame
+// resources included. Any pass changing its own state while drawing would race here, and the layered shadow pass must
+// clear its attachment on the first layer and load it on the rest every frame instead of carrying a load op over.
+static void TestParallelRecordingMatchesSequential()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	// Both runs start on the same frame index and swap chain image, which cycle independently. The first frame drops the
+	// UI pass, as nothing draws UI, which the second frame builds.
+	const Null::NullRenderer& nullRenderer = static_cast<const Null::NullRenderer&>(*renderer);
+	const uint32_t frameCycle = renderer->GetConcurrentFrameCount() * nullRenderer.GetSwapChainImageCount();
+	const uint32_t frameCount = RECORDING_COMPARISON_FRAME_COUNT * frameCycle;
+	for (uint32_t i = 0; i < std::max(frameCycle, 2u); ++i)
+	{
+		if (!RenderFrame(*renderer))
+			return;
+	}
+
+	const RenderGraph& renderGraph = renderer->GetRenderGraph();
+	uint32_t buildCount = renderGraph.GetBuildCount();
+
+	std::vector<RecordedFrame> sequentialFrames;
+	std::vector<Null::RecordedFrameStats> sequentialStats;
+	renderer->SetParallelRecordingState(false);
+	if (!RecordFrames(*renderer, frameCount, sequentialFrames, sequentialStats))
+		return;
+
+	std::vector<RecordedFrame> parallelFrames;
+	std::vector<Null::RecordedFrameStats> parallelStats;
+	renderer->SetParallelRecordingState(true);
+	if (!RecordFrames(*renderer, frameCount, parallelFrames, parallelStats))
+		return;
+
+	TEST_CHECK(renderGraph.GetBuildCount() == buildCount);
+
+	uint32_t layeredPassCount = 0;
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		const RecordedFrame& sequentialFrame = sequentialFrames[i];
+		const RecordedFrame& parallelFrame = parallelFrames[i];
+		if (!TEST_CHECK(sequentialFrame.size() == parallelFrame.size()))
+			continue;
+
+		for (size_t j = 0; j < sequentialFrame.size(); ++j)
+			TEST_CHECK(SameCommands(sequentialFrame[j], parallelFrame[j]));
+
+		TEST_CHECK(sequentialStats[i].CommandBufferCount == parallelStats[i].CommandBufferCount);
+		TEST_CHECK(sequentialStats[i].CommandCount == parallelStats[i].CommandCount);
+		TEST_CHECK(sequentialStats[i].DrawCount == parallelStats[i].DrawCount);
+		TEST_CHECK(sequentialStats[i].DispatchCount == parallelStats[i].DispatchCount);
+		TEST_CHECK(sequentialStats[i].PipelineBarrierCount == parallelStats[i].PipelineBarrierCount);
+
+		for (const std::vector<Null::RecordedCommand>& commands : parallelFrame)
+		{
+			uint64_t layerIndex = 0;
+			for (const Null::RecordedCommand& command : commands)
+			{
+				if (command.Type != Null::CommandType::BeginRendering || command.Arguments[3] < 2 || command.Resource == nullptr)
+					continue;
+
+				AttachmentLoadOp expectedLoadOp = layerIndex == 0 ? AttachmentLoadOp::Clear : AttachmentLoadOp::Load;
+				TEST_CHECK(command.Arguments[1] == static_cast<uint64_t>(expectedLoadOp));
+				layeredPassCount += layerIndex == 0 ? 1 : 0;
+				layerIndex = (layerIndex + 1) % command.Arguments[3];
+			}
+		}
+	}
+
+	TEST_CHECK(layeredPassCount == frameCount);
+}
+
+// Not a pass or fail check, reports the CPU cost of recording a frame and of rebuilding the graph for each kind of change.
+// Nothing actually changes between the builds, so each reports the least that kind of rebuild costs.
+static void BenchmarkFrameAndBuildCost()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer) || !RenderFrame(*renderer))
+		return;
+
+	const Null::NullRenderer& nullRenderer = static_cast<const Null::NullRenderer&>(*renderer);
+	float totalRecordTime = 0.0f;
+	for (uint32_t i = 0; i < BENCHMARK_FRAME_COUNT; ++i)
+	{
+		if (!RenderFrame(*renderer))
+			return;
+
+		totalRecordTime += nullRenderer.GetFrameStats().RecordTime;
+	}
+
+	Logger::Info("Frame record time: {}ms average over {} frames.", totalRecordTime / BENCHMARK_FRAME_COUNT, BENCHMARK_FRAME_COUNT);
+
+	const std::pair<RenderGraphChange, const char*> changes[] = { { RenderGraphChange::Passes, "Passes" },
+		{ RenderGraphChange::RenderExtent, "RenderExtent" }, { RenderGraphChange::Resources, "Resources" }, { RenderGraphChange::All, "All" } };
+	RenderGraph& renderGraph = renderer->GetRenderGraph();
+	for (const auto& [change, changeName] : changes)
+	{
+		float totalBuildTime = 0.0f;
+		for (uint32_t i = 0; i < BENCHMARK_BUILD_COUNT; ++i)
+		{
+			renderGraph.MarkDirty(change);
+
+			auto startTime = std::chrono::high_resolution_clock::now();
+			if (!RenderFrame(*renderer))
+				return;
+
+			auto endTime = std::chrono::high_resolution_clock::now();
+			totalBuildTime += std::chrono::duration<float, std::chrono::milliseconds::period>(endTime - startTime).count();
+		}
+
+		Logger::Info("'{}' rebuild and frame time: {}ms average over {} builds, {} of {} nodes built, {} of {} transient images kept.",
+			changeName, totalBuildTime / BENCHMARK_BUILD_COUNT, BENCHMARK_BUILD_COUNT, renderGraph.GetNodeBuildCount(), renderGraph.GetNodeCount(),
+			renderGraph.GetTransientMemoryStats().RetainedImageCount, renderGraph.GetTransientMemoryStats().ImageCount);
+	}
+
+	const RenderGraphScheduleStats& scheduleStats = renderGraph.GetScheduleStats();
+	Logger::Info("Graph has {} stages, {} submits and {} pipeline barriers ({} image, {} buffer).", scheduleStats.StageCount,
+		scheduleStats.SubmitCount, scheduleStats.PipelineBarrierCount, scheduleStats.ImageBarrierCount, scheduleStats.BufferBarrierCount);
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestFramesRecordCommands", TestFramesRecordCommands },
+		{ "TestResizeRebuildsGraph", TestResizeRebuildsGraph },
+		{ "TestTransientMemoryIsAliased", TestTransientMemoryIsAliased },
+		{ "TestPassVariantsSwitchWithoutRebuild", TestPassVariantsSwitchWithoutRebuild },
+		{ "TestBypassedPassesOnlyCopy", TestBypassedPassesOnlyCopy },
+		{ "TestDisabledPassCannotBeBypassed", TestDisabledPassCannotBeBypassed },
+		{ "TestPassToggleRebuildsPartially", TestPassToggleRebuildsPartially },
+		{ "TestLayoutCacheRestoresSchedule", TestLayoutCacheRestoresSchedule },
+		{ "TestLayoutDiff", TestLayoutDiff },
+		{ "TestParallelRecordingMatchesSequential", TestParallelRecordingMatchesSequential },
+		{ "BenchmarkFrameAndBuildCost", BenchmarkFrameAndBuildCost }
+	});
+}
\ No newline at end of file
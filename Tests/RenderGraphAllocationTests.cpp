@@ -0,0 +1,105 @@
+#include "TestUtilities.hpp"
+#include "CountingAllocator.hpp"
+#include <OS/HeadlessWindow.hpp>
+#include <Rendering/Renderer.hpp>
+#include <Rendering/RenderGraph.hpp>
+#include <memory>
+
+using namespace Engine;
+using namespace Engine::OS;
+using namespace Engine::Rendering;
+using namespace Engine::Tests;
+
+#define WARM_UP_FRAME_COUNT 8
+#define COUNTED_FRAME_COUNT 32
+
+static bool CreateRenderer(std::unique_ptr<HeadlessWindow>& window, std::unique_ptr<Renderer>& renderer)
+{
+	window = HeadlessWindow::Create("RenderGraphAllocationTests", glm::uvec2(1280, 720));
+	if (!TEST_CHECK(window != nullptr))
+		return false;
+
+	renderer = Renderer::Create(RendererType::Null, *window, false);
+	if (!TEST_CHECK(renderer != nullptr) || !TEST_CHECK(renderer->Initialise()))
+		return false;
+
+	// The parallel algorithms may allocate for their own scheduling, and a changing render scale rebuilds the graph.
+	renderer->SetParallelRecordingState(false);
+	renderer->SetDynamicResolutionState(false);
+	return true;
+}
+
+static bool RenderFrame(Renderer& renderer)
+{
+	return TEST_CHECK(renderer.BeginFrame()) && TEST_CHECK(renderer.Render());
+}
+
+// Once every frame in flight has been recorded, drawing an unchanged graph reuses what the build and the earlier
+// frames allocated.
+static void TestSteadyStateFramesDoNotAllocate()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer))
+		return;
+
+	for (uint32_t i = 0; i < WARM_UP_FRAME_COUNT; ++i)
+	{
+		if (!RenderFrame(*renderer))
+			return;
+	}
+
+#ifdef COUNTING_ALLOCATOR
+	bool rendered = true;
+	s_allocationCount = 0;
+	s_countAllocations = true;
+	for (uint32_t i = 0; i < COUNTED_FRAME_COUNT && rendered; ++i)
+		rendered = renderer->BeginFrame() && renderer->Render();
+
+	s_countAllocations = false;
+
+	TEST_CHECK(rendered);
+	if (!TEST_CHECK(s_allocationCount == 0))
+		Logger::Error("{} heap allocations over {} steady state frames.", s_allocationCount.load(), COUNTED_FRAME_COUNT);
+#else
+	Logger::Info("Skipping allocation counting, global operator new is not replaceable across the engine library here.");
+#endif
+}
+
+// Memory usage entries are created when the graph is built and only their values change from frame to frame.
+static void TestMemoryStatsKeepTheirEntries()
+{
+	std::unique_ptr<HeadlessWindow> window;
+	std::unique_ptr<Renderer> renderer;
+	if (!CreateRenderer(window, renderer) || !RenderFrame(*renderer))
+		return;
+
+	const MemoryStats& memoryStats = renderer->GetMemoryStats();
+	if (!TEST_CHECK(!memoryStats.ResourceMemoryUsage.empty()))
+		return;
+
+	const size_t* firstUsage = &memoryStats.ResourceMemoryUsage.begin()->second;
+	size_t entryCount = memoryStats.ResourceMemoryUsage.size();
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		if (!RenderFrame(*renderer))
+			return;
+	}
+
+	TEST_CHECK(memoryStats.ResourceMemoryUsage.size() == entryCount);
+	TEST_CHECK(&memoryStats.ResourceMemoryUsage.begin()->second == firstUsage);
+
+	size_t totalUsage = 0;
+	for (const auto& [name, usage] : memoryStats.ResourceMemoryUsage)
+		totalUsage += usage;
+
+	TEST_CHECK(memoryStats.SharedUsage == totalUsage);
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestSteadyStateFramesDoNotAllocate", TestSteadyStateFramesDoNotAllocate },
+		{ "TestMemoryStatsKeepTheirEntries", TestMemoryStatsKeepTheirEntries }
+	});
+}
\ No newline at end of file
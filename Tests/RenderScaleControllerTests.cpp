@@ -0,0 +1,130 @@
+#include "TestUtilities.hpp"
+#include <Rendering/RenderScaleController.hpp>
+#include <cmath>
+
+using namespace Engine;
+using namespace Engine::Rendering;
+using namespace Engine::Tests;
+
+// Matches the controller's own threshold for scaling down.
+#define OVER_BUDGET_RATIO 1.05f
+#define TARGET_FRAME_TIME (1.0f / 60.0f)
+
+struct SimulationResult
+{
+	uint32_t ChangeCount;
+	uint32_t LastChangeFrame;
+	float FinalScale;
+};
+
+// Frame time follows the pixel count, as the controller assumes, with a little deterministic jitter on top.
+static SimulationResult Simulate(RenderScaleController& controller, float fullScaleRatio, uint32_t frameCount)
+{
+	SimulationResult result = { 0, 0, controller.GetScale() };
+	for (uint32_t frame = 0; frame < frameCount; ++frame)
+	{
+		float scale = controller.GetScale();
+		float jitter = 1.0f + 0.02f * std::sin(frame * 0.7f);
+		if (controller.Update(TARGET_FRAME_TIME * fullScaleRatio * scale * scale * jitter))
+		{
+			++result.ChangeCount;
+			result.LastChangeFrame = frame;
+		}
+	}
+
+	result.FinalScale = controller.GetScale();
+	return result;
+}
+
+static void TestHoldsScaleWithinBudget()
+{
+	RenderScaleController controller;
+	controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+
+	SimulationResult result = Simulate(controller, 1.0f, 600);
+	TEST_CHECK(result.ChangeCount == 0);
+	TEST_CHECK(result.FinalScale == 1.0f);
+}
+
+static void TestWaitsBeforeFirstChange()
+{
+	RenderScaleController controller;
+	controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+
+	for (uint32_t frame = 0; frame < 29; ++frame)
+		TEST_CHECK(!controller.Update(TARGET_FRAME_TIME * 4.0f));
+
+	TEST_CHECK(controller.Update(TARGET_FRAME_TIME * 4.0f));
+	TEST_CHECK(controller.GetScale() < 1.0f);
+}
+
+static void TestScalesDownUnderBudget()
+{
+	RenderScaleController controller;
+	controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+
+	SimulationResult result = Simulate(controller, 2.0f, 600);
+	float ratio = 2.0f * result.FinalScale * result.FinalScale;
+	TEST_CHECK(result.ChangeCount >= 1);
+	TEST_CHECK(ratio <= OVER_BUDGET_RATIO);
+	TEST_CHECK(result.FinalScale >= 0.6f);
+}
+
+static void TestScalesUpWithHeadroom()
+{
+	RenderScaleController controller;
+	controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+	controller.Reset(0.5f);
+
+	SimulationResult result = Simulate(controller, 0.5f, 600);
+	TEST_CHECK(result.ChangeCount == 1);
+	TEST_CHECK(result.FinalScale == 1.0f);
+}
+
+static void TestStaysWithinScaleRange()
+{
+	RenderScaleController controller;
+	controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+	controller.SetScaleRange(0.7f, 0.9f);
+	TEST_CHECK(std::abs(controller.GetScale() - 0.9f) < 0.001f);
+
+	SimulationResult result = Simulate(controller, 8.0f, 600);
+	TEST_CHECK(std::abs(result.FinalScale - 0.7f) < 0.001f);
+
+	controller.Reset(0.7f);
+	result = Simulate(controller, 0.1f, 600);
+	TEST_CHECK(std::abs(result.FinalScale - 0.9f) < 0.001f);
+}
+
+// Across a sweep of loads the scale settles within a few changes, never on a step predicted to run over budget, and
+// then stays there rather than oscillating between neighbouring steps.
+static void TestSettlesWithoutOscillating()
+{
+	for (float fullScaleRatio = 0.3f; fullScaleRatio <= 3.5f; fullScaleRatio += 0.05f)
+	{
+		RenderScaleController controller;
+		controller.SetTargetFrameTime(TARGET_FRAME_TIME);
+
+		SimulationResult result = Simulate(controller, fullScaleRatio, 2000);
+		float ratio = fullScaleRatio * result.FinalScale * result.FinalScale;
+		bool settled = TEST_CHECK(result.ChangeCount <= 3) && TEST_CHECK(result.LastChangeFrame < 500);
+		bool inBudget = result.FinalScale == controller.GetMinScale() || TEST_CHECK(ratio <= OVER_BUDGET_RATIO);
+		if (!settled || !inBudget)
+		{
+			Logger::Error("Load of {} times the target settled at scale {} after {} changes.", fullScaleRatio,
+				result.FinalScale, result.ChangeCount);
+		}
+	}
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestHoldsScaleWithinBudget", TestHoldsScaleWithinBudget },
+		{ "TestWaitsBeforeFirstChange", TestWaitsBeforeFirstChange },
+		{ "TestScalesDownUnderBudget", TestScalesDownUnderBudget },
+		{ "TestScalesUpWithHeadroom", TestScalesUpWithHeadroom },
+		{ "TestStaysWithinScaleRange", TestStaysWithinScaleRange },
+		{ "TestSettlesWithoutOscillating", TestSettlesWithoutOscillating }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "TestUtilities.hpp"
+#include <Core/TangentCalculator.hpp>
+#include <Core/VertexData.hpp>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define TANGENT_EPSILON 0.0001f
+#define CYLINDER_SEGMENTS 16
+#define CYLINDER_RINGS 4
+
+struct TestMesh
+{
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::vec2> TextureCoordinates;
+	std::vector<glm::vec3> Normals;
+	std::vector<uint32_t> Indices;
+};
+
+static std::vector<glm::vec4> CalculateTangents(const TestMesh& mesh)
+{
+	std::unique_ptr<VertexData> tangents;
+	TangentCalculator::CalculateTangents(VertexData(mesh.Positions), VertexData(mesh.Normals), VertexData(mesh.TextureCoordinates), mesh.Indices, tangents);
+	if (!TEST_CHECK(tangents != nullptr) || !TEST_CHECK(tangents->GetCount() == mesh.Positions.size()))
+		return {};
+
+	const glm::vec4* tangentData = tangents->GetData<glm::vec4>();
+	return std::vector<glm::vec4>(tangentData, tangentData + tangents->GetCount());
+}
+
+static bool IsUnitAndOrthogonal(const glm::vec4& tangent, const glm::vec3& normal)
+{
+	glm::vec3 direction = glm::vec3(tangent);
+	return std::abs(glm::length(direction) - 1.0f) < TANGENT_EPSILON && std::abs(glm::dot(direction, normal)) < TANGENT_EPSILON
+		&& std::abs(tangent.w) == 1.0f;
+}
+
+// Two unit squares facing +Z side by side, the right one with its U coordinate mirrored as artists do for symmetric
+// models. The halves do not share vertices, just like the split seam of a mirrored mesh.
+static TestMesh CreateMirroredQuad()
+{
+	TestMesh mesh;
+	for (uint32_t half = 0; half < 2; ++half)
+	{
+		uint32_t base = static_cast<uint32_t>(mesh.Positions.size());
+		float x = static_cast<float>(half);
+		mesh.Positions.insert(mesh.Positions.end(), { { x, 0.0f, 0.0f }, { x + 1.0f, 0.0f, 0.0f }, { x + 1.0f, 1.0f, 0.0f }, { x, 1.0f, 0.0f } });
+		mesh.Normals.insert(mesh.Normals.end(), 4, glm::vec3(0.0f, 0.0f, 1.0f));
+
+		if (half == 0)
+			mesh.TextureCoordinates.insert(mesh.TextureCoordinates.end(), { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } });
+		else
+			mesh.TextureCoordinates.insert(mesh.TextureCoordinates.end(), { { 1.0f, 0.0f }, { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } });
+
+		mesh.Indices.insert(mesh.Indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+	}
+
+	return mesh;
+}
+
+// An open cylinder around Y with shared vertices and smooth radial normals, U runs around it and V along it.
+static TestMesh CreateCylinder()
+{
+	TestMesh mesh;
+	for (uint32_t ring = 0; ring <= CYLINDER_RINGS; ++ring)
+	{
+		for (uint32_t segment = 0; segment <= CYLINDER_SEGMENTS; ++segment)
+		{
+			float u = static_cast<float>(segment) / CYLINDER_SEGMENTS;
+			float v = static_cast<float>(ring) / CYLINDER_RINGS;
+			float angle = u * 2.0f * 3.14159265f;
+			glm::vec3 normal(std::cos(angle), 0.0f, std::sin(angle));
+			mesh.Positions.push_back(normal + glm::vec3(0.0f, v * 2.0f, 0.0f));
+			mesh.Normals.push_back(normal);
+			mesh.TextureCoordinates.push_back(glm::vec2(u, v));
+		}
+	}
+
+	const uint32_t rowSize = CYLINDER_SEGMENTS + 1;
+	for (uint32_t ring = 0; ring < CYLINDER_RINGS; ++ring)
+	{
+		for (uint32_t segment = 0; segment < CYLINDER_SEGMENTS; ++segment)
+		{
+			uint32_t i0 = ring * rowSize + segment;
+			uint32_t i1 = i0 + 1;
+			uint32_t i2 = i0 + rowSize + 1;
+			uint32_t i3 = i0 + rowSize;
+			mesh.Indices.insert(mesh.Indices.end(), { i0, i2, i1, i0, i3, i2 });
+		}
+	}
+
+	return mesh;
+}
+
+// The tangent follows increasing U, so it reverses on the mirrored half while the bitangent keeps following V. Only the
+// sign in w tells the shader to flip cross(normal, tangent) back to +Y there.
+static void TestMirroredUVsFlipHandedness()
+{
+	TestMesh mesh = CreateMirroredQuad();
+	std::vector<glm::vec4> tangents = CalculateTangents(mesh);
+	if (tangents.empty())
+		return;
+
+	for (size_t i = 0; i < tangents.size(); ++i)
+	{
+		bool mirrored = i >= 4;
+		glm::vec3 expectedTangent = mirrored ? glm::vec3(-1.0f, 0.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		TEST_CHECK(glm::length(glm::vec3(tangents[i]) - expectedTangent) < TANGENT_EPSILON);
+		TEST_CHECK(tangents[i].w == (mirrored ? -1.0f : 1.0f));
+		TEST_CHECK(IsUnitAndOrthogonal(tangents[i], mesh.Normals[i]));
+
+		glm::vec3 bitangent = glm::cross(mesh.Normals[i], glm::vec3(tangents[i])) * tangents[i].w;
+		TEST_CHECK(glm::length(bitangent - glm::vec3(0.0f, 1.0f, 0.0f)) < TANGENT_EPSILON);
+	}
+}
+
+// Accumulated face tangents on a curved surface are projected into each vertex's tangent plane.
+static void TestTangentsAreOrthogonalToNormals()
+{
+	TestMesh mesh = CreateCylinder();
+	std::vector<glm::vec4> tangents = CalculateTangents(mesh);
+	if (tangents.empty())
+		return;
+
+	for (size_t i = 0; i < tangents.size(); ++i)
+	{
+		TEST_CHECK(IsUnitAndOrthogonal(tangents[i], mesh.Normals[i]));
+
+		// U runs around the cylinder, so the tangent is horizontal and the bitangent points up the cylinder along V.
+		TEST_CHECK(std::abs(tangents[i].y) < TANGENT_EPSILON);
+		glm::vec3 bitangent = glm::cross(mesh.Normals[i], glm::vec3(tangents[i])) * tangents[i].w;
+		TEST_CHECK(bitangent.y > 1.0f - TANGENT_EPSILON);
+	}
+}
+
+// Triangles without UV area or without surface area give no direction, vertices only touched by them still get a valid
+// frame instead of NaNs.
+static void TestDegenerateTrianglesAreSkipped()
+{
+	TestMesh mesh = CreateMirroredQuad();
+	for (size_t i = 0; i < 4; ++i)
+		mesh.TextureCoordinates[i] = glm::vec2(0.5f);
+
+	uint32_t base = static_cast<uint32_t>(mesh.Positions.size());
+	mesh.Positions.insert(mesh.Positions.end(), 3, glm::vec3(3.0f, 0.0f, 0.0f));
+	mesh.Normals.insert(mesh.Normals.end(), 3, glm::vec3(0.0f, 0.0f, 1.0f));
+	mesh.TextureCoordinates.insert(mesh.TextureCoordinates.end(), { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f } });
+	mesh.Indices.insert(mesh.Indices.end(), { base, base + 1, base + 2 });
+
+	std::vector<glm::vec4> tangents = CalculateTangents(mesh);
+	if (tangents.empty())
+		return;
+
+	for (size_t i = 0; i < tangents.size(); ++i)
+		TEST_CHECK(IsUnitAndOrthogonal(tangents[i], mesh.Normals[i]));
+
+	// The mirrored half is unaffected by its degenerate neighbour.
+	for (size_t i = 4; i < 8; ++i)
+	{
+		TEST_CHECK(glm::length(glm::vec3(tangents[i]) - glm::vec3(-1.0f, 0.0f, 0.0f)) < TANGENT_EPSILON);
+		TEST_CHECK(tangents[i].w == -1.0f);
+	}
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestMirroredUVsFlipHandedness", TestMirroredUVsFlipHandedness },
+		{ "TestTangentsAreOrthogonalToNormals", TestTangentsAreOrthogonalToNormals },
+		{ "TestDegenerateTrianglesAreSkipped", TestDegenerateTrianglesAreSkipped }
+	});
+}
\ No newline at end of file
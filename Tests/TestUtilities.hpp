@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Core/Logger.hpp>
+#include <stdint.h>
+#include <initializer_list>
+#include <utility>
+
+// Records a failed check without stopping the test, so one run reports every broken expectation.
+#define TEST_CHECK(condition) Engine::Tests::Check((condition), #condition, __FILE__, __LINE__)
+
+namespace Engine::Tests
+{
+	typedef void (*TestFunction)();
+
+	inline uint32_t& GetFailureCount()
+	{
+		static uint32_t failureCount = 0;
+		return failureCount;
+	}
+
+	inline bool Check(bool condition, const char* expression, const char* file, int line)
+	{
+		if (!condition)
+		{
+			Logger::Error("Check failed: {} ({}:{})", expression, file, line);
+			++GetFailureCount();
+		}
+
+		return condition;
+	}
+
+	// Runs each test in order and returns the process exit code CTest expects.
+	inline int RunTests(std::initializer_list<std::pair<const char*, TestFunction>> tests)
+	{
+		uint32_t failedTestCount = 0;
+		for (const auto& [name, function] : tests)
+		{
+			uint32_t failureCount = GetFailureCount();
+			function();
+
+			if (GetFailureCount() != failureCount)
+			{
+				Logger::Error("{} failed.", name);
+				++failedTestCount;
+			}
+			else
+			{
+				Logger::Info("{} passed.", name);
+			}
+		}
+
+		return failedTestCount == 0 ? 0 : 1;
+	}
+}
\ No newline at end of file
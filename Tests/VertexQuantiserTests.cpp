@@ -0,0 +1,122 @@
+#include "TestUtilities.hpp"
+#include <Core/VertexQuantiser.hpp>
+#include <Core/VertexData.hpp>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::Tests;
+
+#define SAMPLE_COUNT 4096
+#define UV_RANGE 4.0f
+// Half of a 16-bit unorm step on each axis, with a little room for the float maths around it.
+#define MAX_POSITION_STEPS 0.51f
+// 16-bit octahedral normals are accurate to a few thousandths of a degree, measuring through a float acos is not.
+#define MAX_NORMAL_ANGLE 0.05f
+// Half floats keep 11 significant bits, so rounding is within 2^-12 of the largest magnitude.
+#define MAX_UV_RELATIVE_ERROR (1.0f / 4096.0f)
+
+struct TestStreams
+{
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::vec3> Normals;
+	std::vector<glm::vec2> TextureCoordinates;
+};
+
+// Points spread evenly over a stretched, offset ellipsoid so every axis has a different range, normals covering both
+// hemispheres and the octahedral folds, and tiling UVs that include negative coordinates.
+static TestStreams CreateStreams()
+{
+	TestStreams streams;
+	const float goldenAngle = 3.14159265f * (3.0f - std::sqrt(5.0f));
+	for (uint32_t i = 0; i < SAMPLE_COUNT; ++i)
+	{
+		float y = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / SAMPLE_COUNT;
+		float radius = std::sqrt(1.0f - y * y);
+		float angle = goldenAngle * static_cast<float>(i);
+		glm::vec3 direction(std::cos(angle) * radius, y, std::sin(angle) * radius);
+
+		streams.Positions.push_back(glm::vec3(-20.0f, 3.0f, 150.0f) + direction * glm::vec3(40.0f, 0.5f, 7.0f));
+		streams.Normals.push_back(direction);
+		streams.TextureCoordinates.push_back(glm::vec2(std::cos(angle * 0.37f), y) * UV_RANGE);
+	}
+
+	// The axes and diagonals land exactly on the octahedron's vertices, edges and folds.
+	for (float x = -1.0f; x <= 1.0f; x += 1.0f)
+	{
+		for (float y = -1.0f; y <= 1.0f; y += 1.0f)
+		{
+			for (float z = -1.0f; z <= 1.0f; z += 1.0f)
+			{
+				if (x == 0.0f && y == 0.0f && z == 0.0f)
+					continue;
+
+				streams.Positions.push_back(glm::vec3(-20.0f, 3.0f, 150.0f));
+				streams.Normals.push_back(glm::normalize(glm::vec3(x, y, z)));
+				streams.TextureCoordinates.push_back(glm::vec2(x, z) * UV_RANGE);
+			}
+		}
+	}
+
+	return streams;
+}
+
+// Decoding the quantised streams stays within the precision each encoding can represent: positions within half a step
+// of the mesh bounds, normals within a small angle, and UVs within half float rounding of their range.
+static void TestQuantisationErrorIsBounded()
+{
+	TestStreams streams = CreateStreams();
+	VertexData positions(streams.Positions);
+	VertexData normals(streams.Normals);
+	VertexData uvs(streams.TextureCoordinates);
+
+	std::vector<QuantisedPosition> quantisedPositions;
+	std::vector<uint32_t> quantisedNormals;
+	std::vector<uint32_t> quantisedUVs;
+	glm::vec3 offset;
+	glm::vec3 scale;
+	VertexQuantiser::QuantisePositions(positions, quantisedPositions, offset, scale);
+	VertexQuantiser::QuantiseNormals(normals, quantisedNormals);
+	VertexQuantiser::QuantiseTextureCoordinates(uvs, quantisedUVs);
+
+	if (!TEST_CHECK(quantisedPositions.size() == streams.Positions.size()) || !TEST_CHECK(quantisedNormals.size() == streams.Normals.size())
+		|| !TEST_CHECK(quantisedUVs.size() == streams.TextureCoordinates.size()))
+	{
+		return;
+	}
+
+	VertexQuantisationError error;
+	VertexQuantiser::MeasureError(positions, normals, uvs, quantisedPositions, offset, scale, quantisedNormals, quantisedUVs, error);
+
+	float maxPositionError = glm::length(scale / 65535.0f) * MAX_POSITION_STEPS;
+	float maxUVError = UV_RANGE * MAX_UV_RELATIVE_ERROR;
+	Logger::Info("Position error {} of {} allowed, normal angle {} of {} degrees, UV error {} of {}.", error.MaxPositionError,
+		maxPositionError, error.MaxNormalAngle, MAX_NORMAL_ANGLE, error.MaxUVError, maxUVError);
+
+	TEST_CHECK(error.MaxPositionError <= maxPositionError);
+	TEST_CHECK(error.MaxNormalAngle <= MAX_NORMAL_ANGLE);
+	TEST_CHECK(error.MaxUVError <= maxUVError);
+}
+
+// A mesh that is flat along an axis quantises that axis to the offset without dividing by zero.
+static void TestFlatAxisDecodesExactly()
+{
+	std::vector<glm::vec3> flatPositions = { { 0.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 1.0f } };
+	std::vector<QuantisedPosition> quantisedPositions;
+	glm::vec3 offset;
+	glm::vec3 scale;
+	VertexQuantiser::QuantisePositions(VertexData(flatPositions), quantisedPositions, offset, scale);
+
+	TEST_CHECK(scale.y == 0.0f);
+	for (size_t i = 0; i < flatPositions.size(); ++i)
+		TEST_CHECK(VertexQuantiser::DecodePosition(quantisedPositions[i], offset, scale) == flatPositions[i]);
+}
+
+int main()
+{
+	return RunTests({
+		{ "TestQuantisationErrorIsBounded", TestQuantisationErrorIsBounded },
+		{ "TestFlatAxisDecodesExactly", TestFlatAxisDecodesExactly }
+	});
+}
\ No newline at end of file